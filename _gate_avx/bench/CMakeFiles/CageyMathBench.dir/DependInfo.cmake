@@ -0,0 +1,30 @@
+
+# Consider dependencies only in project.
+set(CMAKE_DEPENDS_IN_PROJECT_ONLY OFF)
+
+# The set of languages for which implicit dependencies are needed:
+set(CMAKE_DEPENDS_LANGUAGES
+  )
+
+# The set of dependency files which are needed:
+set(CMAKE_DEPENDS_DEPENDENCY_FILES
+  "/root/repo/bench/cagey/math/AngleBench.cc" "bench/CMakeFiles/CageyMathBench.dir/cagey/math/AngleBench.cc.o" "gcc" "bench/CMakeFiles/CageyMathBench.dir/cagey/math/AngleBench.cc.o.d"
+  "/root/repo/bench/cagey/math/BvhBench.cc" "bench/CMakeFiles/CageyMathBench.dir/cagey/math/BvhBench.cc.o" "gcc" "bench/CMakeFiles/CageyMathBench.dir/cagey/math/BvhBench.cc.o.d"
+  "/root/repo/bench/cagey/math/LuBench.cc" "bench/CMakeFiles/CageyMathBench.dir/cagey/math/LuBench.cc.o" "gcc" "bench/CMakeFiles/CageyMathBench.dir/cagey/math/LuBench.cc.o.d"
+  "/root/repo/bench/cagey/math/Mat4ArrayBench.cc" "bench/CMakeFiles/CageyMathBench.dir/cagey/math/Mat4ArrayBench.cc.o" "gcc" "bench/CMakeFiles/CageyMathBench.dir/cagey/math/Mat4ArrayBench.cc.o.d"
+  "/root/repo/bench/cagey/math/MatrixBench.cc" "bench/CMakeFiles/CageyMathBench.dir/cagey/math/MatrixBench.cc.o" "gcc" "bench/CMakeFiles/CageyMathBench.dir/cagey/math/MatrixBench.cc.o.d"
+  "/root/repo/bench/cagey/math/MortonBench.cc" "bench/CMakeFiles/CageyMathBench.dir/cagey/math/MortonBench.cc.o" "gcc" "bench/CMakeFiles/CageyMathBench.dir/cagey/math/MortonBench.cc.o.d"
+  "/root/repo/bench/cagey/math/PackedNormalBench.cc" "bench/CMakeFiles/CageyMathBench.dir/cagey/math/PackedNormalBench.cc.o" "gcc" "bench/CMakeFiles/CageyMathBench.dir/cagey/math/PackedNormalBench.cc.o.d"
+  "/root/repo/bench/cagey/math/RebaseBench.cc" "bench/CMakeFiles/CageyMathBench.dir/cagey/math/RebaseBench.cc.o" "gcc" "bench/CMakeFiles/CageyMathBench.dir/cagey/math/RebaseBench.cc.o.d"
+  "/root/repo/bench/cagey/math/SpatialHashBench.cc" "bench/CMakeFiles/CageyMathBench.dir/cagey/math/SpatialHashBench.cc.o" "gcc" "bench/CMakeFiles/CageyMathBench.dir/cagey/math/SpatialHashBench.cc.o.d"
+  "/root/repo/bench/cagey/math/TransformHierarchyBench.cc" "bench/CMakeFiles/CageyMathBench.dir/cagey/math/TransformHierarchyBench.cc.o" "gcc" "bench/CMakeFiles/CageyMathBench.dir/cagey/math/TransformHierarchyBench.cc.o.d"
+  "/root/repo/bench/cagey/math/UtilBench.cc" "bench/CMakeFiles/CageyMathBench.dir/cagey/math/UtilBench.cc.o" "gcc" "bench/CMakeFiles/CageyMathBench.dir/cagey/math/UtilBench.cc.o.d"
+  "/root/repo/bench/cagey/math/VectorBench.cc" "bench/CMakeFiles/CageyMathBench.dir/cagey/math/VectorBench.cc.o" "gcc" "bench/CMakeFiles/CageyMathBench.dir/cagey/math/VectorBench.cc.o.d"
+  )
+
+# Targets to which this target links.
+set(CMAKE_TARGET_LINKED_INFO_FILES
+  )
+
+# Fortran module output directory.
+set(CMAKE_Fortran_TARGET_MODULE_DIR "")
@@ -0,0 +1,33 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/CageyMathBench.dir/cagey/math/AngleBench.cc.o"
+  "CMakeFiles/CageyMathBench.dir/cagey/math/AngleBench.cc.o.d"
+  "CMakeFiles/CageyMathBench.dir/cagey/math/BvhBench.cc.o"
+  "CMakeFiles/CageyMathBench.dir/cagey/math/BvhBench.cc.o.d"
+  "CMakeFiles/CageyMathBench.dir/cagey/math/LuBench.cc.o"
+  "CMakeFiles/CageyMathBench.dir/cagey/math/LuBench.cc.o.d"
+  "CMakeFiles/CageyMathBench.dir/cagey/math/Mat4ArrayBench.cc.o"
+  "CMakeFiles/CageyMathBench.dir/cagey/math/Mat4ArrayBench.cc.o.d"
+  "CMakeFiles/CageyMathBench.dir/cagey/math/MatrixBench.cc.o"
+  "CMakeFiles/CageyMathBench.dir/cagey/math/MatrixBench.cc.o.d"
+  "CMakeFiles/CageyMathBench.dir/cagey/math/MortonBench.cc.o"
+  "CMakeFiles/CageyMathBench.dir/cagey/math/MortonBench.cc.o.d"
+  "CMakeFiles/CageyMathBench.dir/cagey/math/PackedNormalBench.cc.o"
+  "CMakeFiles/CageyMathBench.dir/cagey/math/PackedNormalBench.cc.o.d"
+  "CMakeFiles/CageyMathBench.dir/cagey/math/RebaseBench.cc.o"
+  "CMakeFiles/CageyMathBench.dir/cagey/math/RebaseBench.cc.o.d"
+  "CMakeFiles/CageyMathBench.dir/cagey/math/SpatialHashBench.cc.o"
+  "CMakeFiles/CageyMathBench.dir/cagey/math/SpatialHashBench.cc.o.d"
+  "CMakeFiles/CageyMathBench.dir/cagey/math/TransformHierarchyBench.cc.o"
+  "CMakeFiles/CageyMathBench.dir/cagey/math/TransformHierarchyBench.cc.o.d"
+  "CMakeFiles/CageyMathBench.dir/cagey/math/UtilBench.cc.o"
+  "CMakeFiles/CageyMathBench.dir/cagey/math/UtilBench.cc.o.d"
+  "CMakeFiles/CageyMathBench.dir/cagey/math/VectorBench.cc.o"
+  "CMakeFiles/CageyMathBench.dir/cagey/math/VectorBench.cc.o.d"
+  "CageyMathBench"
+  "CageyMathBench.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/CageyMathBench.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,27 @@
+
+# Consider dependencies only in project.
+set(CMAKE_DEPENDS_IN_PROJECT_ONLY OFF)
+
+# The set of languages for which implicit dependencies are needed:
+set(CMAKE_DEPENDS_LANGUAGES
+  )
+
+# The set of dependency files which are needed:
+set(CMAKE_DEPENDS_DEPENDENCY_FILES
+  "/root/repo/cagey-engine/source/cagey/input/InputManager.cc" "cagey-engine/CMakeFiles/CageyEngine.dir/source/cagey/input/InputManager.cc.o" "gcc" "cagey-engine/CMakeFiles/CageyEngine.dir/source/cagey/input/InputManager.cc.o.d"
+  "/root/repo/cagey-engine/source/cagey/input/InputSystemFactory.cc" "cagey-engine/CMakeFiles/CageyEngine.dir/source/cagey/input/InputSystemFactory.cc.o" "gcc" "cagey-engine/CMakeFiles/CageyEngine.dir/source/cagey/input/InputSystemFactory.cc.o.d"
+  "/root/repo/cagey-engine/source/cagey/input/MouseEvent.cc" "cagey-engine/CMakeFiles/CageyEngine.dir/source/cagey/input/MouseEvent.cc.o" "gcc" "cagey-engine/CMakeFiles/CageyEngine.dir/source/cagey/input/MouseEvent.cc.o.d"
+  "/root/repo/cagey-engine/source/cagey/input/x11/X11InputSystem.cc" "cagey-engine/CMakeFiles/CageyEngine.dir/source/cagey/input/x11/X11InputSystem.cc.o" "gcc" "cagey-engine/CMakeFiles/CageyEngine.dir/source/cagey/input/x11/X11InputSystem.cc.o.d"
+  "/root/repo/cagey-engine/source/cagey/input/x11/X11Keyboard.cc" "cagey-engine/CMakeFiles/CageyEngine.dir/source/cagey/input/x11/X11Keyboard.cc.o" "gcc" "cagey-engine/CMakeFiles/CageyEngine.dir/source/cagey/input/x11/X11Keyboard.cc.o.d"
+  "/root/repo/cagey-engine/source/cagey/input/x11/X11Mouse.cc" "cagey-engine/CMakeFiles/CageyEngine.dir/source/cagey/input/x11/X11Mouse.cc.o" "gcc" "cagey-engine/CMakeFiles/CageyEngine.dir/source/cagey/input/x11/X11Mouse.cc.o.d"
+  "/root/repo/cagey-engine/source/cagey/window/VideoMode.cc" "cagey-engine/CMakeFiles/CageyEngine.dir/source/cagey/window/VideoMode.cc.o" "gcc" "cagey-engine/CMakeFiles/CageyEngine.dir/source/cagey/window/VideoMode.cc.o.d"
+  "/root/repo/cagey-engine/source/cagey/window/Window.cc" "cagey-engine/CMakeFiles/CageyEngine.dir/source/cagey/window/Window.cc.o" "gcc" "cagey-engine/CMakeFiles/CageyEngine.dir/source/cagey/window/Window.cc.o.d"
+  "/root/repo/cagey-engine/source/cagey/window/WindowFactory.cc" "cagey-engine/CMakeFiles/CageyEngine.dir/source/cagey/window/WindowFactory.cc.o" "gcc" "cagey-engine/CMakeFiles/CageyEngine.dir/source/cagey/window/WindowFactory.cc.o.d"
+  )
+
+# Targets to which this target links.
+set(CMAKE_TARGET_LINKED_INFO_FILES
+  )
+
+# Fortran module output directory.
+set(CMAKE_Fortran_TARGET_MODULE_DIR "")
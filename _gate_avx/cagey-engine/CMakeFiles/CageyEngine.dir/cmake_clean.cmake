@@ -0,0 +1,27 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/CageyEngine.dir/source/cagey/input/InputManager.cc.o"
+  "CMakeFiles/CageyEngine.dir/source/cagey/input/InputManager.cc.o.d"
+  "CMakeFiles/CageyEngine.dir/source/cagey/input/InputSystemFactory.cc.o"
+  "CMakeFiles/CageyEngine.dir/source/cagey/input/InputSystemFactory.cc.o.d"
+  "CMakeFiles/CageyEngine.dir/source/cagey/input/MouseEvent.cc.o"
+  "CMakeFiles/CageyEngine.dir/source/cagey/input/MouseEvent.cc.o.d"
+  "CMakeFiles/CageyEngine.dir/source/cagey/input/x11/X11InputSystem.cc.o"
+  "CMakeFiles/CageyEngine.dir/source/cagey/input/x11/X11InputSystem.cc.o.d"
+  "CMakeFiles/CageyEngine.dir/source/cagey/input/x11/X11Keyboard.cc.o"
+  "CMakeFiles/CageyEngine.dir/source/cagey/input/x11/X11Keyboard.cc.o.d"
+  "CMakeFiles/CageyEngine.dir/source/cagey/input/x11/X11Mouse.cc.o"
+  "CMakeFiles/CageyEngine.dir/source/cagey/input/x11/X11Mouse.cc.o.d"
+  "CMakeFiles/CageyEngine.dir/source/cagey/window/VideoMode.cc.o"
+  "CMakeFiles/CageyEngine.dir/source/cagey/window/VideoMode.cc.o.d"
+  "CMakeFiles/CageyEngine.dir/source/cagey/window/Window.cc.o"
+  "CMakeFiles/CageyEngine.dir/source/cagey/window/Window.cc.o.d"
+  "CMakeFiles/CageyEngine.dir/source/cagey/window/WindowFactory.cc.o"
+  "CMakeFiles/CageyEngine.dir/source/cagey/window/WindowFactory.cc.o.d"
+  "libCageyEngine.a"
+  "libCageyEngine.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/CageyEngine.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,50 @@
+
+# Consider dependencies only in project.
+set(CMAKE_DEPENDS_IN_PROJECT_ONLY OFF)
+
+# The set of languages for which implicit dependencies are needed:
+set(CMAKE_DEPENDS_LANGUAGES
+  )
+
+# The set of dependency files which are needed:
+set(CMAKE_DEPENDS_DEPENDENCY_FILES
+  "/root/repo/test/CageyTestMain.cc" "test/CMakeFiles/CageyMathTest.dir/CageyTestMain.cc.o" "gcc" "test/CMakeFiles/CageyMathTest.dir/CageyTestMain.cc.o.d"
+  "/root/repo/test/cagey/math/AabbTest.cc" "test/CMakeFiles/CageyMathTest.dir/cagey/math/AabbTest.cc.o" "gcc" "test/CMakeFiles/CageyMathTest.dir/cagey/math/AabbTest.cc.o.d"
+  "/root/repo/test/cagey/math/Affine3Test.cc" "test/CMakeFiles/CageyMathTest.dir/cagey/math/Affine3Test.cc.o" "gcc" "test/CMakeFiles/CageyMathTest.dir/cagey/math/Affine3Test.cc.o.d"
+  "/root/repo/test/cagey/math/AlignedTest.cc" "test/CMakeFiles/CageyMathTest.dir/cagey/math/AlignedTest.cc.o" "gcc" "test/CMakeFiles/CageyMathTest.dir/cagey/math/AlignedTest.cc.o.d"
+  "/root/repo/test/cagey/math/Array3Test.cc" "test/CMakeFiles/CageyMathTest.dir/cagey/math/Array3Test.cc.o" "gcc" "test/CMakeFiles/CageyMathTest.dir/cagey/math/Array3Test.cc.o.d"
+  "/root/repo/test/cagey/math/BatchTransformTest.cc" "test/CMakeFiles/CageyMathTest.dir/cagey/math/BatchTransformTest.cc.o" "gcc" "test/CMakeFiles/CageyMathTest.dir/cagey/math/BatchTransformTest.cc.o.d"
+  "/root/repo/test/cagey/math/BvhTest.cc" "test/CMakeFiles/CageyMathTest.dir/cagey/math/BvhTest.cc.o" "gcc" "test/CMakeFiles/CageyMathTest.dir/cagey/math/BvhTest.cc.o.d"
+  "/root/repo/test/cagey/math/ConstantsTest.cc" "test/CMakeFiles/CageyMathTest.dir/cagey/math/ConstantsTest.cc.o" "gcc" "test/CMakeFiles/CageyMathTest.dir/cagey/math/ConstantsTest.cc.o.d"
+  "/root/repo/test/cagey/math/DegreeTest.cc" "test/CMakeFiles/CageyMathTest.dir/cagey/math/DegreeTest.cc.o" "gcc" "test/CMakeFiles/CageyMathTest.dir/cagey/math/DegreeTest.cc.o.d"
+  "/root/repo/test/cagey/math/ExpressionTest.cc" "test/CMakeFiles/CageyMathTest.dir/cagey/math/ExpressionTest.cc.o" "gcc" "test/CMakeFiles/CageyMathTest.dir/cagey/math/ExpressionTest.cc.o.d"
+  "/root/repo/test/cagey/math/FixedTest.cc" "test/CMakeFiles/CageyMathTest.dir/cagey/math/FixedTest.cc.o" "gcc" "test/CMakeFiles/CageyMathTest.dir/cagey/math/FixedTest.cc.o.d"
+  "/root/repo/test/cagey/math/FrustumTest.cc" "test/CMakeFiles/CageyMathTest.dir/cagey/math/FrustumTest.cc.o" "gcc" "test/CMakeFiles/CageyMathTest.dir/cagey/math/FrustumTest.cc.o.d"
+  "/root/repo/test/cagey/math/HalfTest.cc" "test/CMakeFiles/CageyMathTest.dir/cagey/math/HalfTest.cc.o" "gcc" "test/CMakeFiles/CageyMathTest.dir/cagey/math/HalfTest.cc.o.d"
+  "/root/repo/test/cagey/math/LuTest.cc" "test/CMakeFiles/CageyMathTest.dir/cagey/math/LuTest.cc.o" "gcc" "test/CMakeFiles/CageyMathTest.dir/cagey/math/LuTest.cc.o.d"
+  "/root/repo/test/cagey/math/Mat4ArrayTest.cc" "test/CMakeFiles/CageyMathTest.dir/cagey/math/Mat4ArrayTest.cc.o" "gcc" "test/CMakeFiles/CageyMathTest.dir/cagey/math/Mat4ArrayTest.cc.o.d"
+  "/root/repo/test/cagey/math/MatrixTest.cc" "test/CMakeFiles/CageyMathTest.dir/cagey/math/MatrixTest.cc.o" "gcc" "test/CMakeFiles/CageyMathTest.dir/cagey/math/MatrixTest.cc.o.d"
+  "/root/repo/test/cagey/math/MortonTest.cc" "test/CMakeFiles/CageyMathTest.dir/cagey/math/MortonTest.cc.o" "gcc" "test/CMakeFiles/CageyMathTest.dir/cagey/math/MortonTest.cc.o.d"
+  "/root/repo/test/cagey/math/PackedNormalTest.cc" "test/CMakeFiles/CageyMathTest.dir/cagey/math/PackedNormalTest.cc.o" "gcc" "test/CMakeFiles/CageyMathTest.dir/cagey/math/PackedNormalTest.cc.o.d"
+  "/root/repo/test/cagey/math/PointTest.cc" "test/CMakeFiles/CageyMathTest.dir/cagey/math/PointTest.cc.o" "gcc" "test/CMakeFiles/CageyMathTest.dir/cagey/math/PointTest.cc.o.d"
+  "/root/repo/test/cagey/math/QuaternionTest.cc" "test/CMakeFiles/CageyMathTest.dir/cagey/math/QuaternionTest.cc.o" "gcc" "test/CMakeFiles/CageyMathTest.dir/cagey/math/QuaternionTest.cc.o.d"
+  "/root/repo/test/cagey/math/RadixSortTest.cc" "test/CMakeFiles/CageyMathTest.dir/cagey/math/RadixSortTest.cc.o" "gcc" "test/CMakeFiles/CageyMathTest.dir/cagey/math/RadixSortTest.cc.o.d"
+  "/root/repo/test/cagey/math/RayPacketTest.cc" "test/CMakeFiles/CageyMathTest.dir/cagey/math/RayPacketTest.cc.o" "gcc" "test/CMakeFiles/CageyMathTest.dir/cagey/math/RayPacketTest.cc.o.d"
+  "/root/repo/test/cagey/math/RayTest.cc" "test/CMakeFiles/CageyMathTest.dir/cagey/math/RayTest.cc.o" "gcc" "test/CMakeFiles/CageyMathTest.dir/cagey/math/RayTest.cc.o.d"
+  "/root/repo/test/cagey/math/RebaseTest.cc" "test/CMakeFiles/CageyMathTest.dir/cagey/math/RebaseTest.cc.o" "gcc" "test/CMakeFiles/CageyMathTest.dir/cagey/math/RebaseTest.cc.o.d"
+  "/root/repo/test/cagey/math/SpatialHashTest.cc" "test/CMakeFiles/CageyMathTest.dir/cagey/math/SpatialHashTest.cc.o" "gcc" "test/CMakeFiles/CageyMathTest.dir/cagey/math/SpatialHashTest.cc.o.d"
+  "/root/repo/test/cagey/math/SphereTest.cc" "test/CMakeFiles/CageyMathTest.dir/cagey/math/SphereTest.cc.o" "gcc" "test/CMakeFiles/CageyMathTest.dir/cagey/math/SphereTest.cc.o.d"
+  "/root/repo/test/cagey/math/TransformHierarchyTest.cc" "test/CMakeFiles/CageyMathTest.dir/cagey/math/TransformHierarchyTest.cc.o" "gcc" "test/CMakeFiles/CageyMathTest.dir/cagey/math/TransformHierarchyTest.cc.o.d"
+  "/root/repo/test/cagey/math/TrigTest.cc" "test/CMakeFiles/CageyMathTest.dir/cagey/math/TrigTest.cc.o" "gcc" "test/CMakeFiles/CageyMathTest.dir/cagey/math/TrigTest.cc.o.d"
+  "/root/repo/test/cagey/math/UtilTest.cc" "test/CMakeFiles/CageyMathTest.dir/cagey/math/UtilTest.cc.o" "gcc" "test/CMakeFiles/CageyMathTest.dir/cagey/math/UtilTest.cc.o.d"
+  "/root/repo/test/cagey/math/VectorTest.cc" "test/CMakeFiles/CageyMathTest.dir/cagey/math/VectorTest.cc.o" "gcc" "test/CMakeFiles/CageyMathTest.dir/cagey/math/VectorTest.cc.o.d"
+  )
+
+# Targets to which this target links.
+set(CMAKE_TARGET_LINKED_INFO_FILES
+  "/root/repo/_gate_avx/gtest/CMakeFiles/gtest_main.dir/DependInfo.cmake"
+  "/root/repo/_gate_avx/gtest/CMakeFiles/gtest.dir/DependInfo.cmake"
+  )
+
+# Fortran module output directory.
+set(CMAKE_Fortran_TARGET_MODULE_DIR "")
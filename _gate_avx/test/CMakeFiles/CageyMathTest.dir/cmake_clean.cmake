@@ -0,0 +1,69 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/CageyMathTest.dir/CageyTestMain.cc.o"
+  "CMakeFiles/CageyMathTest.dir/CageyTestMain.cc.o.d"
+  "CMakeFiles/CageyMathTest.dir/cagey/math/AabbTest.cc.o"
+  "CMakeFiles/CageyMathTest.dir/cagey/math/AabbTest.cc.o.d"
+  "CMakeFiles/CageyMathTest.dir/cagey/math/Affine3Test.cc.o"
+  "CMakeFiles/CageyMathTest.dir/cagey/math/Affine3Test.cc.o.d"
+  "CMakeFiles/CageyMathTest.dir/cagey/math/AlignedTest.cc.o"
+  "CMakeFiles/CageyMathTest.dir/cagey/math/AlignedTest.cc.o.d"
+  "CMakeFiles/CageyMathTest.dir/cagey/math/Array3Test.cc.o"
+  "CMakeFiles/CageyMathTest.dir/cagey/math/Array3Test.cc.o.d"
+  "CMakeFiles/CageyMathTest.dir/cagey/math/BatchTransformTest.cc.o"
+  "CMakeFiles/CageyMathTest.dir/cagey/math/BatchTransformTest.cc.o.d"
+  "CMakeFiles/CageyMathTest.dir/cagey/math/BvhTest.cc.o"
+  "CMakeFiles/CageyMathTest.dir/cagey/math/BvhTest.cc.o.d"
+  "CMakeFiles/CageyMathTest.dir/cagey/math/ConstantsTest.cc.o"
+  "CMakeFiles/CageyMathTest.dir/cagey/math/ConstantsTest.cc.o.d"
+  "CMakeFiles/CageyMathTest.dir/cagey/math/DegreeTest.cc.o"
+  "CMakeFiles/CageyMathTest.dir/cagey/math/DegreeTest.cc.o.d"
+  "CMakeFiles/CageyMathTest.dir/cagey/math/ExpressionTest.cc.o"
+  "CMakeFiles/CageyMathTest.dir/cagey/math/ExpressionTest.cc.o.d"
+  "CMakeFiles/CageyMathTest.dir/cagey/math/FixedTest.cc.o"
+  "CMakeFiles/CageyMathTest.dir/cagey/math/FixedTest.cc.o.d"
+  "CMakeFiles/CageyMathTest.dir/cagey/math/FrustumTest.cc.o"
+  "CMakeFiles/CageyMathTest.dir/cagey/math/FrustumTest.cc.o.d"
+  "CMakeFiles/CageyMathTest.dir/cagey/math/HalfTest.cc.o"
+  "CMakeFiles/CageyMathTest.dir/cagey/math/HalfTest.cc.o.d"
+  "CMakeFiles/CageyMathTest.dir/cagey/math/LuTest.cc.o"
+  "CMakeFiles/CageyMathTest.dir/cagey/math/LuTest.cc.o.d"
+  "CMakeFiles/CageyMathTest.dir/cagey/math/Mat4ArrayTest.cc.o"
+  "CMakeFiles/CageyMathTest.dir/cagey/math/Mat4ArrayTest.cc.o.d"
+  "CMakeFiles/CageyMathTest.dir/cagey/math/MatrixTest.cc.o"
+  "CMakeFiles/CageyMathTest.dir/cagey/math/MatrixTest.cc.o.d"
+  "CMakeFiles/CageyMathTest.dir/cagey/math/MortonTest.cc.o"
+  "CMakeFiles/CageyMathTest.dir/cagey/math/MortonTest.cc.o.d"
+  "CMakeFiles/CageyMathTest.dir/cagey/math/PackedNormalTest.cc.o"
+  "CMakeFiles/CageyMathTest.dir/cagey/math/PackedNormalTest.cc.o.d"
+  "CMakeFiles/CageyMathTest.dir/cagey/math/PointTest.cc.o"
+  "CMakeFiles/CageyMathTest.dir/cagey/math/PointTest.cc.o.d"
+  "CMakeFiles/CageyMathTest.dir/cagey/math/QuaternionTest.cc.o"
+  "CMakeFiles/CageyMathTest.dir/cagey/math/QuaternionTest.cc.o.d"
+  "CMakeFiles/CageyMathTest.dir/cagey/math/RadixSortTest.cc.o"
+  "CMakeFiles/CageyMathTest.dir/cagey/math/RadixSortTest.cc.o.d"
+  "CMakeFiles/CageyMathTest.dir/cagey/math/RayPacketTest.cc.o"
+  "CMakeFiles/CageyMathTest.dir/cagey/math/RayPacketTest.cc.o.d"
+  "CMakeFiles/CageyMathTest.dir/cagey/math/RayTest.cc.o"
+  "CMakeFiles/CageyMathTest.dir/cagey/math/RayTest.cc.o.d"
+  "CMakeFiles/CageyMathTest.dir/cagey/math/RebaseTest.cc.o"
+  "CMakeFiles/CageyMathTest.dir/cagey/math/RebaseTest.cc.o.d"
+  "CMakeFiles/CageyMathTest.dir/cagey/math/SpatialHashTest.cc.o"
+  "CMakeFiles/CageyMathTest.dir/cagey/math/SpatialHashTest.cc.o.d"
+  "CMakeFiles/CageyMathTest.dir/cagey/math/SphereTest.cc.o"
+  "CMakeFiles/CageyMathTest.dir/cagey/math/SphereTest.cc.o.d"
+  "CMakeFiles/CageyMathTest.dir/cagey/math/TransformHierarchyTest.cc.o"
+  "CMakeFiles/CageyMathTest.dir/cagey/math/TransformHierarchyTest.cc.o.d"
+  "CMakeFiles/CageyMathTest.dir/cagey/math/TrigTest.cc.o"
+  "CMakeFiles/CageyMathTest.dir/cagey/math/TrigTest.cc.o.d"
+  "CMakeFiles/CageyMathTest.dir/cagey/math/UtilTest.cc.o"
+  "CMakeFiles/CageyMathTest.dir/cagey/math/UtilTest.cc.o.d"
+  "CMakeFiles/CageyMathTest.dir/cagey/math/VectorTest.cc.o"
+  "CMakeFiles/CageyMathTest.dir/cagey/math/VectorTest.cc.o.d"
+  "CageyMathTest"
+  "CageyMathTest.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/CageyMathTest.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,25 @@
+
+# Consider dependencies only in project.
+set(CMAKE_DEPENDS_IN_PROJECT_ONLY OFF)
+
+# The set of languages for which implicit dependencies are needed:
+set(CMAKE_DEPENDS_LANGUAGES
+  )
+
+# The set of dependency files which are needed:
+set(CMAKE_DEPENDS_DEPENDENCY_FILES
+  "/root/repo/test/CageyTestMain.cc" "test/CMakeFiles/CageyWindowTest.dir/CageyTestMain.cc.o" "gcc" "test/CMakeFiles/CageyWindowTest.dir/CageyTestMain.cc.o.d"
+  "/root/repo/test/cagey/window/DisplayConfigTest.cc" "test/CMakeFiles/CageyWindowTest.dir/cagey/window/DisplayConfigTest.cc.o" "gcc" "test/CMakeFiles/CageyWindowTest.dir/cagey/window/DisplayConfigTest.cc.o.d"
+  "/root/repo/test/cagey/window/VideoModeTest.cc" "test/CMakeFiles/CageyWindowTest.dir/cagey/window/VideoModeTest.cc.o" "gcc" "test/CMakeFiles/CageyWindowTest.dir/cagey/window/VideoModeTest.cc.o.d"
+  "/root/repo/test/cagey/window/WindowTest.cc" "test/CMakeFiles/CageyWindowTest.dir/cagey/window/WindowTest.cc.o" "gcc" "test/CMakeFiles/CageyWindowTest.dir/cagey/window/WindowTest.cc.o.d"
+  )
+
+# Targets to which this target links.
+set(CMAKE_TARGET_LINKED_INFO_FILES
+  "/root/repo/_gate_avx/gtest/CMakeFiles/gtest_main.dir/DependInfo.cmake"
+  "/root/repo/_gate_avx/cagey-engine/CMakeFiles/CageyEngine.dir/DependInfo.cmake"
+  "/root/repo/_gate_avx/gtest/CMakeFiles/gtest.dir/DependInfo.cmake"
+  )
+
+# Fortran module output directory.
+set(CMAKE_Fortran_TARGET_MODULE_DIR "")
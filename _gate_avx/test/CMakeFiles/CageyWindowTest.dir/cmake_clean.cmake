@@ -0,0 +1,17 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/CageyWindowTest.dir/CageyTestMain.cc.o"
+  "CMakeFiles/CageyWindowTest.dir/CageyTestMain.cc.o.d"
+  "CMakeFiles/CageyWindowTest.dir/cagey/window/DisplayConfigTest.cc.o"
+  "CMakeFiles/CageyWindowTest.dir/cagey/window/DisplayConfigTest.cc.o.d"
+  "CMakeFiles/CageyWindowTest.dir/cagey/window/VideoModeTest.cc.o"
+  "CMakeFiles/CageyWindowTest.dir/cagey/window/VideoModeTest.cc.o.d"
+  "CMakeFiles/CageyWindowTest.dir/cagey/window/WindowTest.cc.o"
+  "CMakeFiles/CageyWindowTest.dir/cagey/window/WindowTest.cc.o.d"
+  "CageyWindowTest"
+  "CageyWindowTest.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/CageyWindowTest.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+# CMake generated Testfile for 
+# Source directory: /root/repo/test
+# Build directory: /root/repo/_gate_avx/test
+# 
+# This file includes the relevant testing commands required for 
+# testing this directory and lists subdirectories to be tested as well.
+add_test(CageyMathTest "CageyMathTest")
+set_tests_properties(CageyMathTest PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/test/CMakeLists.txt;50;add_test;/root/repo/test/CMakeLists.txt;0;")
+add_test(CageyWindowTest "CageyWindowTest")
+set_tests_properties(CageyWindowTest PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/test/CMakeLists.txt;51;add_test;/root/repo/test/CMakeLists.txt;0;")
+subdirs("../gtest")
@@ -0,0 +1,135 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// cagey-engine - Toy 3D Engine 
+// Copyright (c) 2014 Kyle Girard <theycallmecoach@gmail.com>
+//
+// The MIT License (MIT)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in 
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+
+#include <cagey/math/Degree.hh>
+#include <cagey/math/Radian.hh>
+#include <cagey/math/Trig.hh>
+#include <benchmark/benchmark.h>
+#include <cmath>
+#include <random>
+#include <vector>
+
+using namespace cagey::math;
+
+namespace {
+
+/// Number of inputs cycled through, a power of two so wrapping is a mask
+constexpr std::size_t Count = 256;
+constexpr std::size_t Mask = Count - 1;
+
+template<typename T>
+auto randomValues() -> std::vector<T> {
+  std::mt19937 gen{4};
+  std::uniform_real_distribution<double> dist(-360.0, 360.0);
+  std::vector<T> ret(Count);
+  for (auto & val : ret) {
+    val = static_cast<T>(dist(gen));
+  }
+  return ret;
+}
+
+template<typename T>
+auto BM_degreeToRadian(benchmark::State & state) -> void {
+  auto const vals = randomValues<T>();
+  std::size_t i = 0;
+  for (auto _ : state) {
+    Radian<T> rad{Degree<T>{vals[i++ & Mask]}};
+    benchmark::DoNotOptimize(rad);
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+
+template<typename T>
+auto BM_radianToDegree(benchmark::State & state) -> void {
+  auto const vals = randomValues<T>();
+  std::size_t i = 0;
+  for (auto _ : state) {
+    Degree<T> deg{Radian<T>{vals[i++ & Mask]}};
+    benchmark::DoNotOptimize(deg);
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+
+template<typename T>
+auto BM_sincosStd(benchmark::State & state) -> void {
+  auto const vals = randomValues<T>();
+  std::size_t i = 0;
+  for (auto _ : state) {
+    T const val = vals[i++ & Mask];
+    benchmark::DoNotOptimize(std::sin(val));
+    benchmark::DoNotOptimize(std::cos(val));
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+
+template<typename T, Precision Prec>
+auto BM_sincos(benchmark::State & state) -> void {
+  auto const vals = randomValues<T>();
+  std::size_t i = 0;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(sincos<Prec>(Radian<T>{vals[i++ & Mask]}));
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+
+/**
+ * Whole array of Count angles per iteration
+ */
+template<typename T, Precision Prec>
+auto BM_sincosArray(benchmark::State & state) -> void {
+  auto const vals = randomValues<T>();
+  std::vector<Radian<T>> angles;
+  for (auto const val : vals) {
+    angles.emplace_back(val);
+  }
+  std::vector<T> sins(Count);
+  std::vector<T> coss(Count);
+  for (auto _ : state) {
+    sincos<Prec>(angles.data(), sins.data(), coss.data(), Count);
+    benchmark::DoNotOptimize(sins.data());
+    benchmark::DoNotOptimize(coss.data());
+  }
+  state.SetItemsProcessed(state.iterations() * Count);
+}
+
+} // namespace
+
+BENCHMARK_TEMPLATE(BM_degreeToRadian, float);
+BENCHMARK_TEMPLATE(BM_degreeToRadian, double);
+BENCHMARK_TEMPLATE(BM_radianToDegree, float);
+BENCHMARK_TEMPLATE(BM_radianToDegree, double);
+BENCHMARK_TEMPLATE(BM_sincosStd, float);
+BENCHMARK_TEMPLATE(BM_sincos, float, Precision::High);
+BENCHMARK_TEMPLATE(BM_sincos, float, Precision::Fast);
+BENCHMARK_TEMPLATE(BM_sincosArray, float, Precision::Exact);
+BENCHMARK_TEMPLATE(BM_sincosArray, float, Precision::High);
+BENCHMARK_TEMPLATE(BM_sincosArray, float, Precision::Fast);
+BENCHMARK_TEMPLATE(BM_sincosStd, double);
+BENCHMARK_TEMPLATE(BM_sincos, double, Precision::High);
+BENCHMARK_TEMPLATE(BM_sincosArray, double, Precision::Exact);
+BENCHMARK_TEMPLATE(BM_sincosArray, double, Precision::High);
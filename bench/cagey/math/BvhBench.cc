@@ -0,0 +1,91 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// cagey-engine - Toy 3D Engine 
+// Copyright (c) 2014 Kyle Girard <theycallmecoach@gmail.com>
+//
+// The MIT License (MIT)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in 
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+////////////////////////////////////////////////////////////////////////////////
+#include <cagey/math/Bvh.hh>
+#include <benchmark/benchmark.h>
+#include <random>
+#include <vector>
+
+using namespace cagey::math;
+
+namespace {
+
+/// Number of rays cycled through, a power of two so wrapping is a mask
+constexpr std::size_t Count = 1024;
+constexpr std::size_t Mask = Count - 1;
+
+auto randomBoxes(std::size_t const count) -> std::vector<Aabbf> {
+  std::mt19937 gen{3};
+  std::uniform_real_distribution<float> pos{-500.0f, 500.0f};
+  std::uniform_real_distribution<float> size{0.5f, 5.0f};
+  std::vector<Aabbf> boxes(count);
+  for (auto & box : boxes) {
+    Point3f const lo{pos(gen), pos(gen), pos(gen)};
+    box = Aabbf{lo, Point3f{lo.x + size(gen), lo.y + size(gen), lo.z + size(gen)}};
+  }
+  return boxes;
+}
+
+auto randomRays() -> std::vector<Rayf> {
+  std::mt19937 gen{9};
+  std::uniform_real_distribution<float> pos{-500.0f, 500.0f};
+  std::vector<Rayf> rays(Count);
+  for (auto & ray : rays) {
+    ray = Rayf{Point3f{pos(gen), pos(gen), pos(gen)}, Vec3f{pos(gen), pos(gen), pos(gen)}};
+  }
+  return rays;
+}
+
+/**
+ * Build time for range(0) boxes using range(1) threads, 0 for one per core
+ */
+auto BM_buildBvh(benchmark::State & state) -> void {
+  auto const boxes = randomBoxes(static_cast<std::size_t>(state.range(0)));
+  for (auto _ : state) {
+    Bvh bvh{boxes, 4, static_cast<std::size_t>(state.range(1))};
+    benchmark::DoNotOptimize(bvh.nodes().data());
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+/**
+ * Closest hit rays per second against range(0) boxes
+ */
+auto BM_raycastBvh(benchmark::State & state) -> void {
+  Bvh const bvh{randomBoxes(static_cast<std::size_t>(state.range(0))), 4, 0};
+  auto const rays = randomRays();
+  std::size_t i = 0;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(bvh.raycast(rays[i]));
+    i = (i + 1) & Mask;
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+
+} // namespace
+
+BENCHMARK(BM_buildBvh)->Args({100000, 1})->Args({100000, 0})->Unit(benchmark::kMillisecond)->UseRealTime();
+BENCHMARK(BM_raycastBvh)->Arg(10000)->Arg(100000);
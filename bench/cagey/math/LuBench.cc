@@ -0,0 +1,140 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// cagey-engine - Toy 3D Engine 
+// Copyright (c) 2014 Kyle Girard <theycallmecoach@gmail.com>
+//
+// The MIT License (MIT)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in 
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+////////////////////////////////////////////////////////////////////////////////
+#include <cagey/math/Lu.hh>
+#include <benchmark/benchmark.h>
+#include <algorithm>
+#include <random>
+#include <vector>
+
+using namespace cagey::math;
+
+namespace {
+
+/// Number of inputs cycled through, a power of two so wrapping is a mask
+constexpr std::size_t Count = 256;
+constexpr std::size_t Mask = Count - 1;
+
+template<typename T, std::size_t N>
+auto randomMatrices() -> std::vector<Matrix<T, N, N>> {
+  std::mt19937 gen{4};
+  std::uniform_real_distribution<double> dist(-10.0, 10.0);
+  std::vector<Matrix<T, N, N>> ret(Count);
+  for (auto & mat : ret) {
+    std::generate(mat.begin(), mat.end(), [&] { return static_cast<T>(dist(gen)); });
+  }
+  return ret;
+}
+
+/**
+ * det() picks the cofactor expansion for N <= 4
+ */
+template<typename T, std::size_t N>
+auto BM_detCofactor(benchmark::State & state) -> void {
+  auto const mats = randomMatrices<T, N>();
+  std::size_t i = 0;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(det(mats[i]));
+    i = (i + 1) & Mask;
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+
+template<typename T, std::size_t N>
+auto BM_detLu(benchmark::State & state) -> void {
+  auto const mats = randomMatrices<T, N>();
+  std::size_t i = 0;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(Lu<T, N>{mats[i]}.det());
+    i = (i + 1) & Mask;
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+
+/**
+ * tryInverse() picks the cofactor expansion for N <= 4 and LU otherwise
+ */
+template<typename T, std::size_t N>
+auto BM_tryInverse(benchmark::State & state) -> void {
+  auto const mats = randomMatrices<T, N>();
+  std::size_t i = 0;
+  for (auto _ : state) {
+    Matrix<T, N, N> out;
+    benchmark::DoNotOptimize(tryInverse(mats[i], out));
+    benchmark::DoNotOptimize(out);
+    i = (i + 1) & Mask;
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+
+template<typename T, std::size_t N>
+auto BM_inverseLu(benchmark::State & state) -> void {
+  auto const mats = randomMatrices<T, N>();
+  std::size_t i = 0;
+  for (auto _ : state) {
+    Matrix<T, N, N> out;
+    benchmark::DoNotOptimize(Lu<T, N>{mats[i]}.trySolve(Matrix<T, N, N>{}, out));
+    benchmark::DoNotOptimize(out);
+    i = (i + 1) & Mask;
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+
+template<typename T, std::size_t N>
+auto BM_solveLu(benchmark::State & state) -> void {
+  auto const mats = randomMatrices<T, N>();
+  Vector<T, N> b;
+  for (std::size_t k = 0; k < N; ++k) {
+    b[k] = static_cast<T>(k);
+  }
+  std::size_t i = 0;
+  for (auto _ : state) {
+    Vector<T, N> x;
+    benchmark::DoNotOptimize(trySolve(mats[i], b, x));
+    benchmark::DoNotOptimize(x);
+    i = (i + 1) & Mask;
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+
+} // namespace
+
+BENCHMARK_TEMPLATE(BM_detCofactor, float, 3);
+BENCHMARK_TEMPLATE(BM_detLu, float, 3);
+BENCHMARK_TEMPLATE(BM_detCofactor, float, 4);
+BENCHMARK_TEMPLATE(BM_detLu, float, 4);
+BENCHMARK_TEMPLATE(BM_detCofactor, double, 4);
+BENCHMARK_TEMPLATE(BM_detLu, double, 4);
+BENCHMARK_TEMPLATE(BM_tryInverse, float, 3);
+BENCHMARK_TEMPLATE(BM_inverseLu, float, 3);
+BENCHMARK_TEMPLATE(BM_tryInverse, float, 4);
+BENCHMARK_TEMPLATE(BM_inverseLu, float, 4);
+BENCHMARK_TEMPLATE(BM_tryInverse, double, 4);
+BENCHMARK_TEMPLATE(BM_inverseLu, double, 4);
+BENCHMARK_TEMPLATE(BM_tryInverse, double, 6);
+BENCHMARK_TEMPLATE(BM_tryInverse, double, 12);
+BENCHMARK_TEMPLATE(BM_solveLu, double, 6);
+BENCHMARK_TEMPLATE(BM_solveLu, double, 12);
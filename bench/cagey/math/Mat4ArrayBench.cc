@@ -0,0 +1,119 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// cagey-engine - Toy 3D Engine 
+// Copyright (c) 2014 Kyle Girard <theycallmecoach@gmail.com>
+//
+// The MIT License (MIT)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in 
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+
+#include <cagey/math/Mat4Array.hh>
+#include <benchmark/benchmark.h>
+#include <algorithm>
+#include <random>
+#include <vector>
+
+using namespace cagey::math;
+
+namespace {
+
+auto randomMatrices(std::size_t count) -> std::vector<Mat4f> {
+  std::mt19937 gen{5};
+  std::uniform_real_distribution<float> dist(-10.0f, 10.0f);
+  std::vector<Mat4f> ret(count);
+  for (auto & mat : ret) {
+    std::generate(mat.begin(), mat.end(), [&] { return dist(gen); });
+  }
+  return ret;
+}
+
+auto BM_detScalar(benchmark::State & state) -> void {
+  auto const mats = randomMatrices(static_cast<std::size_t>(state.range(0)));
+  std::vector<float> out(mats.size());
+  for (auto _ : state) {
+    std::transform(mats.begin(), mats.end(), out.begin(), [](Mat4f const & m) { return det(m); });
+    benchmark::DoNotOptimize(out.data());
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+auto BM_detArray(benchmark::State & state) -> void {
+  Mat4fArray const mats{randomMatrices(static_cast<std::size_t>(state.range(0)))};
+  std::vector<float> out(mats.size());
+  for (auto _ : state) {
+    det(mats, out.data());
+    benchmark::DoNotOptimize(out.data());
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+auto BM_inverseScalar(benchmark::State & state) -> void {
+  auto const mats = randomMatrices(static_cast<std::size_t>(state.range(0)));
+  std::vector<Mat4f> out(mats.size());
+  for (auto _ : state) {
+    for (std::size_t i = 0; i < mats.size(); ++i) {
+      tryInverse(mats[i], out[i]);
+    }
+    benchmark::DoNotOptimize(out.data());
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+auto BM_inverseArray(benchmark::State & state) -> void {
+  Mat4fArray const mats{randomMatrices(static_cast<std::size_t>(state.range(0)))};
+  Mat4fArray out;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(inverse(mats, out));
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+auto BM_multiplyScalar(benchmark::State & state) -> void {
+  auto const lhs = randomMatrices(static_cast<std::size_t>(state.range(0)));
+  auto const rhs = randomMatrices(lhs.size());
+  std::vector<Mat4f> out(lhs.size());
+  for (auto _ : state) {
+    std::transform(lhs.begin(), lhs.end(), rhs.begin(), out.begin(), [](Mat4f const & a, Mat4f const & b) { return a * b; });
+    benchmark::DoNotOptimize(out.data());
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+auto BM_multiplyArray(benchmark::State & state) -> void {
+  Mat4fArray const lhs{randomMatrices(static_cast<std::size_t>(state.range(0)))};
+  Mat4fArray const rhs{randomMatrices(lhs.size())};
+  Mat4fArray out;
+  for (auto _ : state) {
+    multiply(lhs, rhs, out);
+    benchmark::DoNotOptimize(out.stream(0));
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+} // namespace
+
+BENCHMARK(BM_detScalar)->Arg(1024)->Arg(65536);
+BENCHMARK(BM_detArray)->Arg(1024)->Arg(65536);
+BENCHMARK(BM_inverseScalar)->Arg(1024)->Arg(65536);
+BENCHMARK(BM_inverseArray)->Arg(1024)->Arg(65536);
+BENCHMARK(BM_multiplyScalar)->Arg(1024)->Arg(65536);
+BENCHMARK(BM_multiplyArray)->Arg(1024)->Arg(65536);
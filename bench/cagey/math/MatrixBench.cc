@@ -0,0 +1,201 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// cagey-engine - Toy 3D Engine 
+// Copyright (c) 2014 Kyle Girard <theycallmecoach@gmail.com>
+//
+// The MIT License (MIT)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in 
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+
+#include <cagey/math/Matrix.hh>
+#include <cagey/math/Aligned.hh>
+#include <cagey/math/Affine3.hh>
+#include <benchmark/benchmark.h>
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <vector>
+
+using namespace cagey::math;
+
+namespace {
+
+/// Number of inputs cycled through, a power of two so wrapping is a mask
+constexpr std::size_t Count = 256;
+constexpr std::size_t Mask = Count - 1;
+
+/**
+ * A batch of rotation and translation matrices, cycled through so the
+ * compiler cannot hoist the work out of the loop
+ */
+template<typename T>
+auto rigidMatrices() -> std::vector<Mat4<T>> {
+  std::mt19937 gen{1};
+  std::uniform_real_distribution<double> dist(-3.0, 3.0);
+  std::vector<Mat4<T>> ret(Count);
+  for (auto & mat : ret) {
+    double const a = dist(gen);
+    mat(0, 0) = static_cast<T>(std::cos(a)); mat(0, 1) = static_cast<T>(-std::sin(a));
+    mat(1, 0) = static_cast<T>(std::sin(a)); mat(1, 1) = static_cast<T>(std::cos(a));
+    mat(0, 3) = static_cast<T>(dist(gen));
+    mat(1, 3) = static_cast<T>(dist(gen));
+    mat(2, 3) = static_cast<T>(dist(gen));
+  }
+  return ret;
+}
+
+template<typename T>
+auto randomMatrices() -> std::vector<Mat4<T>> {
+  std::mt19937 gen{2};
+  std::uniform_real_distribution<double> dist(-10.0, 10.0);
+  std::vector<Mat4<T>> ret(Count);
+  for (auto & mat : ret) {
+    std::generate(mat.begin(), mat.end(), [&] { return static_cast<T>(dist(gen)); });
+  }
+  return ret;
+}
+
+template<typename T>
+auto BM_multiplyMat4(benchmark::State & state) -> void {
+  auto const mats = randomMatrices<T>();
+  std::size_t i = 0;
+  for (auto _ : state) {
+    auto ret = mats[i & Mask] * mats[(i + 1) & Mask];
+    benchmark::DoNotOptimize(ret);
+    ++i;
+  }
+  state.SetItemsProcessed(state.iterations());
+  state.SetBytesProcessed(state.iterations() * 2 * sizeof(Mat4<T>));
+}
+
+auto BM_multiplyMat4fA(benchmark::State & state) -> void {
+  auto const unaligned = randomMatrices<float>();
+  AlignedVector<Mat4fA> const mats(unaligned.begin(), unaligned.end());
+  std::size_t i = 0;
+  for (auto _ : state) {
+    auto ret = mats[i & Mask] * mats[(i + 1) & Mask];
+    benchmark::DoNotOptimize(ret);
+    ++i;
+  }
+  state.SetItemsProcessed(state.iterations());
+  state.SetBytesProcessed(state.iterations() * 2 * sizeof(Mat4fA));
+}
+
+template<typename T>
+auto BM_multiplyAffine3(benchmark::State & state) -> void {
+  auto const rigid = rigidMatrices<T>();
+  std::vector<Affine3<T>> affs;
+  for (auto const & mat : rigid) {
+    affs.emplace_back(mat);
+  }
+  std::size_t i = 0;
+  for (auto _ : state) {
+    auto ret = affs[i & Mask] * affs[(i + 1) & Mask];
+    benchmark::DoNotOptimize(ret);
+    ++i;
+  }
+  state.SetItemsProcessed(state.iterations());
+  state.SetBytesProcessed(state.iterations() * 2 * sizeof(Affine3<T>));
+}
+
+template<typename T>
+auto BM_multiplyVec4(benchmark::State & state) -> void {
+  auto const mats = randomMatrices<T>();
+  Vec4<T> vec{T{1}, T{2}, T{3}, T{1}};
+  std::size_t i = 0;
+  for (auto _ : state) {
+    vec = mats[i++ & Mask] * vec;
+    benchmark::DoNotOptimize(vec);
+  }
+  state.SetItemsProcessed(state.iterations());
+  state.SetBytesProcessed(state.iterations() * (sizeof(Mat4<T>) + sizeof(Vec4<T>)));
+}
+
+template<typename T>
+auto BM_det(benchmark::State & state) -> void {
+  auto const mats = randomMatrices<T>();
+  std::size_t i = 0;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(det(mats[i++ & Mask]));
+  }
+  state.SetItemsProcessed(state.iterations());
+  state.SetBytesProcessed(state.iterations() * sizeof(Mat4<T>));
+}
+
+template<typename T>
+auto BM_transpose(benchmark::State & state) -> void {
+  auto const mats = randomMatrices<T>();
+  std::size_t i = 0;
+  for (auto _ : state) {
+    auto ret = transpose(mats[i++ & Mask]);
+    benchmark::DoNotOptimize(ret);
+  }
+  state.SetItemsProcessed(state.iterations());
+  state.SetBytesProcessed(state.iterations() * sizeof(Mat4<T>));
+}
+
+template<typename T, typename F>
+auto runInverse(benchmark::State & state, F && f) -> void {
+  auto const mats = rigidMatrices<T>();
+  std::size_t i = 0;
+  for (auto _ : state) {
+    auto inv = f(mats[i++ & Mask]);
+    benchmark::DoNotOptimize(inv);
+  }
+  state.SetItemsProcessed(state.iterations());
+  state.SetBytesProcessed(state.iterations() * sizeof(Mat4<T>));
+}
+
+template<typename T>
+auto BM_inverse(benchmark::State & state) -> void {
+  runInverse<T>(state, [](Mat4<T> const & m) { return inverse(m); });
+}
+
+template<typename T>
+auto BM_inverseAffine(benchmark::State & state) -> void {
+  runInverse<T>(state, [](Mat4<T> const & m) { return inverseAffine(m); });
+}
+
+template<typename T>
+auto BM_inverseRigid(benchmark::State & state) -> void {
+  runInverse<T>(state, [](Mat4<T> const & m) { return inverseRigid(m); });
+}
+
+} // namespace
+
+BENCHMARK_TEMPLATE(BM_multiplyMat4, float);
+BENCHMARK_TEMPLATE(BM_multiplyMat4, double);
+BENCHMARK(BM_multiplyMat4fA);
+BENCHMARK_TEMPLATE(BM_multiplyAffine3, float);
+BENCHMARK_TEMPLATE(BM_multiplyAffine3, double);
+BENCHMARK_TEMPLATE(BM_multiplyVec4, float);
+BENCHMARK_TEMPLATE(BM_multiplyVec4, double);
+BENCHMARK_TEMPLATE(BM_det, float);
+BENCHMARK_TEMPLATE(BM_det, double);
+BENCHMARK_TEMPLATE(BM_transpose, float);
+BENCHMARK_TEMPLATE(BM_transpose, double);
+BENCHMARK_TEMPLATE(BM_inverse, float);
+BENCHMARK_TEMPLATE(BM_inverseAffine, float);
+BENCHMARK_TEMPLATE(BM_inverseRigid, float);
+BENCHMARK_TEMPLATE(BM_inverse, double);
+BENCHMARK_TEMPLATE(BM_inverseAffine, double);
+BENCHMARK_TEMPLATE(BM_inverseRigid, double);
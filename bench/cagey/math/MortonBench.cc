@@ -0,0 +1,157 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// cagey-engine - Toy 3D Engine 
+// Copyright (c) 2014 Kyle Girard <theycallmecoach@gmail.com>
+//
+// The MIT License (MIT)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in 
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+////////////////////////////////////////////////////////////////////////////////
+#include <cagey/math/Morton.hh>
+#include <cagey/math/RadixSort.hh>
+#include <benchmark/benchmark.h>
+#include <algorithm>
+#include <cstdint>
+#include <numeric>
+#include <random>
+#include <utility>
+#include <vector>
+
+using namespace cagey::math;
+
+namespace {
+
+constexpr std::size_t Count = 1 << 20;
+
+auto randomPoints() -> std::vector<Point3u> {
+  std::mt19937 gen{5};
+  std::uniform_int_distribution<unsigned> dist(0, (1u << 21) - 1);
+  std::vector<Point3u> ret(Count);
+  for (auto & pt : ret) {
+    pt = Point3u{dist(gen), dist(gen), dist(gen)};
+  }
+  return ret;
+}
+
+auto randomPoints2() -> std::vector<Point2u> {
+  std::mt19937 gen{7};
+  std::uniform_int_distribution<unsigned> dist;
+  std::vector<Point2u> ret(Count);
+  for (auto & pt : ret) {
+    pt = Point2u{dist(gen), dist(gen)};
+  }
+  return ret;
+}
+
+auto randomCodes() -> std::vector<std::uint64_t> {
+  auto const pts = randomPoints();
+  std::vector<std::uint64_t> ret(Count);
+  encodeMorton3(pts.data(), ret.data(), Count);
+  return ret;
+}
+
+auto BM_encodeMorton3(benchmark::State & state) -> void {
+  auto const pts = randomPoints();
+  std::vector<std::uint64_t> codes(Count);
+  for (auto _ : state) {
+    encodeMorton3(pts.data(), codes.data(), Count);
+    benchmark::DoNotOptimize(codes.data());
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations() * Count);
+}
+
+auto BM_decodeMorton3(benchmark::State & state) -> void {
+  auto const codes = randomCodes();
+  std::vector<Point3u> pts(Count);
+  for (auto _ : state) {
+    decodeMorton3(codes.data(), pts.data(), Count);
+    benchmark::DoNotOptimize(pts.data());
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations() * Count);
+}
+
+auto BM_encodeMorton2(benchmark::State & state) -> void {
+  auto const pts = randomPoints2();
+  std::vector<std::uint64_t> codes(Count);
+  for (auto _ : state) {
+    encodeMorton2(pts.data(), codes.data(), Count);
+    benchmark::DoNotOptimize(codes.data());
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations() * Count);
+}
+
+auto BM_decodeMorton2(benchmark::State & state) -> void {
+  auto const pts = randomPoints2();
+  std::vector<std::uint64_t> codes(Count);
+  encodeMorton2(pts.data(), codes.data(), Count);
+  std::vector<Point2u> decoded(Count);
+  for (auto _ : state) {
+    decodeMorton2(codes.data(), decoded.data(), Count);
+    benchmark::DoNotOptimize(decoded.data());
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations() * Count);
+}
+
+/**
+ * Sort Morton codes with the index of the point each came from
+ */
+auto BM_radixSort(benchmark::State & state) -> void {
+  auto const codes = randomCodes();
+  std::vector<std::uint64_t> keys(Count);
+  std::vector<std::uint32_t> values(Count);
+  for (auto _ : state) {
+    state.PauseTiming();
+    keys = codes;
+    std::iota(values.begin(), values.end(), 0u);
+    state.ResumeTiming();
+    radixSort(keys, values, static_cast<std::size_t>(state.range(0)));
+    benchmark::DoNotOptimize(keys.data());
+    benchmark::DoNotOptimize(values.data());
+  }
+  state.SetItemsProcessed(state.iterations() * Count);
+}
+
+auto BM_stdSort(benchmark::State & state) -> void {
+  auto const codes = randomCodes();
+  std::vector<std::pair<std::uint64_t, std::uint32_t>> pairs(Count);
+  for (auto _ : state) {
+    state.PauseTiming();
+    for (std::size_t i = 0; i < Count; ++i) {
+      pairs[i] = {codes[i], static_cast<std::uint32_t>(i)};
+    }
+    state.ResumeTiming();
+    std::sort(pairs.begin(), pairs.end());
+    benchmark::DoNotOptimize(pairs.data());
+  }
+  state.SetItemsProcessed(state.iterations() * Count);
+}
+
+} // namespace
+
+BENCHMARK(BM_encodeMorton2);
+BENCHMARK(BM_decodeMorton2);
+BENCHMARK(BM_encodeMorton3);
+BENCHMARK(BM_decodeMorton3);
+BENCHMARK(BM_radixSort)->Arg(1)->Arg(4)->Arg(0)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_stdSort)->Unit(benchmark::kMillisecond);
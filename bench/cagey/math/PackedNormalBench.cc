@@ -0,0 +1,111 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// cagey-engine - Toy 3D Engine 
+// Copyright (c) 2014 Kyle Girard <theycallmecoach@gmail.com>
+//
+// The MIT License (MIT)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in 
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+
+#include <cagey/math/PackedNormal.hh>
+#include <benchmark/benchmark.h>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+using namespace cagey::math;
+
+namespace {
+
+constexpr std::size_t Count = 4096;
+
+auto randomNormals() -> std::vector<Vec3f> {
+  std::mt19937 gen{6};
+  std::normal_distribution<float> dist;
+  std::vector<Vec3f> ret;
+  for (std::size_t i = 0; i < Count; ++i) {
+    ret.push_back(normalize(Vec3f{dist(gen), dist(gen), dist(gen)}));
+  }
+  return ret;
+}
+
+auto BM_encodeOct32(benchmark::State & state) -> void {
+  auto const normals = randomNormals();
+  std::vector<std::uint32_t> packed(Count);
+  for (auto _ : state) {
+    encodeOct32(normals.data(), packed.data(), Count);
+    benchmark::DoNotOptimize(packed.data());
+  }
+  state.SetItemsProcessed(state.iterations() * Count);
+}
+
+auto BM_decodeOct32(benchmark::State & state) -> void {
+  auto const normals = randomNormals();
+  std::vector<std::uint32_t> packed(Count);
+  encodeOct32(normals.data(), packed.data(), Count);
+  std::vector<Vec3f> decoded(Count);
+  for (auto _ : state) {
+    decodeOct32(packed.data(), decoded.data(), Count);
+    benchmark::DoNotOptimize(decoded.data());
+  }
+  state.SetItemsProcessed(state.iterations() * Count);
+}
+
+auto BM_encodeOct16(benchmark::State & state) -> void {
+  auto const normals = randomNormals();
+  std::vector<std::uint16_t> packed(Count);
+  for (auto _ : state) {
+    encodeOct16(normals.data(), packed.data(), Count);
+    benchmark::DoNotOptimize(packed.data());
+  }
+  state.SetItemsProcessed(state.iterations() * Count);
+}
+
+auto BM_encode1010102(benchmark::State & state) -> void {
+  auto const normals = randomNormals();
+  std::vector<std::uint32_t> packed(Count);
+  for (auto _ : state) {
+    encode1010102(normals.data(), static_cast<float const *>(nullptr), packed.data(), Count);
+    benchmark::DoNotOptimize(packed.data());
+  }
+  state.SetItemsProcessed(state.iterations() * Count);
+}
+
+auto BM_decode1010102(benchmark::State & state) -> void {
+  auto const normals = randomNormals();
+  std::vector<std::uint32_t> packed(Count);
+  encode1010102(normals.data(), static_cast<float const *>(nullptr), packed.data(), Count);
+  std::vector<Vec3f> decoded(Count);
+  for (auto _ : state) {
+    decode1010102(packed.data(), decoded.data(), static_cast<float *>(nullptr), Count);
+    benchmark::DoNotOptimize(decoded.data());
+  }
+  state.SetItemsProcessed(state.iterations() * Count);
+}
+
+} // namespace
+
+BENCHMARK(BM_encodeOct32);
+BENCHMARK(BM_decodeOct32);
+BENCHMARK(BM_encodeOct16);
+BENCHMARK(BM_encode1010102);
+BENCHMARK(BM_decode1010102);
@@ -0,0 +1,82 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// cagey-engine - Toy 3D Engine 
+// Copyright (c) 2014 Kyle Girard <theycallmecoach@gmail.com>
+//
+// The MIT License (MIT)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in 
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+
+#include <cagey/math/Rebase.hh>
+#include <benchmark/benchmark.h>
+#include <random>
+#include <vector>
+
+using namespace cagey::math;
+
+namespace {
+
+constexpr std::size_t Count = 1 << 16;
+
+Point3d const Camera{1.0e7, -2.5e7, 6.0e6};
+
+auto makeWorld() -> std::vector<Point3d> {
+  std::mt19937 gen{6};
+  std::uniform_real_distribution<double> dist(-1000.0, 1000.0);
+  std::vector<Point3d> ret(Count);
+  for (auto & pt : ret) {
+    pt = Point3d{Camera.x + dist(gen), Camera.y + dist(gen), Camera.z + dist(gen)};
+  }
+  return ret;
+}
+
+/**
+ * Rebase one point at a time, what callers wrote before the array form
+ */
+auto BM_rebaseScalar(benchmark::State & state) -> void {
+  auto const in = makeWorld();
+  std::vector<Point3f> out(Count);
+  for (auto _ : state) {
+    for (std::size_t i = 0; i < Count; ++i) {
+      out[i] = rebase(in[i], Camera);
+    }
+    benchmark::DoNotOptimize(out.data());
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations() * Count);
+}
+
+auto BM_rebaseArray(benchmark::State & state) -> void {
+  auto const in = makeWorld();
+  std::vector<Point3f> out(Count);
+  for (auto _ : state) {
+    rebase(in.data(), Camera, out.data(), Count);
+    benchmark::DoNotOptimize(out.data());
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations() * Count);
+}
+
+} // namespace
+
+BENCHMARK(BM_rebaseScalar);
+BENCHMARK(BM_rebaseArray);
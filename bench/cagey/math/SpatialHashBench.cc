@@ -0,0 +1,81 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// cagey-engine - Toy 3D Engine 
+// Copyright (c) 2014 Kyle Girard <theycallmecoach@gmail.com>
+//
+// The MIT License (MIT)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in 
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+////////////////////////////////////////////////////////////////////////////////
+#include <cagey/math/SpatialHash.hh>
+#include <benchmark/benchmark.h>
+#include <random>
+#include <vector>
+
+using namespace cagey::math;
+
+namespace {
+
+/// Number of query centers cycled through, a power of two so wrapping is a mask
+constexpr std::size_t Count = 256;
+constexpr std::size_t Mask = Count - 1;
+
+auto randomPoints(std::size_t const count, float const extent) -> std::vector<Point3f> {
+  std::mt19937 gen{13};
+  std::uniform_real_distribution<float> pos{-extent, extent};
+  std::vector<Point3f> points(count);
+  for (auto & pt : points) {
+    pt = Point3f{pos(gen), pos(gen), pos(gen)};
+  }
+  return points;
+}
+
+/**
+ * Rebuild over range(0) points, buffers are reused like a per frame update
+ */
+auto BM_rebuildSpatialHash(benchmark::State & state) -> void {
+  auto const points = randomPoints(static_cast<std::size_t>(state.range(0)), 1000.0f);
+  SpatialHash3f hash{4.0f};
+  for (auto _ : state) {
+    hash.rebuild(points);
+    benchmark::DoNotOptimize(hash.indices().data());
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+auto BM_queryRadiusSpatialHash(benchmark::State & state) -> void {
+  auto const points = randomPoints(1 << 20, 1000.0f);
+  auto const centers = randomPoints(Count, 1000.0f);
+  SpatialHash3f hash{4.0f};
+  hash.rebuild(points);
+  std::size_t i = 0;
+  for (auto _ : state) {
+    std::size_t found = 0;
+    hash.queryRadius(centers[i], 4.0f, [&found](std::uint32_t) { ++found; });
+    benchmark::DoNotOptimize(found);
+    i = (i + 1) & Mask;
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+
+} // namespace
+
+BENCHMARK(BM_rebuildSpatialHash)->Arg(1 << 16)->Arg(1 << 20)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_queryRadiusSpatialHash);
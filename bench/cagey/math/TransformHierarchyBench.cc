@@ -0,0 +1,72 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// cagey-engine - Toy 3D Engine 
+// Copyright (c) 2014 Kyle Girard <theycallmecoach@gmail.com>
+//
+// The MIT License (MIT)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in 
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+////////////////////////////////////////////////////////////////////////////////
+#include <cagey/math/TransformHierarchy.hh>
+#include <benchmark/benchmark.h>
+#include <random>
+
+using namespace cagey::math;
+
+namespace {
+
+/**
+ * A 200k node forest about a dozen levels deep, each node below the first
+ * few parented to a random node a quarter of the way back
+ */
+auto makeHierarchy() -> TransformHierarchyf {
+  std::mt19937 gen{19};
+  std::uniform_real_distribution<float> dist{-1.0f, 1.0f};
+  TransformHierarchyf tree;
+  tree.reserve(200000);
+  for (std::uint32_t i = 0; i < 200000; ++i) {
+    auto const local = makeTranslation(dist(gen), dist(gen), dist(gen));
+    if (i < 4) {
+      tree.add(TransformHierarchyf::NoParent, local);
+    } else {
+      tree.add(std::uniform_int_distribution<std::uint32_t>{i / 8, i / 4 - 1}(gen), local);
+    }
+  }
+  return tree;
+}
+
+/**
+ * Full update on a pool of range(0) threads, 0 for one per core
+ */
+auto BM_updateHierarchy(benchmark::State & state) -> void {
+  auto tree = makeHierarchy();
+  ThreadPool pool{static_cast<std::size_t>(state.range(0))};
+  for (auto _ : state) {
+    for (std::uint32_t root = 0; root < 4; ++root) {
+      tree.setLocal(root, tree.local(root));
+    }
+    benchmark::DoNotOptimize(tree.update(pool));
+  }
+  state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(tree.size()));
+}
+
+} // namespace
+
+BENCHMARK(BM_updateHierarchy)->Arg(1)->Arg(2)->Arg(4)->Arg(8)->Arg(0)->Unit(benchmark::kMillisecond)->UseRealTime();
@@ -0,0 +1,141 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// cagey-engine - Toy 3D Engine 
+// Copyright (c) 2014 Kyle Girard <theycallmecoach@gmail.com>
+//
+// The MIT License (MIT)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in 
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+
+#include <cagey/math/Util.hh>
+#include <benchmark/benchmark.h>
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <vector>
+
+using namespace cagey::math;
+
+namespace {
+
+/// Number of inputs cycled through, a power of two so wrapping is a mask
+constexpr std::size_t Count = 256;
+constexpr std::size_t Mask = Count - 1;
+
+/**
+ * Pairs that are equal, nearly equal, zero and far apart so every branch
+ * of equals is exercised
+ */
+template<typename T>
+auto valuePairs() -> std::vector<T> {
+  std::mt19937 gen{5};
+  std::uniform_real_distribution<double> dist(-100.0, 100.0);
+  std::vector<T> ret(2 * Count);
+  for (std::size_t i = 0; i < ret.size(); i += 2) {
+    T const x = static_cast<T>(dist(gen));
+    ret[i] = x;
+    switch (i / 2 % 4) {
+      case 0: ret[i + 1] = x; break;
+      case 1: ret[i + 1] = x * (T{1} + std::numeric_limits<T>::epsilon()); break;
+      case 2: ret[i] = T{0}; ret[i + 1] = std::numeric_limits<T>::epsilon() / 2; break;
+      default: ret[i + 1] = static_cast<T>(dist(gen)); break;
+    }
+  }
+  return ret;
+}
+
+template<typename T>
+auto BM_equals(benchmark::State & state) -> void {
+  auto const vals = valuePairs<T>();
+  std::size_t i = 0;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(equals(vals[i], vals[i + 1]));
+    i = (i + 2) & (2 * Count - 1);
+  }
+  state.SetItemsProcessed(state.iterations());
+  state.SetBytesProcessed(state.iterations() * 2 * sizeof(T));
+}
+
+/// Size of the snapshots compared by the array benchmarks
+constexpr std::size_t SnapshotSize = 1 << 16;
+
+/**
+ * A snapshot and a replay of it a few ulps off, which match throughout so
+ * the whole array is scanned
+ */
+template<typename T>
+auto snapshots() -> std::pair<std::vector<T>, std::vector<T>> {
+  std::mt19937 gen{6};
+  std::uniform_real_distribution<T> dist(-100, 100);
+  std::vector<T> lhs(SnapshotSize);
+  std::generate(lhs.begin(), lhs.end(), [&] { return dist(gen); });
+  std::vector<T> rhs(lhs);
+  for (auto & x : rhs) {
+    x = std::nextafter(x, T{0});
+  }
+  return {lhs, rhs};
+}
+
+/**
+ * Element by element loop over equals, what callers wrote before
+ * allNearlyEqual
+ */
+template<typename T>
+auto BM_equalsLoop(benchmark::State & state) -> void {
+  auto const snap = snapshots<T>();
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(std::equal(snap.first.begin(), snap.first.end(), snap.second.begin(),
+                                        [](T l, T r) { return equals(l, r); }));
+  }
+  state.SetItemsProcessed(state.iterations() * SnapshotSize);
+}
+
+template<typename T>
+auto BM_allNearlyEqualUlps(benchmark::State & state) -> void {
+  auto const snap = snapshots<T>();
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(allNearlyEqual(snap.first.data(), snap.second.data(), SnapshotSize,
+                                            Tolerance<T>::ulps(4)));
+  }
+  state.SetItemsProcessed(state.iterations() * SnapshotSize);
+}
+
+template<typename T>
+auto BM_allNearlyEqualRelAbs(benchmark::State & state) -> void {
+  auto const snap = snapshots<T>();
+  auto const tol = Tolerance<T>::relAbs(std::numeric_limits<T>::epsilon() * 4, std::numeric_limits<T>::min());
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(allNearlyEqual(snap.first.data(), snap.second.data(), SnapshotSize, tol));
+  }
+  state.SetItemsProcessed(state.iterations() * SnapshotSize);
+}
+
+} // namespace
+
+BENCHMARK_TEMPLATE(BM_equals, float);
+BENCHMARK_TEMPLATE(BM_equals, double);
+BENCHMARK_TEMPLATE(BM_equalsLoop, float);
+BENCHMARK_TEMPLATE(BM_allNearlyEqualUlps, float);
+BENCHMARK_TEMPLATE(BM_allNearlyEqualRelAbs, float);
+BENCHMARK_TEMPLATE(BM_equalsLoop, double);
+BENCHMARK_TEMPLATE(BM_allNearlyEqualUlps, double);
+BENCHMARK_TEMPLATE(BM_allNearlyEqualRelAbs, double);
@@ -0,0 +1,101 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// cagey-engine - Toy 3D Engine 
+// Copyright (c) 2014 Kyle Girard <theycallmecoach@gmail.com>
+//
+// The MIT License (MIT)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in 
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+
+#include <cagey/math/Vector.hh>
+#include <benchmark/benchmark.h>
+#include <random>
+#include <vector>
+
+using namespace cagey::math;
+
+namespace {
+
+/// Number of inputs cycled through, a power of two so wrapping is a mask
+constexpr std::size_t Count = 256;
+constexpr std::size_t Mask = Count - 1;
+
+template<typename T, std::size_t N>
+auto randomVectors() -> std::vector<Vector<T, N>> {
+  std::mt19937 gen{3};
+  std::uniform_real_distribution<double> dist(-10.0, 10.0);
+  std::vector<Vector<T, N>> ret(Count);
+  for (auto & vec : ret) {
+    for (auto & e : vec) {
+      e = static_cast<T>(dist(gen));
+    }
+  }
+  return ret;
+}
+
+template<typename T, std::size_t N>
+auto BM_dot(benchmark::State & state) -> void {
+  auto const vecs = randomVectors<T, N>();
+  std::size_t i = 0;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(dot(vecs[i & Mask], vecs[(i + 1) & Mask]));
+    ++i;
+  }
+  state.SetItemsProcessed(state.iterations());
+  state.SetBytesProcessed(state.iterations() * 2 * sizeof(Vector<T, N>));
+}
+
+template<typename T>
+auto BM_cross(benchmark::State & state) -> void {
+  auto const vecs = randomVectors<T, 3>();
+  std::size_t i = 0;
+  for (auto _ : state) {
+    auto ret = cross(vecs[i & Mask], vecs[(i + 1) & Mask]);
+    benchmark::DoNotOptimize(ret);
+    ++i;
+  }
+  state.SetItemsProcessed(state.iterations());
+  state.SetBytesProcessed(state.iterations() * 2 * sizeof(Vec3<T>));
+}
+
+template<typename T, std::size_t N>
+auto BM_normalize(benchmark::State & state) -> void {
+  auto const vecs = randomVectors<T, N>();
+  std::size_t i = 0;
+  for (auto _ : state) {
+    auto ret = normalize(vecs[i++ & Mask]);
+    benchmark::DoNotOptimize(ret);
+  }
+  state.SetItemsProcessed(state.iterations());
+  state.SetBytesProcessed(state.iterations() * sizeof(Vector<T, N>));
+}
+
+} // namespace
+
+BENCHMARK_TEMPLATE(BM_dot, float, 3);
+BENCHMARK_TEMPLATE(BM_dot, float, 4);
+BENCHMARK_TEMPLATE(BM_dot, double, 3);
+BENCHMARK_TEMPLATE(BM_cross, float);
+BENCHMARK_TEMPLATE(BM_cross, double);
+BENCHMARK_TEMPLATE(BM_normalize, float, 3);
+BENCHMARK_TEMPLATE(BM_normalize, float, 4);
+BENCHMARK_TEMPLATE(BM_normalize, double, 3);
@@ -0,0 +1,182 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// cagey-engine - Toy 3D Engine
+// Copyright (c) 2014 Kyle Girard <theycallmecoach@gmail.com>
+//
+// The MIT License (MIT)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+
+/**
+ * @file
+ * @ref cagey::math::Aabb class.
+ */
+
+#ifndef CAGEY_MATH_AABB_HH_
+#define CAGEY_MATH_AABB_HH_
+
+#include <algorithm>
+#include <limits>
+#include <type_traits>
+#include <iostream>
+
+#include "cagey/math/Point.hh"
+#include "cagey/math/Vector.hh"
+
+namespace cagey {
+namespace math {
+
+/**
+ * Axis aligned bounding box given by its minimum and maximum corners.
+ *
+ * @tparam T underlying type
+ */
+template<typename T>
+class Aabb {
+public:
+  /** @cond doxygen has some issues with static assert */
+  static_assert(std::is_arithmetic<T>::value, "Underlying type must be a number");
+  /** @endcond */
+
+  /// The underlying type of this Aabb
+  using Type = T;
+
+  /**
+   * Construct an empty box, merging anything into it yields that thing
+   */
+  constexpr Aabb() noexcept
+    : min{std::numeric_limits<T>::max(), std::numeric_limits<T>::max(), std::numeric_limits<T>::max()},
+      max{std::numeric_limits<T>::lowest(), std::numeric_limits<T>::lowest(), std::numeric_limits<T>::lowest()} {}
+
+  /**
+   * Construct a box from its corners
+   *
+   * @param lo the minimum corner
+   * @param hi the maximum corner
+   */
+  constexpr Aabb(Point3<T> const & lo, Point3<T> const & hi) noexcept : min(lo), max(hi) {}
+
+public:
+  Point3<T> min; ///< The minimum corner
+  Point3<T> max; ///< The maximum corner
+};
+
+using Aabbi = Aabb<int>;
+using Aabbf = Aabb<float>;
+using Aabbd = Aabb<double>;
+
+/**
+ * Return true if the box contains at least one point
+ */
+template<typename T>
+auto isEmpty(Aabb<T> const & box) -> bool {
+  return box.min.x > box.max.x || box.min.y > box.max.y || box.min.z > box.max.z;
+}
+
+/**
+ * Return the center of the given box
+ */
+template<typename T>
+auto center(Aabb<T> const & box) -> Point3<T> {
+  return Point3<T>{(box.min.x + box.max.x) / T{2}, (box.min.y + box.max.y) / T{2}, (box.min.z + box.max.z) / T{2}};
+}
+
+/**
+ * Return half the size of the given box along each axis
+ */
+template<typename T>
+auto extents(Aabb<T> const & box) -> Vec3<T> {
+  return Vec3<T>{(box.max.x - box.min.x) / T{2}, (box.max.y - box.min.y) / T{2}, (box.max.z - box.min.z) / T{2}};
+}
+
+/**
+ * Return the surface area of the given box
+ */
+template<typename T>
+auto surfaceArea(Aabb<T> const & box) -> T {
+  T const dx = box.max.x - box.min.x;
+  T const dy = box.max.y - box.min.y;
+  T const dz = box.max.z - box.min.z;
+  return T{2} * (dx * dy + dy * dz + dz * dx);
+}
+
+/**
+ * Return the smallest box containing both boxes
+ */
+template<typename T>
+auto merge(Aabb<T> const & lhs, Aabb<T> const & rhs) -> Aabb<T> {
+  using std::min;
+  using std::max;
+  return Aabb<T>{Point3<T>{min(lhs.min.x, rhs.min.x), min(lhs.min.y, rhs.min.y), min(lhs.min.z, rhs.min.z)},
+                 Point3<T>{max(lhs.max.x, rhs.max.x), max(lhs.max.y, rhs.max.y), max(lhs.max.z, rhs.max.z)}};
+}
+
+/**
+ * Return the smallest box containing the box and the point
+ */
+template<typename T>
+auto merge(Aabb<T> const & box, Point3<T> const & pt) -> Aabb<T> {
+  return merge(box, Aabb<T>{pt, pt});
+}
+
+/**
+ * Return true if the point lies inside or on the box
+ */
+template<typename T>
+auto contains(Aabb<T> const & box, Point3<T> const & pt) -> bool {
+  return pt.x >= box.min.x && pt.x <= box.max.x &&
+         pt.y >= box.min.y && pt.y <= box.max.y &&
+         pt.z >= box.min.z && pt.z <= box.max.z;
+}
+
+/**
+ * Return true if the boxes overlap or touch
+ */
+template<typename T>
+auto intersects(Aabb<T> const & lhs, Aabb<T> const & rhs) -> bool {
+  return lhs.min.x <= rhs.max.x && rhs.min.x <= lhs.max.x &&
+         lhs.min.y <= rhs.max.y && rhs.min.y <= lhs.max.y &&
+         lhs.min.z <= rhs.max.z && rhs.min.z <= lhs.max.z;
+}
+
+template<typename T>
+auto operator==(Aabb<T> const & lhs, Aabb<T> const & rhs) -> bool {
+  return lhs.min == rhs.min && lhs.max == rhs.max;
+}
+
+template<typename T>
+auto operator!=(Aabb<T> const & lhs, Aabb<T> const & rhs) -> bool {
+  return !(lhs == rhs);
+}
+
+/**
+ * Output the given box to the given output stream
+ */
+template<typename T>
+auto operator<<(std::ostream & os, Aabb<T> const & box) -> std::ostream & {
+  return os << "Aabb(" << box.min << ", " << box.max << ")";
+}
+
+} // namespace math
+} // namespace cagey
+
+#endif /* CAGEY_MATH_AABB_HH_ */
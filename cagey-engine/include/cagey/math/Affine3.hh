@@ -0,0 +1,413 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// cagey-engine - Toy 3D Engine
+// Copyright (c) 2014 Kyle Girard <theycallmecoach@gmail.com>
+//
+// The MIT License (MIT)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+
+/**
+ * @file
+ * @ref cagey::math::Affine3 class.
+ */
+
+#ifndef CAGEY_MATH_AFFINE3_HH_
+#define CAGEY_MATH_AFFINE3_HH_
+
+#include <cstddef>
+#include <cmath>
+#include <limits>
+#include <array>
+#include <type_traits>
+#include <iostream>
+
+#include "cagey/math/Matrix.hh"
+#include "cagey/math/Vector.hh"
+#include "cagey/math/Point.hh"
+#include "cagey/math/BatchTransform.hh"
+#include "cagey/math/Simd.hh"
+#include "cagey/core/Exception.hh"
+
+namespace cagey {
+namespace math {
+
+/**
+ * Affine transform stored as the upper 3x4 of a Mat4, the bottom row being
+ * implicitly (0, 0, 0, 1).  A quarter smaller than a Mat4 and cheaper to
+ * compose and invert.
+ *
+ * Like Matrix the storage is column major: three basis columns followed by
+ * the translation.
+ *
+ * @tparam T underlying floating point type
+ */
+template<typename T>
+class Affine3 {
+public:
+  /** @cond doxygen has some issues with static assert */
+  static_assert(std::is_floating_point<T>::value, "Underlying type must be floating point");
+  /** @endcond */
+
+  /// The underlying type of this transform
+  using Type = T;
+
+  /**
+   * Construct the identity transform
+   */
+  constexpr Affine3() noexcept : matrix{std::array<T, 12>{{1, 0, 0, 0, 1, 0, 0, 0, 1, 0, 0, 0}}} {}
+
+  /**
+   * Construct from the upper 3x4 of a transform
+   *
+   * @param mat basis columns followed by the translation
+   */
+  constexpr explicit Affine3(Matrix<T, 3, 4> const & mat) noexcept : matrix(mat) {}
+
+  /**
+   * Construct from a Mat4, dropping the bottom row.  The bottom row is
+   * never read, a projective matrix loses its projection; check with
+   * isAffine() first if the input is not known to be affine.
+   *
+   * @param mat an affine matrix
+   */
+  explicit Affine3(Mat4<T> const & mat) noexcept;
+
+  /**
+   * Element access
+   *
+   * @param r row index, less than 3
+   * @param c column index, less than 4, 3 being the translation
+   * @return a reference to the value at row r and column c
+   */
+  constexpr auto operator()(std::size_t r, std::size_t c) -> T & { return matrix.data[r + 3 * c]; }
+
+  /**
+   * Element access
+   *
+   * @param r row index, less than 3
+   * @param c column index, less than 4, 3 being the translation
+   * @return a reference to the value at row r and column c
+   */
+  constexpr auto operator()(std::size_t r, std::size_t c) const -> T const & { return matrix.data[r + 3 * c]; }
+
+  /**
+   * Return a pointer to the first of the twelve elements
+   */
+  constexpr auto begin() noexcept -> T * { return matrix.begin(); }
+
+  /**
+   * Return a pointer to the first of the twelve elements
+   */
+  constexpr auto begin() const noexcept -> T const * { return matrix.begin(); }
+
+  /**
+   * Return a pointer one past the last element
+   */
+  constexpr auto end() noexcept -> T * { return matrix.end(); }
+
+  /**
+   * Return a pointer one past the last element
+   */
+  constexpr auto end() const noexcept -> T const * { return matrix.end(); }
+
+public:
+  /// The upper three rows of the transform
+  Matrix<T, 3, 4> matrix;
+};
+
+using Affine3f = Affine3<float>;
+using Affine3d = Affine3<double>;
+
+namespace detail {
+
+/**
+ * Expand a column major 3x4 affine transform into a column major 4x4.
+ * Scalar fallback for types without a SIMD kernel.
+ */
+template<typename T>
+inline auto expandAffine(T const * aff, T * mat) -> void {
+  for (std::size_t c = 0; c < 4; ++c) {
+    mat[4 * c] = aff[3 * c];
+    mat[4 * c + 1] = aff[3 * c + 1];
+    mat[4 * c + 2] = aff[3 * c + 2];
+    mat[4 * c + 3] = T{0};
+  }
+  mat[15] = T{1};
+}
+
+/**
+ * Drop the bottom row of a column major 4x4 matrix.  Scalar fallback for
+ * types without a SIMD kernel.
+ */
+template<typename T>
+inline auto compactAffine(T const * mat, T * aff) -> void {
+  for (std::size_t c = 0; c < 4; ++c) {
+    aff[3 * c] = mat[4 * c];
+    aff[3 * c + 1] = mat[4 * c + 1];
+    aff[3 * c + 2] = mat[4 * c + 2];
+  }
+}
+
+/**
+ * Compose two 3x4 affine transforms, out = lhs * rhs.  Scalar fallback for
+ * types without a SIMD kernel.
+ */
+template<typename T>
+inline auto mulAffine(T const * lhs, T const * rhs, T * out) -> void {
+  for (std::size_t c = 0; c < 4; ++c) {
+    for (std::size_t r = 0; r < 3; ++r) {
+      out[r + 3 * c] = lhs[r] * rhs[3 * c] + lhs[r + 3] * rhs[3 * c + 1] + lhs[r + 6] * rhs[3 * c + 2] +
+                       (c == 3 ? lhs[r + 9] : T{0});
+    }
+  }
+}
+
+/**
+ * Transform a single xyz triple, w is 1 for points and 0 for vectors.
+ * Scalar fallback for types without a SIMD kernel.
+ */
+template<typename T>
+inline auto transformAffine(T const * aff, T const * in, T * out, T const w) -> void {
+  T const x = in[0];
+  T const y = in[1];
+  T const z = in[2];
+  for (std::size_t r = 0; r < 3; ++r) {
+    out[r] = aff[r] * x + aff[r + 3] * y + aff[r + 6] * z + aff[r + 9] * w;
+  }
+}
+
+#if defined(CAGEY_SIMD_SSE2)
+
+/**
+ * Load the four columns of a 3x4 transform, the w lanes are unspecified.
+ * Only the twelve elements are touched.
+ */
+inline auto loadAffine(float const * aff, __m128 & c0, __m128 & c1, __m128 & c2, __m128 & c3) -> void {
+  c0 = _mm_loadu_ps(aff);
+  c1 = _mm_loadu_ps(aff + 3);
+  c2 = _mm_loadu_ps(aff + 6);
+  __m128 const last = _mm_loadu_ps(aff + 8);
+  c3 = _mm_shuffle_ps(last, last, _MM_SHUFFLE(3, 3, 2, 1));
+}
+
+/**
+ * Store the xyz lanes of four columns as a 3x4 transform.  The columns are
+ * written front to back with overlapping stores so nothing past the twelfth
+ * element is touched.
+ */
+inline auto storeAffine(float * aff, __m128 const c0, __m128 const c1, __m128 const c2, __m128 const c3) -> void {
+  _mm_storeu_ps(aff, c0);
+  _mm_storeu_ps(aff + 3, c1);
+  _mm_storeu_ps(aff + 6, c2);
+  __m128 const t = _mm_shuffle_ps(c2, c3, _MM_SHUFFLE(0, 0, 2, 2));               // z2 z2 x3 x3
+  _mm_storeu_ps(aff + 8, _mm_shuffle_ps(t, c3, _MM_SHUFFLE(2, 1, 2, 0)));         // z2 x3 y3 z3
+}
+
+/**
+ * SSE kernel
+ */
+inline auto expandAffine(float const * aff, float * mat) -> void {
+  __m128 const xyz = _mm_castsi128_ps(_mm_set_epi32(0, -1, -1, -1));
+  __m128 c0, c1, c2, c3;
+  loadAffine(aff, c0, c1, c2, c3);
+  _mm_storeu_ps(mat, _mm_and_ps(c0, xyz));
+  _mm_storeu_ps(mat + 4, _mm_and_ps(c1, xyz));
+  _mm_storeu_ps(mat + 8, _mm_and_ps(c2, xyz));
+  _mm_storeu_ps(mat + 12, _mm_or_ps(_mm_and_ps(c3, xyz), _mm_set_ps(1.0f, 0.0f, 0.0f, 0.0f)));
+}
+
+/**
+ * SSE kernel
+ */
+inline auto compactAffine(float const * mat, float * aff) -> void {
+  storeAffine(aff, _mm_loadu_ps(mat), _mm_loadu_ps(mat + 4), _mm_loadu_ps(mat + 8), _mm_loadu_ps(mat + 12));
+}
+
+/**
+ * SSE kernel.  Each column of the result is a combination of the columns of
+ * lhs, the translation column also picks up the translation of lhs.
+ */
+inline auto mulAffine(float const * lhs, float const * rhs, float * out) -> void {
+  __m128 a0, a1, a2, a3;
+  loadAffine(lhs, a0, a1, a2, a3);
+  __m128 r[4];
+  for (std::size_t c = 0; c < 4; ++c) {
+    float const * col = rhs + 3 * c;
+    r[c] = _mm_add_ps(_mm_add_ps(_mm_mul_ps(a0, _mm_set1_ps(col[0])), _mm_mul_ps(a1, _mm_set1_ps(col[1]))),
+                      _mm_mul_ps(a2, _mm_set1_ps(col[2])));
+  }
+  storeAffine(out, r[0], r[1], r[2], _mm_add_ps(r[3], a3));
+}
+
+/**
+ * SSE kernel
+ */
+inline auto transformAffine(float const * aff, float const * in, float * out, float const w) -> void {
+  __m128 c0, c1, c2, c3;
+  loadAffine(aff, c0, c1, c2, c3);
+  __m128 r = _mm_add_ps(_mm_mul_ps(c0, _mm_set1_ps(in[0])), _mm_mul_ps(c1, _mm_set1_ps(in[1])));
+  r = _mm_add_ps(r, _mm_add_ps(_mm_mul_ps(c2, _mm_set1_ps(in[2])), _mm_mul_ps(c3, _mm_set1_ps(w))));
+  float tmp[4];
+  _mm_storeu_ps(tmp, r);
+  out[0] = tmp[0];
+  out[1] = tmp[1];
+  out[2] = tmp[2];
+}
+
+#endif // CAGEY_SIMD_SSE2
+
+} // namespace detail
+
+template<typename T>
+Affine3<T>::Affine3(Mat4<T> const & mat) noexcept : matrix{T{0}} {
+  detail::compactAffine(mat.begin(), matrix.begin());
+}
+
+/**
+ * Return the given transform as a Mat4
+ */
+template<typename T>
+auto toMat4(Affine3<T> const & aff) -> Mat4<T> {
+  Mat4<T> ret;
+  detail::expandAffine(aff.begin(), ret.begin());
+  return ret;
+}
+
+/**
+ * Compose two transforms, the result applies rhs then lhs
+ */
+template<typename T>
+auto operator*(Affine3<T> const & lhs, Affine3<T> const & rhs) -> Affine3<T> {
+  Affine3<T> ret;
+  detail::mulAffine(lhs.begin(), rhs.begin(), ret.begin());
+  return ret;
+}
+
+/**
+ * Transform a point
+ */
+template<typename T>
+auto operator*(Affine3<T> const & lhs, Point3<T> const & rhs) -> Point3<T> {
+  Point3<T> ret;
+  detail::transformAffine(lhs.begin(), rhs.begin(), ret.begin(), T{1});
+  return ret;
+}
+
+/**
+ * Transform a direction vector, the translation is ignored
+ */
+template<typename T>
+auto operator*(Affine3<T> const & lhs, Vec3<T> const & rhs) -> Vec3<T> {
+  Vec3<T> ret;
+  detail::transformAffine(lhs.begin(), rhs.begin(), ret.begin(), T{0});
+  return ret;
+}
+
+template<typename T>
+auto operator==(Affine3<T> const & lhs, Affine3<T> const & rhs) -> bool {
+  return lhs.matrix == rhs.matrix;
+}
+
+template<typename T>
+auto operator!=(Affine3<T> const & lhs, Affine3<T> const & rhs) -> bool {
+  return !(lhs == rhs);
+}
+
+/**
+ * Transform an array of points
+ *
+ * @param aff the transform to apply
+ * @param in pointer to the first of count points
+ * @param out pointer to storage for count points, may be the same as in
+ * @param count the number of points to transform
+ */
+template<typename T>
+auto transformPoints(Affine3<T> const & aff, Point3<T> const * in, Point3<T> * out, std::size_t count) -> void {
+  transformPoints(toMat4(aff), in, out, count);
+}
+
+/**
+ * Transform an array of direction vectors, the translation is ignored
+ *
+ * @param aff the transform to apply
+ * @param in pointer to the first of count vectors
+ * @param out pointer to storage for count vectors, may be the same as in
+ * @param count the number of vectors to transform
+ */
+template<typename T>
+auto transformVectors(Affine3<T> const & aff, Vec3<T> const * in, Vec3<T> * out, std::size_t count) -> void {
+  transformVectors(toMat4(aff), in, out, count);
+}
+
+/**
+ * Calculate the inverse of the given transform without throwing
+ *
+ * @param aff the transform to invert
+ * @param out set to the inverse of aff, left unchanged if there is none
+ * @return false if the basis of aff is singular
+ */
+template<typename T>
+auto tryInverse(Affine3<T> const & aff, Affine3<T> & out) noexcept -> bool {
+  Mat4<T> inv;
+  if (!tryInverseAffine(toMat4(aff), inv)) {
+    return false;
+  }
+  detail::compactAffine(inv.begin(), out.begin());
+  return true;
+}
+
+/**
+ * Return the inverse of the given transform
+ *
+ * @throws SingularMatrixException if the basis is not invertible
+ */
+template<typename T>
+auto inverse(Affine3<T> const & aff) -> Affine3<T> {
+  Affine3<T> ret;
+  if (!tryInverse(aff, ret)) {
+    BOOST_THROW_EXCEPTION(core::SingularMatrixException() << core::ThrowMsg("Transform is not invertible"));
+  }
+  return ret;
+}
+
+/**
+ * Return the inverse of a rotation and translation only transform.  Debug
+ * builds assert that the transform is rigid.
+ */
+template<typename T>
+auto inverseRigid(Affine3<T> const & aff) -> Affine3<T> {
+  return Affine3<T>{inverseRigid(toMat4(aff))};
+}
+
+/**
+ * Output the given transform to the given output stream
+ */
+template<typename T>
+auto operator<<(std::ostream & os, Affine3<T> const & aff) -> std::ostream & {
+  return os << toMat4(aff);
+}
+
+} // namespace math
+} // namespace cagey
+
+#endif /* CAGEY_MATH_AFFINE3_HH_ */
@@ -0,0 +1,253 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// cagey-engine - Toy 3D Engine
+// Copyright (c) 2014 Kyle Girard <theycallmecoach@gmail.com>
+//
+// The MIT License (MIT)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+
+/**
+ * @file
+ * Over-aligned Vec4f and Mat4f variants and an allocator that keeps their
+ * alignment inside std::vector.
+ */
+
+#ifndef CAGEY_MATH_ALIGNED_HH_
+#define CAGEY_MATH_ALIGNED_HH_
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <limits>
+#include <new>
+#include <vector>
+
+#include "cagey/math/Matrix.hh"
+#include "cagey/math/Vector.hh"
+#include "cagey/math/BatchTransform.hh"
+#include "cagey/math/Simd.hh"
+
+namespace cagey {
+namespace math {
+
+namespace detail {
+
+/**
+ * Allocate size bytes aligned to alignment, a power of two.  The pointer
+ * returned by malloc is stashed just in front of the aligned block.
+ *
+ * @throws std::bad_alloc if the allocation fails
+ */
+inline auto alignedAllocate(std::size_t const size, std::size_t const alignment) -> void * {
+  std::size_t const extra = alignment - 1 + sizeof(void *);
+  if (size > std::numeric_limits<std::size_t>::max() - extra) {
+    throw std::bad_alloc();
+  }
+  void * const raw = std::malloc(size + extra);
+  if (raw == nullptr) {
+    throw std::bad_alloc();
+  }
+  auto const addr = (reinterpret_cast<std::uintptr_t>(raw) + extra) & ~static_cast<std::uintptr_t>(alignment - 1);
+  void ** const ret = reinterpret_cast<void **>(addr);
+  ret[-1] = raw;
+  return ret;
+}
+
+/**
+ * Free memory returned by alignedAllocate
+ */
+inline auto alignedDeallocate(void * const ptr) noexcept -> void {
+  if (ptr != nullptr) {
+    std::free(static_cast<void **>(ptr)[-1]);
+  }
+}
+
+} // namespace detail
+
+/**
+ * Allocator handing out storage aligned to A bytes.  Before C++17 neither
+ * std::allocator nor new respect alignas beyond alignof(std::max_align_t),
+ * so std::vector<Mat4fA> needs this to keep its elements aligned.
+ *
+ * @tparam T the element type
+ * @tparam A the alignment in bytes, a power of two
+ */
+template<typename T, std::size_t A = alignof(T)>
+class AlignedAllocator {
+  /** @cond doxygen has an issue with static assert */
+  static_assert(A != 0 && (A & (A - 1)) == 0, "Alignment must be a power of two");
+  /** @endcond */
+public:
+  using value_type = T;
+
+  /// Rebinding must keep the alignment which std::allocator_traits cannot deduce
+  template<typename U>
+  struct rebind {
+    using other = AlignedAllocator<U, A>;
+  };
+
+  AlignedAllocator() noexcept = default;
+
+  template<typename U>
+  AlignedAllocator(AlignedAllocator<U, A> const &) noexcept {}
+
+  /**
+   * Allocate storage for n elements
+   */
+  auto allocate(std::size_t const n) -> T * {
+    if (n > std::numeric_limits<std::size_t>::max() / sizeof(T)) {
+      throw std::bad_alloc();
+    }
+    std::size_t const alignment = A < alignof(T) ? alignof(T) : A;
+    return static_cast<T *>(detail::alignedAllocate(n * sizeof(T), alignment));
+  }
+
+  /**
+   * Release storage returned by allocate
+   */
+  auto deallocate(T * const ptr, std::size_t) noexcept -> void {
+    detail::alignedDeallocate(ptr);
+  }
+};
+
+template<typename T, typename U, std::size_t A>
+auto operator==(AlignedAllocator<T, A> const &, AlignedAllocator<U, A> const &) noexcept -> bool { return true; }
+
+template<typename T, typename U, std::size_t A>
+auto operator!=(AlignedAllocator<T, A> const &, AlignedAllocator<U, A> const &) noexcept -> bool { return false; }
+
+/**
+ * A std::vector whose elements keep their alignment
+ */
+template<typename T>
+using AlignedVector = std::vector<T, AlignedAllocator<T>>;
+
+/**
+ * Vec4f aligned to 16 bytes so it can be loaded with a single aligned SSE
+ * load.  Converts freely to and from Vec4f and works with every Vector
+ * function.
+ */
+class alignas(16) Vec4fA : public Vec4f {
+public:
+  using Vec4f::Vec4f;
+
+  constexpr Vec4fA() noexcept = default;
+
+  /**
+   * Construct from an unaligned Vec4f
+   */
+  constexpr Vec4fA(Vec4f const & other) noexcept : Vec4f(other) {}
+};
+
+/**
+ * Mat4f aligned to 64 bytes, so it never straddles a cache line and each
+ * column can be loaded with an aligned SSE load.  Converts freely to and
+ * from Mat4f and works with every Matrix function.  Use AlignedVector (or
+ * AlignedAllocator) to keep the alignment inside containers.
+ */
+class alignas(64) Mat4fA : public Mat4f {
+public:
+  using Mat4f::Mat4f;
+
+  /**
+   * Default constructor.  Initializes to the identity matrix
+   */
+  constexpr Mat4fA() : Mat4f() {}
+
+  /**
+   * Construct from an unaligned Mat4f
+   */
+  constexpr Mat4fA(Mat4f const & other) : Mat4f(other) {}
+
+  static auto operator new(std::size_t const size) -> void * { return detail::alignedAllocate(size, alignof(Mat4fA)); }
+  static auto operator new[](std::size_t const size) -> void * { return detail::alignedAllocate(size, alignof(Mat4fA)); }
+  static auto operator new(std::size_t, void * const ptr) noexcept -> void * { return ptr; }
+  static auto operator delete(void * const ptr) noexcept -> void { detail::alignedDeallocate(ptr); }
+  static auto operator delete[](void * const ptr) noexcept -> void { detail::alignedDeallocate(ptr); }
+};
+
+namespace detail {
+
+inline auto mul4x4Aligned(float const * lhs, float const * rhs, float * out) -> void {
+#if defined(CAGEY_SIMD_SSE2)
+  mul4x4Ps<true>(lhs, rhs, out);
+#else
+  mul4x4(lhs, rhs, out);
+#endif
+}
+
+inline auto mul4x1Aligned(float const * mat, float const * vec, float * out) -> void {
+#if defined(CAGEY_SIMD_SSE2)
+  mul4x1Ps<true>(mat, vec, out);
+#else
+  mul4x1(mat, vec, out);
+#endif
+}
+
+inline auto transform4Aligned(float const * mat, float const * in, float * out, std::size_t const count) -> void {
+#if defined(CAGEY_SIMD_SSE2)
+  transform4Ps<true>(mat, in, out, count);
+#else
+  transform4(mat, in, out, count);
+#endif
+}
+
+} // namespace detail
+
+/**
+ * Multiply two aligned matrices using aligned loads and stores
+ */
+inline auto operator*(Mat4fA const & lhs, Mat4fA const & rhs) -> Mat4fA {
+  Mat4fA ret;
+  detail::mul4x4Aligned(lhs.begin(), rhs.begin(), ret.begin());
+  return ret;
+}
+
+/**
+ * Multiply an aligned matrix and vector using aligned loads and stores
+ */
+inline auto operator*(Mat4fA const & lhs, Vec4fA const & rhs) -> Vec4fA {
+  Vec4fA ret;
+  detail::mul4x1Aligned(lhs.begin(), rhs.begin(), ret.begin());
+  return ret;
+}
+
+/**
+ * Transform an array of aligned four element vectors by the given matrix
+ *
+ * @param mat the transform to apply
+ * @param in pointer to the first of count vectors
+ * @param out pointer to storage for count vectors, may be the same as in
+ * @param count the number of vectors to transform
+ */
+inline auto transformVectors(Mat4fA const & mat, Vec4fA const * in, Vec4fA * out, std::size_t const count) -> void {
+  /** @cond doxygen has an issue with static assert */
+  static_assert(sizeof(Vec4fA) == 4 * sizeof(float), "Vec4fA must be tightly packed");
+  /** @endcond */
+  detail::transform4Aligned(mat.begin(), reinterpret_cast<float const *>(in), reinterpret_cast<float *>(out), count);
+}
+
+} // namespace math
+} // namespace cagey
+
+#endif /* CAGEY_MATH_ALIGNED_HH_ */
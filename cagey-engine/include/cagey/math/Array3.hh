@@ -0,0 +1,412 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// cagey-engine - Toy 3D Engine
+// Copyright (c) 2014 Kyle Girard <theycallmecoach@gmail.com>
+//
+// The MIT License (MIT)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * @file
+ * Structure of arrays storage for three element Vectors and Points.
+ */
+
+#ifndef CAGEY_MATH_ARRAY3_HH_
+#define CAGEY_MATH_ARRAY3_HH_
+
+#include <cstddef>
+#include <vector>
+
+#include "cagey/math/Vector.hh"
+#include "cagey/math/Point.hh"
+#include "cagey/math/Simd.hh"
+#include "cagey/core/Exception.hh"
+
+namespace cagey {
+namespace math {
+
+/**
+ * Stores three element Vectors or Points as three separate streams of x, y
+ * and z values so bulk operations can process a full register of elements
+ * at a time.
+ *
+ * @tparam D the element class, Vector or Point
+ * @tparam T the underlying type
+ */
+template<template<typename, std::size_t> class D, typename T>
+class Array3 {
+public:
+  /// The underlying type of this Array3
+  using Type = T;
+
+  /// The type of a single element
+  using Element = D<T, 3>;
+
+  /**
+   * Proxy to a single element of an Array3.  Converts to and from Element.
+   */
+  class Reference {
+  public:
+    /**
+     * Construct a Reference to the given components
+     */
+    Reference(T & x, T & y, T & z) noexcept : x(x), y(y), z(z) {}
+
+    /**
+     * Copy Constructor. The new Reference refers to the same element
+     */
+    Reference(Reference const & other) = default;
+
+    /**
+     * Return a copy of the referenced element
+     */
+    operator Element() const { return Element{x, y, z}; }
+
+    /**
+     * Assign the given value to the referenced element
+     */
+    auto operator=(Element const & val) -> Reference & {
+      x = val.x;
+      y = val.y;
+      z = val.z;
+      return *this;
+    }
+
+    /**
+     * Assign the value referenced by other to the referenced element
+     */
+    auto operator=(Reference const & other) -> Reference & {
+      return *this = Element(other);
+    }
+
+    T & x; ///< The first element
+    T & y; ///< The second element
+    T & z; ///< The third element
+  };
+
+  /**
+   * Construct an empty Array3
+   */
+  Array3() = default;
+
+  /**
+   * Construct an Array3 holding count zero elements
+   *
+   * @param count the number of elements
+   */
+  explicit Array3(std::size_t const count) : mX(count), mY(count), mZ(count) {}
+
+  /**
+   * Construct an Array3 holding a copy of the given elements
+   *
+   * @param vals the elements to copy
+   */
+  explicit Array3(std::vector<Element> const & vals) : Array3(vals.size()) {
+    for (std::size_t i = 0; i < vals.size(); ++i) {
+      (*this)[i] = vals[i];
+    }
+  }
+
+  /**
+   * Return the elements of this Array3 as an array of structs
+   */
+  auto toVector() const -> std::vector<Element> {
+    std::vector<Element> ret;
+    ret.reserve(size());
+    for (std::size_t i = 0; i < size(); ++i) {
+      ret.emplace_back(mX[i], mY[i], mZ[i]);
+    }
+    return ret;
+  }
+
+  /**
+   * Return the number of elements
+   */
+  auto size() const noexcept -> std::size_t { return mX.size(); }
+
+  /**
+   * Return true if this Array3 has no elements
+   */
+  auto empty() const noexcept -> bool { return mX.empty(); }
+
+  /**
+   * Change the number of elements, new elements are zero
+   */
+  auto resize(std::size_t const count) -> void {
+    mX.resize(count);
+    mY.resize(count);
+    mZ.resize(count);
+  }
+
+  /**
+   * Reserve storage for count elements
+   */
+  auto reserve(std::size_t const count) -> void {
+    mX.reserve(count);
+    mY.reserve(count);
+    mZ.reserve(count);
+  }
+
+  /**
+   * Remove all elements
+   */
+  auto clear() noexcept -> void {
+    mX.clear();
+    mY.clear();
+    mZ.clear();
+  }
+
+  /**
+   * Append the given element
+   */
+  auto pushBack(Element const & val) -> void {
+    mX.push_back(val.x);
+    mY.push_back(val.y);
+    mZ.push_back(val.z);
+  }
+
+  /**
+   * Index operator
+   *
+   * @param i index into this Array3
+   * @return a proxy referring to the element at index i
+   */
+  auto operator[](std::size_t const i) -> Reference { return Reference{mX[i], mY[i], mZ[i]}; }
+
+  /**
+   * Index operator
+   *
+   * @param i index into this Array3
+   * @return a copy of the element at index i
+   */
+  auto operator[](std::size_t const i) const -> Element { return Element{mX[i], mY[i], mZ[i]}; }
+
+  /// Return the stream of x values
+  auto getX() noexcept -> T * { return mX.data(); }
+  /// Return the stream of x values
+  auto getX() const noexcept -> T const * { return mX.data(); }
+  /// Return the stream of y values
+  auto getY() noexcept -> T * { return mY.data(); }
+  /// Return the stream of y values
+  auto getY() const noexcept -> T const * { return mY.data(); }
+  /// Return the stream of z values
+  auto getZ() noexcept -> T * { return mZ.data(); }
+  /// Return the stream of z values
+  auto getZ() const noexcept -> T const * { return mZ.data(); }
+
+private:
+  /// x values
+  std::vector<T> mX;
+  /// y values
+  std::vector<T> mY;
+  /// z values
+  std::vector<T> mZ;
+};
+
+template<typename T> using Vec3Array = Array3<Vector, T>;
+template<typename T> using Point3Array = Array3<Point, T>;
+
+using Vec3fArray = Vec3Array<float>;
+using Vec3dArray = Vec3Array<double>;
+using Point3fArray = Point3Array<float>;
+using Point3dArray = Point3Array<double>;
+
+namespace detail {
+
+/**
+ * Throw an InvalidArgumentException if the given sizes differ
+ */
+inline auto checkSameSize(std::size_t const lhs, std::size_t const rhs) -> void {
+  if (lhs != rhs) {
+    BOOST_THROW_EXCEPTION(core::InvalidArgumentException() << core::ThrowMsg("Array sizes do not match"));
+  }
+}
+
+} // namespace detail
+
+/**
+ * Calculate the dot product of each pair of Vectors.
+ *
+ * @param lhs an array of Vectors
+ * @param rhs an array of Vectors the same size as lhs
+ * @param out storage for lhs.size() results
+ */
+template<typename T>
+auto dot(Vec3Array<T> const & lhs, Vec3Array<T> const & rhs, T * out) -> void {
+  detail::checkSameSize(lhs.size(), rhs.size());
+  T const * ax = lhs.getX();
+  T const * ay = lhs.getY();
+  T const * az = lhs.getZ();
+  T const * bx = rhs.getX();
+  T const * by = rhs.getY();
+  T const * bz = rhs.getZ();
+  detail::forEachPack<T>(lhs.size(), [&](auto p, std::size_t const i) {
+    using P = decltype(p);
+    auto d = P::load(ax + i) * P::load(bx + i) + P::load(ay + i) * P::load(by + i) + P::load(az + i) * P::load(bz + i);
+    d.store(out + i);
+  });
+}
+
+/**
+ * Calculate the cross product of each pair of Vectors.
+ *
+ * @param lhs an array of Vectors
+ * @param rhs an array of Vectors the same size as lhs
+ * @param out resized to hold the results, may be lhs or rhs
+ */
+template<typename T>
+auto cross(Vec3Array<T> const & lhs, Vec3Array<T> const & rhs, Vec3Array<T> & out) -> void {
+  detail::checkSameSize(lhs.size(), rhs.size());
+  out.resize(lhs.size());
+  T const * ax = lhs.getX();
+  T const * ay = lhs.getY();
+  T const * az = lhs.getZ();
+  T const * bx = rhs.getX();
+  T const * by = rhs.getY();
+  T const * bz = rhs.getZ();
+  T * ox = out.getX();
+  T * oy = out.getY();
+  T * oz = out.getZ();
+  detail::forEachPack<T>(lhs.size(), [&](auto p, std::size_t const i) {
+    using P = decltype(p);
+    auto const x0 = P::load(ax + i);
+    auto const y0 = P::load(ay + i);
+    auto const z0 = P::load(az + i);
+    auto const x1 = P::load(bx + i);
+    auto const y1 = P::load(by + i);
+    auto const z1 = P::load(bz + i);
+    (y0 * z1 - z0 * y1).store(ox + i);
+    (z0 * x1 - x0 * z1).store(oy + i);
+    (x0 * y1 - y0 * x1).store(oz + i);
+  });
+}
+
+/**
+ * Calculate the squared length of each Vector.
+ *
+ * @param vecs an array of Vectors
+ * @param out storage for vecs.size() results
+ */
+template<typename T>
+auto lengthSquared(Vec3Array<T> const & vecs, T * out) -> void {
+  dot(vecs, vecs, out);
+}
+
+/**
+ * Calculate the length of each Vector.
+ *
+ * @param vecs an array of Vectors
+ * @param out storage for vecs.size() results
+ */
+template<typename T>
+auto length(Vec3Array<T> const & vecs, T * out) -> void {
+  T const * x = vecs.getX();
+  T const * y = vecs.getY();
+  T const * z = vecs.getZ();
+  detail::forEachPack<T>(vecs.size(), [&](auto p, std::size_t const i) {
+    using P = decltype(p);
+    auto const vx = P::load(x + i);
+    auto const vy = P::load(y + i);
+    auto const vz = P::load(z + i);
+    sqrt(vx * vx + vy * vy + vz * vz).store(out + i);
+  });
+}
+
+/**
+ * Normalize each Vector in place.  Zero length Vectors are left unmodified.
+ *
+ * @param vecs an array of Vectors
+ */
+template<typename T>
+auto normalize(Vec3Array<T> & vecs) -> void {
+  T * x = vecs.getX();
+  T * y = vecs.getY();
+  T * z = vecs.getZ();
+  detail::forEachPack<T>(vecs.size(), [&](auto p, std::size_t const i) {
+    using P = decltype(p);
+    auto const vx = P::load(x + i);
+    auto const vy = P::load(y + i);
+    auto const vz = P::load(z + i);
+    auto const len = sqrt(vx * vx + vy * vy + vz * vz);
+    auto const nonZero = len > P::broadcast(T{0});
+    auto const inv = P::broadcast(T{1}) / select(nonZero, len, P::broadcast(T{1}));
+    select(nonZero, vx * inv, vx).store(x + i);
+    select(nonZero, vy * inv, vy).store(y + i);
+    select(nonZero, vz * inv, vz).store(z + i);
+  });
+}
+
+/**
+ * Calculate the squared distance between each pair of elements.
+ *
+ * @param lhs an array of Vectors or Points
+ * @param rhs an array of Vectors or Points the same size as lhs
+ * @param out storage for lhs.size() results
+ */
+template<template<typename, std::size_t> class D, typename T>
+auto distanceSquared(Array3<D, T> const & lhs, Array3<D, T> const & rhs, T * out) -> void {
+  detail::checkSameSize(lhs.size(), rhs.size());
+  T const * ax = lhs.getX();
+  T const * ay = lhs.getY();
+  T const * az = lhs.getZ();
+  T const * bx = rhs.getX();
+  T const * by = rhs.getY();
+  T const * bz = rhs.getZ();
+  detail::forEachPack<T>(lhs.size(), [&](auto p, std::size_t const i) {
+    using P = decltype(p);
+    auto const dx = P::load(ax + i) - P::load(bx + i);
+    auto const dy = P::load(ay + i) - P::load(by + i);
+    auto const dz = P::load(az + i) - P::load(bz + i);
+    (dx * dx + dy * dy + dz * dz).store(out + i);
+  });
+}
+
+/**
+ * Add a scaled copy of each Vector in rhs to the matching element of lhs,
+ * lhs[i] += rhs[i] * scale.
+ *
+ * @param lhs an array of Vectors or Points to modify
+ * @param rhs an array of Vectors the same size as lhs
+ * @param scale the amount to scale rhs by
+ */
+template<template<typename, std::size_t> class D, typename T>
+auto addScaled(Array3<D, T> & lhs, Vec3Array<T> const & rhs, T const scale) -> void {
+  detail::checkSameSize(lhs.size(), rhs.size());
+  T * ax = lhs.getX();
+  T * ay = lhs.getY();
+  T * az = lhs.getZ();
+  T const * bx = rhs.getX();
+  T const * by = rhs.getY();
+  T const * bz = rhs.getZ();
+  detail::forEachPack<T>(lhs.size(), [&](auto p, std::size_t const i) {
+    using P = decltype(p);
+    auto const s = P::broadcast(scale);
+    (P::load(ax + i) + P::load(bx + i) * s).store(ax + i);
+    (P::load(ay + i) + P::load(by + i) * s).store(ay + i);
+    (P::load(az + i) + P::load(bz + i) * s).store(az + i);
+  });
+}
+
+} // namespace math
+} // namespace cagey
+
+#endif /* CAGEY_MATH_ARRAY3_HH_ */
@@ -312,7 +312,7 @@ public:
 
 
 private:
-  Type value;
+  Type value{};
 };
 
 } // namespace math
@@ -35,6 +35,8 @@
 #include <numeric> //for std::numeric_limits
 #include <iostream>
 
+#include <cagey/math/NumberTraits.hh>
+
 
 
 namespace cagey {
@@ -44,7 +46,7 @@ template<template<typename,std::size_t> class D, typename T, std::size_t N> clas
 public:
   /** @cond doxygen has some issues with static assert */
   static_assert(N != 0, "Point cannot have zero elements");
-  static_assert(std::is_arithmetic<T>::value, "Underlying type must be a number");
+  static_assert(IsNumber<T>::value, "Underlying type must be a number");
   /** @endcond */
 
   /// The underlying type of this Point
@@ -98,7 +100,7 @@ public:
   * @param i index into this Point
   * @return a reference to the element at index i
   */
-  constexpr auto operator[](std::size_t i) const -> T&;
+  constexpr auto operator[](std::size_t i) const -> T const &;
 
   /**
   * Return an iterator to the first element of this Point
@@ -112,7 +114,7 @@ public:
   *
   * @return an iterator pointing to the begining of this Point
   */
-  constexpr auto begin() const noexcept -> T*;
+  constexpr auto begin() const noexcept -> T const *;
 
   /**
   * Return an iterator to the end of this Point.
@@ -126,7 +128,7 @@ public:
   *
   * @return an iterator pointing to the end of this Point
   */
-  constexpr auto end() const noexcept -> T*;
+  constexpr auto end() const noexcept -> T const *;
 
   private:
   template<class U, std::size_t... I>
@@ -146,7 +148,7 @@ template<template<typename, std::size_t> class D,typename T>
 class BasePoint<D,T,2>
 {
   /** @cond doxygen has issues with static_assert */
-  static_assert(std::is_arithmetic<T>::value, "Underlying type must be a number");
+  static_assert(IsNumber<T>::value, "Underlying type must be a number");
   /** @endcond */
 public:
   /// The underlying type of this Point
@@ -205,7 +207,7 @@ public:
   * @param i index into this Point
   * @return a reference to the element at index i
   */
-  constexpr auto operator[](std::size_t i) const -> T&;
+  constexpr auto operator[](std::size_t i) const -> T const &;
 
   /**
   * Return an iterator to the first element of this Point
@@ -219,7 +221,7 @@ public:
   *
   * @return an iterator pointing to the begining of this Point
   */
-  constexpr auto begin() const noexcept -> T*;
+  constexpr auto begin() const noexcept -> T const *;
 
   /**
   * Return an iterator to the end of this Point.
@@ -233,7 +235,7 @@ public:
   *
   * @return an iterator pointing to the end of this Point
   */
-  constexpr auto end() const noexcept -> T*;
+  constexpr auto end() const noexcept -> T const *;
 public:
   /**
   * Anonymous union to allow access to members using different names
@@ -261,7 +263,7 @@ template<template<typename, std::size_t> class D,typename T>
 class BasePoint<D,T,3>
 {
   /** @cond doxygen has issues with static_assert */
-  static_assert(std::is_arithmetic<T>::value, "Underlying type must be a number");
+  static_assert(IsNumber<T>::value, "Underlying type must be a number");
   /** @endcond */
 public:
   /// The underlying type of this Point
@@ -323,7 +325,7 @@ public:
   * @param i index into this Point
   * @return a reference to the element at index i
   */
-  constexpr auto operator[](std::size_t i) const -> T&;
+  constexpr auto operator[](std::size_t i) const -> T const &;
 
   /**
   * Return an iterator to the first element of this Point
@@ -337,7 +339,7 @@ public:
   *
   * @return an iterator pointing to the begining of this Point
   */
-  constexpr auto begin() const noexcept -> T*;
+  constexpr auto begin() const noexcept -> T const *;
 
   /**
   * Return an iterator to the end of this Point.
@@ -351,7 +353,7 @@ public:
   *
   * @return an iterator pointing to the end of this Point
   */
-  constexpr auto end() const noexcept -> T*;
+  constexpr auto end() const noexcept -> T const *;
 public:
   /**
   * Anonymous union to allow access to members using different names
@@ -382,7 +384,7 @@ template<template<typename, std::size_t> class D,typename T>
 class BasePoint<D,T,4>
 {
   /** @cond doxygen has issues with static_assert */
-  static_assert(std::is_arithmetic<T>::value, "Underlying type must be a number");
+  static_assert(IsNumber<T>::value, "Underlying type must be a number");
   /** @endcond */
 public:
   /// The underlying type of this Point
@@ -445,7 +447,7 @@ public:
   * @param i index into this Point
   * @return a reference to the element at index i
   */
-  constexpr auto operator[](std::size_t i) const -> T&;
+  constexpr auto operator[](std::size_t i) const -> T const &;
 
   /**
   * Return an iterator to the first element of this Point
@@ -459,7 +461,7 @@ public:
   *
   * @return an iterator pointing to the begining of this Point
   */
-  constexpr auto begin() const noexcept -> T*;
+  constexpr auto begin() const noexcept -> T const *;
 
   /**
   * Return an iterator to the end of this Point.
@@ -473,7 +475,7 @@ public:
   *
   * @return an iterator pointing to the end of this Point
   */
-  constexpr auto end() const noexcept -> T*;
+  constexpr auto end() const noexcept -> T const *;
 public:
   /**
   * Anonymous union to allow access to members using different names
@@ -690,22 +692,22 @@ inline constexpr auto BasePoint<D,T,4>::operator[](std::size_t i) -> T& {
 }
 
 template<template<typename,std::size_t> class D,typename T, std::size_t S>
-inline constexpr auto BasePoint<D,T, S>::operator[](std::size_t i) const -> T& {
+inline constexpr auto BasePoint<D,T, S>::operator[](std::size_t i) const -> T const & {
   return data[i];
 }
 
 template<template<typename,std::size_t> class D,typename T>
-inline constexpr auto BasePoint<D,T,2>::operator[](std::size_t i) const -> T& {
+inline constexpr auto BasePoint<D,T,2>::operator[](std::size_t i) const -> T const & {
   return data[i];
 }
 
 template<template<typename,std::size_t> class D,typename T>
-inline constexpr auto BasePoint<D,T,3>::operator[](std::size_t i) const -> T& {
+inline constexpr auto BasePoint<D,T,3>::operator[](std::size_t i) const -> T const & {
   return data[i];
 }
 
 template<template<typename,std::size_t> class D,typename T>
-inline constexpr auto BasePoint<D,T,4>::operator[](std::size_t i) const -> T& {
+inline constexpr auto BasePoint<D,T,4>::operator[](std::size_t i) const -> T const & {
   return data[i];
 }
 
@@ -727,16 +729,16 @@ template<template<typename,std::size_t> class D,typename T>
 inline constexpr auto BasePoint<D,T,4>::begin() noexcept -> T* { return data.begin(); }
 
 template<template<typename,std::size_t> class D,typename T, std::size_t S>
-inline constexpr auto BasePoint<D,T, S>::begin() const  noexcept -> T* { return data.begin(); }
+inline constexpr auto BasePoint<D,T, S>::begin() const noexcept -> T const * { return data.begin(); }
 
 template<template<typename,std::size_t> class D,typename T>
-inline constexpr auto BasePoint<D,T,2>::begin() const  noexcept -> T* { return data.begin(); }
+inline constexpr auto BasePoint<D,T,2>::begin() const noexcept -> T const * { return data.begin(); }
 
 template<template<typename,std::size_t> class D,typename T>
-inline constexpr auto BasePoint<D,T,3>::begin() const  noexcept -> T* { return data.begin(); }
+inline constexpr auto BasePoint<D,T,3>::begin() const noexcept -> T const * { return data.begin(); }
 
 template<template<typename,std::size_t> class D,typename T>
-inline constexpr auto BasePoint<D,T,4>::begin() const  noexcept -> T* { return data.begin(); }
+inline constexpr auto BasePoint<D,T,4>::begin() const noexcept -> T const * { return data.begin(); }
 
 
 //////////////////////////////////////////////////////////////////////////////
@@ -757,16 +759,16 @@ inline constexpr auto BasePoint<D,T,4>::end() noexcept -> T* { return data.end()
 
 
 template<template<typename,std::size_t> class D,typename T, std::size_t S>
-inline constexpr auto BasePoint<D,T, S>::end() const noexcept -> T* { return data.end(); }
+inline constexpr auto BasePoint<D,T, S>::end() const noexcept -> T const * { return data.end(); }
 
 template<template<typename,std::size_t> class D,typename T>
-inline constexpr auto BasePoint<D,T,2>::end() const noexcept -> T* { return data.end(); }
+inline constexpr auto BasePoint<D,T,2>::end() const noexcept -> T const * { return data.end(); }
 
 template<template<typename,std::size_t> class D,typename T>
-inline constexpr auto BasePoint<D,T,3>::end() const noexcept -> T* { return data.end(); }
+inline constexpr auto BasePoint<D,T,3>::end() const noexcept -> T const * { return data.end(); }
 
 template<template<typename,std::size_t> class D,typename T>
-inline constexpr auto BasePoint<D,T,4>::end() const noexcept -> T* { return data.end(); }
+inline constexpr auto BasePoint<D,T,4>::end() const noexcept -> T const * { return data.end(); }
 
 
 //////////////////////////////////////////////////////////////////////////////
@@ -774,7 +776,7 @@ inline constexpr auto BasePoint<D,T,4>::end() const noexcept -> T* { return data
 //////////////////////////////////////////////////////////////////////////////
 
 template<template<typename,std::size_t> class D,typename T, std::size_t S>
-inline auto operator+=(BasePoint<D,T,S> & lhs, BasePoint<D,T,S> & rhs) -> void {
+inline auto operator+=(BasePoint<D,T,S> & lhs, BasePoint<D,T,S> const & rhs) -> void {
   std::transform(lhs.begin(), lhs.end(), rhs.begin(), lhs.begin(), [](T l, T r) -> T { return l + r; } );
 }
 
@@ -783,7 +785,7 @@ inline auto operator+=(BasePoint<D,T,S> & lhs, BasePoint<D,T,S> & rhs) -> void {
 //////////////////////////////////////////////////////////////////////////////
 
 template<template<typename,std::size_t> class D,typename T, std::size_t S>
-inline auto operator-=(BasePoint<D,T,S> & lhs, BasePoint<D,T,S> & rhs) -> void {
+inline auto operator-=(BasePoint<D,T,S> & lhs, BasePoint<D,T,S> const & rhs) -> void {
   std::transform(lhs.begin(), lhs.end(), rhs.begin(), lhs.begin(), [](T l, T r) -> T { return l - r; } );
 }
 
@@ -808,49 +810,54 @@ inline auto operator/=(BasePoint<D,T, S> & lhs, T value) -> void {
 
 
 template<template<typename,std::size_t> class D,typename T, std::size_t S>
-auto operator==(BasePoint<D,T, S> const & rhs, BasePoint<D,T, S> const & lhs) -> BasePoint<D,T, S> {
-  return rhs.data == rhs.data;
+auto operator==(BasePoint<D,T, S> const & lhs, BasePoint<D,T, S> const & rhs) -> bool {
+  return lhs.data == rhs.data;
 }
 
 template<template<typename,std::size_t> class D,typename T, std::size_t S>
-auto operator!=(BasePoint<D,T, S> const & rhs, BasePoint<D,T, S> const & lhs) -> BasePoint<D,T, S> {
-  return !(rhs.data == rhs.data);
+auto operator!=(BasePoint<D,T, S> const & lhs, BasePoint<D,T, S> const & rhs) -> bool {
+  return !(lhs == rhs);
 }
 
 template<template<typename,std::size_t> class D,typename T, std::size_t S>
-auto operator+(BasePoint<D,T, S> rhs, BasePoint<D,T, S> const & lhs) -> BasePoint<D,T, S> {
-  rhs += lhs;
-  return rhs;
+auto operator+(BasePoint<D,T, S> const & lhs, BasePoint<D,T, S> const & rhs) -> D<T, S> {
+  D<T, S> ret{lhs.data};
+  ret += rhs;
+  return ret;
 }
 
 template<template<typename,std::size_t> class D,typename T, std::size_t S>
-auto operator-(BasePoint<D,T, S> vec) -> BasePoint<D,T, S> {
-  std::transform(vec.begin(), vec.end(), vec.begin(), std::negate<T>());
-  return vec;
+auto operator-(BasePoint<D,T, S> const & vec) -> D<T, S> {
+  D<T, S> ret{vec.data};
+  std::transform(ret.begin(), ret.end(), ret.begin(), std::negate<T>());
+  return ret;
 }
 
 template<template<typename,std::size_t> class D,typename T, std::size_t S>
-auto operator-(BasePoint<D,T, S> rhs, BasePoint<D,T, S> const & lhs) -> BasePoint<D,T, S> {
-  rhs -= lhs;
-  return rhs;
+auto operator-(BasePoint<D,T, S> const & lhs, BasePoint<D,T, S> const & rhs) -> D<T, S> {
+  D<T, S> ret{lhs.data};
+  ret -= rhs;
+  return ret;
 }
 
 template<template<typename,std::size_t> class D,typename T, std::size_t S>
-auto operator*(BasePoint<D,T, S> rhs, T lhs) -> BasePoint<D,T, S> {
-  rhs *= lhs;
-  return rhs;
+auto operator*(BasePoint<D,T, S> const & lhs, T rhs) -> D<T, S> {
+  D<T, S> ret{lhs.data};
+  ret *= rhs;
+  return ret;
 }
 
 template<template<typename,std::size_t> class D,typename T, std::size_t S>
-auto operator/(BasePoint<D,T, S> rhs, T lhs) -> BasePoint<D,T, S> {
-  rhs /= lhs;
-  return rhs;
+auto operator/(BasePoint<D,T, S> const & lhs, T rhs) -> D<T, S> {
+  D<T, S> ret{lhs.data};
+  ret /= rhs;
+  return ret;
 }
 
 template <template<typename,std::size_t> class D, typename T, std::size_t S>
 std::ostream &operator<<(std::ostream &sink, BasePoint<D,T,S> const &vec) {
   sink << "( ";
-  std::for_each(vec.begin(), vec.end()-1, [&sink](T&v) { sink << v << ", ";});
+  std::for_each(vec.begin(), vec.end()-1, [&sink](T const & v) { sink << v << ", ";});
   sink << vec[S-1] << " )";
   return sink;
 }
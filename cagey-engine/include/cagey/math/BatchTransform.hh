@@ -0,0 +1,309 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// cagey-engine - Toy 3D Engine
+// Copyright (c) 2014 Kyle Girard <theycallmecoach@gmail.com>
+//
+// The MIT License (MIT)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * @file
+ * Transform contiguous arrays of Points and Vectors by a single Mat4.
+ */
+
+#ifndef CAGEY_MATH_BATCHTRANSFORM_HH_
+#define CAGEY_MATH_BATCHTRANSFORM_HH_
+
+#include <cstddef>
+
+#include "cagey/math/Matrix.hh"
+#include "cagey/math/Point.hh"
+#include "cagey/math/Vector.hh"
+#include "cagey/math/Simd.hh"
+
+namespace cagey {
+namespace math {
+
+namespace detail {
+
+/**
+ * Load one packed xyz triple as scalar Packs
+ */
+template<typename T>
+inline auto loadXyz(T const * in, Pack<T, 1> & x, Pack<T, 1> & y, Pack<T, 1> & z) -> void {
+  x.v = in[0];
+  y.v = in[1];
+  z.v = in[2];
+}
+
+template<typename T>
+inline auto storeXyz(T * out, Pack<T, 1> const x, Pack<T, 1> const y, Pack<T, 1> const z) -> void {
+  out[0] = x.v;
+  out[1] = y.v;
+  out[2] = z.v;
+}
+
+#if defined(CAGEY_SIMD_SSE2)
+
+/**
+ * Four xyz triples of floats, transposed from three registers into x, y
+ * and z registers
+ */
+inline auto loadXyz(float const * in, Pack<float, 4> & x, Pack<float, 4> & y, Pack<float, 4> & z) -> void {
+  // a = x0 y0 z0 x1, b = y1 z1 x2 y2, c = z2 x3 y3 z3
+  __m128 const a = _mm_loadu_ps(in);
+  __m128 const b = _mm_loadu_ps(in + 4);
+  __m128 const c = _mm_loadu_ps(in + 8);
+
+  __m128 const t0 = _mm_shuffle_ps(b, c, _MM_SHUFFLE(2, 1, 3, 2)); // x2 y2 x3 y3
+  __m128 const t1 = _mm_shuffle_ps(a, b, _MM_SHUFFLE(1, 0, 2, 1)); // y0 z0 y1 z1
+  x.v = _mm_shuffle_ps(a, t0, _MM_SHUFFLE(2, 0, 3, 0));
+  y.v = _mm_shuffle_ps(t1, t0, _MM_SHUFFLE(3, 1, 2, 0));
+  z.v = _mm_shuffle_ps(t1, c, _MM_SHUFFLE(3, 0, 3, 1));
+}
+
+inline auto storeXyz(float * out, Pack<float, 4> const x, Pack<float, 4> const y, Pack<float, 4> const z) -> void {
+  __m128 const xy = _mm_unpacklo_ps(x.v, y.v);                          // x0 y0 x1 y1
+  __m128 const zx = _mm_shuffle_ps(z.v, x.v, _MM_SHUFFLE(1, 1, 0, 0));  // z0 z0 x1 x1
+  __m128 const yz = _mm_shuffle_ps(y.v, z.v, _MM_SHUFFLE(2, 1, 2, 1));  // y1 y2 z1 z2
+  __m128 const xyhi = _mm_unpackhi_ps(x.v, y.v);                        // x2 y2 x3 y3
+  __m128 const zx3 = _mm_shuffle_ps(z.v, x.v, _MM_SHUFFLE(3, 3, 2, 2)); // z2 z2 x3 x3
+  __m128 const yz3 = _mm_shuffle_ps(y.v, z.v, _MM_SHUFFLE(3, 3, 3, 3)); // y3 y3 z3 z3
+
+  _mm_storeu_ps(out, _mm_shuffle_ps(xy, zx, _MM_SHUFFLE(2, 0, 1, 0)));
+  _mm_storeu_ps(out + 4, _mm_shuffle_ps(yz, xyhi, _MM_SHUFFLE(1, 0, 2, 0)));
+  _mm_storeu_ps(out + 8, _mm_shuffle_ps(zx3, yz3, _MM_SHUFFLE(2, 0, 2, 0)));
+}
+
+/**
+ * Two xyz triples of doubles: a = x0 y0, b = z0 x1, c = y1 z1
+ */
+inline auto loadXyz(double const * in, Pack<double, 2> & x, Pack<double, 2> & y, Pack<double, 2> & z) -> void {
+  __m128d const a = _mm_loadu_pd(in);
+  __m128d const b = _mm_loadu_pd(in + 2);
+  __m128d const c = _mm_loadu_pd(in + 4);
+  x.v = _mm_shuffle_pd(a, b, 2);
+  y.v = _mm_shuffle_pd(a, c, 1);
+  z.v = _mm_shuffle_pd(b, c, 2);
+}
+
+inline auto storeXyz(double * out, Pack<double, 2> const x, Pack<double, 2> const y, Pack<double, 2> const z) -> void {
+  _mm_storeu_pd(out, _mm_unpacklo_pd(x.v, y.v));
+  _mm_storeu_pd(out + 2, _mm_shuffle_pd(z.v, x.v, 2));
+  _mm_storeu_pd(out + 4, _mm_unpackhi_pd(y.v, z.v));
+}
+
+#endif // CAGEY_SIMD_SSE2
+
+#if defined(CAGEY_SIMD_AVX)
+
+/**
+ * Eight xyz triples of floats.  The low lane of each register holds the
+ * first four triples and the high lane the last four, so the in-lane
+ * shuffles of the SSE version transpose both halves at once.
+ */
+inline auto loadXyz(float const * in, Pack<float, 8> & x, Pack<float, 8> & y, Pack<float, 8> & z) -> void {
+  __m256 const a = _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_loadu_ps(in)), _mm_loadu_ps(in + 12), 1);
+  __m256 const b = _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_loadu_ps(in + 4)), _mm_loadu_ps(in + 16), 1);
+  __m256 const c = _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_loadu_ps(in + 8)), _mm_loadu_ps(in + 20), 1);
+
+  __m256 const t0 = _mm256_shuffle_ps(b, c, _MM_SHUFFLE(2, 1, 3, 2));
+  __m256 const t1 = _mm256_shuffle_ps(a, b, _MM_SHUFFLE(1, 0, 2, 1));
+  x.v = _mm256_shuffle_ps(a, t0, _MM_SHUFFLE(2, 0, 3, 0));
+  y.v = _mm256_shuffle_ps(t1, t0, _MM_SHUFFLE(3, 1, 2, 0));
+  z.v = _mm256_shuffle_ps(t1, c, _MM_SHUFFLE(3, 0, 3, 1));
+}
+
+inline auto storeXyz(float * out, Pack<float, 8> const x, Pack<float, 8> const y, Pack<float, 8> const z) -> void {
+  __m256 const xy = _mm256_unpacklo_ps(x.v, y.v);
+  __m256 const zx = _mm256_shuffle_ps(z.v, x.v, _MM_SHUFFLE(1, 1, 0, 0));
+  __m256 const yz = _mm256_shuffle_ps(y.v, z.v, _MM_SHUFFLE(2, 1, 2, 1));
+  __m256 const xyhi = _mm256_unpackhi_ps(x.v, y.v);
+  __m256 const zx3 = _mm256_shuffle_ps(z.v, x.v, _MM_SHUFFLE(3, 3, 2, 2));
+  __m256 const yz3 = _mm256_shuffle_ps(y.v, z.v, _MM_SHUFFLE(3, 3, 3, 3));
+
+  __m256 const a = _mm256_shuffle_ps(xy, zx, _MM_SHUFFLE(2, 0, 1, 0));
+  __m256 const b = _mm256_shuffle_ps(yz, xyhi, _MM_SHUFFLE(1, 0, 2, 0));
+  __m256 const c = _mm256_shuffle_ps(zx3, yz3, _MM_SHUFFLE(2, 0, 2, 0));
+  _mm_storeu_ps(out, _mm256_castps256_ps128(a));
+  _mm_storeu_ps(out + 4, _mm256_castps256_ps128(b));
+  _mm_storeu_ps(out + 8, _mm256_castps256_ps128(c));
+  _mm_storeu_ps(out + 12, _mm256_extractf128_ps(a, 1));
+  _mm_storeu_ps(out + 16, _mm256_extractf128_ps(b, 1));
+  _mm_storeu_ps(out + 20, _mm256_extractf128_ps(c, 1));
+}
+
+/**
+ * Four xyz triples of doubles, two per lane as in the SSE2 version
+ */
+inline auto loadXyz(double const * in, Pack<double, 4> & x, Pack<double, 4> & y, Pack<double, 4> & z) -> void {
+  __m256d const a = _mm256_insertf128_pd(_mm256_castpd128_pd256(_mm_loadu_pd(in)), _mm_loadu_pd(in + 6), 1);
+  __m256d const b = _mm256_insertf128_pd(_mm256_castpd128_pd256(_mm_loadu_pd(in + 2)), _mm_loadu_pd(in + 8), 1);
+  __m256d const c = _mm256_insertf128_pd(_mm256_castpd128_pd256(_mm_loadu_pd(in + 4)), _mm_loadu_pd(in + 10), 1);
+  x.v = _mm256_shuffle_pd(a, b, 0xa);
+  y.v = _mm256_shuffle_pd(a, c, 0x5);
+  z.v = _mm256_shuffle_pd(b, c, 0xa);
+}
+
+inline auto storeXyz(double * out, Pack<double, 4> const x, Pack<double, 4> const y, Pack<double, 4> const z) -> void {
+  __m256d const a = _mm256_unpacklo_pd(x.v, y.v);
+  __m256d const b = _mm256_shuffle_pd(z.v, x.v, 0xa);
+  __m256d const c = _mm256_unpackhi_pd(y.v, z.v);
+  _mm_storeu_pd(out, _mm256_castpd256_pd128(a));
+  _mm_storeu_pd(out + 2, _mm256_castpd256_pd128(b));
+  _mm_storeu_pd(out + 4, _mm256_castpd256_pd128(c));
+  _mm_storeu_pd(out + 6, _mm256_extractf128_pd(a, 1));
+  _mm_storeu_pd(out + 8, _mm256_extractf128_pd(b, 1));
+  _mm_storeu_pd(out + 10, _mm256_extractf128_pd(c, 1));
+}
+
+#endif // CAGEY_SIMD_AVX
+
+/**
+ * Transform count packed xyz triples by the upper 3x4 of a column major
+ * 4x4 matrix.  w is the implied fourth component: 1 for points, 0 for
+ * vectors.  A native register of triples is transposed into x, y and z
+ * Packs, transformed with broadcast matrix elements and transposed back;
+ * the remainder is done one triple at a time.
+ */
+template<typename T>
+inline auto transform3(T const * mat, T const * in, T * out, std::size_t count, T const w) -> void {
+  // local copies, out may alias mat as far as the compiler knows and the
+  // broadcasts would be redone for every pack
+  T const m[12] = {mat[0], mat[1], mat[2], mat[4], mat[5], mat[6],
+                   mat[8], mat[9], mat[10], mat[12] * w, mat[13] * w, mat[14] * w};
+  forEachPack<T>(count, [&](auto p, std::size_t const i) {
+    using P = decltype(p);
+    P x, y, z;
+    loadXyz(in + 3 * i, x, y, z);
+    P const rx = (P::broadcast(m[0]) * x + P::broadcast(m[3]) * y) + (P::broadcast(m[6]) * z + P::broadcast(m[9]));
+    P const ry = (P::broadcast(m[1]) * x + P::broadcast(m[4]) * y) + (P::broadcast(m[7]) * z + P::broadcast(m[10]));
+    P const rz = (P::broadcast(m[2]) * x + P::broadcast(m[5]) * y) + (P::broadcast(m[8]) * z + P::broadcast(m[11]));
+    storeXyz(out + 3 * i, rx, ry, rz);
+  });
+}
+
+/**
+ * Transform count packed xyzw quadruples by a column major 4x4 matrix.
+ * The matrix columns stay in registers for the whole array, split into
+ * 4 / Width Packs when a column is wider than the Pack.
+ */
+template<typename T>
+inline auto transform4(T const * mat, T const * in, T * out, std::size_t count) -> void {
+  using P = Pack<T, FitWidth<T, 4>::value>;
+  constexpr std::size_t Parts = 4 / P::Width;
+  P cols[4][Parts];
+  for (std::size_t c = 0; c < 4; ++c) {
+    for (std::size_t k = 0; k < Parts; ++k) {
+      cols[c][k] = P::load(mat + 4 * c + k * P::Width);
+    }
+  }
+  for (std::size_t i = 0; i < count; ++i, in += 4, out += 4) {
+    P const x = P::broadcast(in[0]);
+    P const y = P::broadcast(in[1]);
+    P const z = P::broadcast(in[2]);
+    P const w = P::broadcast(in[3]);
+    for (std::size_t k = 0; k < Parts; ++k) {
+      (cols[0][k] * x + cols[1][k] * y + cols[2][k] * z + cols[3][k] * w).store(out + k * P::Width);
+    }
+  }
+}
+
+#if defined(CAGEY_SIMD_SSE2)
+
+/**
+ * SSE kernel.  The matrix columns stay in registers for the whole array.
+ * If Aligned is true mat and out must be 16 byte aligned.
+ */
+template<bool Aligned>
+inline auto transform4Ps(float const * mat, float const * in, float * out, std::size_t count) -> void {
+  __m128 const c0 = loadPs<Aligned>(mat);
+  __m128 const c1 = loadPs<Aligned>(mat + 4);
+  __m128 const c2 = loadPs<Aligned>(mat + 8);
+  __m128 const c3 = loadPs<Aligned>(mat + 12);
+  for (std::size_t i = 0; i < count; ++i, in += 4, out += 4) {
+    __m128 r = _mm_mul_ps(c0, _mm_set1_ps(in[0]));
+    r = _mm_add_ps(r, _mm_mul_ps(c1, _mm_set1_ps(in[1])));
+    r = _mm_add_ps(r, _mm_mul_ps(c2, _mm_set1_ps(in[2])));
+    r = _mm_add_ps(r, _mm_mul_ps(c3, _mm_set1_ps(in[3])));
+    storePs<Aligned>(out, r);
+  }
+}
+
+#endif // CAGEY_SIMD_SSE2
+
+} // namespace detail
+
+/**
+ * Transform an array of points by the given matrix.  Each point is treated
+ * as (x, y, z, 1); no perspective divide is performed.
+ *
+ * @param mat the transform to apply
+ * @param in pointer to the first of count points
+ * @param out pointer to storage for count points, may be the same as in
+ * @param count the number of points to transform
+ */
+template<typename T>
+auto transformPoints(Mat4<T> const & mat, Point3<T> const * in, Point3<T> * out, std::size_t count) -> void {
+  /** @cond doxygen has an issue with static assert */
+  static_assert(sizeof(Point3<T>) == 3 * sizeof(T), "Point3 must be tightly packed");
+  /** @endcond */
+  detail::transform3(mat.begin(), reinterpret_cast<T const *>(in), reinterpret_cast<T *>(out), count, T{1});
+}
+
+/**
+ * Transform an array of direction vectors by the given matrix.  Each vector
+ * is treated as (x, y, z, 0) so translation is ignored.
+ *
+ * @param mat the transform to apply
+ * @param in pointer to the first of count vectors
+ * @param out pointer to storage for count vectors, may be the same as in
+ * @param count the number of vectors to transform
+ */
+template<typename T>
+auto transformVectors(Mat4<T> const & mat, Vec3<T> const * in, Vec3<T> * out, std::size_t count) -> void {
+  /** @cond doxygen has an issue with static assert */
+  static_assert(sizeof(Vec3<T>) == 3 * sizeof(T), "Vec3 must be tightly packed");
+  /** @endcond */
+  detail::transform3(mat.begin(), reinterpret_cast<T const *>(in), reinterpret_cast<T *>(out), count, T{0});
+}
+
+/**
+ * Transform an array of four element vectors by the given matrix.
+ *
+ * @param mat the transform to apply
+ * @param in pointer to the first of count vectors
+ * @param out pointer to storage for count vectors, may be the same as in
+ * @param count the number of vectors to transform
+ */
+template<typename T>
+auto transformVectors(Mat4<T> const & mat, Vec4<T> const * in, Vec4<T> * out, std::size_t count) -> void {
+  /** @cond doxygen has an issue with static assert */
+  static_assert(sizeof(Vec4<T>) == 4 * sizeof(T), "Vec4 must be tightly packed");
+  /** @endcond */
+  detail::transform4(mat.begin(), reinterpret_cast<T const *>(in), reinterpret_cast<T *>(out), count);
+}
+
+} // namespace math
+} // namespace cagey
+
+#endif /* CAGEY_MATH_BATCHTRANSFORM_HH_ */
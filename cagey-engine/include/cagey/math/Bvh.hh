@@ -0,0 +1,477 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// cagey-engine - Toy 3D Engine
+// Copyright (c) 2014 Kyle Girard <theycallmecoach@gmail.com>
+//
+// The MIT License (MIT)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+
+/**
+ * @file
+ * @ref cagey::math::Bvh bounding volume hierarchy.
+ */
+
+#ifndef CAGEY_MATH_BVH_HH_
+#define CAGEY_MATH_BVH_HH_
+
+#include <cstddef>
+#include <cstdint>
+#include <algorithm>
+#include <array>
+#include <limits>
+#include <numeric>
+#include <thread>
+#include <vector>
+
+#include "cagey/math/Point.hh"
+#include "cagey/math/Vector.hh"
+#include "cagey/math/Aabb.hh"
+#include "cagey/math/Sphere.hh"
+#include "cagey/math/Ray.hh"
+
+namespace cagey {
+namespace math {
+
+/**
+ * A node of a flattened Bvh.  Nodes are stored depth first so the first
+ * child of an interior node immediately follows it.
+ */
+struct BvhNode {
+  Point3f min;           ///< Minimum corner of the node bounds
+  std::uint32_t offset;  ///< Leaf: first entry in the primitive list, interior: index of the second child
+  Point3f max;           ///< Maximum corner of the node bounds
+  std::uint32_t count;   ///< Leaf: number of primitives, interior: 0
+};
+
+/**
+ * The result of a ray cast
+ */
+struct BvhHit {
+  std::uint32_t primitive;  ///< Index of the primitive hit, Bvh::InvalidIndex if none
+  float t;                  ///< Distance along the ray, infinity if nothing was hit
+};
+
+namespace detail {
+
+/**
+ * Shared state of a Bvh build
+ */
+struct BvhBuilder {
+  /// Number of SAH bins per axis
+  static constexpr std::size_t Bins = 16;
+  /// Below this many primitives a subtree is not worth a thread
+  static constexpr std::uint32_t ParallelThreshold = 4096;
+  /// Past this depth fall back to median splits to bound the query stack
+  static constexpr std::size_t MedianDepth = 48;
+
+  Aabbf const * bounds;
+  std::vector<Point3f> centroids;
+  std::uint32_t * indices;
+  std::uint32_t maxLeafSize;
+
+  auto build(std::uint32_t begin, std::uint32_t end, std::size_t depth, std::size_t threads,
+             std::vector<BvhNode> & nodes) const -> void;
+};
+
+/**
+ * Append src to dst, rebasing the child links of interior nodes
+ */
+inline auto appendNodes(std::vector<BvhNode> & dst, std::vector<BvhNode> const & src) -> void {
+  auto const base = static_cast<std::uint32_t>(dst.size());
+  for (auto node : src) {
+    if (node.count == 0) {
+      node.offset += base;
+    }
+    dst.push_back(node);
+  }
+}
+
+/**
+ * Build the subtree over indices [begin, end) and append it, depth first,
+ * to nodes.  With threads > 1 the two children of large nodes are built
+ * concurrently into separate arrays and spliced in afterwards, which gives
+ * exactly the tree a serial build does.
+ */
+inline auto BvhBuilder::build(std::uint32_t const begin, std::uint32_t const end, std::size_t const depth,
+                              std::size_t const threads, std::vector<BvhNode> & nodes) const -> void {
+  Aabbf box;
+  Aabbf cbox;
+  for (std::uint32_t i = begin; i < end; ++i) {
+    box = merge(box, bounds[indices[i]]);
+    cbox = merge(cbox, centroids[indices[i]]);
+  }
+
+  auto const self = nodes.size();
+  nodes.push_back(BvhNode{box.min, begin, box.max, end - begin});
+  std::uint32_t const count = end - begin;
+  if (count <= maxLeafSize) {
+    return;
+  }
+
+  // binned SAH over all three axes
+  float const invArea = 1.0f / std::max(surfaceArea(box), std::numeric_limits<float>::min());
+  float bestCost = std::numeric_limits<float>::infinity();
+  std::size_t bestAxis = 0;
+  std::size_t bestBin = 0;
+  bool const median = depth >= MedianDepth;
+  for (std::size_t axis = 0; axis < 3 && !median; ++axis) {
+    float const lo = cbox.min[axis];
+    float const extent = cbox.max[axis] - lo;
+    if (!(extent > 0.0f)) {
+      continue;
+    }
+    float const scale = static_cast<float>(Bins) / extent;
+    std::array<Aabbf, Bins> binBounds;
+    std::array<std::uint32_t, Bins> binCounts{};
+    for (std::uint32_t i = begin; i < end; ++i) {
+      auto const b = std::min(static_cast<std::size_t>((centroids[indices[i]][axis] - lo) * scale), Bins - 1);
+      binBounds[b] = merge(binBounds[b], bounds[indices[i]]);
+      ++binCounts[b];
+    }
+    // sweep from the right recording the cost of everything right of each plane
+    std::array<float, Bins> rightCost{};
+    Aabbf right;
+    std::uint32_t rightCount = 0;
+    for (std::size_t b = Bins - 1; b > 0; --b) {
+      right = merge(right, binBounds[b]);
+      rightCount += binCounts[b];
+      rightCost[b - 1] = rightCount ? surfaceArea(right) * static_cast<float>(rightCount) : 0.0f;
+    }
+    Aabbf left;
+    std::uint32_t leftCount = 0;
+    for (std::size_t b = 0; b + 1 < Bins; ++b) {
+      left = merge(left, binBounds[b]);
+      leftCount += binCounts[b];
+      if (leftCount == 0 || leftCount == count) {
+        continue;
+      }
+      float const cost = 1.0f + (surfaceArea(left) * static_cast<float>(leftCount) + rightCost[b]) * invArea;
+      if (cost < bestCost) {
+        bestCost = cost;
+        bestAxis = axis;
+        bestBin = b;
+      }
+    }
+  }
+
+  std::uint32_t * const first = indices + begin;
+  std::uint32_t * const last = indices + end;
+  std::uint32_t * mid = first;
+  if (bestCost < std::numeric_limits<float>::infinity()) {
+    float const lo = cbox.min[bestAxis];
+    float const scale = static_cast<float>(Bins) / (cbox.max[bestAxis] - lo);
+    mid = std::partition(first, last, [&](std::uint32_t const idx) {
+      return std::min(static_cast<std::size_t>((centroids[idx][bestAxis] - lo) * scale), Bins - 1) <= bestBin;
+    });
+  }
+  if (mid == first || mid == last) {
+    // no useful SAH split: halve along the widest centroid axis
+    Vec3f const extent{cbox.max.x - cbox.min.x, cbox.max.y - cbox.min.y, cbox.max.z - cbox.min.z};
+    std::size_t const axis = extent.x >= extent.y && extent.x >= extent.z ? 0 : (extent.y >= extent.z ? 1 : 2);
+    mid = first + count / 2;
+    std::nth_element(first, mid, last, [&](std::uint32_t const a, std::uint32_t const b) {
+      return centroids[a][axis] < centroids[b][axis] || (centroids[a][axis] == centroids[b][axis] && a < b);
+    });
+  }
+  auto const split = static_cast<std::uint32_t>(mid - indices);
+
+  nodes[self].count = 0;
+  if (threads > 1 && count >= ParallelThreshold) {
+    std::vector<BvhNode> leftNodes;
+    std::vector<BvhNode> rightNodes;
+    std::thread worker{[&] { build(begin, split, depth + 1, threads / 2, leftNodes); }};
+    build(split, end, depth + 1, threads - threads / 2, rightNodes);
+    worker.join();
+    appendNodes(nodes, leftNodes);
+    nodes[self].offset = static_cast<std::uint32_t>(nodes.size());
+    appendNodes(nodes, rightNodes);
+  } else {
+    build(begin, split, depth + 1, 1, nodes);
+    nodes[self].offset = static_cast<std::uint32_t>(nodes.size());
+    build(split, end, depth + 1, 1, nodes);
+  }
+}
+
+inline auto overlaps(BvhNode const & node, Aabbf const & box) -> bool {
+  return node.min.x <= box.max.x && box.min.x <= node.max.x &&
+         node.min.y <= box.max.y && box.min.y <= node.max.y &&
+         node.min.z <= box.max.z && box.min.z <= node.max.z;
+}
+
+inline auto overlaps(BvhNode const & node, Spheref const & sphere) -> bool {
+  return intersects(sphere, Aabbf{node.min, node.max});
+}
+
+} // namespace detail
+
+/**
+ * Bounding volume hierarchy over a static set of primitives given by their
+ * bounds.  Built top down with a binned surface area heuristic and stored
+ * as a flat depth first array of 32 byte nodes.  Queries report primitives
+ * by their index in the array the Bvh was built from.
+ */
+class Bvh {
+public:
+  /// Primitive index reported when nothing was hit
+  enum : std::uint32_t { InvalidIndex = std::numeric_limits<std::uint32_t>::max() };
+
+  /// Deepest possible tree, the size of the query stacks
+  static constexpr std::size_t MaxDepth = 128;
+
+  /**
+   * Construct an empty Bvh
+   */
+  Bvh() = default;
+
+  /**
+   * Build a Bvh over count primitives
+   *
+   * @param bounds the bounds of each primitive
+   * @param count the number of primitives
+   * @param maxLeafSize leaves never hold more primitives than this
+   * @param threads the maximum number of threads, 0 for one per core
+   */
+  Bvh(Aabbf const * bounds, std::size_t count, std::size_t maxLeafSize = 4, std::size_t threads = 1);
+
+  /**
+   * Build a Bvh over the given primitive bounds
+   */
+  explicit Bvh(std::vector<Aabbf> const & bounds, std::size_t maxLeafSize = 4, std::size_t threads = 1)
+    : Bvh(bounds.data(), bounds.size(), maxLeafSize, threads) {}
+
+  /**
+   * Return the flattened nodes, the root first
+   */
+  auto nodes() const noexcept -> std::vector<BvhNode> const & { return mNodes; }
+
+  /**
+   * Return the primitive indices in leaf order
+   */
+  auto indices() const noexcept -> std::vector<std::uint32_t> const & { return mIndices; }
+
+  /**
+   * Return the number of primitives
+   */
+  auto size() const noexcept -> std::size_t { return mIndices.size(); }
+
+  /**
+   * Return true if there are no primitives
+   */
+  auto empty() const noexcept -> bool { return mIndices.empty(); }
+
+  /**
+   * Call f(index) for every primitive whose bounds overlap box
+   */
+  template<typename F>
+  auto queryAabb(Aabbf const & box, F && f) const -> void;
+
+  /**
+   * Call f(index) for every primitive whose bounds overlap sphere
+   */
+  template<typename F>
+  auto querySphere(Spheref const & sphere, F && f) const -> void;
+
+  /**
+   * Find the closest primitive along the ray.  intersect(index, tMax) is
+   * called for primitives whose bounds the ray enters before tMax and must
+   * return the distance to the primitive or infinity if it is missed.
+   */
+  template<typename F>
+  auto raycast(Rayf const & ray, float tMax, F && intersect) const -> BvhHit;
+
+  /**
+   * Find the closest primitive bounds along the ray
+   */
+  auto raycast(Rayf const & ray, float const tMax = std::numeric_limits<float>::infinity()) const -> BvhHit {
+    return traverse(ray, tMax, [](std::uint32_t, float const boxT, float) { return boxT; });
+  }
+
+private:
+  template<typename F>
+  auto traverse(Rayf const & ray, float tMax, F && leaf) const -> BvhHit;
+
+  std::vector<BvhNode> mNodes;
+  std::vector<std::uint32_t> mIndices;
+  /// primitive bounds in leaf order
+  std::vector<Aabbf> mBounds;
+};
+
+inline Bvh::Bvh(Aabbf const * bounds, std::size_t const count, std::size_t const maxLeafSize, std::size_t threads) {
+  if (count == 0) {
+    return;
+  }
+  if (threads == 0) {
+    threads = std::max<std::size_t>(1, std::thread::hardware_concurrency());
+  }
+  mIndices.resize(count);
+  std::iota(mIndices.begin(), mIndices.end(), 0u);
+
+  detail::BvhBuilder builder{bounds, std::vector<Point3f>(count), mIndices.data(),
+                             static_cast<std::uint32_t>(std::max<std::size_t>(1, maxLeafSize))};
+  for (std::size_t i = 0; i < count; ++i) {
+    builder.centroids[i] = center(bounds[i]);
+  }
+  mNodes.reserve(2 * count);
+  builder.build(0, static_cast<std::uint32_t>(count), 0, threads, mNodes);
+
+  mBounds.reserve(count);
+  for (auto const idx : mIndices) {
+    mBounds.push_back(bounds[idx]);
+  }
+}
+
+template<typename F>
+auto Bvh::queryAabb(Aabbf const & box, F && f) const -> void {
+  if (mNodes.empty()) {
+    return;
+  }
+  std::uint32_t stack[MaxDepth];
+  std::size_t top = 0;
+  stack[top++] = 0;
+  while (top > 0) {
+    auto const idx = stack[--top];
+    BvhNode const & node = mNodes[idx];
+    if (!detail::overlaps(node, box)) {
+      continue;
+    }
+    if (node.count > 0) {
+      for (std::uint32_t i = node.offset; i < node.offset + node.count; ++i) {
+        if (intersects(mBounds[i], box)) {
+          f(mIndices[i]);
+        }
+      }
+    } else {
+      stack[top++] = node.offset;
+      stack[top++] = idx + 1;
+    }
+  }
+}
+
+template<typename F>
+auto Bvh::querySphere(Spheref const & sphere, F && f) const -> void {
+  if (mNodes.empty()) {
+    return;
+  }
+  std::uint32_t stack[MaxDepth];
+  std::size_t top = 0;
+  stack[top++] = 0;
+  while (top > 0) {
+    auto const idx = stack[--top];
+    BvhNode const & node = mNodes[idx];
+    if (!detail::overlaps(node, sphere)) {
+      continue;
+    }
+    if (node.count > 0) {
+      for (std::uint32_t i = node.offset; i < node.offset + node.count; ++i) {
+        if (intersects(sphere, mBounds[i])) {
+          f(mIndices[i]);
+        }
+      }
+    } else {
+      stack[top++] = node.offset;
+      stack[top++] = idx + 1;
+    }
+  }
+}
+
+template<typename F>
+auto Bvh::raycast(Rayf const & ray, float const tMax, F && intersect) const -> BvhHit {
+  return traverse(ray, tMax, [this, &intersect](std::uint32_t const pos, float, float const limit) {
+    return intersect(mIndices[pos], limit);
+  });
+}
+
+/**
+ * Closest hit traversal.  The nearer child is visited first and the farther
+ * one pushed with its entry distance so it can be skipped once something
+ * closer has been found.  leaf(pos, boxT, tMax) is called with the leaf
+ * order position of primitives whose bounds are entered before tMax, the
+ * distance at which they are entered and the current closest hit
+ * distance, and returns the hit distance.
+ */
+template<typename F>
+auto Bvh::traverse(Rayf const & ray, float tMax, F && leaf) const -> BvhHit {
+  BvhHit hit{InvalidIndex, std::numeric_limits<float>::infinity()};
+  if (mNodes.empty()) {
+    return hit;
+  }
+  Vec3f const invDir = detail::inverseDirection(ray);
+  auto const enter = [&](BvhNode const & node) { return detail::slab(ray.origin, invDir, node.min, node.max, tMax); };
+
+  struct Entry {
+    std::uint32_t index;
+    float t;
+  };
+  Entry stack[MaxDepth];
+  std::size_t top = 0;
+  float const rootT = enter(mNodes[0]);
+  if (rootT == std::numeric_limits<float>::infinity()) {
+    return hit;
+  }
+  stack[top++] = Entry{0, rootT};
+  while (top > 0) {
+    Entry const entry = stack[--top];
+    if (entry.t > tMax) {
+      continue;
+    }
+    std::uint32_t idx = entry.index;
+    for (;;) {
+      BvhNode const & node = mNodes[idx];
+      if (node.count > 0) {
+        for (std::uint32_t i = node.offset; i < node.offset + node.count; ++i) {
+          float const boxT = detail::slab(ray.origin, invDir, mBounds[i].min, mBounds[i].max, tMax);
+          if (boxT == std::numeric_limits<float>::infinity()) {
+            continue;
+          }
+          float const t = leaf(i, boxT, tMax);
+          if (t <= tMax && t < hit.t) {
+            hit = BvhHit{mIndices[i], t};
+            tMax = t;
+          }
+        }
+        break;
+      }
+      std::uint32_t near = idx + 1;
+      std::uint32_t far = node.offset;
+      float nearT = enter(mNodes[near]);
+      float farT = enter(mNodes[far]);
+      if (farT < nearT) {
+        std::swap(near, far);
+        std::swap(nearT, farT);
+      }
+      if (nearT == std::numeric_limits<float>::infinity()) {
+        break;
+      }
+      if (farT != std::numeric_limits<float>::infinity()) {
+        stack[top++] = Entry{far, farT};
+      }
+      idx = near;
+    }
+  }
+  return hit;
+}
+
+} // namespace math
+} // namespace cagey
+
+#endif /* CAGEY_MATH_BVH_HH_ */
@@ -0,0 +1,355 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// cagey-engine - Toy 3D Engine
+// Copyright (c) 2014 Kyle Girard <theycallmecoach@gmail.com>
+//
+// The MIT License (MIT)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * @file
+ * Opt-in expression templates for element-wise Matrix and Vector arithmetic.
+ *
+ * Wrap the operands of a chain in lazy() and the whole chain is evaluated
+ * in a single pass, a full SIMD register at a time, when it is converted
+ * back to a Matrix or Vector:
+ *
+ * @code
+ * Mat4f m = lazy(a) + lazy(b) * s - lazy(c);
+ * assign(m, lazy(m) * 0.5f);
+ * @endcode
+ *
+ * Nodes hold pointers to their lazy() operands, so an expression must not
+ * outlive them.  The regular operators are unaffected.
+ */
+
+#ifndef CAGEY_MATH_EXPRESSION_HH_
+#define CAGEY_MATH_EXPRESSION_HH_
+
+#include <cstddef>
+#include <type_traits>
+
+#include "cagey/math/Matrix.hh"
+#include "cagey/math/Vector.hh"
+#include "cagey/math/Point.hh"
+#include "cagey/math/Simd.hh"
+
+namespace cagey {
+namespace math {
+
+/**
+ * Describes a type that can take part in an expression.  Specialized for
+ * Matrix, Vector and Point.
+ */
+template<typename E> struct ExpressionTraits {
+  /// true if E can be wrapped by lazy()
+  static constexpr bool IsDense = false;
+};
+
+template<typename T, std::size_t R, std::size_t C>
+struct ExpressionTraits<Matrix<T, R, C>> {
+  static constexpr bool IsDense = true;
+  using Type = T;
+  using Result = Matrix<T, R, C>;
+  static constexpr std::size_t Size = R * C;
+};
+
+template<typename T, std::size_t N>
+struct ExpressionTraits<Vector<T, N>> {
+  static constexpr bool IsDense = true;
+  using Type = T;
+  using Result = Vector<T, N>;
+  static constexpr std::size_t Size = N;
+};
+
+template<typename T, std::size_t N>
+struct ExpressionTraits<Point<T, N>> {
+  static constexpr bool IsDense = true;
+  using Type = T;
+  using Result = Point<T, N>;
+  static constexpr std::size_t Size = N;
+};
+
+/**
+ * Base of all expression nodes.  Converts to the Matrix or Vector type the
+ * expression produces.
+ *
+ * @tparam D the derived node type
+ * @tparam R the Matrix or Vector type this expression evaluates to
+ */
+template<typename D, typename R>
+class Expression {
+public:
+  /// The type this expression evaluates to
+  using Result = R;
+  /// The underlying element type
+  using Type = typename ExpressionTraits<R>::Type;
+  /// The number of elements
+  static constexpr std::size_t Size = ExpressionTraits<R>::Size;
+
+  /**
+   * Return the derived node
+   */
+  constexpr auto self() const -> D const & { return static_cast<D const &>(*this); }
+
+  /**
+   * Evaluate this expression
+   */
+  operator Result() const;
+};
+
+namespace detail {
+
+/**
+ * Leaf node referring to a Matrix or Vector
+ */
+template<typename R>
+class TerminalExpression : public Expression<TerminalExpression<R>, R> {
+public:
+  using Type = typename ExpressionTraits<R>::Type;
+
+  constexpr explicit TerminalExpression(R const & val) : mData(val.begin()) {}
+
+  constexpr auto operator[](std::size_t i) const -> Type { return mData[i]; }
+
+  template<typename P>
+  auto pack(std::size_t i) const -> P { return P::load(mData + i); }
+
+private:
+  Type const * mData;
+};
+
+/**
+ * Element-wise binary node, Op is a generic callable applied to elements
+ * and Packs alike
+ */
+template<typename L, typename R, typename Op>
+class BinaryExpression : public Expression<BinaryExpression<L, R, Op>, typename L::Result> {
+  /** @cond doxygen has an issue with static assert */
+  static_assert(std::is_same<typename L::Result, typename R::Result>::value, "Expression operands must have the same type");
+  /** @endcond */
+public:
+  using Type = typename L::Type;
+
+  constexpr BinaryExpression(L const & lhs, R const & rhs) : mLhs(lhs), mRhs(rhs) {}
+
+  constexpr auto operator[](std::size_t i) const -> Type { return Op{}(mLhs[i], mRhs[i]); }
+
+  template<typename P>
+  auto pack(std::size_t i) const -> P {
+    return Op{}(mLhs.template pack<P>(i), mRhs.template pack<P>(i));
+  }
+
+private:
+  L mLhs;
+  R mRhs;
+};
+
+/**
+ * Node applying Op to each element and a scalar
+ */
+template<typename E, typename Op>
+class ScalarExpression : public Expression<ScalarExpression<E, Op>, typename E::Result> {
+public:
+  using Type = typename E::Type;
+
+  constexpr ScalarExpression(E const & expr, Type const val) : mExpr(expr), mValue(val) {}
+
+  constexpr auto operator[](std::size_t i) const -> Type { return Op{}(mExpr[i], mValue); }
+
+  template<typename P>
+  auto pack(std::size_t i) const -> P {
+    return Op{}(mExpr.template pack<P>(i), P::broadcast(mValue));
+  }
+
+private:
+  E mExpr;
+  Type mValue;
+};
+
+/**
+ * Node negating each element
+ */
+template<typename E>
+class NegateExpression : public Expression<NegateExpression<E>, typename E::Result> {
+public:
+  using Type = typename E::Type;
+
+  constexpr explicit NegateExpression(E const & expr) : mExpr(expr) {}
+
+  constexpr auto operator[](std::size_t i) const -> Type { return -mExpr[i]; }
+
+  template<typename P>
+  auto pack(std::size_t i) const -> P { return -mExpr.template pack<P>(i); }
+
+private:
+  E mExpr;
+};
+
+struct AddOp { template<typename V> auto operator()(V const & a, V const & b) const -> V { return a + b; } };
+struct SubOp { template<typename V> auto operator()(V const & a, V const & b) const -> V { return a - b; } };
+struct MulOp { template<typename V> auto operator()(V const & a, V const & b) const -> V { return a * b; } };
+struct DivOp { template<typename V> auto operator()(V const & a, V const & b) const -> V { return a / b; } };
+
+/**
+ * Wrap Matrix/Vector operands in a TerminalExpression, pass nodes through
+ */
+template<typename E, bool = ExpressionTraits<E>::IsDense>
+struct AsExpression {
+  using Node = E;
+  static constexpr auto wrap(E const & e) -> E const & { return e; }
+};
+
+template<typename E>
+struct AsExpression<E, true> {
+  using Node = TerminalExpression<E>;
+  static constexpr auto wrap(E const & e) -> Node { return Node{e}; }
+};
+
+/**
+ * True if E is an expression node
+ */
+template<typename E>
+struct IsExpression {
+  template<typename D, typename R>
+  static auto test(Expression<D, R> const *) -> std::true_type;
+  static auto test(...) -> std::false_type;
+  static constexpr bool value = decltype(test(static_cast<E const *>(nullptr)))::value;
+};
+
+/**
+ * True if L and R may be combined by the expression operators: at least one
+ * is a node and both are nodes or lazy() compatible types
+ */
+template<typename L, typename R>
+struct IsExpressionPair {
+  static constexpr bool value = (IsExpression<L>::value || IsExpression<R>::value) &&
+                                (IsExpression<L>::value || ExpressionTraits<L>::IsDense) &&
+                                (IsExpression<R>::value || ExpressionTraits<R>::IsDense);
+};
+
+template<typename L, typename R, typename Op>
+using BinaryNode = BinaryExpression<typename AsExpression<L>::Node, typename AsExpression<R>::Node, Op>;
+
+} // namespace detail
+
+/**
+ * Start an expression from the given Matrix, Vector or Point
+ */
+template<typename E, typename = std::enable_if_t<ExpressionTraits<E>::IsDense>>
+constexpr auto lazy(E const & val) -> detail::TerminalExpression<E> {
+  return detail::TerminalExpression<E>{val};
+}
+
+/**
+ * Evaluate the given expression into out in a single pass.  out may also be
+ * an operand of the expression.
+ *
+ * @param out the Matrix or Vector to overwrite
+ * @param expr the expression to evaluate
+ */
+template<typename D, typename R>
+auto assign(R & out, Expression<D, R> const & expr) -> R & {
+  using T = typename Expression<D, R>::Type;
+  D const & node = expr.self();
+  T * dest = out.begin();
+  constexpr std::size_t size = Expression<D, R>::Size;
+  using Wide = detail::Pack<T, detail::FitWidth<T, size>::value>;
+  constexpr std::size_t bulk = size - size % Wide::Width;
+  for (std::size_t i = 0; i < bulk; i += Wide::Width) {
+    node.template pack<Wide>(i).store(dest + i);
+  }
+  for (std::size_t i = bulk; i < size; ++i) {
+    dest[i] = node[i];
+  }
+  return out;
+}
+
+/**
+ * Evaluate the given expression
+ */
+template<typename D, typename R>
+auto eval(Expression<D, R> const & expr) -> R {
+  R ret;
+  return assign(ret, expr);
+}
+
+template<typename D, typename R>
+Expression<D, R>::operator Result() const {
+  return eval(*this);
+}
+
+/**
+ * Element-wise addition node
+ */
+template<typename L, typename R, typename = std::enable_if_t<detail::IsExpressionPair<L, R>::value>>
+constexpr auto operator+(L const & lhs, R const & rhs) -> detail::BinaryNode<L, R, detail::AddOp> {
+  return detail::BinaryNode<L, R, detail::AddOp>{detail::AsExpression<L>::wrap(lhs), detail::AsExpression<R>::wrap(rhs)};
+}
+
+/**
+ * Element-wise subtraction node
+ */
+template<typename L, typename R, typename = std::enable_if_t<detail::IsExpressionPair<L, R>::value>>
+constexpr auto operator-(L const & lhs, R const & rhs) -> detail::BinaryNode<L, R, detail::SubOp> {
+  return detail::BinaryNode<L, R, detail::SubOp>{detail::AsExpression<L>::wrap(lhs), detail::AsExpression<R>::wrap(rhs)};
+}
+
+/**
+ * Negation node
+ */
+template<typename D, typename R>
+constexpr auto operator-(Expression<D, R> const & expr) -> detail::NegateExpression<D> {
+  return detail::NegateExpression<D>{expr.self()};
+}
+
+/**
+ * Scale node
+ */
+template<typename D, typename R>
+constexpr auto operator*(Expression<D, R> const & expr, typename Expression<D, R>::Type const val)
+    -> detail::ScalarExpression<D, detail::MulOp> {
+  return detail::ScalarExpression<D, detail::MulOp>{expr.self(), val};
+}
+
+/**
+ * Scale node
+ */
+template<typename D, typename R>
+constexpr auto operator*(typename Expression<D, R>::Type const val, Expression<D, R> const & expr)
+    -> detail::ScalarExpression<D, detail::MulOp> {
+  return detail::ScalarExpression<D, detail::MulOp>{expr.self(), val};
+}
+
+/**
+ * Division by scalar node.  Unlike operator/= no check for zero is made.
+ */
+template<typename D, typename R>
+constexpr auto operator/(Expression<D, R> const & expr, typename Expression<D, R>::Type const val)
+    -> detail::ScalarExpression<D, detail::DivOp> {
+  return detail::ScalarExpression<D, detail::DivOp>{expr.self(), val};
+}
+
+} // namespace math
+} // namespace cagey
+
+#endif /* CAGEY_MATH_EXPRESSION_HH_ */
@@ -0,0 +1,260 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// cagey-engine - Toy 3D Engine
+// Copyright (c) 2014 Kyle Girard <theycallmecoach@gmail.com>
+//
+// The MIT License (MIT)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+
+/**
+ * @file
+ * @ref cagey::math::Fixed, a binary fixed point number.
+ */
+
+#ifndef CAGEY_MATH_FIXED_HH_
+#define CAGEY_MATH_FIXED_HH_
+
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+#include <iostream>
+
+#include "cagey/math/NumberTraits.hh"
+#include "cagey/core/Exception.hh"
+
+namespace cagey {
+namespace math {
+
+/**
+ * Signed fixed point number with I integer bits, sign included, and F
+ * fraction bits.  All arithmetic is integer arithmetic so results are the
+ * same on every platform and compiler, which floats cannot promise.
+ * Products round to nearest, quotients truncate toward zero and overflow
+ * wraps in two's complement.  The wrapping arithmetic is done on unsigned
+ * integers, where it is defined, since signed overflow is undefined
+ * behaviour.  Floating point values outside the
+ * range saturate instead, since converting them to an integer that cannot
+ * hold them is undefined.
+ *
+ * @tparam I the number of integer bits
+ * @tparam F the number of fraction bits
+ */
+template<unsigned I, unsigned F>
+class Fixed {
+public:
+  /** @cond doxygen has some issues with static assert */
+  static_assert(F > 0 && I + F <= 32, "Fixed needs a fraction and fits in 32 bits");
+  /** @endcond */
+
+  /// The integer holding the scaled value
+  using Storage = std::conditional_t<I + F <= 16, std::int16_t, std::int32_t>;
+
+  /// An integer wide enough for the product of two Storage values
+  using Wide = std::conditional_t<I + F <= 16, std::int32_t, std::int64_t>;
+
+  /// The raw value representing one
+  static constexpr Wide One = Wide{1} << F;
+
+  /**
+   * Default constructor, leaves the value uninitialized like an int
+   */
+  Fixed() = default;
+
+  /**
+   * Construct from an integer, values out of range wrap
+   */
+  template<typename U, std::enable_if_t<std::is_integral<U>::value> * = nullptr>
+  constexpr explicit Fixed(U const value) noexcept
+    : mRaw(static_cast<Storage>(static_cast<std::make_unsigned_t<Wide>>(value) << F)) {}
+
+  /**
+   * Construct the nearest Fixed to a floating point value, ties round away
+   * from zero.  Values out of range saturate and NaN gives zero.
+   */
+  template<typename U, std::enable_if_t<std::is_floating_point<U>::value> * = nullptr>
+  constexpr explicit Fixed(U const value) noexcept : mRaw(rawFromFloat(value)) {}
+
+  /**
+   * Construct a Fixed from its raw scaled value
+   */
+  static constexpr auto fromRaw(Storage const raw) noexcept -> Fixed {
+    Fixed ret{};
+    ret.mRaw = raw;
+    return ret;
+  }
+
+  /**
+   * Return the raw scaled value, value * 2^F
+   */
+  constexpr auto raw() const noexcept -> Storage { return mRaw; }
+
+  /**
+   * Convert to an arithmetic type.  Conversion to an integer truncates
+   * toward zero.
+   */
+  template<typename U, std::enable_if_t<std::is_floating_point<U>::value> * = nullptr>
+  constexpr explicit operator U() const noexcept { return static_cast<U>(mRaw) / static_cast<U>(One); }
+
+  template<typename U, std::enable_if_t<std::is_integral<U>::value> * = nullptr>
+  constexpr explicit operator U() const noexcept { return static_cast<U>(mRaw / One); }
+
+  constexpr auto operator+=(Fixed const other) noexcept -> Fixed & {
+    mRaw = static_cast<Storage>(static_cast<Unsigned>(mRaw) + static_cast<Unsigned>(other.mRaw));
+    return *this;
+  }
+
+  constexpr auto operator-=(Fixed const other) noexcept -> Fixed & {
+    mRaw = static_cast<Storage>(static_cast<Unsigned>(mRaw) - static_cast<Unsigned>(other.mRaw));
+    return *this;
+  }
+
+  constexpr auto operator*=(Fixed const other) noexcept -> Fixed & {
+    //the shift of a negative product is arithmetic on every supported compiler
+    Wide const product = static_cast<Wide>(mRaw) * other.mRaw;
+    mRaw = static_cast<Storage>((product + (One >> 1)) >> F);
+    return *this;
+  }
+
+  auto operator/=(Fixed const other) -> Fixed & {
+    if (other.mRaw == 0) {
+      BOOST_THROW_EXCEPTION(core::DivideByZeroException() << core::ThrowMsg("Attempting to divide Fixed by zero"));
+    }
+    mRaw = static_cast<Storage>(static_cast<Wide>(mRaw) * One / other.mRaw);
+    return *this;
+  }
+
+  friend constexpr auto operator+(Fixed lhs, Fixed const rhs) noexcept -> Fixed { return lhs += rhs; }
+  friend constexpr auto operator-(Fixed lhs, Fixed const rhs) noexcept -> Fixed { return lhs -= rhs; }
+  friend constexpr auto operator*(Fixed lhs, Fixed const rhs) noexcept -> Fixed { return lhs *= rhs; }
+  friend auto operator/(Fixed lhs, Fixed const rhs) -> Fixed { return lhs /= rhs; }
+  friend constexpr auto operator-(Fixed const val) noexcept -> Fixed {
+    return fromRaw(static_cast<Storage>(Unsigned{0} - static_cast<Unsigned>(val.mRaw)));
+  }
+
+  friend constexpr auto operator==(Fixed const lhs, Fixed const rhs) noexcept -> bool { return lhs.mRaw == rhs.mRaw; }
+  friend constexpr auto operator!=(Fixed const lhs, Fixed const rhs) noexcept -> bool { return lhs.mRaw != rhs.mRaw; }
+  friend constexpr auto operator<(Fixed const lhs, Fixed const rhs) noexcept -> bool { return lhs.mRaw < rhs.mRaw; }
+  friend constexpr auto operator<=(Fixed const lhs, Fixed const rhs) noexcept -> bool { return lhs.mRaw <= rhs.mRaw; }
+  friend constexpr auto operator>(Fixed const lhs, Fixed const rhs) noexcept -> bool { return lhs.mRaw > rhs.mRaw; }
+  friend constexpr auto operator>=(Fixed const lhs, Fixed const rhs) noexcept -> bool { return lhs.mRaw >= rhs.mRaw; }
+
+  friend constexpr auto abs(Fixed const val) noexcept -> Fixed { return val.mRaw < 0 ? -val : val; }
+
+  /**
+   * Square root rounded down, found by ADL so length() and normalize()
+   * work on Vectors of Fixed.  Negative values give zero.
+   */
+  friend constexpr auto sqrt(Fixed const val) noexcept -> Fixed {
+    using Unsigned = std::make_unsigned_t<Wide>;
+    if (val.mRaw <= 0) {
+      return fromRaw(0);
+    }
+    // sqrt(raw / 2^F) * 2^F == sqrt(raw * 2^F)
+    Unsigned rem = static_cast<Unsigned>(val.mRaw) << F;
+    Unsigned root = 0;
+    Unsigned bit = Unsigned{1} << (sizeof(Unsigned) * 8 - 2);
+    while (bit > rem) {
+      bit >>= 2;
+    }
+    while (bit != 0) {
+      if (rem >= root + bit) {
+        rem -= root + bit;
+        root = (root >> 1) + bit;
+      } else {
+        root >>= 1;
+      }
+      bit >>= 2;
+    }
+    return fromRaw(static_cast<Storage>(root));
+  }
+
+private:
+  /// Storage reinterpreted for wrapping arithmetic
+  using Unsigned = std::make_unsigned_t<Storage>;
+
+  template<typename U>
+  static constexpr auto rawFromFloat(U const value) noexcept -> Storage {
+    U const scaled = value * static_cast<U>(One) + (value < U{0} ? U(-0.5) : U(0.5));
+    // NaN compares false everywhere, so test it before the range checks
+    if (scaled != scaled) {
+      return 0;
+    }
+    if (scaled <= static_cast<U>(std::numeric_limits<Storage>::min())) {
+      return std::numeric_limits<Storage>::min();
+    }
+    if (scaled >= static_cast<U>(std::numeric_limits<Storage>::max())) {
+      return std::numeric_limits<Storage>::max();
+    }
+    return static_cast<Storage>(scaled);
+  }
+
+  Storage mRaw;
+};
+
+template<unsigned I, unsigned F>
+constexpr typename Fixed<I, F>::Wide Fixed<I, F>::One;
+
+template<unsigned I, unsigned F>
+struct IsNumber<Fixed<I, F>> : std::true_type {};
+
+/// 16.16 fixed point
+using Fixed32 = Fixed<16, 16>;
+/// 8.8 fixed point
+using Fixed16 = Fixed<8, 8>;
+
+/**
+ * Output the given Fixed to the given output stream
+ */
+template<unsigned I, unsigned F>
+auto operator<<(std::ostream & os, Fixed<I, F> const val) -> std::ostream & {
+  return os << static_cast<double>(val);
+}
+
+} // namespace math
+} // namespace cagey
+
+namespace std {
+
+template<unsigned I, unsigned F>
+class numeric_limits<cagey::math::Fixed<I, F>> {
+  using Fixed = cagey::math::Fixed<I, F>;
+  using Storage = typename Fixed::Storage;
+public:
+  static constexpr bool is_specialized = true;
+  static constexpr bool is_signed = true;
+  static constexpr bool is_integer = false;
+  static constexpr bool is_exact = true;
+  static constexpr bool has_infinity = false;
+  static constexpr bool has_quiet_NaN = false;
+  static constexpr int digits = static_cast<int>(I + F - 1);
+  static constexpr int radix = 2;
+  /// the smallest positive value
+  static constexpr auto min() noexcept -> Fixed { return Fixed::fromRaw(1); }
+  static constexpr auto max() noexcept -> Fixed { return Fixed::fromRaw(numeric_limits<Storage>::max()); }
+  static constexpr auto lowest() noexcept -> Fixed { return Fixed::fromRaw(numeric_limits<Storage>::lowest()); }
+  static constexpr auto epsilon() noexcept -> Fixed { return Fixed::fromRaw(1); }
+};
+
+} // namespace std
+
+#endif /* CAGEY_MATH_FIXED_HH_ */
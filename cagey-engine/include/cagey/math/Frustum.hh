@@ -0,0 +1,323 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// cagey-engine - Toy 3D Engine
+// Copyright (c) 2014 Kyle Girard <theycallmecoach@gmail.com>
+//
+// The MIT License (MIT)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+
+/**
+ * @file
+ * @ref cagey::math::Frustum class and batched visibility culling.
+ */
+
+#ifndef CAGEY_MATH_FRUSTUM_HH_
+#define CAGEY_MATH_FRUSTUM_HH_
+
+#include <cstddef>
+#include <cstdint>
+#include <cmath>
+#include <array>
+#include <algorithm>
+#include <limits>
+#include <type_traits>
+#include <vector>
+
+#include "cagey/math/Matrix.hh"
+#include "cagey/math/Vector.hh"
+#include "cagey/math/Point.hh"
+#include "cagey/math/Aabb.hh"
+#include "cagey/math/Sphere.hh"
+#include "cagey/math/Array3.hh"
+#include "cagey/math/Simd.hh"
+#include "cagey/math/Parallel.hh"
+#include "cagey/core/Exception.hh"
+
+namespace cagey {
+namespace math {
+
+/**
+ * Plane given by a unit normal and its signed distance, points p with
+ * dot(normal, p) + distance >= 0 are in front of the plane.
+ *
+ * @tparam T underlying floating point type
+ */
+template<typename T>
+class Plane {
+public:
+  /** @cond doxygen has some issues with static assert */
+  static_assert(std::is_floating_point<T>::value, "Underlying type must be floating point");
+  /** @endcond */
+
+  /// The underlying type of this Plane
+  using Type = T;
+
+  constexpr Plane() noexcept = default;
+
+  /**
+   * Construct a plane from the coefficients of ax + by + cz + d = 0,
+   * normalizing them so (a, b, c) has unit length.
+   */
+  Plane(T const a, T const b, T const c, T const d) noexcept;
+
+public:
+  Vec3<T> normal;  ///< The unit normal, pointing to the front
+  T distance{};    ///< The signed distance of the origin
+};
+
+template<typename T>
+Plane<T>::Plane(T const a, T const b, T const c, T const d) noexcept {
+  using std::sqrt;
+  T const len = sqrt(a * a + b * b + c * c);
+  T const inv = len > T{0} ? T{1} / len : T{0};
+  normal = Vec3<T>{a * inv, b * inv, c * inv};
+  distance = d * inv;
+}
+
+/**
+ * Return the signed distance from the plane to the point
+ */
+template<typename T>
+auto signedDistance(Plane<T> const & plane, Point3<T> const & pt) -> T {
+  return plane.normal.x * pt.x + plane.normal.y * pt.y + plane.normal.z * pt.z + plane.distance;
+}
+
+/**
+ * View frustum as six inward facing planes.
+ *
+ * @tparam T underlying floating point type
+ */
+template<typename T>
+class Frustum {
+public:
+  /// Plane indices
+  enum Side : std::size_t { Left, Right, Bottom, Top, Near, Far, Count };
+
+  constexpr Frustum() noexcept = default;
+
+  /**
+   * Extract the planes of a view-projection matrix (Gribb/Hartmann).  The
+   * matrix maps to OpenGL clip space, -w <= x, y, z <= w, with column
+   * vectors as everywhere in cagey::math.
+   *
+   * @param viewProj the projection matrix times the view matrix
+   */
+  explicit Frustum(Mat4<T> const & viewProj) noexcept;
+
+public:
+  /// The planes, indexed by Side
+  std::array<Plane<T>, Count> planes;
+};
+
+using Frustumf = Frustum<float>;
+using Frustumd = Frustum<double>;
+
+template<typename T>
+Frustum<T>::Frustum(Mat4<T> const & m) noexcept {
+  // row 3 +/- row i of the matrix
+  auto plane = [&m](std::size_t const row, T const sign) {
+    return Plane<T>{m(3, 0) + sign * m(row, 0), m(3, 1) + sign * m(row, 1),
+                    m(3, 2) + sign * m(row, 2), m(3, 3) + sign * m(row, 3)};
+  };
+  planes[Left] = plane(0, T{1});
+  planes[Right] = plane(0, T{-1});
+  planes[Bottom] = plane(1, T{1});
+  planes[Top] = plane(1, T{-1});
+  planes[Near] = plane(2, T{1});
+  planes[Far] = plane(2, T{-1});
+}
+
+/**
+ * Return false if the box lies entirely behind one of the planes.  Like
+ * all plane based tests this is conservative near the frustum edges.
+ */
+template<typename T>
+auto intersects(Frustum<T> const & frustum, Aabb<T> const & box) -> bool {
+  using std::abs;
+  auto const c = center(box);
+  auto const e = extents(box);
+  for (auto const & p : frustum.planes) {
+    T const r = abs(p.normal.x) * e.x + abs(p.normal.y) * e.y + abs(p.normal.z) * e.z;
+    if (signedDistance(p, c) + r < T{0}) {
+      return false;
+    }
+  }
+  return true;
+}
+
+/**
+ * Return false if the sphere lies entirely behind one of the planes
+ */
+template<typename T>
+auto intersects(Frustum<T> const & frustum, Sphere<T> const & sphere) -> bool {
+  for (auto const & p : frustum.planes) {
+    if (signedDistance(p, sphere.center) + sphere.radius < T{0}) {
+      return false;
+    }
+  }
+  return true;
+}
+
+namespace detail {
+
+/**
+ * The frustum planes split into per component arrays for broadcasting
+ */
+template<typename T>
+struct CullPlanes {
+  explicit CullPlanes(Frustum<T> const & frustum) {
+    using std::abs;
+    for (std::size_t k = 0; k < Frustum<T>::Count; ++k) {
+      auto const & p = frustum.planes[k];
+      nx[k] = p.normal.x;
+      ny[k] = p.normal.y;
+      nz[k] = p.normal.z;
+      d[k] = p.distance;
+      ax[k] = abs(p.normal.x);
+      ay[k] = abs(p.normal.y);
+      az[k] = abs(p.normal.z);
+    }
+  }
+
+  T nx[Frustum<T>::Count];
+  T ny[Frustum<T>::Count];
+  T nz[Frustum<T>::Count];
+  T d[Frustum<T>::Count];
+  T ax[Frustum<T>::Count];
+  T ay[Frustum<T>::Count];
+  T az[Frustum<T>::Count];
+};
+
+/**
+ * Cull elements [begin, end), begin being a multiple of 32.  radius(P, i)
+ * returns the Pack of projected radii of elements i.. for plane k.  Each
+ * Pack's worst plane distance is turned into visibility bits with one
+ * compare.
+ */
+template<typename T, typename R>
+auto cullRange(CullPlanes<T> const & planes, T const * cx, T const * cy, T const * cz, R const & radius,
+               std::size_t const begin, std::size_t const end, std::uint32_t * visible) -> void {
+  std::fill(visible + begin / 32, visible + (end + 31) / 32, std::uint32_t{0});
+  forEachPack<T>(end - begin, [&](auto p, std::size_t const local) {
+    using P = decltype(p);
+    std::size_t const i = begin + local;
+    P const x = P::load(cx + i);
+    P const y = P::load(cy + i);
+    P const z = P::load(cz + i);
+    P worst = P::broadcast(std::numeric_limits<T>::max());
+    for (std::size_t k = 0; k < Frustum<T>::Count; ++k) {
+      P const dist = P::broadcast(planes.nx[k]) * x + P::broadcast(planes.ny[k]) * y +
+                     P::broadcast(planes.nz[k]) * z + P::broadcast(planes.d[k]);
+      worst = min(worst, dist + radius(p, i, k));
+    }
+    unsigned const outside = P::bits(worst < P::broadcast(T{0}));
+    unsigned const inside = ~outside & ((1u << P::Width) - 1u);
+    visible[i / 32] |= static_cast<std::uint32_t>(inside) << (i % 32);
+  });
+}
+
+} // namespace detail
+
+/**
+ * Test count boxes, given as SoA centers and extents (half sizes), against
+ * the frustum.  Bit (i % 32) of visible[i / 32] is set if box i may be
+ * visible, matching intersects(Frustum, Aabb).
+ *
+ * @param frustum the frustum to test against
+ * @param cx, cy, cz the box centers
+ * @param ex, ey, ez the box extents
+ * @param count the number of boxes
+ * @param visible output bitmask of (count + 31) / 32 words
+ * @param threads the maximum number of threads, 0 for one per core
+ */
+template<typename T>
+auto cullAabbs(Frustum<T> const & frustum, T const * cx, T const * cy, T const * cz,
+               T const * ex, T const * ey, T const * ez, std::size_t const count,
+               std::uint32_t * visible, std::size_t const threads = 1) -> void {
+  detail::CullPlanes<T> const planes{frustum};
+  auto const radius = [&planes, ex, ey, ez](auto p, std::size_t const i, std::size_t const k) {
+    using P = decltype(p);
+    return P::broadcast(planes.ax[k]) * P::load(ex + i) + P::broadcast(planes.ay[k]) * P::load(ey + i) +
+           P::broadcast(planes.az[k]) * P::load(ez + i);
+  };
+  detail::parallelFor(count, threads, 1024, [&](std::size_t const begin, std::size_t const end) {
+    detail::cullRange(planes, cx, cy, cz, radius, begin, end, visible);
+  });
+}
+
+/**
+ * Test boxes given as SoA centers and extents against the frustum
+ *
+ * @throws InvalidArgumentException if centers and extents differ in size
+ */
+template<typename T>
+auto cullAabbs(Frustum<T> const & frustum, Point3Array<T> const & centers, Vec3Array<T> const & extents,
+               std::uint32_t * visible, std::size_t const threads = 1) -> void {
+  if (centers.size() != extents.size()) {
+    BOOST_THROW_EXCEPTION(core::InvalidArgumentException() << core::ThrowMsg("Arrays differ in size"));
+  }
+  cullAabbs(frustum, centers.getX(), centers.getY(), centers.getZ(),
+            extents.getX(), extents.getY(), extents.getZ(), centers.size(), visible, threads);
+}
+
+/**
+ * Test count spheres, given as SoA centers and radii, against the frustum.
+ * Bit (i % 32) of visible[i / 32] is set if sphere i may be visible.
+ *
+ * @param frustum the frustum to test against
+ * @param cx, cy, cz the sphere centers
+ * @param radii the sphere radii
+ * @param count the number of spheres
+ * @param visible output bitmask of (count + 31) / 32 words
+ * @param threads the maximum number of threads, 0 for one per core
+ */
+template<typename T>
+auto cullSpheres(Frustum<T> const & frustum, T const * cx, T const * cy, T const * cz, T const * radii,
+                 std::size_t const count, std::uint32_t * visible, std::size_t const threads = 1) -> void {
+  detail::CullPlanes<T> const planes{frustum};
+  auto const radius = [radii](auto p, std::size_t const i, std::size_t) {
+    return decltype(p)::load(radii + i);
+  };
+  detail::parallelFor(count, threads, 1024, [&](std::size_t const begin, std::size_t const end) {
+    detail::cullRange(planes, cx, cy, cz, radius, begin, end, visible);
+  });
+}
+
+/**
+ * Test spheres given as SoA centers and radii against the frustum
+ *
+ * @throws InvalidArgumentException if centers and radii differ in size
+ */
+template<typename T>
+auto cullSpheres(Frustum<T> const & frustum, Point3Array<T> const & centers, std::vector<T> const & radii,
+                 std::uint32_t * visible, std::size_t const threads = 1) -> void {
+  if (centers.size() != radii.size()) {
+    BOOST_THROW_EXCEPTION(core::InvalidArgumentException() << core::ThrowMsg("Arrays differ in size"));
+  }
+  cullSpheres(frustum, centers.getX(), centers.getY(), centers.getZ(), radii.data(), centers.size(), visible, threads);
+}
+
+} // namespace math
+} // namespace cagey
+
+#endif /* CAGEY_MATH_FRUSTUM_HH_ */
@@ -0,0 +1,310 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// cagey-engine - Toy 3D Engine
+// Copyright (c) 2014 Kyle Girard <theycallmecoach@gmail.com>
+//
+// The MIT License (MIT)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+
+/**
+ * @file
+ * @ref cagey::math::Half, an IEEE 754 binary16 storage type.
+ */
+
+#ifndef CAGEY_MATH_HALF_HH_
+#define CAGEY_MATH_HALF_HH_
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <iostream>
+
+#include "cagey/math/NumberTraits.hh"
+#include "cagey/math/Simd.hh"
+
+#if defined(CAGEY_SIMD_AVX) && defined(__F16C__)
+#  define CAGEY_SIMD_F16C 1
+#endif
+
+namespace cagey {
+namespace math {
+
+namespace detail {
+
+/**
+ * Convert a float to binary16 bits, rounding to nearest even.  Overflow
+ * becomes infinity and NaN stays NaN, matching the F16C instructions.
+ */
+inline auto floatToHalfBits(float const value) noexcept -> std::uint16_t {
+  std::uint32_t bits;
+  std::memcpy(&bits, &value, sizeof(bits));
+  std::uint32_t const sign = (bits >> 16) & 0x8000u;
+  bits &= 0x7fffffffu;
+
+  std::uint32_t ret;
+  if (bits >= 0x47800000u) {
+    // too large for a half, or already Inf or NaN
+    ret = bits > 0x7f800000u ? 0x7e00u | ((bits >> 13) & 0x3ffu) : 0x7c00u;
+  } else if (bits < 0x38800000u) {
+    // subnormal half or zero, let the float adder do the rounding
+    float mag;
+    std::memcpy(&mag, &bits, sizeof(mag));
+    float const magic = 0.5f;
+    float const sum = mag + magic;
+    std::uint32_t sumBits;
+    std::memcpy(&sumBits, &sum, sizeof(sumBits));
+    ret = sumBits - 0x3f000000u;
+  } else {
+    std::uint32_t const odd = (bits >> 13) & 1u;
+    ret = (bits - 0x38000000u + 0xfffu + odd) >> 13;
+  }
+  return static_cast<std::uint16_t>(ret | sign);
+}
+
+/**
+ * Convert binary16 bits to a float, exact for every half value.  NaNs are
+ * quieted, matching the F16C instructions.
+ */
+inline auto halfBitsToFloat(std::uint16_t const half) noexcept -> float {
+  std::uint32_t const sign = (static_cast<std::uint32_t>(half) & 0x8000u) << 16;
+  std::uint32_t const exponent = half & 0x7c00u;
+  std::uint32_t bits = (static_cast<std::uint32_t>(half) & 0x7fffu) << 13;
+  float ret;
+  if (exponent == 0x7c00u) {
+    bits |= (half & 0x3ffu) != 0 ? 0x7fc00000u : 0x7f800000u;
+    std::memcpy(&ret, &bits, sizeof(ret));
+  } else if (exponent == 0) {
+    // subnormal: scale the mantissa by 2^-24
+    ret = static_cast<float>(half & 0x3ffu) * 5.9604644775390625e-8f;
+  } else {
+    bits += 0x38000000u;
+    std::memcpy(&ret, &bits, sizeof(ret));
+  }
+  std::uint32_t retBits;
+  std::memcpy(&retBits, &ret, sizeof(retBits));
+  retBits |= sign;
+  std::memcpy(&ret, &retBits, sizeof(ret));
+  return ret;
+}
+
+#if defined(CAGEY_SIMD_SSE2)
+
+/**
+ * SSE2 version of floatToHalfBits for eight floats, bit for bit the same.
+ * Every case is computed and the right one picked per lane.
+ */
+inline auto floatToHalfBits8(float const * in, std::uint16_t * out) noexcept -> void {
+  auto const convert = [](__m128 const value) {
+    __m128i const bits = _mm_castps_si128(value);
+    __m128i const sign = _mm_and_si128(_mm_srli_epi32(bits, 16), _mm_set1_epi32(0x8000));
+    __m128i const mag = _mm_and_si128(bits, _mm_set1_epi32(0x7fffffff));
+
+    __m128i const nan = _mm_cmpgt_epi32(mag, _mm_set1_epi32(0x7f800000));
+    __m128i const nanBits = _mm_or_si128(_mm_set1_epi32(0x7e00),
+                                         _mm_and_si128(_mm_srli_epi32(mag, 13), _mm_set1_epi32(0x3ff)));
+    __m128i const large = _mm_or_si128(_mm_and_si128(nan, nanBits), _mm_andnot_si128(nan, _mm_set1_epi32(0x7c00)));
+
+    __m128 const sum = _mm_add_ps(_mm_castsi128_ps(mag), _mm_set1_ps(0.5f));
+    __m128i const small = _mm_sub_epi32(_mm_castps_si128(sum), _mm_set1_epi32(0x3f000000));
+
+    __m128i const odd = _mm_and_si128(_mm_srli_epi32(mag, 13), _mm_set1_epi32(1));
+    __m128i const normal = _mm_srli_epi32(
+        _mm_add_epi32(_mm_sub_epi32(mag, _mm_set1_epi32(0x38000000 - 0xfff)), odd), 13);
+
+    __m128i const isLarge = _mm_cmpgt_epi32(mag, _mm_set1_epi32(0x477fffff));
+    __m128i const isSmall = _mm_cmplt_epi32(mag, _mm_set1_epi32(0x38800000));
+    __m128i ret = _mm_or_si128(_mm_and_si128(isSmall, small), _mm_andnot_si128(isSmall, normal));
+    ret = _mm_or_si128(_mm_and_si128(isLarge, large), _mm_andnot_si128(isLarge, ret));
+    ret = _mm_or_si128(ret, sign);
+    // sign extend the low 16 bits so the saturating pack keeps them intact
+    return _mm_srai_epi32(_mm_slli_epi32(ret, 16), 16);
+  };
+  __m128i const lo = convert(_mm_loadu_ps(in));
+  __m128i const hi = convert(_mm_loadu_ps(in + 4));
+  _mm_storeu_si128(reinterpret_cast<__m128i *>(out), _mm_packs_epi32(lo, hi));
+}
+
+/**
+ * SSE2 version of halfBitsToFloat for eight halves, bit for bit the same
+ */
+inline auto halfBitsToFloat8(std::uint16_t const * in, float * out) noexcept -> void {
+  auto const convert = [](__m128i const half) {
+    __m128i const sign = _mm_slli_epi32(_mm_and_si128(half, _mm_set1_epi32(0x8000)), 16);
+    __m128i const exponent = _mm_and_si128(half, _mm_set1_epi32(0x7c00));
+    __m128i const bits = _mm_slli_epi32(_mm_and_si128(half, _mm_set1_epi32(0x7fff)), 13);
+
+    __m128i const nan = _mm_cmpgt_epi32(_mm_and_si128(half, _mm_set1_epi32(0x7fff)), _mm_set1_epi32(0x7c00));
+    __m128i const special = _mm_or_si128(_mm_or_si128(bits, _mm_set1_epi32(0x7f800000)),
+                                         _mm_and_si128(nan, _mm_set1_epi32(0x400000)));
+    __m128 const subnormal = _mm_mul_ps(_mm_cvtepi32_ps(_mm_and_si128(half, _mm_set1_epi32(0x3ff))),
+                                        _mm_set1_ps(5.9604644775390625e-8f));
+    __m128i const normal = _mm_add_epi32(bits, _mm_set1_epi32(0x38000000));
+
+    __m128i const isSpecial = _mm_cmpeq_epi32(exponent, _mm_set1_epi32(0x7c00));
+    __m128i const isSubnormal = _mm_cmpeq_epi32(exponent, _mm_setzero_si128());
+    __m128i ret = _mm_or_si128(_mm_and_si128(isSubnormal, _mm_castps_si128(subnormal)),
+                               _mm_andnot_si128(isSubnormal, normal));
+    ret = _mm_or_si128(_mm_and_si128(isSpecial, special), _mm_andnot_si128(isSpecial, ret));
+    return _mm_castsi128_ps(_mm_or_si128(ret, sign));
+  };
+  __m128i const packed = _mm_loadu_si128(reinterpret_cast<__m128i const *>(in));
+  _mm_storeu_ps(out, convert(_mm_unpacklo_epi16(packed, _mm_setzero_si128())));
+  _mm_storeu_ps(out + 4, convert(_mm_unpackhi_epi16(packed, _mm_setzero_si128())));
+}
+
+#endif // CAGEY_SIMD_SSE2
+
+} // namespace detail
+
+/**
+ * IEEE 754 binary16 floating point number.  Half only stores values,
+ * arithmetic happens in float through the implicit conversions, so a
+ * Vector<Half, 3> computes like a Vec3f but takes half the space.
+ */
+class Half {
+public:
+  /**
+   * Default constructor, leaves the value uninitialized like a float
+   */
+  Half() = default;
+
+  /**
+   * Construct the nearest Half to the given value
+   */
+  Half(float const value) noexcept : mBits{detail::floatToHalfBits(value)} {}
+
+  /**
+   * Construct a Half from its binary16 representation
+   */
+  static auto fromBits(std::uint16_t const bits) noexcept -> Half {
+    Half ret;
+    ret.mBits = bits;
+    return ret;
+  }
+
+  /**
+   * Return the binary16 representation of this Half
+   */
+  auto bits() const noexcept -> std::uint16_t { return mBits; }
+
+  /**
+   * Convert to float, exact for every Half
+   */
+  operator float() const noexcept { return detail::halfBitsToFloat(mBits); }
+
+  /// Compound assignments compute in float and round the result once
+  auto operator+=(float const rhs) noexcept -> Half & { return *this = Half{float(*this) + rhs}; }
+  auto operator-=(float const rhs) noexcept -> Half & { return *this = Half{float(*this) - rhs}; }
+  auto operator*=(float const rhs) noexcept -> Half & { return *this = Half{float(*this) * rhs}; }
+  auto operator/=(float const rhs) noexcept -> Half & { return *this = Half{float(*this) / rhs}; }
+
+private:
+  std::uint16_t mBits;
+};
+
+template<>
+struct IsNumber<Half> : std::true_type {};
+
+/**
+ * Output the given Half to the given output stream
+ */
+inline auto operator<<(std::ostream & os, Half const val) -> std::ostream & {
+  return os << static_cast<float>(val);
+}
+
+/**
+ * Convert an array of floats to Half
+ *
+ * @param in pointer to count floats
+ * @param out storage for count Halfs
+ * @param count the number of values
+ */
+inline auto toHalf(float const * in, Half * out, std::size_t const count) -> void {
+  std::size_t i = 0;
+#if defined(CAGEY_SIMD_F16C)
+  for (; i < count / 8 * 8; i += 8) {
+    __m128i const packed = _mm256_cvtps_ph(_mm256_loadu_ps(in + i), _MM_FROUND_TO_NEAREST_INT);
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(out + i), packed);
+  }
+#elif defined(CAGEY_SIMD_SSE2)
+  for (; i < count / 8 * 8; i += 8) {
+    detail::floatToHalfBits8(in + i, reinterpret_cast<std::uint16_t *>(out + i));
+  }
+#endif
+  for (; i < count; ++i) {
+    out[i] = Half{in[i]};
+  }
+}
+
+/**
+ * Convert an array of Halfs to float
+ *
+ * @param in pointer to count Halfs
+ * @param out storage for count floats
+ * @param count the number of values
+ */
+inline auto toFloat(Half const * in, float * out, std::size_t const count) -> void {
+  std::size_t i = 0;
+#if defined(CAGEY_SIMD_F16C)
+  for (; i < count / 8 * 8; i += 8) {
+    __m128i const packed = _mm_loadu_si128(reinterpret_cast<__m128i const *>(in + i));
+    _mm256_storeu_ps(out + i, _mm256_cvtph_ps(packed));
+  }
+#elif defined(CAGEY_SIMD_SSE2)
+  for (; i < count / 8 * 8; i += 8) {
+    detail::halfBitsToFloat8(reinterpret_cast<std::uint16_t const *>(in + i), out + i);
+  }
+#endif
+  for (; i < count; ++i) {
+    out[i] = in[i];
+  }
+}
+
+} // namespace math
+} // namespace cagey
+
+namespace std {
+
+template<>
+class numeric_limits<cagey::math::Half> {
+public:
+  static constexpr bool is_specialized = true;
+  static constexpr bool is_signed = true;
+  static constexpr bool is_integer = false;
+  static constexpr bool is_exact = false;
+  static constexpr bool has_infinity = true;
+  static constexpr bool has_quiet_NaN = true;
+  static constexpr int digits = 11;
+  static constexpr int radix = 2;
+  static auto min() noexcept -> cagey::math::Half { return cagey::math::Half::fromBits(0x0400); }
+  static auto max() noexcept -> cagey::math::Half { return cagey::math::Half::fromBits(0x7bff); }
+  static auto lowest() noexcept -> cagey::math::Half { return cagey::math::Half::fromBits(0xfbff); }
+  static auto epsilon() noexcept -> cagey::math::Half { return cagey::math::Half::fromBits(0x1400); }
+  static auto infinity() noexcept -> cagey::math::Half { return cagey::math::Half::fromBits(0x7c00); }
+  static auto quiet_NaN() noexcept -> cagey::math::Half { return cagey::math::Half::fromBits(0x7e00); }
+};
+
+} // namespace std
+
+#endif /* CAGEY_MATH_HALF_HH_ */
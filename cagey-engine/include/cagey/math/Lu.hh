@@ -0,0 +1,285 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// cagey-engine - Toy 3D Engine
+// Copyright (c) 2014 Kyle Girard <theycallmecoach@gmail.com>
+//
+// The MIT License (MIT)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+
+/**
+ * @file
+ * @ref cagey::math::Lu decomposition for square matrices of any size.
+ */
+
+#ifndef CAGEY_MATH_LU_HH_
+#define CAGEY_MATH_LU_HH_
+
+#include <cstddef>
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <limits>
+#include <type_traits>
+#include <utility>
+
+#include "cagey/math/Matrix.hh"
+#include "cagey/math/Vector.hh"
+#include "cagey/core/Exception.hh"
+
+namespace cagey {
+namespace math {
+
+/**
+ * LU decomposition with partial pivoting, PA = LU.  L (unit diagonal) and
+ * U share one N x N Matrix and the row permutation is kept as the sequence
+ * of swaps made, so nothing is heap allocated.
+ *
+ * Storage is column major so elimination updates run down contiguous
+ * columns.  For the sizes this is meant for (up to a few dozen) the whole
+ * factorization stays in L1, so the column oriented loop order is all the
+ * blocking that pays off.
+ *
+ * @tparam T underlying floating point type
+ * @tparam N the number of rows and columns
+ */
+template<typename T, std::size_t N>
+class Lu {
+public:
+  /** @cond doxygen has some issues with static assert */
+  static_assert(std::is_floating_point<T>::value, "Underlying type must be floating point");
+  /** @endcond */
+
+  /// The Underlying type of this decomposition
+  using Type = T;
+
+  /**
+   * Factor the given matrix.  A pivot no larger than N * epsilon times the
+   * largest element of mat makes the matrix singular.
+   */
+  explicit Lu(Matrix<T, N, N> const & mat);
+
+  /**
+   * Return true if the matrix could not be factored
+   */
+  auto isSingular() const noexcept -> bool { return mSingular; }
+
+  /**
+   * Return the determinant of the factored matrix, 0 if it is singular
+   */
+  auto det() const noexcept -> T;
+
+  /**
+   * Solve mat * x = b without throwing
+   *
+   * @return false, leaving x unchanged, if the matrix is singular
+   */
+  auto trySolve(Vector<T, N> const & b, Vector<T, N> & x) const noexcept -> bool;
+
+  /**
+   * Solve mat * X = B for M right hand sides without throwing
+   *
+   * @return false, leaving x unchanged, if the matrix is singular
+   */
+  template<std::size_t M>
+  auto trySolve(Matrix<T, N, M> const & b, Matrix<T, N, M> & x) const noexcept -> bool;
+
+  /**
+   * Return the combined factors, L below the diagonal and U on and above it
+   */
+  auto factors() const noexcept -> Matrix<T, N, N> const & { return mLu; }
+
+private:
+  /**
+   * Solve in place for the column of N values starting at col
+   */
+  auto substitute(T * col) const noexcept -> void;
+
+  Matrix<T, N, N> mLu;
+  /// row k was swapped with row mPivots[k] at step k
+  std::array<std::size_t, N> mPivots;
+  T mSign = T{1};
+  bool mSingular = false;
+};
+
+template<typename T, std::size_t N>
+Lu<T, N>::Lu(Matrix<T, N, N> const & mat) : mLu(mat) {
+  T * a = mLu.begin();
+  T scale = T{0};
+  for (auto const v : mat) {
+    scale = std::max(scale, std::abs(v));
+  }
+  T const tolerance = static_cast<T>(N) * std::numeric_limits<T>::epsilon() * scale;
+
+  for (std::size_t k = 0; k < N; ++k) {
+    T * const colK = a + N * k;
+    std::size_t pivot = k;
+    for (std::size_t i = k + 1; i < N; ++i) {
+      if (std::abs(colK[i]) > std::abs(colK[pivot])) {
+        pivot = i;
+      }
+    }
+    mPivots[k] = pivot;
+    if (!(std::abs(colK[pivot]) > tolerance)) {
+      mSingular = true;
+      return;
+    }
+    if (pivot != k) {
+      for (std::size_t j = 0; j < N; ++j) {
+        std::swap(a[k + N * j], a[pivot + N * j]);
+      }
+      mSign = -mSign;
+    }
+
+    T const inv = T{1} / colK[k];
+    for (std::size_t i = k + 1; i < N; ++i) {
+      colK[i] *= inv;
+    }
+    // rank one update of the trailing block, one contiguous column at a time
+    for (std::size_t j = k + 1; j < N; ++j) {
+      T * const colJ = a + N * j;
+      T const f = colJ[k];
+      if (f != T{0}) {
+        for (std::size_t i = k + 1; i < N; ++i) {
+          colJ[i] -= colK[i] * f;
+        }
+      }
+    }
+  }
+}
+
+template<typename T, std::size_t N>
+auto Lu<T, N>::det() const noexcept -> T {
+  if (mSingular) {
+    return T{0};
+  }
+  T ret = mSign;
+  for (std::size_t k = 0; k < N; ++k) {
+    ret *= mLu[k + N * k];
+  }
+  return ret;
+}
+
+template<typename T, std::size_t N>
+auto Lu<T, N>::substitute(T * const x) const noexcept -> void {
+  T const * a = mLu.begin();
+  for (std::size_t k = 0; k < N; ++k) {
+    std::swap(x[k], x[mPivots[k]]);
+  }
+  // forward with unit lower L
+  for (std::size_t k = 0; k < N; ++k) {
+    T const * const col = a + N * k;
+    T const xk = x[k];
+    for (std::size_t i = k + 1; i < N; ++i) {
+      x[i] -= col[i] * xk;
+    }
+  }
+  // back with U
+  for (std::size_t k = N; k-- > 0;) {
+    T const * const col = a + N * k;
+    x[k] /= col[k];
+    T const xk = x[k];
+    for (std::size_t i = 0; i < k; ++i) {
+      x[i] -= col[i] * xk;
+    }
+  }
+}
+
+template<typename T, std::size_t N>
+auto Lu<T, N>::trySolve(Vector<T, N> const & b, Vector<T, N> & x) const noexcept -> bool {
+  if (mSingular) {
+    return false;
+  }
+  std::array<T, N> tmp;
+  for (std::size_t i = 0; i < N; ++i) {
+    tmp[i] = b[i];
+  }
+  substitute(tmp.data());
+  for (std::size_t i = 0; i < N; ++i) {
+    x[i] = tmp[i];
+  }
+  return true;
+}
+
+template<typename T, std::size_t N>
+template<std::size_t M>
+auto Lu<T, N>::trySolve(Matrix<T, N, M> const & b, Matrix<T, N, M> & x) const noexcept -> bool {
+  if (mSingular) {
+    return false;
+  }
+  x = b;
+  for (std::size_t c = 0; c < M; ++c) {
+    substitute(x.begin() + N * c);
+  }
+  return true;
+}
+
+/**
+ * Return the determinant of the given matrix by LU decomposition.  The 2x2,
+ * 3x3 and 4x4 overloads in Matrix.hh are preferred for those sizes.
+ */
+template<typename T, std::size_t N>
+auto det(Matrix<T, N, N> const & mat) -> T {
+  return Lu<T, N>{mat}.det();
+}
+
+/**
+ * Calculate the inverse of a matrix outside 2x2 to 4x4 by LU decomposition
+ * without throwing.  Declared in Matrix.hh.
+ *
+ * @param mat the matrix to invert
+ * @param out set to the inverse of mat, left unchanged if there is none
+ * @return false if mat is singular
+ */
+template <typename T, std::size_t S, std::enable_if_t<(S < 2 || S > 4)> *>
+auto tryInverse(Matrix<T, S, S> const & mat, Matrix<T, S, S> & out) noexcept -> bool {
+  return Lu<T, S>{mat}.trySolve(Matrix<T, S, S>{}, out);
+}
+
+/**
+ * Solve mat * x = b without throwing
+ *
+ * @return false, leaving x unchanged, if mat is singular
+ */
+template<typename T, std::size_t N>
+auto trySolve(Matrix<T, N, N> const & mat, Vector<T, N> const & b, Vector<T, N> & x) noexcept -> bool {
+  return Lu<T, N>{mat}.trySolve(b, x);
+}
+
+/**
+ * Return x such that mat * x = b
+ *
+ * @throws SingularMatrixException if mat is singular
+ */
+template<typename T, std::size_t N>
+auto solve(Matrix<T, N, N> const & mat, Vector<T, N> const & b) -> Vector<T, N> {
+  Vector<T, N> ret;
+  if (!trySolve(mat, b, ret)) {
+    BOOST_THROW_EXCEPTION(core::SingularMatrixException() << core::ThrowMsg("Matrix is singular"));
+  }
+  return ret;
+}
+
+} // namespace math
+} // namespace cagey
+
+#endif /* CAGEY_MATH_LU_HH_ */
@@ -0,0 +1,351 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// cagey-engine - Toy 3D Engine
+// Copyright (c) 2014 Kyle Girard <theycallmecoach@gmail.com>
+//
+// The MIT License (MIT)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+
+/**
+ * @file
+ * Structure of arrays storage and batched operations for 4x4 matrices.
+ */
+
+#ifndef CAGEY_MATH_MAT4ARRAY_HH_
+#define CAGEY_MATH_MAT4ARRAY_HH_
+
+#include <cstddef>
+#include <array>
+#include <limits>
+#include <utility>
+#include <vector>
+
+#include "cagey/math/Matrix.hh"
+#include "cagey/math/Array3.hh"
+#include "cagey/math/Simd.hh"
+
+namespace cagey {
+namespace math {
+
+/**
+ * Stores 4x4 matrices as sixteen separate streams, one per column major
+ * element, so batched operations process a full register of matrices at a
+ * time.
+ *
+ * @tparam T the underlying type
+ */
+template<typename T>
+class Mat4Array {
+public:
+  /// The underlying type of this Mat4Array
+  using Type = T;
+
+  /// The type of a single element
+  using Element = Mat4<T>;
+
+  /// The number of streams
+  static constexpr std::size_t Streams = 16;
+
+  /**
+   * Construct an empty Mat4Array
+   */
+  Mat4Array() = default;
+
+  /**
+   * Construct a Mat4Array holding count zero matrices
+   *
+   * @param count the number of matrices
+   */
+  explicit Mat4Array(std::size_t const count) { resize(count); }
+
+  /**
+   * Construct a Mat4Array holding a copy of the given matrices
+   *
+   * @param vals the matrices to copy
+   */
+  explicit Mat4Array(std::vector<Element> const & vals) : Mat4Array(vals.size()) {
+    for (std::size_t i = 0; i < vals.size(); ++i) {
+      set(i, vals[i]);
+    }
+  }
+
+  /**
+   * Return the matrices of this Mat4Array as an array of structs
+   */
+  auto toVector() const -> std::vector<Element> {
+    std::vector<Element> ret;
+    ret.reserve(size());
+    for (std::size_t i = 0; i < size(); ++i) {
+      ret.push_back((*this)[i]);
+    }
+    return ret;
+  }
+
+  /**
+   * Return the number of matrices
+   */
+  auto size() const noexcept -> std::size_t { return mData[0].size(); }
+
+  /**
+   * Return true if this Mat4Array has no matrices
+   */
+  auto empty() const noexcept -> bool { return mData[0].empty(); }
+
+  /**
+   * Change the number of matrices, new matrices are zero
+   */
+  auto resize(std::size_t const count) -> void {
+    for (auto & stream : mData) {
+      stream.resize(count);
+    }
+  }
+
+  /**
+   * Reserve storage for count matrices
+   */
+  auto reserve(std::size_t const count) -> void {
+    for (auto & stream : mData) {
+      stream.reserve(count);
+    }
+  }
+
+  /**
+   * Remove all matrices
+   */
+  auto clear() noexcept -> void {
+    for (auto & stream : mData) {
+      stream.clear();
+    }
+  }
+
+  /**
+   * Append the given matrix
+   */
+  auto pushBack(Element const & val) -> void {
+    for (std::size_t k = 0; k < Streams; ++k) {
+      mData[k].push_back(val[k]);
+    }
+  }
+
+  /**
+   * Replace the matrix at index i
+   */
+  auto set(std::size_t const i, Element const & val) -> void {
+    for (std::size_t k = 0; k < Streams; ++k) {
+      mData[k][i] = val[k];
+    }
+  }
+
+  /**
+   * Index operator
+   *
+   * @param i index into this Mat4Array
+   * @return a copy of the matrix at index i
+   */
+  auto operator[](std::size_t const i) const -> Element {
+    Element ret;
+    for (std::size_t k = 0; k < Streams; ++k) {
+      ret[k] = mData[k][i];
+    }
+    return ret;
+  }
+
+  /// Return the stream holding element k, in column major order, of every matrix
+  auto stream(std::size_t const k) noexcept -> T * { return mData[k].data(); }
+  /// Return the stream holding element k, in column major order, of every matrix
+  auto stream(std::size_t const k) const noexcept -> T const * { return mData[k].data(); }
+
+  /**
+   * Swap streams k and j, transposing every matrix when applied to each
+   * pair of off diagonal elements
+   */
+  auto swapStreams(std::size_t const k, std::size_t const j) noexcept -> void { mData[k].swap(mData[j]); }
+
+private:
+  std::array<std::vector<T>, Streams> mData;
+};
+
+using Mat4fArray = Mat4Array<float>;
+using Mat4dArray = Mat4Array<double>;
+
+namespace detail {
+
+/**
+ * Cofactor determinant of a column major 4x4 matrix of scalars or Packs,
+ * the same expansion as det(Mat4)
+ */
+template<typename E>
+inline auto det4(E const * m) -> E {
+  return (m[0]*m[5] - m[1]*m[4]) * (m[10]*m[15] - m[11]*m[14]) -
+         (m[0]*m[6] - m[2]*m[4]) * (m[9]*m[15] - m[11]*m[13]) +
+         (m[0]*m[7] - m[3]*m[4]) * (m[9]*m[14] - m[10]*m[13]) +
+         (m[1]*m[6] - m[2]*m[5]) * (m[8]*m[15] - m[11]*m[12]) -
+         (m[1]*m[7] - m[3]*m[5]) * (m[8]*m[14] - m[10]*m[12]) +
+         (m[2]*m[7] - m[3]*m[6]) * (m[8]*m[13] - m[9]*m[12]);
+}
+
+/**
+ * Adjugate of a column major 4x4 matrix of scalars or Packs, the same
+ * expressions as adjugate(Mat4)
+ */
+template<typename E>
+inline auto adjugate4(E const * m, E * out) -> void {
+  E const i0 = m[0]*m[5] - m[1]*m[4];
+  E const i1 = m[0]*m[6] - m[2]*m[4];
+  E const i2 = m[0]*m[7] - m[3]*m[4];
+  E const i3 = m[1]*m[6] - m[2]*m[5];
+  E const i4 = m[1]*m[7] - m[3]*m[5];
+  E const i5 = m[2]*m[7] - m[3]*m[6];
+  E const j0 = m[8]*m[13] - m[9]*m[12];
+  E const j1 = m[8]*m[14] - m[10]*m[12];
+  E const j2 = m[8]*m[15] - m[11]*m[12];
+  E const j3 = m[9]*m[14] - m[10]*m[13];
+  E const j4 = m[9]*m[15] - m[11]*m[13];
+  E const j5 = m[10]*m[15] - m[11]*m[14];
+
+  out[0] = m[5] * j5 - m[6] * j4 + m[7] * j3;
+  out[1] = -m[1] * j5 + m[2] * j4 - m[3] * j3;
+  out[2] = m[13] * i5 - m[14] * i4 + m[15] * i3;
+  out[3] = -m[9] * i5 + m[10] * i4 - m[11] * i3;
+  out[4] = -m[4] * j5 + m[6] * j2 - m[7] * j1;
+  out[5] = m[0] * j5 - m[2] * j2 + m[3] * j1;
+  out[6] = -m[12] * i5 + m[14] * i2 - m[15] * i1;
+  out[7] = m[8] * i5 - m[10] * i2 + m[11] * i1;
+  out[8] = m[4] * j4 - m[5] * j2 + m[7] * j0;
+  out[9] = -m[0] * j4 + m[1] * j2 - m[3] * j0;
+  out[10] = m[12] * i4 - m[13] * i2 + m[15] * i0;
+  out[11] = -m[8] * i4 + m[9] * i2 - m[11] * i0;
+  out[12] = -m[4] * j3 + m[5] * j1 - m[6] * j0;
+  out[13] = m[0] * j3 - m[1] * j1 + m[2] * j0;
+  out[14] = -m[12] * i3 + m[13] * i1 - m[14] * i0;
+  out[15] = m[8] * i3 - m[9] * i1 + m[10] * i0;
+}
+
+/**
+ * Load the sixteen elements of the matrices starting at index i
+ */
+template<typename P, typename T>
+inline auto loadMat4(Mat4Array<T> const & mats, std::size_t const i, P * m) -> void {
+  for (std::size_t k = 0; k < 16; ++k) {
+    m[k] = P::load(mats.stream(k) + i);
+  }
+}
+
+} // namespace detail
+
+/**
+ * Calculate the determinant of every matrix
+ *
+ * @param mats the matrices
+ * @param out storage for mats.size() determinants
+ */
+template<typename T>
+auto det(Mat4Array<T> const & mats, T * out) -> void {
+  detail::forEachPack<T>(mats.size(), [&](auto p, std::size_t const i) {
+    using P = decltype(p);
+    P m[16];
+    detail::loadMat4(mats, i, m);
+    detail::det4(m).store(out + i);
+  });
+}
+
+/**
+ * Invert every matrix by the same cofactor method as tryInverse(Mat4).
+ * Matrices with a determinant smaller in magnitude than epsilon have no
+ * inverse and come out as all zeros.
+ *
+ * @param mats the matrices to invert
+ * @param out resized to hold the inverses, may be mats
+ * @return the number of singular matrices
+ */
+template<typename T>
+auto inverse(Mat4Array<T> const & mats, Mat4Array<T> & out) -> std::size_t {
+  out.resize(mats.size());
+  std::size_t singular = 0;
+  detail::forEachPack<T>(mats.size(), [&](auto p, std::size_t const i) {
+    using P = decltype(p);
+    P m[16];
+    detail::loadMat4(mats, i, m);
+    P adj[16];
+    detail::adjugate4(m, adj);
+    auto const d = detail::det4(m);
+    auto const small = max(d, -d) < P::broadcast(std::numeric_limits<T>::epsilon());
+    auto const inv = select(small, P::broadcast(T{0}), P::broadcast(T{1}) / d);
+    for (std::size_t k = 0; k < 16; ++k) {
+      (inv * adj[k]).store(out.stream(k) + i);
+    }
+    for (auto bits = P::bits(small); bits != 0; bits &= bits - 1) {
+      ++singular;
+    }
+  });
+  return singular;
+}
+
+/**
+ * Transpose every matrix.  Only the streams move, no element is touched.
+ *
+ * @param mats the matrices to transpose
+ * @param out set to the transposed matrices, may be mats
+ */
+template<typename T>
+auto transpose(Mat4Array<T> const & mats, Mat4Array<T> & out) -> void {
+  if (&mats != &out) {
+    out = mats;
+  }
+  for (std::size_t c = 0; c < 4; ++c) {
+    for (std::size_t r = c + 1; r < 4; ++r) {
+      out.swapStreams(r + 4 * c, c + 4 * r);
+    }
+  }
+}
+
+/**
+ * Multiply each pair of matrices, out[i] = lhs[i] * rhs[i]
+ *
+ * @param lhs an array of matrices
+ * @param rhs an array of matrices the same size as lhs
+ * @param out resized to hold the products, may be lhs or rhs
+ */
+template<typename T>
+auto multiply(Mat4Array<T> const & lhs, Mat4Array<T> const & rhs, Mat4Array<T> & out) -> void {
+  detail::checkSameSize(lhs.size(), rhs.size());
+  out.resize(lhs.size());
+  detail::forEachPack<T>(lhs.size(), [&](auto p, std::size_t const i) {
+    using P = decltype(p);
+    P a[16];
+    P b[16];
+    detail::loadMat4(lhs, i, a);
+    detail::loadMat4(rhs, i, b);
+    for (std::size_t c = 0; c < 4; ++c) {
+      for (std::size_t r = 0; r < 4; ++r) {
+        auto const sum = a[r] * b[4 * c] + a[r + 4] * b[4 * c + 1] + a[r + 8] * b[4 * c + 2] + a[r + 12] * b[4 * c + 3];
+        sum.store(out.stream(r + 4 * c) + i);
+      }
+    }
+  });
+}
+
+} // namespace math
+} // namespace cagey
+
+#endif /* CAGEY_MATH_MAT4ARRAY_HH_ */
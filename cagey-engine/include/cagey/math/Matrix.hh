@@ -38,9 +38,14 @@
 #include <algorithm>
 #include <utility>
 #include <iostream>
+#include <limits>
+#include <cmath>
+#include <cassert>
+#include <type_traits>
 
 
 #include "cagey/math/Vector.hh"
+#include "cagey/math/Simd.hh"
 #include "cagey/core/Exception.hh"
 
 namespace cagey {
@@ -68,7 +73,7 @@ template<typename T, std::size_t R, std::size_t C>
 class Matrix {
   /** @cond doxygen has an issue with static assert */
   static_assert(C*R > 0, "Cannot have a zero sized matrix");
-  static_assert(std::is_arithmetic<T>::value, "Underlying type must be a number");
+  static_assert(IsNumber<T>::value, "Underlying type must be a number");
   /** @endcond */
 
 
@@ -194,7 +199,7 @@ public:
 template<typename T>
 class Matrix<T, 2, 2> {
   /** @cond doxygen has an issue with static assert */  
-  static_assert(std::is_arithmetic<T>::value, "Underlying type must be a number");
+  static_assert(IsNumber<T>::value, "Underlying type must be a number");
   /** @endcond */
 
 public:
@@ -319,7 +324,7 @@ public:
 template<typename T>
 class Matrix<T, 3, 3> {
   /** @cond doxygen has an issue with static assert */  
-  static_assert(std::is_arithmetic<T>::value, "Underlying type must be a number");
+  static_assert(IsNumber<T>::value, "Underlying type must be a number");
   /** @endcond */
 
 public:
@@ -443,7 +448,7 @@ public:
  */template<typename T>
 class Matrix<T, 4, 4> {
   /** @cond doxygen has an issue with static assert */  
-  static_assert(std::is_arithmetic<T>::value, "Underlying type must be a number");
+  static_assert(IsNumber<T>::value, "Underlying type must be a number");
   /** @endcond */
 
 public:
@@ -579,7 +584,7 @@ namespace detail {
 template<typename T, std::size_t R, std::size_t C>
 constexpr int getElement(int pos)
 {
-    return (pos % R == pos / C); // 1 if row == col, 0 otherwise
+    return (pos % R == pos / R); // 1 if row == col, 0 otherwise
 }
 
 /**
@@ -587,7 +592,7 @@ constexpr int getElement(int pos)
  */
 template<typename T, std::size_t R, std::size_t C, std::size_t ...I>
 constexpr auto getElementArray(std::index_sequence<I...>) -> std::array<T, R*C> {
-  return std::array<T, R*C>{{getElement<T,R,C>(I)...}};
+  return std::array<T, R*C>{{static_cast<T>(getElement<T,R,C>(I))...}};
 }
 
 /**
@@ -790,7 +795,7 @@ constexpr auto Mat4<T>::operator[](std::size_t i) const -> T const & { return da
 
 
 template<typename T, std::size_t R, std::size_t C>
-constexpr auto Matrix<T, R, C>::operator()(std::size_t r, std::size_t c) -> T & { return data[r+(C*c)]; }
+constexpr auto Matrix<T, R, C>::operator()(std::size_t r, std::size_t c) -> T & { return data[r+(R*c)]; }
 
 template<typename T>
 constexpr auto Mat2<T>::operator()(std::size_t r, std::size_t c) -> T & { return data[r+(Cols*c)]; }
@@ -803,7 +808,7 @@ constexpr auto Mat4<T>::operator()(std::size_t r, std::size_t c) -> T & { return
 
 
 template<typename T, std::size_t R, std::size_t C>
-constexpr auto Matrix<T, R, C>::operator()(std::size_t r, std::size_t c) const -> T const & { return data[r+(C*c)]; }
+constexpr auto Matrix<T, R, C>::operator()(std::size_t r, std::size_t c) const -> T const & { return data[r+(R*c)]; }
 
 template<typename T>
 constexpr auto Mat2<T>::operator()(std::size_t r, std::size_t c) const -> T const & { return data[r+(Cols*c)]; }
@@ -845,12 +850,26 @@ auto operator-(Matrix<T, R, C> mat) -> Matrix<T, R, C> {
 }
 
 
+/**
+ * Divide each element of the given matrix by val unless val is zero.  A non
+ * throwing alternative to operator/= for bulk processing.
+ *
+ * @return false, leaving lhs unchanged, if val is zero
+ */
 template<typename T, std::size_t R, std::size_t C>
-auto operator/=(Matrix<T, R, C> & lhs, T const val) -> Matrix<T, R, C> & {
+auto tryDivide(Matrix<T, R, C> & lhs, T const val) noexcept -> bool {
   if (val == 0) {
-    BOOST_THROW_EXCEPTION(core::DivideByZeroException() << core::ThrowMsg("Attempting to divide Matrix by zero"));
+    return false;
   }
   std::for_each(lhs.begin(), lhs.end(), [val](T& v) {v/=val;});
+  return true;
+}
+
+template<typename T, std::size_t R, std::size_t C>
+auto operator/=(Matrix<T, R, C> & lhs, T const val) -> Matrix<T, R, C> & {
+  if (!tryDivide(lhs, val)) {
+    BOOST_THROW_EXCEPTION(core::DivideByZeroException() << core::ThrowMsg("Attempting to divide Matrix by zero"));
+  }
   return lhs;
 }
 
@@ -889,16 +908,275 @@ auto operator/(Matrix<T, R, C> lhs, T val) -> Matrix<T, R, C> {
   return lhs /= val;
 }
 
-template<typename T, std::size_t R1, std::size_t C1, std::size_t C2>
-auto operator*(Matrix<T, R1, C1> const & lhs, Matrix<T, R1, C2> const & rhs) -> bool {
-  Matrix<T, R1, C2> ret;
-  for (std::size_t i = 0; i < R1; ++i) {
-    for (std::size_t j = 0; j < C2; ++j) {
-      for (std::size_t k = 0; k < C1; ++k)  {
-        ret(i, j) += lhs(i, k) * rhs(k, j);
+namespace detail {
+
+/**
+ * Sum the arguments left to right
+ */
+template<typename T>
+constexpr auto sum(T const first) -> T {
+  return first;
+}
+
+template<typename T, typename... Ts>
+constexpr auto sum(T const first, T const second, Ts const... rest) -> T {
+  return sum(first + second, rest...);
+}
+
+/**
+ * Row r of lhs dotted with column c of rhs, unrolled over K
+ */
+template<typename T, std::size_t R, std::size_t N, std::size_t C, std::size_t... K>
+constexpr auto rowTimesColumn(Matrix<T, R, N> const & lhs, Matrix<T, N, C> const & rhs,
+                              std::size_t const r, std::size_t const c, std::index_sequence<K...>) -> T {
+  return sum((lhs.data[r + R * K] * rhs.data[K + N * c])...);
+}
+
+/**
+ * Every element of lhs * rhs, unrolled over the column major index I
+ */
+template<typename T, std::size_t R, std::size_t N, std::size_t C, std::size_t... I>
+constexpr auto multiply(Matrix<T, R, N> const & lhs, Matrix<T, N, C> const & rhs, std::index_sequence<I...>)
+    -> Matrix<T, R, C> {
+  return Matrix<T, R, C>{std::array<T, R * C>{{rowTimesColumn(lhs, rhs, I % R, I / R, std::make_index_sequence<N>())...}}};
+}
+
+/**
+ * Row r of mat dotted with vec, unrolled over K
+ */
+template<typename T, std::size_t R, std::size_t C, std::size_t... K>
+constexpr auto rowTimesVector(Matrix<T, R, C> const & mat, Vector<T, C> const & vec, std::size_t const r,
+                              std::index_sequence<K...>) -> T {
+  return sum((mat.data[r + R * K] * vec[K])...);
+}
+
+/**
+ * Every element of mat * vec, unrolled over the row index I
+ */
+template<typename T, std::size_t R, std::size_t C, std::size_t... I>
+constexpr auto multiply(Matrix<T, R, C> const & mat, Vector<T, C> const & vec, std::index_sequence<I...>)
+    -> Vector<T, R> {
+  return Vector<T, R>{std::array<T, R>{{rowTimesVector(mat, vec, I, std::make_index_sequence<C>())...}}};
+}
+
+/**
+ * The transpose of mat, unrolled over the column major index I of the result
+ */
+template<typename T, std::size_t R, std::size_t C, std::size_t... I>
+constexpr auto transpose(Matrix<T, R, C> const & mat, std::index_sequence<I...>) -> Matrix<T, C, R> {
+  return Matrix<T, C, R>{std::array<T, R * C>{{mat.data[I / C + R * (I % C)]...}}};
+}
+
+} // namespace detail
+
+/**
+ * Multiply two matrices.  Fully unrolled at compile time.
+ *
+ * @param lhs a matrix with R rows and N columns
+ * @param rhs a matrix with N rows and C columns
+ * @return the R by C product of lhs and rhs
+ */
+template<typename T, std::size_t R, std::size_t N, std::size_t C>
+constexpr auto operator*(Matrix<T, R, N> const & lhs, Matrix<T, N, C> const & rhs) -> Matrix<T, R, C> {
+  return detail::multiply(lhs, rhs, std::make_index_sequence<R * C>());
+}
+
+/**
+ * Transform a column vector by a matrix.  Fully unrolled at compile time.
+ *
+ * @param mat a matrix with R rows and C columns
+ * @param vec a column vector with C elements
+ * @return the R element product of mat and vec
+ */
+template<typename T, std::size_t R, std::size_t C>
+constexpr auto operator*(Matrix<T, R, C> const & mat, Vector<T, C> const & vec) -> Vector<T, R> {
+  return detail::multiply(mat, vec, std::make_index_sequence<R>());
+}
+
+namespace detail {
+
+/**
+ * Multiply two column major 4x4 matrices, out = lhs * rhs.
+ * Scalar fallback for types without a SIMD kernel.
+ */
+template<typename T>
+inline auto mul4x4(T const * lhs, T const * rhs, T * out) -> void {
+  for (std::size_t c = 0; c < 4; ++c) {
+    for (std::size_t r = 0; r < 4; ++r) {
+      T sum{0};
+      for (std::size_t k = 0; k < 4; ++k) {
+        sum += lhs[r + 4 * k] * rhs[k + 4 * c];
       }
+      out[r + 4 * c] = sum;
+    }
+  }
+}
+
+/**
+ * Multiply a column major 4x4 matrix with a 4 element column vector,
+ * out = mat * vec.  Scalar fallback for types without a SIMD kernel.
+ */
+template<typename T>
+inline auto mul4x1(T const * mat, T const * vec, T * out) -> void {
+  T const v[4] = {vec[0], vec[1], vec[2], vec[3]};
+  for (std::size_t r = 0; r < 4; ++r) {
+    T sum{0};
+    for (std::size_t k = 0; k < 4; ++k) {
+      sum += mat[r + 4 * k] * v[k];
+    }
+    out[r] = sum;
+  }
+}
+
+#if defined(CAGEY_SIMD_SSE2)
+
+/**
+ * SSE kernel. Each column of the result is a linear combination of the
+ * columns of lhs weighted by the matching column of rhs.  If Aligned is
+ * true all three pointers must be 16 byte aligned.
+ */
+template<bool Aligned>
+inline auto mul4x4Ps(float const * lhs, float const * rhs, float * out) -> void {
+  __m128 const c0 = loadPs<Aligned>(lhs);
+  __m128 const c1 = loadPs<Aligned>(lhs + 4);
+  __m128 const c2 = loadPs<Aligned>(lhs + 8);
+  __m128 const c3 = loadPs<Aligned>(lhs + 12);
+  for (std::size_t c = 0; c < 4; ++c) {
+    float const * col = rhs + 4 * c;
+    __m128 r = _mm_mul_ps(c0, _mm_set1_ps(col[0]));
+    r = _mm_add_ps(r, _mm_mul_ps(c1, _mm_set1_ps(col[1])));
+    r = _mm_add_ps(r, _mm_mul_ps(c2, _mm_set1_ps(col[2])));
+    r = _mm_add_ps(r, _mm_mul_ps(c3, _mm_set1_ps(col[3])));
+    storePs<Aligned>(out + 4 * c, r);
+  }
+}
+
+/**
+ * SSE kernel for matrix * vector.  If Aligned is true all three pointers
+ * must be 16 byte aligned.
+ */
+template<bool Aligned>
+inline auto mul4x1Ps(float const * mat, float const * vec, float * out) -> void {
+  __m128 r = _mm_mul_ps(loadPs<Aligned>(mat), _mm_set1_ps(vec[0]));
+  r = _mm_add_ps(r, _mm_mul_ps(loadPs<Aligned>(mat + 4), _mm_set1_ps(vec[1])));
+  r = _mm_add_ps(r, _mm_mul_ps(loadPs<Aligned>(mat + 8), _mm_set1_ps(vec[2])));
+  r = _mm_add_ps(r, _mm_mul_ps(loadPs<Aligned>(mat + 12), _mm_set1_ps(vec[3])));
+  storePs<Aligned>(out, r);
+}
+
+inline auto mul4x4(float const * lhs, float const * rhs, float * out) -> void {
+  mul4x4Ps<false>(lhs, rhs, out);
+}
+
+inline auto mul4x1(float const * mat, float const * vec, float * out) -> void {
+  mul4x1Ps<false>(mat, vec, out);
+}
+
+#if defined(CAGEY_SIMD_AVX)
+
+/**
+ * AVX kernel, a whole column of doubles per register
+ */
+inline auto mul4x4(double const * lhs, double const * rhs, double * out) -> void {
+  __m256d const c0 = _mm256_loadu_pd(lhs);
+  __m256d const c1 = _mm256_loadu_pd(lhs + 4);
+  __m256d const c2 = _mm256_loadu_pd(lhs + 8);
+  __m256d const c3 = _mm256_loadu_pd(lhs + 12);
+  for (std::size_t c = 0; c < 4; ++c) {
+    double const * col = rhs + 4 * c;
+    __m256d r = _mm256_mul_pd(c0, _mm256_broadcast_sd(col));
+    r = _mm256_add_pd(r, _mm256_mul_pd(c1, _mm256_broadcast_sd(col + 1)));
+    r = _mm256_add_pd(r, _mm256_mul_pd(c2, _mm256_broadcast_sd(col + 2)));
+    r = _mm256_add_pd(r, _mm256_mul_pd(c3, _mm256_broadcast_sd(col + 3)));
+    _mm256_storeu_pd(out + 4 * c, r);
+  }
+}
+
+/**
+ * AVX kernel for matrix * vector
+ */
+inline auto mul4x1(double const * mat, double const * vec, double * out) -> void {
+  __m256d r = _mm256_mul_pd(_mm256_loadu_pd(mat), _mm256_broadcast_sd(vec));
+  r = _mm256_add_pd(r, _mm256_mul_pd(_mm256_loadu_pd(mat + 4), _mm256_broadcast_sd(vec + 1)));
+  r = _mm256_add_pd(r, _mm256_mul_pd(_mm256_loadu_pd(mat + 8), _mm256_broadcast_sd(vec + 2)));
+  r = _mm256_add_pd(r, _mm256_mul_pd(_mm256_loadu_pd(mat + 12), _mm256_broadcast_sd(vec + 3)));
+  _mm256_storeu_pd(out, r);
+}
+
+#else
+
+/**
+ * SSE2 kernel, each column of doubles is split across two registers
+ */
+inline auto mul4x4(double const * lhs, double const * rhs, double * out) -> void {
+  __m128d lo[4];
+  __m128d hi[4];
+  for (std::size_t k = 0; k < 4; ++k) {
+    lo[k] = _mm_loadu_pd(lhs + 4 * k);
+    hi[k] = _mm_loadu_pd(lhs + 4 * k + 2);
+  }
+  for (std::size_t c = 0; c < 4; ++c) {
+    double const * col = rhs + 4 * c;
+    __m128d v = _mm_set1_pd(col[0]);
+    __m128d rlo = _mm_mul_pd(lo[0], v);
+    __m128d rhi = _mm_mul_pd(hi[0], v);
+    for (std::size_t k = 1; k < 4; ++k) {
+      v = _mm_set1_pd(col[k]);
+      rlo = _mm_add_pd(rlo, _mm_mul_pd(lo[k], v));
+      rhi = _mm_add_pd(rhi, _mm_mul_pd(hi[k], v));
     }
+    _mm_storeu_pd(out + 4 * c, rlo);
+    _mm_storeu_pd(out + 4 * c + 2, rhi);
   }
+}
+
+/**
+ * SSE2 kernel for matrix * vector
+ */
+inline auto mul4x1(double const * mat, double const * vec, double * out) -> void {
+  __m128d v = _mm_set1_pd(vec[0]);
+  __m128d rlo = _mm_mul_pd(_mm_loadu_pd(mat), v);
+  __m128d rhi = _mm_mul_pd(_mm_loadu_pd(mat + 2), v);
+  for (std::size_t k = 1; k < 4; ++k) {
+    v = _mm_set1_pd(vec[k]);
+    rlo = _mm_add_pd(rlo, _mm_mul_pd(_mm_loadu_pd(mat + 4 * k), v));
+    rhi = _mm_add_pd(rhi, _mm_mul_pd(_mm_loadu_pd(mat + 4 * k + 2), v));
+  }
+  _mm_storeu_pd(out, rlo);
+  _mm_storeu_pd(out + 2, rhi);
+}
+
+#endif // CAGEY_SIMD_AVX
+#endif // CAGEY_SIMD_SSE2
+
+} // namespace detail
+
+/**
+ * Multiply two 4x4 matrices.  Uses the SSE/AVX kernels for float and double
+ * when they are available.
+ *
+ * @param lhs a 4x4 matrix
+ * @param rhs a 4x4 matrix
+ * @return the product of lhs and rhs
+ */
+template<typename T>
+auto operator*(Mat4<T> const & lhs, Mat4<T> const & rhs) -> Mat4<T> {
+  Mat4<T> ret;
+  detail::mul4x4(lhs.begin(), rhs.begin(), ret.begin());
+  return ret;
+}
+
+/**
+ * Transform a column vector by a 4x4 matrix.
+ *
+ * @param lhs a 4x4 matrix
+ * @param rhs a column vector
+ * @return the product of lhs and rhs
+ */
+template<typename T>
+auto operator*(Mat4<T> const & lhs, Vec4<T> const & rhs) -> Vec4<T> {
+  Vec4<T> ret;
+  detail::mul4x1(lhs.begin(), rhs.begin(), ret.begin());
   return ret;
 }
 
@@ -960,10 +1238,10 @@ constexpr auto adjugate(Mat3<T> const & mat) -> Mat3<T> {
 }
 
 /**
- * Calculate the adjugate of the given matrix and return it in a Mat3
+ * Return the adjugate matrix of the given matrix
  */
 template <typename T>
-constexpr auto adjugate(Mat4<T> const & mat) -> Mat3<T> {
+constexpr auto adjugate(Mat4<T> const & mat) -> Mat4<T> {
   //Common co-factors
   T i0 = mat[0]*mat[5] - mat[1]*mat[4];
   T i1 = mat[0]*mat[6] - mat[2]*mat[4];
@@ -998,16 +1276,20 @@ constexpr auto adjugate(Mat4<T> const & mat) -> Mat3<T> {
   }}};
 }
 
+template<typename T, std::size_t N>
+class Lu;
 
 /**
- * Return a Matrix containing the inverse of the given matrix
+ * Calculate the inverse of the given matrix without throwing.  Batch callers
+ * can use this to skip degenerate matrices cheaply.  Other sizes are
+ * handled by LU decomposition in cagey/math/Lu.hh.
+ *
+ * @param mat the matrix to invert
+ * @param out set to the inverse of mat, left unchanged if there is none
+ * @return false if mat is singular
  */
-template <typename T, std::size_t S>
-constexpr auto inverse(Matrix<T, S, S> const & mat) -> Matrix<T, S, S> {
-  /** @cond */
-  static_assert(S==2 | S == 3 | S == 4, "Only matrices of 2,3 or 4 are supported");
-  /** @endcond */
-
+template <typename T, std::size_t S, std::enable_if_t<S == 2 || S == 3 || S == 4> * = nullptr>
+constexpr auto tryInverse(Matrix<T, S, S> const & mat, Matrix<T, S, S> & out) noexcept -> bool {
   // Using formula:
   //
   //            1
@@ -1018,23 +1300,347 @@ constexpr auto inverse(Matrix<T, S, S> const & mat) -> Matrix<T, S, S> {
 
   //if d is close enough to zero might as well treat it as 0
   if (std::abs(d) < std::numeric_limits<T>::epsilon()) {
-    throw BOOST_THROW_EXCEPTION(core::SingularMatrixException() << core::ThrowMsg("Matrix is not invertible"));
+    return false;
   }
-  return static_cast<T> (1.0 / d) * adjugate(mat);
+  out = static_cast<T> (1.0 / d) * adjugate(mat);
+  return true;
+}
+
+/**
+ * Calculate the inverse of a matrix outside 2x2 to 4x4 by LU decomposition
+ * without throwing.  Defined in cagey/math/Lu.hh.
+ */
+template <typename T, std::size_t S, std::enable_if_t<(S < 2 || S > 4)> * = nullptr>
+auto tryInverse(Matrix<T, S, S> const & mat, Matrix<T, S, S> & out) noexcept -> bool;
+
+/**
+ * Return a Matrix containing the inverse of the given matrix
+ *
+ * @throws SingularMatrixException if the matrix is not invertible
+ */
+template <typename T, std::size_t S>
+constexpr auto inverse(Matrix<T, S, S> const & mat) -> Matrix<T, S, S> {
+  /** @cond doxygen has some issues with static assert */
+  // Lu is incomplete, and sizeof an error, unless Lu.hh is included
+  static_assert(sizeof(std::conditional_t<S >= 2 && S <= 4, T, Lu<T, S>>) > 0,
+                "Include <cagey/math/Lu.hh> to invert matrices outside 2x2 to 4x4");
+  /** @endcond */
+  Matrix<T, S, S> ret;
+  if (!tryInverse(mat, ret)) {
+    BOOST_THROW_EXCEPTION(core::SingularMatrixException() << core::ThrowMsg("Matrix is not invertible"));
+  }
+  return ret;
+}
+
+/**
+ * Return true if the bottom row of the given matrix is (0, 0, 0, 1)
+ */
+template<typename T>
+auto isAffine(Mat4<T> const & mat, T const epsilon = std::numeric_limits<T>::epsilon()) -> bool {
+  using std::abs;
+  return abs(mat[3]) <= epsilon && abs(mat[7]) <= epsilon && abs(mat[11]) <= epsilon && abs(mat[15] - T{1}) <= epsilon;
+}
+
+/**
+ * Return true if the given matrix is affine and its upper 3x3 is orthonormal,
+ * i.e. it is a rotation and translation only.
+ */
+template<typename T>
+auto isRigid(Mat4<T> const & mat, T const epsilon = std::sqrt(std::numeric_limits<T>::epsilon())) -> bool {
+  using std::abs;
+  if (!isAffine(mat, epsilon)) {
+    return false;
+  }
+  for (std::size_t i = 0; i < 3; ++i) {
+    for (std::size_t j = i; j < 3; ++j) {
+      T const d = mat[4*i]*mat[4*j] + mat[4*i+1]*mat[4*j+1] + mat[4*i+2]*mat[4*j+2];
+      if (abs(d - (i == j ? T{1} : T{0})) > epsilon) {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+namespace detail {
+
+/**
+ * Invert the affine column major 4x4 matrix mat into out.  The rows of the
+ * inverse of the upper 3x3 are cross products of its columns, the
+ * translation is rotated back by the result.  Returns the determinant of
+ * the upper 3x3, out is meaningless if it is zero.  Scalar fallback for
+ * types without a SIMD kernel.
+ */
+template<typename T>
+inline auto inverseAffine4(T const * mat, T * out) -> T {
+  T const r[3][3] = {
+    {mat[5]*mat[10] - mat[6]*mat[9], mat[6]*mat[8] - mat[4]*mat[10], mat[4]*mat[9] - mat[5]*mat[8]},
+    {mat[9]*mat[2] - mat[10]*mat[1], mat[10]*mat[0] - mat[8]*mat[2], mat[8]*mat[1] - mat[9]*mat[0]},
+    {mat[1]*mat[6] - mat[2]*mat[5], mat[2]*mat[4] - mat[0]*mat[6], mat[0]*mat[5] - mat[1]*mat[4]}};
+  T const d = mat[0]*r[0][0] + mat[1]*r[0][1] + mat[2]*r[0][2];
+  T const invD = T{1} / d;
+  for (std::size_t i = 0; i < 3; ++i) {
+    for (std::size_t j = 0; j < 3; ++j) {
+      out[i + 4*j] = r[i][j] * invD;
+    }
+    out[4*i + 3] = T{0};
+  }
+  for (std::size_t i = 0; i < 3; ++i) {
+    out[12 + i] = -(out[i]*mat[12] + out[i + 4]*mat[13] + out[i + 8]*mat[14]);
+  }
+  out[15] = T{1};
+  return d;
+}
+
+/**
+ * Invert the rigid column major 4x4 matrix mat into out by transposing the
+ * upper 3x3 and rotating back the translation.  Scalar fallback for types
+ * without a SIMD kernel.
+ */
+template<typename T>
+inline auto inverseRigid4(T const * mat, T * out) -> void {
+  for (std::size_t i = 0; i < 3; ++i) {
+    for (std::size_t j = 0; j < 3; ++j) {
+      out[i + 4*j] = mat[j + 4*i];
+    }
+    out[4*i + 3] = T{0};
+  }
+  for (std::size_t i = 0; i < 3; ++i) {
+    out[12 + i] = -(mat[4*i]*mat[12] + mat[4*i + 1]*mat[13] + mat[4*i + 2]*mat[14]);
+  }
+  out[15] = T{1};
+}
+
+#if defined(CAGEY_SIMD_SSE2)
+
+/**
+ * Cross product of the xyz lanes of a and b, the w lane is a.w*b.w - a.w*b.w
+ */
+inline auto cross3(__m128 const a, __m128 const b) -> __m128 {
+  __m128 const aYzx = _mm_shuffle_ps(a, a, _MM_SHUFFLE(3, 0, 2, 1));
+  __m128 const bYzx = _mm_shuffle_ps(b, b, _MM_SHUFFLE(3, 0, 2, 1));
+  __m128 const c = _mm_sub_ps(_mm_mul_ps(a, bYzx), _mm_mul_ps(aYzx, b));
+  return _mm_shuffle_ps(c, c, _MM_SHUFFLE(3, 0, 2, 1));
+}
+
+/**
+ * Return (0, 0, 0, 1) - (c0 * t.x + c1 * t.y + c2 * t.z)
+ */
+inline auto invTranslation(__m128 const c0, __m128 const c1, __m128 const c2, __m128 const t) -> __m128 {
+  __m128 r = _mm_mul_ps(c0, _mm_shuffle_ps(t, t, _MM_SHUFFLE(0, 0, 0, 0)));
+  r = _mm_add_ps(r, _mm_mul_ps(c1, _mm_shuffle_ps(t, t, _MM_SHUFFLE(1, 1, 1, 1))));
+  r = _mm_add_ps(r, _mm_mul_ps(c2, _mm_shuffle_ps(t, t, _MM_SHUFFLE(2, 2, 2, 2))));
+  return _mm_sub_ps(_mm_set_ps(1.0f, 0.0f, 0.0f, 0.0f), r);
+}
+
+/**
+ * SSE kernel.  The three cross products are computed side by side, scaled
+ * by the reciprocal determinant and transposed into columns.
+ */
+inline auto inverseAffine4(float const * mat, float * out) -> float {
+  __m128 const xyz = _mm_castsi128_ps(_mm_set_epi32(0, -1, -1, -1));
+  __m128 const a0 = _mm_and_ps(_mm_loadu_ps(mat), xyz);
+  __m128 const a1 = _mm_and_ps(_mm_loadu_ps(mat + 4), xyz);
+  __m128 const a2 = _mm_and_ps(_mm_loadu_ps(mat + 8), xyz);
+
+  __m128 r0 = cross3(a1, a2);
+  __m128 r1 = cross3(a2, a0);
+  __m128 r2 = cross3(a0, a1);
+  __m128 r3 = _mm_setzero_ps();
+
+  __m128 d = _mm_mul_ps(a0, r0);
+  d = _mm_add_ps(d, _mm_shuffle_ps(d, d, _MM_SHUFFLE(2, 3, 0, 1)));
+  d = _mm_add_ps(d, _mm_shuffle_ps(d, d, _MM_SHUFFLE(1, 0, 3, 2)));
+  __m128 const invD = _mm_div_ps(_mm_set1_ps(1.0f), d);
+
+  r0 = _mm_mul_ps(r0, invD);
+  r1 = _mm_mul_ps(r1, invD);
+  r2 = _mm_mul_ps(r2, invD);
+  _MM_TRANSPOSE4_PS(r0, r1, r2, r3);
+
+  _mm_storeu_ps(out, r0);
+  _mm_storeu_ps(out + 4, r1);
+  _mm_storeu_ps(out + 8, r2);
+  _mm_storeu_ps(out + 12, invTranslation(r0, r1, r2, _mm_loadu_ps(mat + 12)));
+  return _mm_cvtss_f32(d);
+}
+
+/**
+ * SSE kernel.  Transposes the upper 3x3 in registers.
+ */
+inline auto inverseRigid4(float const * mat, float * out) -> void {
+  __m128 const xyz = _mm_castsi128_ps(_mm_set_epi32(0, -1, -1, -1));
+  __m128 c0 = _mm_and_ps(_mm_loadu_ps(mat), xyz);
+  __m128 c1 = _mm_and_ps(_mm_loadu_ps(mat + 4), xyz);
+  __m128 c2 = _mm_and_ps(_mm_loadu_ps(mat + 8), xyz);
+  __m128 c3 = _mm_setzero_ps();
+  _MM_TRANSPOSE4_PS(c0, c1, c2, c3);
+
+  _mm_storeu_ps(out, c0);
+  _mm_storeu_ps(out + 4, c1);
+  _mm_storeu_ps(out + 8, c2);
+  _mm_storeu_ps(out + 12, invTranslation(c0, c1, c2, _mm_loadu_ps(mat + 12)));
+}
+
+/**
+ * Three doubles held as xy and z0 halves of a column
+ */
+struct Column3d {
+  __m128d xy;
+  __m128d z;
+};
+
+inline auto loadColumn3(double const * p) -> Column3d {
+  return Column3d{_mm_loadu_pd(p), _mm_load_sd(p + 2)};
+}
+
+/**
+ * Cross product of two columns, the w lane of the result is zero
+ */
+inline auto cross3(Column3d const & a, Column3d const & b) -> Column3d {
+  __m128d const aYz = _mm_shuffle_pd(a.xy, a.z, 1);
+  __m128d const aZx = _mm_shuffle_pd(a.z, a.xy, 0);
+  __m128d const bYz = _mm_shuffle_pd(b.xy, b.z, 1);
+  __m128d const bZx = _mm_shuffle_pd(b.z, b.xy, 0);
+  __m128d const p = _mm_mul_pd(a.xy, _mm_shuffle_pd(b.xy, b.xy, 1));
+  return Column3d{_mm_sub_pd(_mm_mul_pd(aYz, bZx), _mm_mul_pd(aZx, bYz)),
+                  _mm_move_sd(_mm_setzero_pd(), _mm_sub_sd(p, _mm_unpackhi_pd(p, p)))};
+}
+
+/**
+ * Store (0, 0, 0, 1) - (c0 * t.x + c1 * t.y + c2 * t.z) at out
+ */
+inline auto storeInvTranslation(Column3d const & c0, Column3d const & c1, Column3d const & c2,
+                                double const * t, double * out) -> void {
+  __m128d const tx = _mm_set1_pd(t[0]);
+  __m128d const ty = _mm_set1_pd(t[1]);
+  __m128d const tz = _mm_set1_pd(t[2]);
+  __m128d const xy = _mm_add_pd(_mm_add_pd(_mm_mul_pd(c0.xy, tx), _mm_mul_pd(c1.xy, ty)), _mm_mul_pd(c2.xy, tz));
+  __m128d const zw = _mm_add_pd(_mm_add_pd(_mm_mul_pd(c0.z, tx), _mm_mul_pd(c1.z, ty)), _mm_mul_pd(c2.z, tz));
+  _mm_storeu_pd(out, _mm_sub_pd(_mm_setzero_pd(), xy));
+  _mm_storeu_pd(out + 2, _mm_sub_pd(_mm_set_pd(1.0, 0.0), zw));
+}
+
+/**
+ * Transpose the rows r0, r1 and r2 into the upper 3x3 of out and return
+ * the columns
+ */
+inline auto storeTranspose3(Column3d const & r0, Column3d const & r1, Column3d const & r2, double * out)
+    -> std::array<Column3d, 3> {
+  __m128d const zero = _mm_setzero_pd();
+  std::array<Column3d, 3> const c{{
+    Column3d{_mm_unpacklo_pd(r0.xy, r1.xy), _mm_unpacklo_pd(r2.xy, zero)},
+    Column3d{_mm_unpackhi_pd(r0.xy, r1.xy), _mm_unpackhi_pd(r2.xy, zero)},
+    Column3d{_mm_unpacklo_pd(r0.z, r1.z), _mm_unpacklo_pd(r2.z, zero)}}};
+  for (std::size_t i = 0; i < 3; ++i) {
+    _mm_storeu_pd(out + 4*i, c[i].xy);
+    _mm_storeu_pd(out + 4*i + 2, c[i].z);
+  }
+  return c;
+}
+
+/**
+ * SSE2 kernel for doubles, also used by AVX builds as AVX lacks the cross
+ * lane shuffles a cross product of 256 bit columns needs.  Each column is
+ * split into xy and z0 halves.
+ */
+inline auto inverseAffine4(double const * mat, double * out) -> double {
+  Column3d const a0 = loadColumn3(mat);
+  Column3d const a1 = loadColumn3(mat + 4);
+  Column3d const a2 = loadColumn3(mat + 8);
+  Column3d r0 = cross3(a1, a2);
+  Column3d r1 = cross3(a2, a0);
+  Column3d r2 = cross3(a0, a1);
+
+  __m128d d = _mm_add_pd(_mm_mul_pd(a0.xy, r0.xy), _mm_mul_pd(a0.z, r0.z));
+  d = _mm_add_sd(d, _mm_unpackhi_pd(d, d));
+  __m128d const invD = _mm_div_pd(_mm_set1_pd(1.0), _mm_unpacklo_pd(d, d));
+  r0 = Column3d{_mm_mul_pd(r0.xy, invD), _mm_mul_pd(r0.z, invD)};
+  r1 = Column3d{_mm_mul_pd(r1.xy, invD), _mm_mul_pd(r1.z, invD)};
+  r2 = Column3d{_mm_mul_pd(r2.xy, invD), _mm_mul_pd(r2.z, invD)};
+
+  auto const c = storeTranspose3(r0, r1, r2, out);
+  storeInvTranslation(c[0], c[1], c[2], mat + 12, out + 12);
+  return _mm_cvtsd_f64(d);
+}
+
+/**
+ * SSE2 kernel for doubles, transposes the upper 3x3 with unpacks
+ */
+inline auto inverseRigid4(double const * mat, double * out) -> void {
+  auto const c = storeTranspose3(loadColumn3(mat), loadColumn3(mat + 4), loadColumn3(mat + 8), out);
+  storeInvTranslation(c[0], c[1], c[2], mat + 12, out + 12);
+}
+
+#endif // CAGEY_SIMD_SSE2
+
+} // namespace detail
+
+/**
+ * Calculate the inverse of an affine transform, one whose bottom row is
+ * (0, 0, 0, 1), without throwing.  Only the upper 3x3 is inverted so this
+ * is considerably cheaper than tryInverse().  The bottom row of mat is
+ * never read and that of the result is (0, 0, 0, 1), so a projective mat
+ * gives the inverse of its affine part; check with isAffine() first if the
+ * input is not known to be affine.
+ *
+ * @param mat the matrix to invert
+ * @param out set to the inverse of mat, left unchanged if there is none
+ * @return false if the upper 3x3 of mat is singular
+ */
+template<typename T>
+auto tryInverseAffine(Mat4<T> const & mat, Mat4<T> & out) noexcept -> bool {
+  /** @cond */
+  static_assert(std::is_floating_point<T>::value, "inverseAffine requires a floating point Matrix");
+  /** @endcond */
+  Mat4<T> ret;
+  T const d = detail::inverseAffine4(mat.begin(), ret.begin());
+  if (std::abs(d) < std::numeric_limits<T>::epsilon()) {
+    return false;
+  }
+  out = ret;
+  return true;
+}
+
+/**
+ * Return the inverse of an affine transform, one whose bottom row is
+ * (0, 0, 0, 1).  Only the upper 3x3 is inverted so this is considerably
+ * cheaper than inverse().  The bottom row is ignored as in
+ * tryInverseAffine().
+ *
+ * @throws SingularMatrixException if the upper 3x3 is not invertible
+ */
+template<typename T>
+auto inverseAffine(Mat4<T> const & mat) -> Mat4<T> {
+  Mat4<T> ret;
+  if (!tryInverseAffine(mat, ret)) {
+    BOOST_THROW_EXCEPTION(core::SingularMatrixException() << core::ThrowMsg("Matrix is not invertible"));
+  }
+  return ret;
+}
+
+/**
+ * Return the inverse of a rigid transform, a rotation followed by a
+ * translation.  The rotation is simply transposed.  Debug builds assert
+ * that the input is rigid.
+ */
+template<typename T>
+auto inverseRigid(Mat4<T> const & mat) -> Mat4<T> {
+  /** @cond */
+  static_assert(std::is_floating_point<T>::value, "inverseRigid requires a floating point Matrix");
+  /** @endcond */
+  assert(isRigid(mat) && "inverseRigid requires a rotation and translation only Matrix");
+  Mat4<T> ret;
+  detail::inverseRigid4(mat.begin(), ret.begin());
+  return ret;
 }
 
 /** 
  * Return a transposed copy of the given Matrix
  */
 template <typename T, std::size_t R, std::size_t C>
-auto transpose(Matrix<T, R, C> const & mat) -> Matrix<T, C, R> {
-  Matrix<T, C, R> ret;
-  for (std::size_t r = 0; r < C; ++r) {
-    for (std::size_t c = 0; c < R; ++ c) {
-      ret(r, c) = mat(c,r);
-    }
-  }
-  return mat;
+constexpr auto transpose(Matrix<T, R, C> const & mat) -> Matrix<T, C, R> {
+  return detail::transpose(mat, std::make_index_sequence<R * C>());
 }
 
 /**
@@ -1142,7 +1748,7 @@ auto makeScale(T const x, T const y, T const z) -> Mat4<T> {
  */
 template<typename T>
 auto makeScale(Vec3<T> const & vec) -> Mat4<T>{
-  return makeTranslation(vec.x, vec.y, vec.z);
+  return makeScale(vec.x, vec.y, vec.z);
 }
 
 
@@ -0,0 +1,216 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// cagey-engine - Toy 3D Engine
+// Copyright (c) 2014 Kyle Girard <theycallmecoach@gmail.com>
+//
+// The MIT License (MIT)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+
+/**
+ * @file
+ * Morton (Z-order) codes for Point2u and Point3u.
+ *
+ * Only BMI2 accelerates these: with it each code is a single pdep or
+ * pext, without it the bit masks below, and the array functions are plain
+ * loops over either.  pdep and pext are microcoded and far slower than
+ * the masks on AMD CPUs before Zen 3, so only enable BMI2 for Intel or
+ * Zen 3 and later targets.
+ */
+
+#ifndef CAGEY_MATH_MORTON_HH_
+#define CAGEY_MATH_MORTON_HH_
+
+#include <cstddef>
+#include <cstdint>
+
+#include "cagey/math/Point.hh"
+#include "cagey/math/Simd.hh"
+
+namespace cagey {
+namespace math {
+
+namespace detail {
+
+/// Bit i of the input lands on bit 2i of the result
+inline auto spreadBits2(std::uint64_t x) noexcept -> std::uint64_t {
+  x &= 0xffffffffull;
+  x = (x | (x << 16)) & 0x0000ffff0000ffffull;
+  x = (x | (x << 8)) & 0x00ff00ff00ff00ffull;
+  x = (x | (x << 4)) & 0x0f0f0f0f0f0f0f0full;
+  x = (x | (x << 2)) & 0x3333333333333333ull;
+  x = (x | (x << 1)) & 0x5555555555555555ull;
+  return x;
+}
+
+/// Inverse of spreadBits2
+inline auto compactBits2(std::uint64_t x) noexcept -> std::uint64_t {
+  x &= 0x5555555555555555ull;
+  x = (x | (x >> 1)) & 0x3333333333333333ull;
+  x = (x | (x >> 2)) & 0x0f0f0f0f0f0f0f0full;
+  x = (x | (x >> 4)) & 0x00ff00ff00ff00ffull;
+  x = (x | (x >> 8)) & 0x0000ffff0000ffffull;
+  x = (x | (x >> 16)) & 0x00000000ffffffffull;
+  return x;
+}
+
+/// Bit i of the low 21 bits of the input lands on bit 3i of the result
+inline auto spreadBits3(std::uint64_t x) noexcept -> std::uint64_t {
+  x &= 0x1fffffull;
+  x = (x | (x << 32)) & 0x001f00000000ffffull;
+  x = (x | (x << 16)) & 0x001f0000ff0000ffull;
+  x = (x | (x << 8)) & 0x100f00f00f00f00full;
+  x = (x | (x << 4)) & 0x10c30c30c30c30c3ull;
+  x = (x | (x << 2)) & 0x1249249249249249ull;
+  return x;
+}
+
+/// Inverse of spreadBits3
+inline auto compactBits3(std::uint64_t x) noexcept -> std::uint64_t {
+  x &= 0x1249249249249249ull;
+  x = (x | (x >> 2)) & 0x10c30c30c30c30c3ull;
+  x = (x | (x >> 4)) & 0x100f00f00f00f00full;
+  x = (x | (x >> 8)) & 0x001f0000ff0000ffull;
+  x = (x | (x >> 16)) & 0x001f00000000ffffull;
+  x = (x | (x >> 32)) & 0x00000000001fffffull;
+  return x;
+}
+
+#if defined(CAGEY_SIMD_BMI2)
+
+// pdep and pext do the spread and compact in a single instruction
+
+inline auto interleave2(std::uint32_t const x, std::uint32_t const y) noexcept -> std::uint64_t {
+  return _pdep_u64(x, 0x5555555555555555ull) | _pdep_u64(y, 0xaaaaaaaaaaaaaaaaull);
+}
+
+inline auto interleave3(std::uint32_t const x, std::uint32_t const y, std::uint32_t const z) noexcept -> std::uint64_t {
+  return _pdep_u64(x, 0x1249249249249249ull) | _pdep_u64(y, 0x2492492492492492ull) | _pdep_u64(z, 0x4924924924924924ull);
+}
+
+inline auto deinterleave2(std::uint64_t const code) noexcept -> Point2u {
+  return Point2u{static_cast<std::uint32_t>(_pext_u64(code, 0x5555555555555555ull)),
+                 static_cast<std::uint32_t>(_pext_u64(code, 0xaaaaaaaaaaaaaaaaull))};
+}
+
+inline auto deinterleave3(std::uint64_t const code) noexcept -> Point3u {
+  return Point3u{static_cast<std::uint32_t>(_pext_u64(code, 0x1249249249249249ull)),
+                 static_cast<std::uint32_t>(_pext_u64(code, 0x2492492492492492ull)),
+                 static_cast<std::uint32_t>(_pext_u64(code, 0x4924924924924924ull))};
+}
+
+#else
+
+inline auto interleave2(std::uint32_t const x, std::uint32_t const y) noexcept -> std::uint64_t {
+  return spreadBits2(x) | (spreadBits2(y) << 1);
+}
+
+inline auto interleave3(std::uint32_t const x, std::uint32_t const y, std::uint32_t const z) noexcept -> std::uint64_t {
+  return spreadBits3(x) | (spreadBits3(y) << 1) | (spreadBits3(z) << 2);
+}
+
+inline auto deinterleave2(std::uint64_t const code) noexcept -> Point2u {
+  return Point2u{static_cast<std::uint32_t>(compactBits2(code)), static_cast<std::uint32_t>(compactBits2(code >> 1))};
+}
+
+inline auto deinterleave3(std::uint64_t const code) noexcept -> Point3u {
+  return Point3u{static_cast<std::uint32_t>(compactBits3(code)),
+                 static_cast<std::uint32_t>(compactBits3(code >> 1)),
+                 static_cast<std::uint32_t>(compactBits3(code >> 2))};
+}
+
+#endif // CAGEY_SIMD_BMI2
+
+} // namespace detail
+
+/**
+ * Return the Morton code of a 2D point, the bits of x and y interleaved
+ * with x in the lowest bit
+ */
+inline auto encodeMorton2(Point2u const & pt) noexcept -> std::uint64_t {
+  return detail::interleave2(pt.x, pt.y);
+}
+
+/**
+ * Return the Morton code of a 3D point.  Only the low 21 bits of each
+ * coordinate are kept.
+ */
+inline auto encodeMorton3(Point3u const & pt) noexcept -> std::uint64_t {
+  return detail::interleave3(pt.x & 0x1fffffu, pt.y & 0x1fffffu, pt.z & 0x1fffffu);
+}
+
+/**
+ * Return the 2D point with the given Morton code
+ */
+inline auto decodeMorton2(std::uint64_t const code) noexcept -> Point2u {
+  return detail::deinterleave2(code);
+}
+
+/**
+ * Return the 3D point with the given Morton code, bit 63 is ignored
+ */
+inline auto decodeMorton3(std::uint64_t const code) noexcept -> Point3u {
+  return detail::deinterleave3(code);
+}
+
+/**
+ * Calculate the Morton codes of an array of points
+ *
+ * @param in pointer to count points
+ * @param out storage for count codes
+ * @param count the number of points
+ */
+inline auto encodeMorton2(Point2u const * in, std::uint64_t * out, std::size_t const count) noexcept -> void {
+  for (std::size_t i = 0; i < count; ++i) {
+    out[i] = detail::interleave2(in[i].x, in[i].y);
+  }
+}
+
+inline auto encodeMorton3(Point3u const * in, std::uint64_t * out, std::size_t const count) noexcept -> void {
+  for (std::size_t i = 0; i < count; ++i) {
+    out[i] = detail::interleave3(in[i].x & 0x1fffffu, in[i].y & 0x1fffffu, in[i].z & 0x1fffffu);
+  }
+}
+
+/**
+ * Decode an array of Morton codes
+ *
+ * @param in pointer to count codes
+ * @param out storage for count points
+ * @param count the number of codes
+ */
+inline auto decodeMorton2(std::uint64_t const * in, Point2u * out, std::size_t const count) noexcept -> void {
+  for (std::size_t i = 0; i < count; ++i) {
+    out[i] = detail::deinterleave2(in[i]);
+  }
+}
+
+inline auto decodeMorton3(std::uint64_t const * in, Point3u * out, std::size_t const count) noexcept -> void {
+  for (std::size_t i = 0; i < count; ++i) {
+    out[i] = detail::deinterleave3(in[i]);
+  }
+}
+
+} // namespace math
+} // namespace cagey
+
+#endif /* CAGEY_MATH_MORTON_HH_ */
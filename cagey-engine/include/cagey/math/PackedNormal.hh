@@ -0,0 +1,371 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// cagey-engine - Toy 3D Engine
+// Copyright (c) 2014 Kyle Girard <theycallmecoach@gmail.com>
+//
+// The MIT License (MIT)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+
+/**
+ * @file
+ * Compact encodings of unit vectors for normals and tangents.
+ *
+ * Maximum angle between a unit vector and its decoded encoding:
+ *   - octahedral 32 bit (two 16 bit snorm)  0.005 degrees
+ *   - octahedral 16 bit (two 8 bit snorm)   1 degree
+ *   - 10:10:10:2 snorm                      0.11 degrees
+ */
+
+#ifndef CAGEY_MATH_PACKEDNORMAL_HH_
+#define CAGEY_MATH_PACKEDNORMAL_HH_
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+#include "cagey/math/Vector.hh"
+#include "cagey/math/Simd.hh"
+
+namespace cagey {
+namespace math {
+
+namespace detail {
+
+template<typename P>
+inline auto absPack(P const x) -> P { return max(x, -x); }
+
+/**
+ * -1 for negative values, 1 otherwise
+ */
+template<typename P>
+inline auto signNotZero(P const x) -> P {
+  using T = typename P::Type;
+  return select(x < P::broadcast(T{0}), P::broadcast(T{-1}), P::broadcast(T{1}));
+}
+
+/**
+ * Map a unit vector onto the octahedron and unfold it into the square
+ * [-1, 1]^2
+ */
+template<typename P>
+inline auto octEncode(P const x, P const y, P const z, P & u, P & v) -> void {
+  using T = typename P::Type;
+  P const inv = P::broadcast(T{1}) / (absPack(x) + absPack(y) + absPack(z));
+  P const px = x * inv;
+  P const py = y * inv;
+  auto const lower = z < P::broadcast(T{0});
+  u = select(lower, (P::broadcast(T{1}) - absPack(py)) * signNotZero(px), px);
+  v = select(lower, (P::broadcast(T{1}) - absPack(px)) * signNotZero(py), py);
+}
+
+/**
+ * Inverse of octEncode, the result is normalized
+ */
+template<typename P>
+inline auto octDecode(P const u, P const v, P & x, P & y, P & z) -> void {
+  using T = typename P::Type;
+  P const zero = P::broadcast(T{0});
+  z = P::broadcast(T{1}) - absPack(u) - absPack(v);
+  P const t = max(-z, zero);
+  x = u - t * signNotZero(u);
+  y = v - t * signNotZero(v);
+  P const inv = P::broadcast(T{1}) / sqrt(x * x + y * y + z * z);
+  x = x * inv;
+  y = y * inv;
+  z = z * inv;
+}
+
+/**
+ * Scale a value in [-1, 1] to the nearest integer in [-Max, Max]
+ */
+template<typename P>
+inline auto quantizeSnorm(P const val, typename P::Type const maxVal) -> P {
+  using T = typename P::Type;
+  P const clamped = min(max(val, P::broadcast(T{-1})), P::broadcast(T{1}));
+  return round(clamped * P::broadcast(maxVal));
+}
+
+/**
+ * Return the low Bits bits of the two's complement of an integral value
+ */
+template<unsigned Bits, typename T>
+inline auto packSnorm(T const val) -> std::uint32_t {
+  return static_cast<std::uint32_t>(static_cast<std::int32_t>(val)) & ((1u << Bits) - 1u);
+}
+
+/**
+ * Sign extend the Bits bits of packed starting at bit Shift
+ */
+template<unsigned Bits, unsigned Shift, typename T>
+inline auto unpackSnorm(std::uint32_t const packed) -> T {
+  return static_cast<T>(static_cast<std::int32_t>(packed << (32 - Bits - Shift)) >> (32 - Bits));
+}
+
+/// Largest magnitude of a Bits wide snorm
+template<unsigned Bits>
+struct SnormMax : std::integral_constant<std::int32_t, (1 << (Bits - 1)) - 1> {};
+
+/**
+ * Bulk kernels.  W interleaved inputs are split into streams on the stack,
+ * the math runs a register at a time and the bits are packed one lane at a
+ * time.  The single vector functions call these with a count of one so
+ * both paths produce identical bits.
+ */
+template<unsigned Bits, typename Packed, typename T>
+inline auto encodeOct(Vec3<T> const * in, Packed * out, std::size_t const count) -> void {
+  constexpr T Max = T(SnormMax<Bits>::value);
+  forEachPack<T>(count, [&](auto p, std::size_t const i) {
+    using P = decltype(p);
+    constexpr std::size_t W = P::Width;
+    T xs[W], ys[W], zs[W];
+    for (std::size_t k = 0; k < W; ++k) {
+      xs[k] = in[i + k].x;
+      ys[k] = in[i + k].y;
+      zs[k] = in[i + k].z;
+    }
+    P u;
+    P v;
+    octEncode(P::load(xs), P::load(ys), P::load(zs), u, v);
+    T us[W], vs[W];
+    quantizeSnorm(u, Max).store(us);
+    quantizeSnorm(v, Max).store(vs);
+    for (std::size_t k = 0; k < W; ++k) {
+      out[i + k] = static_cast<Packed>(packSnorm<Bits>(us[k]) | (packSnorm<Bits>(vs[k]) << Bits));
+    }
+  });
+}
+
+template<unsigned Bits, typename Packed, typename T>
+inline auto decodeOct(Packed const * in, Vec3<T> * out, std::size_t const count) -> void {
+  constexpr T Inv = T{1} / T(SnormMax<Bits>::value);
+  forEachPack<T>(count, [&](auto p, std::size_t const i) {
+    using P = decltype(p);
+    constexpr std::size_t W = P::Width;
+    T us[W], vs[W];
+    for (std::size_t k = 0; k < W; ++k) {
+      us[k] = unpackSnorm<Bits, 0, T>(in[i + k]);
+      vs[k] = unpackSnorm<Bits, Bits, T>(in[i + k]);
+    }
+    // -Max - 1 is a valid bit pattern, clamp it back onto the square
+    P const lo = P::broadcast(T{-1});
+    P x;
+    P y;
+    P z;
+    octDecode(max(P::load(us) * P::broadcast(Inv), lo), max(P::load(vs) * P::broadcast(Inv), lo), x, y, z);
+    T xs[W], ys[W], zs[W];
+    x.store(xs);
+    y.store(ys);
+    z.store(zs);
+    for (std::size_t k = 0; k < W; ++k) {
+      out[i + k] = Vec3<T>{xs[k], ys[k], zs[k]};
+    }
+  });
+}
+
+template<typename T>
+inline auto encode1010102(Vec3<T> const * in, T const * w, std::uint32_t * out, std::size_t const count) -> void {
+  constexpr T Max = T(SnormMax<10>::value);
+  forEachPack<T>(count, [&](auto p, std::size_t const i) {
+    using P = decltype(p);
+    constexpr std::size_t W = P::Width;
+    T xs[W], ys[W], zs[W], ws[W];
+    for (std::size_t k = 0; k < W; ++k) {
+      xs[k] = in[i + k].x;
+      ys[k] = in[i + k].y;
+      zs[k] = in[i + k].z;
+      ws[k] = w ? w[i + k] : T{1};
+    }
+    quantizeSnorm(P::load(xs), Max).store(xs);
+    quantizeSnorm(P::load(ys), Max).store(ys);
+    quantizeSnorm(P::load(zs), Max).store(zs);
+    quantizeSnorm(P::load(ws), T{1}).store(ws);
+    for (std::size_t k = 0; k < W; ++k) {
+      out[i + k] = packSnorm<10>(xs[k]) | (packSnorm<10>(ys[k]) << 10) | (packSnorm<10>(zs[k]) << 20) | (packSnorm<2>(ws[k]) << 30);
+    }
+  });
+}
+
+template<typename T>
+inline auto decode1010102(std::uint32_t const * in, Vec3<T> * out, T * w, std::size_t const count) -> void {
+  forEachPack<T>(count, [&](auto p, std::size_t const i) {
+    using P = decltype(p);
+    constexpr std::size_t W = P::Width;
+    T xs[W], ys[W], zs[W];
+    for (std::size_t k = 0; k < W; ++k) {
+      xs[k] = unpackSnorm<10, 0, T>(in[i + k]);
+      ys[k] = unpackSnorm<10, 10, T>(in[i + k]);
+      zs[k] = unpackSnorm<10, 20, T>(in[i + k]);
+    }
+    P const x = P::load(xs);
+    P const y = P::load(ys);
+    P const z = P::load(zs);
+    // normalizing removes the 1 / Max scale too
+    P const inv = P::broadcast(T{1}) / sqrt(x * x + y * y + z * z);
+    (x * inv).store(xs);
+    (y * inv).store(ys);
+    (z * inv).store(zs);
+    for (std::size_t k = 0; k < W; ++k) {
+      out[i + k] = Vec3<T>{xs[k], ys[k], zs[k]};
+      if (w) {
+        w[i + k] = std::max(unpackSnorm<2, 30, T>(in[i + k]), T{-1});
+      }
+    }
+  });
+}
+
+} // namespace detail
+
+/**
+ * Encode a unit vector as two 16 bit octahedral coordinates
+ */
+template<typename T>
+auto encodeOct32(Vec3<T> const & vec) -> std::uint32_t {
+  std::uint32_t ret;
+  detail::encodeOct<16>(&vec, &ret, 1);
+  return ret;
+}
+
+/**
+ * Decode a vector packed by encodeOct32, the result has unit length
+ */
+template<typename T = float>
+auto decodeOct32(std::uint32_t const packed) -> Vec3<T> {
+  Vec3<T> ret;
+  detail::decodeOct<16>(&packed, &ret, 1);
+  return ret;
+}
+
+/**
+ * Encode a unit vector as two 8 bit octahedral coordinates
+ */
+template<typename T>
+auto encodeOct16(Vec3<T> const & vec) -> std::uint16_t {
+  std::uint16_t ret;
+  detail::encodeOct<8>(&vec, &ret, 1);
+  return ret;
+}
+
+/**
+ * Decode a vector packed by encodeOct16, the result has unit length
+ */
+template<typename T = float>
+auto decodeOct16(std::uint16_t const packed) -> Vec3<T> {
+  Vec3<T> ret;
+  detail::decodeOct<8>(&packed, &ret, 1);
+  return ret;
+}
+
+/**
+ * Encode a unit vector as three 10 bit snorm values and w, the tangent
+ * handedness, as a 2 bit snorm
+ *
+ * @param vec the vector to encode
+ * @param w -1 or 1
+ */
+template<typename T>
+auto encode1010102(Vec3<T> const & vec, T const w = T{1}) -> std::uint32_t {
+  std::uint32_t ret;
+  detail::encode1010102(&vec, &w, &ret, 1);
+  return ret;
+}
+
+/**
+ * Decode a vector packed by encode1010102, the result has unit length
+ *
+ * @param packed the encoded vector
+ * @param w if not null set to the decoded handedness
+ */
+template<typename T = float>
+auto decode1010102(std::uint32_t const packed, T * w = nullptr) -> Vec3<T> {
+  Vec3<T> ret;
+  detail::decode1010102(&packed, &ret, w, 1);
+  return ret;
+}
+
+/**
+ * Encode an array of unit vectors with encodeOct32
+ *
+ * @param in pointer to count unit vectors
+ * @param out storage for count encoded vectors
+ * @param count the number of vectors
+ */
+template<typename T>
+auto encodeOct32(Vec3<T> const * in, std::uint32_t * out, std::size_t const count) -> void {
+  detail::encodeOct<16>(in, out, count);
+}
+
+/**
+ * Decode an array of vectors encoded with encodeOct32
+ */
+template<typename T>
+auto decodeOct32(std::uint32_t const * in, Vec3<T> * out, std::size_t const count) -> void {
+  detail::decodeOct<16>(in, out, count);
+}
+
+/**
+ * Encode an array of unit vectors with encodeOct16
+ */
+template<typename T>
+auto encodeOct16(Vec3<T> const * in, std::uint16_t * out, std::size_t const count) -> void {
+  detail::encodeOct<8>(in, out, count);
+}
+
+/**
+ * Decode an array of vectors encoded with encodeOct16
+ */
+template<typename T>
+auto decodeOct16(std::uint16_t const * in, Vec3<T> * out, std::size_t const count) -> void {
+  detail::decodeOct<8>(in, out, count);
+}
+
+/**
+ * Encode an array of unit vectors with encode1010102
+ *
+ * @param in pointer to count unit vectors
+ * @param w pointer to count handedness values, or null to store 1
+ * @param out storage for count encoded vectors
+ * @param count the number of vectors
+ */
+template<typename T>
+auto encode1010102(Vec3<T> const * in, T const * w, std::uint32_t * out, std::size_t const count) -> void {
+  detail::encode1010102(in, w, out, count);
+}
+
+/**
+ * Decode an array of vectors encoded with encode1010102
+ *
+ * @param in pointer to count encoded vectors
+ * @param out storage for count unit vectors
+ * @param w storage for count handedness values, or null
+ * @param count the number of vectors
+ */
+template<typename T>
+auto decode1010102(std::uint32_t const * in, Vec3<T> * out, T * w, std::size_t const count) -> void {
+  detail::decode1010102(in, out, w, count);
+}
+
+} // namespace math
+} // namespace cagey
+
+#endif /* CAGEY_MATH_PACKEDNORMAL_HH_ */
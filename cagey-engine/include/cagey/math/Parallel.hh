@@ -0,0 +1,212 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// cagey-engine - Toy 3D Engine
+// Copyright (c) 2014 Kyle Girard <theycallmecoach@gmail.com>
+//
+// The MIT License (MIT)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+
+/**
+ * @file
+ * Fork/join helper and persistent @ref cagey::math::ThreadPool used by the
+ * bulk math routines.
+ */
+
+#ifndef CAGEY_MATH_PARALLEL_HH_
+#define CAGEY_MATH_PARALLEL_HH_
+
+#include <cstddef>
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+namespace cagey {
+namespace math {
+namespace detail {
+
+/**
+ * Split [0, count) into at most threads contiguous chunks and call
+ * f(begin, end) for each, one per thread.  The calling thread runs the last
+ * chunk and the call returns once all chunks are done.  Chunk boundaries
+ * are multiples of grain, so callers writing packed output (bitmasks,
+ * SIMD lanes) never share a word between threads.
+ *
+ * @param count the number of elements
+ * @param threads the maximum number of threads to use, 0 means one per core
+ * @param grain chunk boundaries are multiples of this
+ * @param f callable taking (std::size_t begin, std::size_t end)
+ */
+template<typename F>
+auto parallelFor(std::size_t const count, std::size_t threads, std::size_t const grain, F && f) -> void {
+  if (threads == 0) {
+    threads = std::max<std::size_t>(1, std::thread::hardware_concurrency());
+  }
+  std::size_t const blocks = (count + grain - 1) / grain;
+  threads = std::min(threads, blocks);
+  if (threads <= 1) {
+    f(std::size_t{0}, count);
+    return;
+  }
+
+  std::size_t const perThread = (blocks + threads - 1) / threads * grain;
+  std::vector<std::thread> workers;
+  workers.reserve(threads - 1);
+  std::size_t begin = 0;
+  for (; begin + perThread < count; begin += perThread) {
+    workers.emplace_back([&f, begin, perThread] { f(begin, begin + perThread); });
+  }
+  f(begin, count);
+  for (auto & worker : workers) {
+    worker.join();
+  }
+}
+
+} // namespace detail
+
+/**
+ * Fixed set of worker threads for loops that run every frame, where
+ * creating threads per call as parallelFor() does would cost more than the
+ * work.  Workers sleep between calls.  One loop runs at a time and the
+ * calling thread takes chunks alongside the workers.
+ */
+class ThreadPool {
+public:
+  /**
+   * Start the workers
+   *
+   * @param threads the number of threads including the caller's, 0 means
+   * one per core
+   */
+  explicit ThreadPool(std::size_t threads = 0) {
+    if (threads == 0) {
+      threads = std::max<std::size_t>(1, std::thread::hardware_concurrency());
+    }
+    mWorkers.reserve(threads - 1);
+    for (std::size_t i = 1; i < threads; ++i) {
+      mWorkers.emplace_back([this] { work(); });
+    }
+  }
+
+  ThreadPool(ThreadPool const &) = delete;
+  auto operator=(ThreadPool const &) -> ThreadPool & = delete;
+
+  ~ThreadPool() {
+    {
+      std::lock_guard<std::mutex> lock{mMutex};
+      mStop = true;
+    }
+    mWake.notify_all();
+    for (auto & worker : mWorkers) {
+      worker.join();
+    }
+  }
+
+  /**
+   * Return the number of threads, the caller's included
+   */
+  auto size() const noexcept -> std::size_t { return mWorkers.size() + 1; }
+
+  /**
+   * Call f(begin, end) over [0, count) in chunks of grain elements, shared
+   * out among the workers and the calling thread, and return once every
+   * chunk is done.  Ranges of a single chunk run on the caller without
+   * waking anyone.  f must not throw.
+   *
+   * @param count the number of elements
+   * @param grain the chunk size, boundaries are multiples of this
+   * @param f callable taking (std::size_t begin, std::size_t end)
+   */
+  template<typename F>
+  auto parallelFor(std::size_t const count, std::size_t const grain, F && f) -> void {
+    if (mWorkers.empty() || count <= grain) {
+      f(std::size_t{0}, count);
+      return;
+    }
+    {
+      std::lock_guard<std::mutex> lock{mMutex};
+      mJob = &f;
+      mInvoke = [](void const * job, std::size_t const begin, std::size_t const end) {
+        (*static_cast<std::remove_reference_t<F> const *>(job))(begin, end);
+      };
+      mCount = count;
+      mGrain = grain;
+      mNext = 0;
+      mBusy = mWorkers.size();
+      ++mGeneration;
+    }
+    mWake.notify_all();
+    runChunks();
+    std::unique_lock<std::mutex> lock{mMutex};
+    mDone.wait(lock, [this] { return mBusy == 0; });
+  }
+
+private:
+  auto work() -> void {
+    std::size_t seen = 0;
+    std::unique_lock<std::mutex> lock{mMutex};
+    for (;;) {
+      mWake.wait(lock, [&] { return mStop || mGeneration != seen; });
+      if (mStop) {
+        return;
+      }
+      seen = mGeneration;
+      lock.unlock();
+      runChunks();
+      lock.lock();
+      if (--mBusy == 0) {
+        mDone.notify_one();
+      }
+    }
+  }
+
+  auto runChunks() -> void {
+    for (auto begin = mGrain * mNext++; begin < mCount; begin = mGrain * mNext++) {
+      mInvoke(mJob, begin, std::min(begin + mGrain, mCount));
+    }
+  }
+
+  std::vector<std::thread> mWorkers;
+  std::mutex mMutex;
+  std::condition_variable mWake;
+  std::condition_variable mDone;
+  /// the current loop, written under mMutex before mGeneration changes
+  void const * mJob = nullptr;
+  void (*mInvoke)(void const *, std::size_t, std::size_t) = nullptr;
+  std::size_t mCount = 0;
+  std::size_t mGrain = 1;
+  /// the next chunk to hand out
+  std::atomic<std::size_t> mNext{0};
+  /// workers still inside the current loop
+  std::size_t mBusy = 0;
+  std::size_t mGeneration = 0;
+  bool mStop = false;
+};
+
+} // namespace math
+} // namespace cagey
+
+#endif /* CAGEY_MATH_PARALLEL_HH_ */
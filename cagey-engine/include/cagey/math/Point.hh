@@ -38,7 +38,7 @@ class Point : public BasePoint<Point, T, N> {
 public:
   /** @cond doxygen has some issues with static assert */
   static_assert(N != 0, "Point cannot have zero elements");
-  static_assert(std::is_arithmetic<T>::value, "Underlying type must be a number");
+  static_assert(IsNumber<T>::value, "Underlying type must be a number");
   /** @endcond */
 
   /// The underlying type of this Point
@@ -91,7 +91,7 @@ template<typename T>
 class Point<T,2> : public BasePoint<Point, T, 2>
 {
   /** @cond doxygen has issues with static_assert */
-  static_assert(std::is_arithmetic<T>::value, "Underlying type must be a number");
+  static_assert(IsNumber<T>::value, "Underlying type must be a number");
   /** @endcond */
 public:
   /// The number of elements in this BasePoint
@@ -142,7 +142,7 @@ template<typename T>
 class Point<T,3> : public BasePoint<Point, T, 3>
 {
   /** @cond doxygen has issues with static_assert */
-  static_assert(std::is_arithmetic<T>::value, "Underlying type must be a number");
+  static_assert(IsNumber<T>::value, "Underlying type must be a number");
   /** @endcond */
 public:
   /// The number of elements in this BasePoint
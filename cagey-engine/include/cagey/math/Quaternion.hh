@@ -0,0 +1,613 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// cagey-engine - Toy 3D Engine
+// Copyright (c) 2014 Kyle Girard <theycallmecoach@gmail.com>
+//
+// The MIT License (MIT)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * @file
+ * @ref cagey::math::Quaternion class.
+ */
+
+#ifndef CAGEY_MATH_QUATERNION_HH_
+#define CAGEY_MATH_QUATERNION_HH_
+
+#include <cstddef>
+#include <cmath>
+#include <limits>
+#include <algorithm>
+#include <array>
+#include <type_traits>
+#include <iostream>
+
+#include "cagey/math/Vector.hh"
+#include "cagey/math/Matrix.hh"
+#include "cagey/math/Radian.hh"
+#include "cagey/math/Simd.hh"
+
+namespace cagey {
+namespace math {
+
+/**
+ * Quaternion used to represent rotations.  Elements are stored in x, y, z,
+ * w order where w is the real part.
+ *
+ * @tparam T underlying floating point type
+ */
+template<typename T>
+class Quaternion {
+public:
+  /** @cond doxygen has some issues with static assert */
+  static_assert(std::is_floating_point<T>::value, "Underlying type must be floating point");
+  /** @endcond */
+
+  /// The underlying type of this Quaternion
+  using Type = T;
+
+  /// The number of elements in this Quaternion
+  const static std::size_t Size = 4;
+
+  /**
+   * Construct the identity Quaternion
+   */
+  constexpr Quaternion() noexcept : x{0}, y{0}, z{0}, w{1} {}
+
+  /**
+   * Construct a Quaternion from its components
+   *
+   * @param a value to assign to x
+   * @param b value to assign to y
+   * @param c value to assign to z
+   * @param d value to assign to w, the real part
+   */
+  constexpr Quaternion(T const a, T const b, T const c, T const d) noexcept : x{a}, y{b}, z{c}, w{d} {}
+
+  /**
+   * Construct a Quaternion representing a rotation of angle around axis
+   *
+   * @param axis the axis of rotation, does not need to be unit length
+   * @param angle the amount to rotate
+   */
+  Quaternion(Vec3<T> const & axis, Radian<T> const angle) noexcept;
+
+  /**
+   * Index operator
+   *
+   * @param i index into this Quaternion, 3 is the real part
+   * @return a reference to the element at index i
+   */
+  constexpr auto operator[](std::size_t i) -> T & { return data[i]; }
+
+  /**
+   * Index operator
+   *
+   * @param i index into this Quaternion, 3 is the real part
+   * @return a reference to the element at index i
+   */
+  constexpr auto operator[](std::size_t i) const -> T const & { return data[i]; }
+
+public:
+  /**
+   * Anonymous union to allow access to members using different names
+   */
+  union {
+    ///Data represented as a std::array
+    std::array<T, Size> data;
+    struct {
+      T x; ///< The first imaginary element
+      T y; ///< The second imaginary element
+      T z; ///< The third imaginary element
+      T w; ///< The real element
+    };
+  };
+};
+
+template<typename T>
+Quaternion<T>::Quaternion(Vec3<T> const & axis, Radian<T> const angle) noexcept {
+  using std::sin;
+  using std::cos;
+  using std::sqrt;
+  T const half = T(angle) / T{2};
+  T const len = sqrt(axis.x * axis.x + axis.y * axis.y + axis.z * axis.z);
+  T const s = len > T{0} ? sin(half) / len : T{0};
+  x = axis.x * s;
+  y = axis.y * s;
+  z = axis.z * s;
+  w = cos(half);
+}
+
+using Quatf = Quaternion<float>;
+using Quatd = Quaternion<double>;
+
+/**
+ * Hamilton product of two Quaternions.  The resulting rotation applies rhs
+ * first then lhs.
+ */
+template<typename T>
+constexpr auto operator*(Quaternion<T> const & lhs, Quaternion<T> const & rhs) -> Quaternion<T> {
+  return Quaternion<T>{
+    lhs.w * rhs.x + lhs.x * rhs.w + lhs.y * rhs.z - lhs.z * rhs.y,
+    lhs.w * rhs.y - lhs.x * rhs.z + lhs.y * rhs.w + lhs.z * rhs.x,
+    lhs.w * rhs.z + lhs.x * rhs.y - lhs.y * rhs.x + lhs.z * rhs.w,
+    lhs.w * rhs.w - lhs.x * rhs.x - lhs.y * rhs.y - lhs.z * rhs.z};
+}
+
+/**
+ * Rotate the given Vector by the given unit Quaternion
+ */
+template<typename T>
+constexpr auto operator*(Quaternion<T> const & quat, Vec3<T> const & vec) -> Vec3<T> {
+  // t = 2 * cross(q.xyz, v), v' = v + w * t + cross(q.xyz, t)
+  T const tx = T{2} * (quat.y * vec.z - quat.z * vec.y);
+  T const ty = T{2} * (quat.z * vec.x - quat.x * vec.z);
+  T const tz = T{2} * (quat.x * vec.y - quat.y * vec.x);
+  return Vec3<T>{
+    vec.x + quat.w * tx + quat.y * tz - quat.z * ty,
+    vec.y + quat.w * ty + quat.z * tx - quat.x * tz,
+    vec.z + quat.w * tz + quat.x * ty - quat.y * tx};
+}
+
+/**
+ * Negate all elements of the given Quaternion.  The result represents the
+ * same rotation.
+ */
+template<typename T>
+constexpr auto operator-(Quaternion<T> const & quat) -> Quaternion<T> {
+  return Quaternion<T>{-quat.x, -quat.y, -quat.z, -quat.w};
+}
+
+/**
+ * Exact equality, not really useful with floating point
+ */
+template<typename T>
+constexpr auto operator==(Quaternion<T> const & lhs, Quaternion<T> const & rhs) -> bool {
+  return lhs.data == rhs.data;
+}
+
+template<typename T>
+constexpr auto operator!=(Quaternion<T> const & lhs, Quaternion<T> const & rhs) -> bool {
+  return !(lhs == rhs);
+}
+
+/**
+ * Return the conjugate of the given Quaternion.  For unit Quaternions this
+ * is also the inverse rotation.
+ */
+template<typename T>
+constexpr auto conjugate(Quaternion<T> const & quat) -> Quaternion<T> {
+  return Quaternion<T>{-quat.x, -quat.y, -quat.z, quat.w};
+}
+
+/**
+ * Return the dot product of the given Quaternions
+ */
+template<typename T>
+constexpr auto dot(Quaternion<T> const & lhs, Quaternion<T> const & rhs) -> T {
+  return lhs.x * rhs.x + lhs.y * rhs.y + lhs.z * rhs.z + lhs.w * rhs.w;
+}
+
+/**
+ * Return the length(magnitude) of the given Quaternion
+ */
+template<typename T>
+auto length(Quaternion<T> const & quat) -> T {
+  using std::sqrt;
+  return sqrt(dot(quat, quat));
+}
+
+/**
+ * Return a unit length copy of the given Quaternion.  If the length is zero
+ * the identity is returned.
+ */
+template<typename T>
+auto normalize(Quaternion<T> const & quat) -> Quaternion<T> {
+  T const len = length(quat);
+  if (len > T{0}) {
+    T const inv = T{1} / len;
+    return Quaternion<T>{quat.x * inv, quat.y * inv, quat.z * inv, quat.w * inv};
+  }
+  return Quaternion<T>{};
+}
+
+/**
+ * Normalized linear interpolation between two unit Quaternions along the
+ * shortest path.  Cheaper than slerp but does not have constant angular
+ * velocity.
+ *
+ * @param from the rotation at t = 0
+ * @param to the rotation at t = 1
+ * @param t the interpolation factor
+ */
+template<typename T>
+auto nlerp(Quaternion<T> const & from, Quaternion<T> const & to, T const t) -> Quaternion<T> {
+  T const wb = dot(from, to) < T{0} ? -t : t;
+  T const wa = T{1} - t;
+  return normalize(Quaternion<T>{
+    wa * from.x + wb * to.x,
+    wa * from.y + wb * to.y,
+    wa * from.z + wb * to.z,
+    wa * from.w + wb * to.w});
+}
+
+/**
+ * Spherical linear interpolation between two unit Quaternions along the
+ * shortest path.  Falls back to nlerp when the rotations are nearly
+ * identical.
+ *
+ * @param from the rotation at t = 0
+ * @param to the rotation at t = 1
+ * @param t the interpolation factor
+ */
+template<typename T>
+auto slerp(Quaternion<T> const & from, Quaternion<T> const & to, T const t) -> Quaternion<T> {
+  using std::acos;
+  using std::sin;
+  T d = dot(from, to);
+  T sign{1};
+  if (d < T{0}) {
+    d = -d;
+    sign = T{-1};
+  }
+  if (d > T{1} - T{16} * std::numeric_limits<T>::epsilon()) {
+    return nlerp(from, to, t);
+  }
+  T const theta = acos(d);
+  T const inv = T{1} / sin(theta);
+  T const wa = sin((T{1} - t) * theta) * inv;
+  T const wb = sin(t * theta) * inv * sign;
+  return Quaternion<T>{
+    wa * from.x + wb * to.x,
+    wa * from.y + wb * to.y,
+    wa * from.z + wb * to.z,
+    wa * from.w + wb * to.w};
+}
+
+/**
+ * Convert the given unit Quaternion to a rotation matrix
+ */
+template<typename T>
+constexpr auto toMat3(Quaternion<T> const & quat) -> Mat3<T> {
+  T const x2 = quat.x + quat.x;
+  T const y2 = quat.y + quat.y;
+  T const z2 = quat.z + quat.z;
+  T const xx = quat.x * x2;
+  T const yy = quat.y * y2;
+  T const zz = quat.z * z2;
+  T const xy = quat.x * y2;
+  T const xz = quat.x * z2;
+  T const yz = quat.y * z2;
+  T const wx = quat.w * x2;
+  T const wy = quat.w * y2;
+  T const wz = quat.w * z2;
+  return Mat3<T>{{{
+    T{1} - yy - zz, xy + wz, xz - wy,
+    xy - wz, T{1} - xx - zz, yz + wx,
+    xz + wy, yz - wx, T{1} - xx - yy}}};
+}
+
+/**
+ * Convert the given unit Quaternion to a rotation matrix
+ */
+template<typename T>
+constexpr auto toMat4(Quaternion<T> const & quat) -> Mat4<T> {
+  T const x2 = quat.x + quat.x;
+  T const y2 = quat.y + quat.y;
+  T const z2 = quat.z + quat.z;
+  T const xx = quat.x * x2;
+  T const yy = quat.y * y2;
+  T const zz = quat.z * z2;
+  T const xy = quat.x * y2;
+  T const xz = quat.x * z2;
+  T const yz = quat.y * z2;
+  T const wx = quat.w * x2;
+  T const wy = quat.w * y2;
+  T const wz = quat.w * z2;
+  return Mat4<T>{{{
+    T{1} - yy - zz, xy + wz, xz - wy, T{0},
+    xy - wz, T{1} - xx - zz, yz + wx, T{0},
+    xz + wy, yz - wx, T{1} - xx - yy, T{0},
+    T{0}, T{0}, T{0}, T{1}}}};
+}
+
+/**
+ * Output the given Quaternion to the given output stream
+ */
+template<typename T>
+auto operator<<(std::ostream & os, Quaternion<T> const & quat) -> std::ostream & {
+  return os << "( " << quat.x << ", " << quat.y << ", " << quat.z << ", " << quat.w << " )";
+}
+
+namespace detail {
+
+/**
+ * acos(x) for x in [0, 1].  Abramowitz and Stegun 4.4.46, absolute error
+ * below 2e-8.
+ */
+template<typename P>
+inline auto acosUnit(P const x) -> P {
+  using T = typename P::Type;
+  P r = P::broadcast(T(-0.0012624911));
+  r = r * x + P::broadcast(T(0.0066700901));
+  r = r * x + P::broadcast(T(-0.0170881256));
+  r = r * x + P::broadcast(T(0.0308918810));
+  r = r * x + P::broadcast(T(-0.0501743046));
+  r = r * x + P::broadcast(T(0.0889789874));
+  r = r * x + P::broadcast(T(-0.2145988016));
+  r = r * x + P::broadcast(T(1.5707963050));
+  return r * sqrt(P::broadcast(T{1}) - x);
+}
+
+/**
+ * sin(x) for x in [0, pi/2].  Taylor series through x^15, absolute error
+ * below 1e-11.
+ */
+template<typename P>
+inline auto sinHalfPi(P const x) -> P {
+  using T = typename P::Type;
+  P const x2 = x * x;
+  P r = P::broadcast(T(-1.0 / 1307674368000.0));
+  r = r * x2 + P::broadcast(T(1.0 / 6227020800.0));
+  r = r * x2 + P::broadcast(T(-1.0 / 39916800.0));
+  r = r * x2 + P::broadcast(T(1.0 / 362880.0));
+  r = r * x2 + P::broadcast(T(-1.0 / 5040.0));
+  r = r * x2 + P::broadcast(T(1.0 / 120.0));
+  r = r * x2 + P::broadcast(T(-1.0 / 6.0));
+  r = r * x2 + P::broadcast(T{1});
+  return r * x;
+}
+
+/**
+ * Load one Quaternion as scalar Packs
+ */
+template<typename T>
+inline auto loadXyzw(T const * in, Pack<T, 1> & x, Pack<T, 1> & y, Pack<T, 1> & z, Pack<T, 1> & w) -> void {
+  x.v = in[0];
+  y.v = in[1];
+  z.v = in[2];
+  w.v = in[3];
+}
+
+template<typename T>
+inline auto storeXyzw(T * out, Pack<T, 1> const x, Pack<T, 1> const y, Pack<T, 1> const z, Pack<T, 1> const w) -> void {
+  out[0] = x.v;
+  out[1] = y.v;
+  out[2] = z.v;
+  out[3] = w.v;
+}
+
+#if defined(CAGEY_SIMD_SSE2)
+
+/**
+ * Four Quaternions of floats, one register each, transposed into one
+ * register per component.  The transpose is its own inverse.
+ */
+inline auto loadXyzw(float const * in, Pack<float, 4> & x, Pack<float, 4> & y, Pack<float, 4> & z, Pack<float, 4> & w) -> void {
+  x.v = _mm_loadu_ps(in);
+  y.v = _mm_loadu_ps(in + 4);
+  z.v = _mm_loadu_ps(in + 8);
+  w.v = _mm_loadu_ps(in + 12);
+  _MM_TRANSPOSE4_PS(x.v, y.v, z.v, w.v);
+}
+
+inline auto storeXyzw(float * out, Pack<float, 4> x, Pack<float, 4> y, Pack<float, 4> z, Pack<float, 4> w) -> void {
+  _MM_TRANSPOSE4_PS(x.v, y.v, z.v, w.v);
+  _mm_storeu_ps(out, x.v);
+  _mm_storeu_ps(out + 4, y.v);
+  _mm_storeu_ps(out + 8, z.v);
+  _mm_storeu_ps(out + 12, w.v);
+}
+
+/**
+ * Two Quaternions of doubles, xy and zw halves unpacked into components
+ */
+inline auto loadXyzw(double const * in, Pack<double, 2> & x, Pack<double, 2> & y, Pack<double, 2> & z, Pack<double, 2> & w) -> void {
+  __m128d const xy0 = _mm_loadu_pd(in);
+  __m128d const zw0 = _mm_loadu_pd(in + 2);
+  __m128d const xy1 = _mm_loadu_pd(in + 4);
+  __m128d const zw1 = _mm_loadu_pd(in + 6);
+  x.v = _mm_unpacklo_pd(xy0, xy1);
+  y.v = _mm_unpackhi_pd(xy0, xy1);
+  z.v = _mm_unpacklo_pd(zw0, zw1);
+  w.v = _mm_unpackhi_pd(zw0, zw1);
+}
+
+inline auto storeXyzw(double * out, Pack<double, 2> const x, Pack<double, 2> const y, Pack<double, 2> const z,
+                      Pack<double, 2> const w) -> void {
+  _mm_storeu_pd(out, _mm_unpacklo_pd(x.v, y.v));
+  _mm_storeu_pd(out + 2, _mm_unpacklo_pd(z.v, w.v));
+  _mm_storeu_pd(out + 4, _mm_unpackhi_pd(x.v, y.v));
+  _mm_storeu_pd(out + 6, _mm_unpackhi_pd(z.v, w.v));
+}
+
+#endif // CAGEY_SIMD_SSE2
+
+#if defined(CAGEY_SIMD_AVX)
+
+/**
+ * In-lane 4x4 transpose of two sets of four floats, as _MM_TRANSPOSE4_PS
+ */
+inline auto transpose4(__m256 & r0, __m256 & r1, __m256 & r2, __m256 & r3) -> void {
+  __m256 const t0 = _mm256_unpacklo_ps(r0, r1);
+  __m256 const t1 = _mm256_unpacklo_ps(r2, r3);
+  __m256 const t2 = _mm256_unpackhi_ps(r0, r1);
+  __m256 const t3 = _mm256_unpackhi_ps(r2, r3);
+  r0 = _mm256_shuffle_ps(t0, t1, _MM_SHUFFLE(1, 0, 1, 0));
+  r1 = _mm256_shuffle_ps(t0, t1, _MM_SHUFFLE(3, 2, 3, 2));
+  r2 = _mm256_shuffle_ps(t2, t3, _MM_SHUFFLE(1, 0, 1, 0));
+  r3 = _mm256_shuffle_ps(t2, t3, _MM_SHUFFLE(3, 2, 3, 2));
+}
+
+/**
+ * Eight Quaternions of floats.  Quaternions j and j + 4 share a register,
+ * so transposing each 128 bit lane leaves components in order.
+ */
+inline auto loadXyzw(float const * in, Pack<float, 8> & x, Pack<float, 8> & y, Pack<float, 8> & z, Pack<float, 8> & w) -> void {
+  x.v = _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_loadu_ps(in)), _mm_loadu_ps(in + 16), 1);
+  y.v = _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_loadu_ps(in + 4)), _mm_loadu_ps(in + 20), 1);
+  z.v = _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_loadu_ps(in + 8)), _mm_loadu_ps(in + 24), 1);
+  w.v = _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_loadu_ps(in + 12)), _mm_loadu_ps(in + 28), 1);
+  transpose4(x.v, y.v, z.v, w.v);
+}
+
+inline auto storeXyzw(float * out, Pack<float, 8> x, Pack<float, 8> y, Pack<float, 8> z, Pack<float, 8> w) -> void {
+  transpose4(x.v, y.v, z.v, w.v);
+  _mm_storeu_ps(out, _mm256_castps256_ps128(x.v));
+  _mm_storeu_ps(out + 4, _mm256_castps256_ps128(y.v));
+  _mm_storeu_ps(out + 8, _mm256_castps256_ps128(z.v));
+  _mm_storeu_ps(out + 12, _mm256_castps256_ps128(w.v));
+  _mm_storeu_ps(out + 16, _mm256_extractf128_ps(x.v, 1));
+  _mm_storeu_ps(out + 20, _mm256_extractf128_ps(y.v, 1));
+  _mm_storeu_ps(out + 24, _mm256_extractf128_ps(z.v, 1));
+  _mm_storeu_ps(out + 28, _mm256_extractf128_ps(w.v, 1));
+}
+
+/**
+ * Four Quaternions of doubles, transposed with unpacks within each lane
+ * and a swap of 128 bit lanes
+ */
+inline auto transpose4(__m256d & r0, __m256d & r1, __m256d & r2, __m256d & r3) -> void {
+  __m256d const t0 = _mm256_unpacklo_pd(r0, r1); // x0 x1 z0 z1
+  __m256d const t1 = _mm256_unpackhi_pd(r0, r1); // y0 y1 w0 w1
+  __m256d const t2 = _mm256_unpacklo_pd(r2, r3); // x2 x3 z2 z3
+  __m256d const t3 = _mm256_unpackhi_pd(r2, r3); // y2 y3 w2 w3
+  r0 = _mm256_permute2f128_pd(t0, t2, 0x20);
+  r1 = _mm256_permute2f128_pd(t1, t3, 0x20);
+  r2 = _mm256_permute2f128_pd(t0, t2, 0x31);
+  r3 = _mm256_permute2f128_pd(t1, t3, 0x31);
+}
+
+inline auto loadXyzw(double const * in, Pack<double, 4> & x, Pack<double, 4> & y, Pack<double, 4> & z, Pack<double, 4> & w) -> void {
+  x.v = _mm256_loadu_pd(in);
+  y.v = _mm256_loadu_pd(in + 4);
+  z.v = _mm256_loadu_pd(in + 8);
+  w.v = _mm256_loadu_pd(in + 12);
+  transpose4(x.v, y.v, z.v, w.v);
+}
+
+inline auto storeXyzw(double * out, Pack<double, 4> x, Pack<double, 4> y, Pack<double, 4> z, Pack<double, 4> w) -> void {
+  transpose4(x.v, y.v, z.v, w.v);
+  _mm256_storeu_pd(out, x.v);
+  _mm256_storeu_pd(out + 4, y.v);
+  _mm256_storeu_pd(out + 8, z.v);
+  _mm256_storeu_pd(out + 12, w.v);
+}
+
+#endif // CAGEY_SIMD_AVX
+
+} // namespace detail
+
+/**
+ * Spherical linear interpolation of arrays of unit Quaternions,
+ * out[i] = slerp(from[i], to[i], t[i]).  acos and sin are evaluated with
+ * polynomials a full register of Quaternions at a time.  The sin
+ * polynomial only covers [0, pi/2], which the angles reach for t in
+ * [0, 1]; there each component agrees with the scalar slerp to within
+ * 1e-6 for float and 1e-8 for double, the acos polynomial limiting the
+ * latter.  Lanes with t outside [0, 1] are extrapolated by the scalar
+ * slerp.
+ *
+ * @param from pointer to count Quaternions at t = 0
+ * @param to pointer to count Quaternions at t = 1
+ * @param t pointer to count interpolation factors
+ * @param out storage for count Quaternions, may be from or to
+ * @param count the number of Quaternions
+ */
+template<typename T>
+auto slerp(Quaternion<T> const * from, Quaternion<T> const * to, T const * t, Quaternion<T> * out, std::size_t const count) -> void {
+  /** @cond doxygen has an issue with static assert */
+  static_assert(sizeof(Quaternion<T>) == 4 * sizeof(T), "Quaternion must be tightly packed");
+  /** @endcond */
+  detail::forEachPack<T>(count, [&](auto p, std::size_t const i) {
+    using P = decltype(p);
+    constexpr std::size_t W = P::Width;
+    P ax, ay, az, aw, bx, by, bz, bw;
+    detail::loadXyzw(from[i].data.data(), ax, ay, az, aw);
+    detail::loadXyzw(to[i].data.data(), bx, by, bz, bw);
+    P const tt = P::load(t + i);
+    P const zero = P::broadcast(T{0});
+    P const one = P::broadcast(T{1});
+
+    //take the shortest path
+    P d = ax * bx + ay * by + az * bz + aw * bw;
+    auto const negative = d < zero;
+    P const sign = select(negative, P::broadcast(T{-1}), one);
+    d = select(negative, zero - d, d);
+
+    //slerp weights, replaced by lerp weights when the angle is tiny
+    auto const small = d > P::broadcast(T{1} - T{16} * std::numeric_limits<T>::epsilon());
+    P const theta = detail::acosUnit(min(d, one));
+    P const inv = one / select(small, one, detail::sinHalfPi(theta));
+    P wa = select(small, one - tt, detail::sinHalfPi((one - tt) * theta) * inv);
+    P wb = select(small, tt, detail::sinHalfPi(tt * theta) * inv) * sign;
+
+    P rx = wa * ax + wb * bx;
+    P ry = wa * ay + wb * by;
+    P rz = wa * az + wb * bz;
+    P rw = wa * aw + wb * bw;
+
+    //extrapolated lanes are redone before out, which may alias the inputs,
+    //is written
+    unsigned const outside = P::bits(tt < zero) | P::bits(one < tt);
+    Quaternion<T> extrapolated[W];
+    for (std::size_t j = 0; j < W; ++j) {
+      if (outside & (1u << j)) {
+        extrapolated[j] = slerp(from[i + j], to[i + j], t[i + j]);
+      }
+    }
+
+    //nlerp results need normalizing, slerp results only gain from it
+    P const invLen = one / sqrt(rx * rx + ry * ry + rz * rz + rw * rw);
+    detail::storeXyzw(out[i].data.data(), rx * invLen, ry * invLen, rz * invLen, rw * invLen);
+    for (std::size_t j = 0; j < W; ++j) {
+      if (outside & (1u << j)) {
+        out[i + j] = extrapolated[j];
+      }
+    }
+  });
+}
+
+/**
+ * Spherical linear interpolation of arrays of unit Quaternions with a
+ * single interpolation factor, out[i] = slerp(from[i], to[i], t).
+ *
+ * @param from pointer to count Quaternions at t = 0
+ * @param to pointer to count Quaternions at t = 1
+ * @param t the interpolation factor
+ * @param out storage for count Quaternions, may be from or to
+ * @param count the number of Quaternions
+ */
+template<typename T>
+auto slerp(Quaternion<T> const * from, Quaternion<T> const * to, T const t, Quaternion<T> * out, std::size_t const count) -> void {
+  constexpr std::size_t Block = 64;
+  T ts[Block];
+  std::fill(ts, ts + Block, t);
+  for (std::size_t i = 0; i < count; i += Block) {
+    slerp(from + i, to + i, ts, out + i, std::min(Block, count - i));
+  }
+}
+
+} // namespace math
+} // namespace cagey
+
+#endif /* CAGEY_MATH_QUATERNION_HH_ */
@@ -70,7 +70,7 @@ public:
    * 
    * @param val Degree to convert to a Radian
    */
-  constexpr explicit Radian(BaseAngle<Degree, T> val) : BaseAngle<math::Degree, T>{T{val}*constants::degToRad<T>}{}
+  constexpr explicit Radian(BaseAngle<Degree, T> val) : BaseAngle<math::Radian, T>{T{val}*constants::degToRad<T>}{}
 };
 
 /**
@@ -0,0 +1,157 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// cagey-engine - Toy 3D Engine
+// Copyright (c) 2014 Kyle Girard <theycallmecoach@gmail.com>
+//
+// The MIT License (MIT)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * @file
+ * Radix sort of (key, value) pairs.
+ */
+
+#ifndef CAGEY_MATH_RADIXSORT_HH_
+#define CAGEY_MATH_RADIXSORT_HH_
+
+#include <cstddef>
+#include <cstdint>
+#include <algorithm>
+#include <array>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+#include "cagey/math/Parallel.hh"
+#include "cagey/core/Exception.hh"
+
+namespace cagey {
+namespace math {
+namespace detail {
+
+/// Bits sorted per radix pass
+constexpr unsigned RadixBits = 11;
+constexpr std::uint32_t RadixSize = 1u << RadixBits;
+
+/// Fewest pairs per thread worth splitting a pass for
+constexpr std::size_t RadixParallelGrain = 1 << 16;
+
+/**
+ * Stable LSD radix sort of count (key, value) pairs by the low bits of the
+ * key.  The tmp buffers must hold count elements; the sorted pairs end up
+ * back in keys and values.
+ *
+ * With more than one thread each pass splits the pairs into one chunk per
+ * thread.  Every chunk is histogrammed in parallel, the histograms are
+ * prefix summed digit by digit across chunks and every chunk then scatters
+ * its pairs in parallel, which keeps the sort stable and the output
+ * identical to the single threaded one.
+ *
+ * @param keys the keys to sort by, std::uint32_t or std::uint64_t
+ * @param values the values moved along with their keys
+ * @param keysTmp scratch space for count keys
+ * @param valuesTmp scratch space for count values
+ * @param count the number of pairs
+ * @param bits only the low bits of each key are significant
+ * @param threads the maximum number of threads to use, 0 means one per core
+ */
+template<typename Key>
+inline auto radixSortPairs(Key * keys, std::uint32_t * values, Key * keysTmp, std::uint32_t * valuesTmp,
+                           std::size_t const count, unsigned const bits = sizeof(Key) * 8,
+                           std::size_t threads = 1) -> void {
+  if (threads == 0) {
+    threads = std::max<std::size_t>(1, std::thread::hardware_concurrency());
+  }
+  std::size_t const chunks = std::max<std::size_t>(1, std::min(threads, count / RadixParallelGrain));
+  std::size_t const chunkSize = std::max<std::size_t>(1, (count + chunks - 1) / chunks);
+  std::vector<std::array<std::size_t, RadixSize>> offsets(chunks);
+
+  Key * srcKeys = keys;
+  std::uint32_t * srcValues = values;
+  Key * dstKeys = keysTmp;
+  std::uint32_t * dstValues = valuesTmp;
+  for (unsigned shift = 0; shift < bits; shift += RadixBits) {
+    parallelFor(count, chunks, chunkSize, [&](std::size_t const begin, std::size_t const end) {
+      auto & hist = offsets[begin / chunkSize];
+      hist.fill(0);
+      for (std::size_t i = begin; i < end; ++i) {
+        ++hist[(srcKeys[i] >> shift) & (RadixSize - 1)];
+      }
+    });
+    std::size_t sum = 0;
+    for (std::size_t digit = 0; digit < RadixSize; ++digit) {
+      for (auto & hist : offsets) {
+        auto const n = hist[digit];
+        hist[digit] = sum;
+        sum += n;
+      }
+    }
+    parallelFor(count, chunks, chunkSize, [&](std::size_t const begin, std::size_t const end) {
+      auto & offset = offsets[begin / chunkSize];
+      for (std::size_t i = begin; i < end; ++i) {
+        auto const pos = offset[(srcKeys[i] >> shift) & (RadixSize - 1)]++;
+        dstKeys[pos] = srcKeys[i];
+        dstValues[pos] = srcValues[i];
+      }
+    });
+    std::swap(srcKeys, dstKeys);
+    std::swap(srcValues, dstValues);
+  }
+  if (srcKeys != keys) {
+    std::copy(srcKeys, srcKeys + count, keys);
+    std::copy(srcValues, srcValues + count, values);
+  }
+}
+
+} // namespace detail
+
+/**
+ * Sort (key, value) pairs by key, for instance Morton codes and the index
+ * of the object each code came from.  The sort is stable and only makes
+ * as many passes as the largest key needs.
+ *
+ * @param keys the keys to sort by, std::uint32_t or std::uint64_t
+ * @param values the values moved along with their keys, the same size as keys
+ * @param threads the maximum number of threads to use, 0 means one per core
+ */
+template<typename Key>
+auto radixSort(std::vector<Key> & keys, std::vector<std::uint32_t> & values, std::size_t const threads = 1) -> void {
+  /** @cond doxygen has an issue with static assert */
+  static_assert(std::is_unsigned<Key>::value, "Radix sort keys must be unsigned integers");
+  /** @endcond */
+  if (keys.size() != values.size()) {
+    BOOST_THROW_EXCEPTION(core::InvalidArgumentException() << core::ThrowMsg("Array sizes do not match"));
+  }
+  Key const maxKey = keys.empty() ? Key{0} : *std::max_element(keys.begin(), keys.end());
+  unsigned bits = 0;
+  while (bits < sizeof(Key) * 8 && (maxKey >> bits) != 0) {
+    ++bits;
+  }
+  std::vector<Key> keysTmp(keys.size());
+  std::vector<std::uint32_t> valuesTmp(values.size());
+  detail::radixSortPairs(keys.data(), values.data(), keysTmp.data(), valuesTmp.data(), keys.size(), bits, threads);
+}
+
+} // namespace math
+} // namespace cagey
+
+#endif /* CAGEY_MATH_RADIXSORT_HH_ */
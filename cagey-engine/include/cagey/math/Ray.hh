@@ -0,0 +1,212 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// cagey-engine - Toy 3D Engine
+// Copyright (c) 2014 Kyle Girard <theycallmecoach@gmail.com>
+//
+// The MIT License (MIT)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+
+/**
+ * @file
+ * @ref cagey::math::Ray class.
+ */
+
+#ifndef CAGEY_MATH_RAY_HH_
+#define CAGEY_MATH_RAY_HH_
+
+#include <algorithm>
+#include <limits>
+#include <type_traits>
+#include <iostream>
+
+#include "cagey/math/Point.hh"
+#include "cagey/math/Vector.hh"
+#include "cagey/math/Aabb.hh"
+#include "cagey/math/Simd.hh"
+
+namespace cagey {
+namespace math {
+
+/**
+ * Half line starting at origin and heading along direction.  Distances
+ * along the ray are measured in multiples of direction, which need not be
+ * unit length.
+ *
+ * @tparam T underlying floating point type
+ */
+template<typename T>
+class Ray {
+public:
+  /** @cond doxygen has some issues with static assert */
+  static_assert(std::is_floating_point<T>::value, "Underlying type must be floating point");
+  /** @endcond */
+
+  /// The underlying type of this Ray
+  using Type = T;
+
+  constexpr Ray() noexcept = default;
+
+  /**
+   * Construct a ray
+   *
+   * @param o the origin
+   * @param d the direction
+   */
+  constexpr Ray(Point3<T> const & o, Vec3<T> const & d) noexcept : origin(o), direction(d) {}
+
+public:
+  Point3<T> origin;   ///< Where the ray starts
+  Vec3<T> direction;  ///< Where the ray heads
+};
+
+using Rayf = Ray<float>;
+using Rayd = Ray<double>;
+
+/**
+ * Return the point at distance t along the ray
+ */
+template<typename T>
+auto pointAt(Ray<T> const & ray, T const t) -> Point3<T> {
+  return Point3<T>{ray.origin.x + ray.direction.x * t, ray.origin.y + ray.direction.y * t, ray.origin.z + ray.direction.z * t};
+}
+
+namespace detail {
+
+/**
+ * Clip [tNear, tFar] to the slab between the distances t0 and t1.  A ray
+ * parallel to the slab gives opposite infinities when it runs inside it
+ * and 0 * inf = NaN when it runs along a boundary; the sum of the two is
+ * NaN in both cases and the slab is skipped, so boundaries are inclusive on
+ * every face.  Skipping NaNs before min and max also keeps SIMD lanes,
+ * whose min and max differ from std::min and std::max for NaN, in
+ * agreement with the scalar Pack.
+ */
+template<typename P>
+inline auto clipSlab(P const t0, P const t1, P & tNear, P & tFar) -> void {
+  auto const sum = t0 + t1;
+  auto const clips = sum <= sum;
+  tNear = select(clips, max(tNear, min(t0, t1)), tNear);
+  tFar = select(clips, min(tFar, max(t0, t1)), tFar);
+}
+
+/**
+ * Single lane clipSlab, a slab is almost never skipped so a branch is
+ * cheaper than the selects
+ */
+template<typename T>
+inline auto clipSlab(Pack<T, 1> const t0, Pack<T, 1> const t1, Pack<T, 1> & tNear, Pack<T, 1> & tFar) -> void {
+  T const sum = t0.v + t1.v;
+  if (sum <= sum) {
+    tNear = max(tNear, min(t0, t1));
+    tFar = min(tFar, max(t0, t1));
+  }
+}
+
+/**
+ * Slab test on Packs of rays and boxes.  Returns the distance at which each
+ * ray enters its box, clamped to 0 for origins inside it, or infinity if
+ * the box is missed within [0, tMax].
+ */
+template<typename P>
+inline auto slabPack(P const ox, P const oy, P const oz, P const ix, P const iy, P const iz,
+                     P const loX, P const loY, P const loZ, P const hiX, P const hiY, P const hiZ, P const tMax) -> P {
+  auto tNear = P::broadcast(typename P::Type{0});
+  auto tFar = tMax;
+  clipSlab((loX - ox) * ix, (hiX - ox) * ix, tNear, tFar);
+  clipSlab((loY - oy) * iy, (hiY - oy) * iy, tNear, tFar);
+  clipSlab((loZ - oz) * iz, (hiZ - oz) * iz, tNear, tFar);
+  return select(tNear <= tFar, tNear, P::broadcast(std::numeric_limits<typename P::Type>::infinity()));
+}
+
+/**
+ * Slab test with a precomputed reciprocal direction, see slabPack
+ */
+template<typename T>
+auto slab(Point3<T> const & origin, Vec3<T> const & invDir, Point3<T> const & lo, Point3<T> const & hi, T const tMax) -> T {
+  using P = Pack<T, 1>;
+  return slabPack(P{origin.x}, P{origin.y}, P{origin.z}, P{invDir.x}, P{invDir.y}, P{invDir.z},
+                  P{lo.x}, P{lo.y}, P{lo.z}, P{hi.x}, P{hi.y}, P{hi.z}, P{tMax}).v;
+}
+
+/**
+ * Return the componentwise reciprocal of the ray direction
+ */
+template<typename T>
+auto inverseDirection(Ray<T> const & ray) -> Vec3<T> {
+  return Vec3<T>{T{1} / ray.direction.x, T{1} / ray.direction.y, T{1} / ray.direction.z};
+}
+
+} // namespace detail
+
+/**
+ * Return the distance at which the ray enters the box, 0 if it starts
+ * inside, or infinity if it misses the box within [0, tMax]
+ */
+template<typename T>
+auto intersect(Ray<T> const & ray, Aabb<T> const & box, T const tMax = std::numeric_limits<T>::infinity()) -> T {
+  return detail::slab(ray.origin, detail::inverseDirection(ray), box.min, box.max, tMax);
+}
+
+/**
+ * Moller-Trumbore ray/triangle test.  Returns the distance to the hit or
+ * infinity if the triangle is missed within [0, tMax].  Both faces count
+ * and degenerate triangles are never hit.
+ */
+template<typename T>
+auto intersect(Ray<T> const & ray, Point3<T> const & a, Point3<T> const & b, Point3<T> const & c,
+               T const tMax = std::numeric_limits<T>::infinity()) -> T {
+  Vec3<T> const e1{b.x - a.x, b.y - a.y, b.z - a.z};
+  Vec3<T> const e2{c.x - a.x, c.y - a.y, c.z - a.z};
+  Vec3<T> const p = cross(ray.direction, e2);
+  T const det = dot(e1, p);
+  T const miss = std::numeric_limits<T>::infinity();
+  if (!(det * det > T{0})) {
+    return miss;
+  }
+  T const invDet = T{1} / det;
+  Vec3<T> const s{ray.origin.x - a.x, ray.origin.y - a.y, ray.origin.z - a.z};
+  T const u = dot(s, p) * invDet;
+  if (u < T{0} || u > T{1}) {
+    return miss;
+  }
+  Vec3<T> const q = cross(s, e1);
+  T const v = dot(ray.direction, q) * invDet;
+  if (v < T{0} || u + v > T{1}) {
+    return miss;
+  }
+  T const t = dot(e2, q) * invDet;
+  return t < T{0} || t > tMax ? miss : t;
+}
+
+/**
+ * Output the given ray to the given output stream
+ */
+template<typename T>
+auto operator<<(std::ostream & os, Ray<T> const & ray) -> std::ostream & {
+  return os << "Ray(" << ray.origin << ", " << ray.direction << ")";
+}
+
+} // namespace math
+} // namespace cagey
+
+#endif /* CAGEY_MATH_RAY_HH_ */
@@ -0,0 +1,242 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// cagey-engine - Toy 3D Engine
+// Copyright (c) 2014 Kyle Girard <theycallmecoach@gmail.com>
+//
+// The MIT License (MIT)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+
+/**
+ * @file
+ * Packet ray/box and ray/triangle tests over structure of arrays data.
+ */
+
+#ifndef CAGEY_MATH_RAYPACKET_HH_
+#define CAGEY_MATH_RAYPACKET_HH_
+
+#include <cstddef>
+#include <limits>
+
+#include "cagey/math/Ray.hh"
+#include "cagey/math/Aabb.hh"
+#include "cagey/math/Array3.hh"
+#include "cagey/math/Simd.hh"
+
+namespace cagey {
+namespace math {
+
+/**
+ * Triangles stored as a first vertex and two edges, each as separate x, y
+ * and z streams, the layout the packet ray tests consume.
+ *
+ * @tparam T the underlying type
+ */
+template<typename T>
+class TriangleArray {
+public:
+  /// The underlying type of this TriangleArray
+  using Type = T;
+
+  /**
+   * Return the number of triangles
+   */
+  auto size() const noexcept -> std::size_t { return mV0.size(); }
+
+  /**
+   * Return true if there are no triangles
+   */
+  auto empty() const noexcept -> bool { return mV0.empty(); }
+
+  /**
+   * Reserve space for count triangles
+   */
+  auto reserve(std::size_t const count) -> void {
+    mV0.reserve(count);
+    mE1.reserve(count);
+    mE2.reserve(count);
+  }
+
+  /**
+   * Remove all triangles
+   */
+  auto clear() noexcept -> void {
+    mV0.clear();
+    mE1.clear();
+    mE2.clear();
+  }
+
+  /**
+   * Append the triangle (a, b, c)
+   */
+  auto pushBack(Point3<T> const & a, Point3<T> const & b, Point3<T> const & c) -> void {
+    mV0.pushBack(a);
+    mE1.pushBack(Vec3<T>{b.x - a.x, b.y - a.y, b.z - a.z});
+    mE2.pushBack(Vec3<T>{c.x - a.x, c.y - a.y, c.z - a.z});
+  }
+
+  /// The first vertex of each triangle
+  auto vertices() const noexcept -> Point3Array<T> const & { return mV0; }
+  /// The second vertex minus the first
+  auto edges1() const noexcept -> Vec3Array<T> const & { return mE1; }
+  /// The third vertex minus the first
+  auto edges2() const noexcept -> Vec3Array<T> const & { return mE2; }
+
+private:
+  Point3Array<T> mV0;
+  Vec3Array<T> mE1;
+  Vec3Array<T> mE2;
+};
+
+using TriangleArrayf = TriangleArray<float>;
+using TriangleArrayd = TriangleArray<double>;
+
+/**
+ * Test one ray against an array of boxes, a register of boxes at a time
+ *
+ * @param ray the ray
+ * @param mins the minimum corner of each box
+ * @param maxs the maximum corner of each box, the same size as mins
+ * @param out storage for mins.size() entry distances, infinity for a miss
+ * @param tMax only hits within [0, tMax] count
+ */
+template<typename T>
+auto intersect(Ray<T> const & ray, Point3Array<T> const & mins, Point3Array<T> const & maxs, T * out,
+               T const tMax = std::numeric_limits<T>::infinity()) -> void {
+  detail::checkSameSize(mins.size(), maxs.size());
+  Vec3<T> const inv = detail::inverseDirection(ray);
+  T const * loX = mins.getX();
+  T const * loY = mins.getY();
+  T const * loZ = mins.getZ();
+  T const * hiX = maxs.getX();
+  T const * hiY = maxs.getY();
+  T const * hiZ = maxs.getZ();
+  detail::forEachPack<T>(mins.size(), [&](auto p, std::size_t const i) {
+    using P = decltype(p);
+    detail::slabPack(P::broadcast(ray.origin.x), P::broadcast(ray.origin.y), P::broadcast(ray.origin.z),
+                     P::broadcast(inv.x), P::broadcast(inv.y), P::broadcast(inv.z),
+                     P::load(loX + i), P::load(loY + i), P::load(loZ + i),
+                     P::load(hiX + i), P::load(hiY + i), P::load(hiZ + i), P::broadcast(tMax)).store(out + i);
+  });
+}
+
+/**
+ * Test a packet of rays against one box, a register of rays at a time
+ *
+ * @param origins the origin of each ray
+ * @param directions the direction of each ray, the same size as origins
+ * @param box the box
+ * @param out storage for origins.size() entry distances, infinity for a miss
+ * @param tMax only hits within [0, tMax] count
+ */
+template<typename T>
+auto intersect(Point3Array<T> const & origins, Vec3Array<T> const & directions, Aabb<T> const & box, T * out,
+               T const tMax = std::numeric_limits<T>::infinity()) -> void {
+  detail::checkSameSize(origins.size(), directions.size());
+  T const * ox = origins.getX();
+  T const * oy = origins.getY();
+  T const * oz = origins.getZ();
+  T const * dx = directions.getX();
+  T const * dy = directions.getY();
+  T const * dz = directions.getZ();
+  detail::forEachPack<T>(origins.size(), [&](auto p, std::size_t const i) {
+    using P = decltype(p);
+    auto const one = P::broadcast(T{1});
+    detail::slabPack(P::load(ox + i), P::load(oy + i), P::load(oz + i),
+                     one / P::load(dx + i), one / P::load(dy + i), one / P::load(dz + i),
+                     P::broadcast(box.min.x), P::broadcast(box.min.y), P::broadcast(box.min.z),
+                     P::broadcast(box.max.x), P::broadcast(box.max.y), P::broadcast(box.max.z),
+                     P::broadcast(tMax)).store(out + i);
+  });
+}
+
+/**
+ * Moller-Trumbore test of one ray against an array of triangles, a register
+ * of triangles at a time.  Matches the scalar intersect for each triangle:
+ * both faces count and degenerate triangles are never hit.
+ *
+ * @param ray the ray
+ * @param tris the triangles
+ * @param out storage for tris.size() hit distances, infinity for a miss
+ * @param tMax only hits within [0, tMax] count
+ */
+template<typename T>
+auto intersect(Ray<T> const & ray, TriangleArray<T> const & tris, T * out,
+               T const tMax = std::numeric_limits<T>::infinity()) -> void {
+  T const * ax = tris.vertices().getX();
+  T const * ay = tris.vertices().getY();
+  T const * az = tris.vertices().getZ();
+  T const * e1x = tris.edges1().getX();
+  T const * e1y = tris.edges1().getY();
+  T const * e1z = tris.edges1().getZ();
+  T const * e2x = tris.edges2().getX();
+  T const * e2y = tris.edges2().getY();
+  T const * e2z = tris.edges2().getZ();
+  detail::forEachPack<T>(tris.size(), [&](auto p, std::size_t const i) {
+    using P = decltype(p);
+    auto const dx = P::broadcast(ray.direction.x);
+    auto const dy = P::broadcast(ray.direction.y);
+    auto const dz = P::broadcast(ray.direction.z);
+    auto const ux = P::load(e1x + i);
+    auto const uy = P::load(e1y + i);
+    auto const uz = P::load(e1z + i);
+    auto const vx = P::load(e2x + i);
+    auto const vy = P::load(e2y + i);
+    auto const vz = P::load(e2z + i);
+
+    // p = d x e2, det = e1 . p
+    auto const px = dy * vz - dz * vy;
+    auto const py = dz * vx - dx * vz;
+    auto const pz = dx * vy - dy * vx;
+    auto const det = ux * px + uy * py + uz * pz;
+    auto const invDet = P::broadcast(T{1}) / det;
+
+    auto const sx = P::broadcast(ray.origin.x) - P::load(ax + i);
+    auto const sy = P::broadcast(ray.origin.y) - P::load(ay + i);
+    auto const sz = P::broadcast(ray.origin.z) - P::load(az + i);
+    auto const u = (sx * px + sy * py + sz * pz) * invDet;
+
+    // q = s x e1
+    auto const qx = sy * uz - sz * uy;
+    auto const qy = sz * ux - sx * uz;
+    auto const qz = sx * uy - sy * ux;
+    auto const v = (dx * qx + dy * qy + dz * qz) * invDet;
+    auto const t = (vx * qx + vy * qy + vz * qz) * invDet;
+
+    auto const zero = P::broadcast(T{0});
+    auto const one = P::broadcast(T{1});
+    auto const miss = P::broadcast(std::numeric_limits<T>::infinity());
+    auto hit = select(det * det > zero, t, miss);
+    hit = select(u < zero, miss, hit);
+    hit = select(u > one, miss, hit);
+    hit = select(v < zero, miss, hit);
+    hit = select(u + v > one, miss, hit);
+    hit = select(t < zero, miss, hit);
+    hit = select(t > P::broadcast(tMax), miss, hit);
+    hit.store(out + i);
+  });
+}
+
+} // namespace math
+} // namespace cagey
+
+#endif /* CAGEY_MATH_RAYPACKET_HH_ */
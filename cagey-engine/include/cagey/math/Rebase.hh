@@ -0,0 +1,150 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// cagey-engine - Toy 3D Engine
+// Copyright (c) 2014 Kyle Girard <theycallmecoach@gmail.com>
+//
+// The MIT License (MIT)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+
+/**
+ * @file
+ * Rebase double precision world positions to single precision positions
+ * relative to an origin, such as the camera.
+ */
+
+#ifndef CAGEY_MATH_REBASE_HH_
+#define CAGEY_MATH_REBASE_HH_
+
+#include <cstddef>
+
+#include "cagey/math/Point.hh"
+#include "cagey/math/Simd.hh"
+
+namespace cagey {
+namespace math {
+
+namespace detail {
+
+/**
+ * Subtract the origin from count packed xyz double triples and narrow the
+ * result to float.  Scalar fallback and tail of the SIMD kernels.
+ */
+inline auto rebase3(double const * in, double const * origin, float * out, std::size_t const count) -> void {
+  for (std::size_t i = 0; i < count; ++i, in += 3, out += 3) {
+    out[0] = static_cast<float>(in[0] - origin[0]);
+    out[1] = static_cast<float>(in[1] - origin[1]);
+    out[2] = static_cast<float>(in[2] - origin[2]);
+  }
+}
+
+#if defined(CAGEY_SIMD_AVX)
+
+/**
+ * AVX kernel.  Four xyz triples are twelve doubles, three registers whose
+ * lanes line up with three rotations of the origin, so no shuffles are
+ * needed before narrowing each register to four floats.
+ */
+inline auto rebase3Simd(double const * in, double const * origin, float * out, std::size_t const count) -> void {
+  __m256d const o0 = _mm256_setr_pd(origin[0], origin[1], origin[2], origin[0]);
+  __m256d const o1 = _mm256_setr_pd(origin[1], origin[2], origin[0], origin[1]);
+  __m256d const o2 = _mm256_setr_pd(origin[2], origin[0], origin[1], origin[2]);
+  std::size_t const blocks = count / 4;
+  for (std::size_t i = 0; i < blocks; ++i, in += 12, out += 12) {
+    _mm_storeu_ps(out, _mm256_cvtpd_ps(_mm256_sub_pd(_mm256_loadu_pd(in), o0)));
+    _mm_storeu_ps(out + 4, _mm256_cvtpd_ps(_mm256_sub_pd(_mm256_loadu_pd(in + 4), o1)));
+    _mm_storeu_ps(out + 8, _mm256_cvtpd_ps(_mm256_sub_pd(_mm256_loadu_pd(in + 8), o2)));
+  }
+  rebase3(in, origin, out, count % 4);
+}
+
+#elif defined(CAGEY_SIMD_SSE2)
+
+/**
+ * SSE kernel.  Four xyz triples are six registers of two doubles; each pair
+ * of registers is narrowed and merged into one register of four floats.
+ */
+inline auto rebase3Simd(double const * in, double const * origin, float * out, std::size_t const count) -> void {
+  __m128d const o0 = _mm_setr_pd(origin[0], origin[1]);
+  __m128d const o1 = _mm_setr_pd(origin[2], origin[0]);
+  __m128d const o2 = _mm_setr_pd(origin[1], origin[2]);
+  std::size_t const blocks = count / 4;
+  for (std::size_t i = 0; i < blocks; ++i, in += 12, out += 12) {
+    __m128 const a = _mm_cvtpd_ps(_mm_sub_pd(_mm_loadu_pd(in), o0));
+    __m128 const b = _mm_cvtpd_ps(_mm_sub_pd(_mm_loadu_pd(in + 2), o1));
+    __m128 const c = _mm_cvtpd_ps(_mm_sub_pd(_mm_loadu_pd(in + 4), o2));
+    __m128 const d = _mm_cvtpd_ps(_mm_sub_pd(_mm_loadu_pd(in + 6), o0));
+    __m128 const e = _mm_cvtpd_ps(_mm_sub_pd(_mm_loadu_pd(in + 8), o1));
+    __m128 const f = _mm_cvtpd_ps(_mm_sub_pd(_mm_loadu_pd(in + 10), o2));
+    _mm_storeu_ps(out, _mm_movelh_ps(a, b));
+    _mm_storeu_ps(out + 4, _mm_movelh_ps(c, d));
+    _mm_storeu_ps(out + 8, _mm_movelh_ps(e, f));
+  }
+  rebase3(in, origin, out, count % 4);
+}
+
+#else
+
+inline auto rebase3Simd(double const * in, double const * origin, float * out, std::size_t const count) -> void {
+  rebase3(in, origin, out, count);
+}
+
+#endif
+
+} // namespace detail
+
+/**
+ * Return the position of the given point relative to origin in single
+ * precision.  The difference is taken in double so only the final result
+ * is rounded: the error depends on the distance from origin, not on how
+ * far either point is from the world origin.
+ *
+ * @param pt the world position
+ * @param origin the new origin, usually the camera position
+ */
+inline auto rebase(Point3d const & pt, Point3d const & origin) -> Point3f {
+  return Point3f{static_cast<float>(pt.x - origin.x),
+                 static_cast<float>(pt.y - origin.y),
+                 static_cast<float>(pt.z - origin.z)};
+}
+
+/**
+ * Rebase an array of world positions to the given origin.  The results
+ * are identical to calling rebase() on each point.
+ *
+ * @param in pointer to the first of count points
+ * @param origin the new origin, usually the camera position
+ * @param out pointer to storage for count points
+ * @param count the number of points to rebase
+ */
+inline auto rebase(Point3d const * in, Point3d const & origin, Point3f * out, std::size_t const count) -> void {
+  /** @cond doxygen has an issue with static assert */
+  static_assert(sizeof(Point3d) == 3 * sizeof(double), "Point3d must be tightly packed");
+  static_assert(sizeof(Point3f) == 3 * sizeof(float), "Point3f must be tightly packed");
+  /** @endcond */
+  detail::rebase3Simd(reinterpret_cast<double const *>(in), origin.begin(), reinterpret_cast<float *>(out), count);
+}
+
+} // namespace math
+} // namespace cagey
+
+#endif /* CAGEY_MATH_REBASE_HH_ */
@@ -0,0 +1,316 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// cagey-engine - Toy 3D Engine
+// Copyright (c) 2014 Kyle Girard <theycallmecoach@gmail.com>
+//
+// The MIT License (MIT)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * @file
+ * Compile time selection of the SIMD instruction sets used by cagey::math.
+ *
+ * The instruction sets are picked up from the compiler flags (-msse2, -mavx
+ * etc.).  Define CAGEY_NO_SIMD to force every kernel onto its scalar path.
+ */
+
+#ifndef CAGEY_MATH_SIMD_HH_
+#define CAGEY_MATH_SIMD_HH_
+
+#if !defined(CAGEY_NO_SIMD)
+#  if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#    define CAGEY_SIMD_SSE2 1
+#  endif
+#  if defined(__AVX__)
+#    define CAGEY_SIMD_AVX 1
+#  endif
+#  if defined(__BMI2__)
+#    define CAGEY_SIMD_BMI2 1
+#  endif
+#endif
+
+#if defined(CAGEY_SIMD_AVX) || defined(CAGEY_SIMD_BMI2)
+#  include <immintrin.h>
+#elif defined(CAGEY_SIMD_SSE2)
+#  include <emmintrin.h>
+#endif
+
+#include <cstddef>
+#include <cmath>
+#include <algorithm>
+#include <type_traits>
+
+namespace cagey {
+namespace math {
+namespace detail {
+
+/**
+ * The number of elements of type T that fit in the widest available
+ * register.  1 for types without SIMD support.
+ */
+template<typename T> struct NativeWidth : std::integral_constant<std::size_t, 1> {};
+
+#if defined(CAGEY_SIMD_AVX)
+template<> struct NativeWidth<float> : std::integral_constant<std::size_t, 8> {};
+template<> struct NativeWidth<double> : std::integral_constant<std::size_t, 4> {};
+#elif defined(CAGEY_SIMD_SSE2)
+template<> struct NativeWidth<float> : std::integral_constant<std::size_t, 4> {};
+template<> struct NativeWidth<double> : std::integral_constant<std::size_t, 2> {};
+#endif
+
+/**
+ * A register's worth of W elements of type T.  Kernels written against
+ * Pack run unchanged on every width, W == 1 being plain scalar code.
+ * bits() packs a comparison Mask into an integer, one bit per lane with
+ * lane 0 in the lowest bit.
+ *
+ * @tparam T the element type
+ * @tparam W the number of elements
+ */
+template<typename T, std::size_t W = NativeWidth<T>::value> struct Pack;
+
+/**
+ * Scalar Pack, used for the tail of arrays and when no SIMD is available
+ */
+template<typename T>
+struct Pack<T, 1> {
+  /// element type
+  using Type = T;
+  /// number of elements in this pack
+  static constexpr std::size_t Width = 1;
+  /// result of a comparison
+  using Mask = bool;
+
+  /// the value
+  T v;
+
+  static auto load(T const * p) -> Pack { return Pack{*p}; }
+  static auto broadcast(T const x) -> Pack { return Pack{x}; }
+  static auto bits(Mask const m) -> unsigned { return m ? 1u : 0u; }
+  auto store(T * p) const -> void { *p = v; }
+
+  friend auto operator+(Pack a, Pack b) -> Pack { return Pack{a.v + b.v}; }
+  friend auto operator-(Pack a, Pack b) -> Pack { return Pack{a.v - b.v}; }
+  friend auto operator*(Pack a, Pack b) -> Pack { return Pack{a.v * b.v}; }
+  friend auto operator/(Pack a, Pack b) -> Pack { return Pack{a.v / b.v}; }
+  friend auto operator-(Pack a) -> Pack { return Pack{-a.v}; }
+  friend auto operator<(Pack a, Pack b) -> Mask { return a.v < b.v; }
+  friend auto operator>(Pack a, Pack b) -> Mask { return a.v > b.v; }
+  friend auto operator<=(Pack a, Pack b) -> Mask { return a.v <= b.v; }
+  friend auto sqrt(Pack a) -> Pack { using std::sqrt; return Pack{sqrt(a.v)}; }
+  friend auto min(Pack a, Pack b) -> Pack { return Pack{std::min(a.v, b.v)}; }
+  friend auto max(Pack a, Pack b) -> Pack { return Pack{std::max(a.v, b.v)}; }
+  friend auto select(Mask m, Pack a, Pack b) -> Pack { return m ? a : b; }
+  friend auto round(Pack a) -> Pack { using std::rint; return Pack{rint(a.v)}; }
+};
+
+#if defined(CAGEY_SIMD_SSE2)
+
+/**
+ * Four floats in an SSE register
+ */
+template<>
+struct Pack<float, 4> {
+  using Type = float;
+  static constexpr std::size_t Width = 4;
+  using Mask = __m128;
+
+  __m128 v;
+
+  static auto load(float const * p) -> Pack { return Pack{_mm_loadu_ps(p)}; }
+  static auto broadcast(float const x) -> Pack { return Pack{_mm_set1_ps(x)}; }
+  static auto bits(Mask const m) -> unsigned { return static_cast<unsigned>(_mm_movemask_ps(m)); }
+  auto store(float * p) const -> void { _mm_storeu_ps(p, v); }
+
+  friend auto operator+(Pack a, Pack b) -> Pack { return Pack{_mm_add_ps(a.v, b.v)}; }
+  friend auto operator-(Pack a, Pack b) -> Pack { return Pack{_mm_sub_ps(a.v, b.v)}; }
+  friend auto operator*(Pack a, Pack b) -> Pack { return Pack{_mm_mul_ps(a.v, b.v)}; }
+  friend auto operator/(Pack a, Pack b) -> Pack { return Pack{_mm_div_ps(a.v, b.v)}; }
+  friend auto operator-(Pack a) -> Pack { return Pack{_mm_xor_ps(a.v, _mm_set1_ps(-0.0f))}; }
+  friend auto operator<(Pack a, Pack b) -> Mask { return _mm_cmplt_ps(a.v, b.v); }
+  friend auto operator>(Pack a, Pack b) -> Mask { return _mm_cmpgt_ps(a.v, b.v); }
+  friend auto operator<=(Pack a, Pack b) -> Mask { return _mm_cmple_ps(a.v, b.v); }
+  friend auto sqrt(Pack a) -> Pack { return Pack{_mm_sqrt_ps(a.v)}; }
+  friend auto min(Pack a, Pack b) -> Pack { return Pack{_mm_min_ps(a.v, b.v)}; }
+  friend auto max(Pack a, Pack b) -> Pack { return Pack{_mm_max_ps(a.v, b.v)}; }
+  friend auto select(Mask m, Pack a, Pack b) -> Pack {
+    return Pack{_mm_or_ps(_mm_and_ps(m, a.v), _mm_andnot_ps(m, b.v))};
+  }
+  /// round to nearest, only valid for |a| < 2^31 as SSE2 has no float rounding
+  friend auto round(Pack a) -> Pack { return Pack{_mm_cvtepi32_ps(_mm_cvtps_epi32(a.v))}; }
+};
+
+/**
+ * Load four floats from p, which must be 16 byte aligned if Aligned is true
+ */
+template<bool Aligned>
+inline auto loadPs(float const * p) -> __m128 { return Aligned ? _mm_load_ps(p) : _mm_loadu_ps(p); }
+
+/**
+ * Store four floats to p, which must be 16 byte aligned if Aligned is true
+ */
+template<bool Aligned>
+inline auto storePs(float * p, __m128 const v) -> void {
+  if (Aligned) {
+    _mm_store_ps(p, v);
+  } else {
+    _mm_storeu_ps(p, v);
+  }
+}
+
+/**
+ * Two doubles in an SSE register
+ */
+template<>
+struct Pack<double, 2> {
+  using Type = double;
+  static constexpr std::size_t Width = 2;
+  using Mask = __m128d;
+
+  __m128d v;
+
+  static auto load(double const * p) -> Pack { return Pack{_mm_loadu_pd(p)}; }
+  static auto broadcast(double const x) -> Pack { return Pack{_mm_set1_pd(x)}; }
+  static auto bits(Mask const m) -> unsigned { return static_cast<unsigned>(_mm_movemask_pd(m)); }
+  auto store(double * p) const -> void { _mm_storeu_pd(p, v); }
+
+  friend auto operator+(Pack a, Pack b) -> Pack { return Pack{_mm_add_pd(a.v, b.v)}; }
+  friend auto operator-(Pack a, Pack b) -> Pack { return Pack{_mm_sub_pd(a.v, b.v)}; }
+  friend auto operator*(Pack a, Pack b) -> Pack { return Pack{_mm_mul_pd(a.v, b.v)}; }
+  friend auto operator/(Pack a, Pack b) -> Pack { return Pack{_mm_div_pd(a.v, b.v)}; }
+  friend auto operator-(Pack a) -> Pack { return Pack{_mm_xor_pd(a.v, _mm_set1_pd(-0.0))}; }
+  friend auto operator<(Pack a, Pack b) -> Mask { return _mm_cmplt_pd(a.v, b.v); }
+  friend auto operator>(Pack a, Pack b) -> Mask { return _mm_cmpgt_pd(a.v, b.v); }
+  friend auto operator<=(Pack a, Pack b) -> Mask { return _mm_cmple_pd(a.v, b.v); }
+  friend auto sqrt(Pack a) -> Pack { return Pack{_mm_sqrt_pd(a.v)}; }
+  friend auto min(Pack a, Pack b) -> Pack { return Pack{_mm_min_pd(a.v, b.v)}; }
+  friend auto max(Pack a, Pack b) -> Pack { return Pack{_mm_max_pd(a.v, b.v)}; }
+  friend auto select(Mask m, Pack a, Pack b) -> Pack {
+    return Pack{_mm_or_pd(_mm_and_pd(m, a.v), _mm_andnot_pd(m, b.v))};
+  }
+  /// round to nearest, only valid for |a| < 2^31 as SSE2 has no double rounding
+  friend auto round(Pack a) -> Pack { return Pack{_mm_cvtepi32_pd(_mm_cvtpd_epi32(a.v))}; }
+};
+
+#endif // CAGEY_SIMD_SSE2
+
+#if defined(CAGEY_SIMD_AVX)
+
+/**
+ * Eight floats in an AVX register
+ */
+template<>
+struct Pack<float, 8> {
+  using Type = float;
+  static constexpr std::size_t Width = 8;
+  using Mask = __m256;
+
+  __m256 v;
+
+  static auto load(float const * p) -> Pack { return Pack{_mm256_loadu_ps(p)}; }
+  static auto broadcast(float const x) -> Pack { return Pack{_mm256_set1_ps(x)}; }
+  static auto bits(Mask const m) -> unsigned { return static_cast<unsigned>(_mm256_movemask_ps(m)); }
+  auto store(float * p) const -> void { _mm256_storeu_ps(p, v); }
+
+  friend auto operator+(Pack a, Pack b) -> Pack { return Pack{_mm256_add_ps(a.v, b.v)}; }
+  friend auto operator-(Pack a, Pack b) -> Pack { return Pack{_mm256_sub_ps(a.v, b.v)}; }
+  friend auto operator*(Pack a, Pack b) -> Pack { return Pack{_mm256_mul_ps(a.v, b.v)}; }
+  friend auto operator/(Pack a, Pack b) -> Pack { return Pack{_mm256_div_ps(a.v, b.v)}; }
+  friend auto operator-(Pack a) -> Pack { return Pack{_mm256_xor_ps(a.v, _mm256_set1_ps(-0.0f))}; }
+  friend auto operator<(Pack a, Pack b) -> Mask { return _mm256_cmp_ps(a.v, b.v, _CMP_LT_OQ); }
+  friend auto operator>(Pack a, Pack b) -> Mask { return _mm256_cmp_ps(a.v, b.v, _CMP_GT_OQ); }
+  friend auto operator<=(Pack a, Pack b) -> Mask { return _mm256_cmp_ps(a.v, b.v, _CMP_LE_OQ); }
+  friend auto sqrt(Pack a) -> Pack { return Pack{_mm256_sqrt_ps(a.v)}; }
+  friend auto min(Pack a, Pack b) -> Pack { return Pack{_mm256_min_ps(a.v, b.v)}; }
+  friend auto max(Pack a, Pack b) -> Pack { return Pack{_mm256_max_ps(a.v, b.v)}; }
+  friend auto select(Mask m, Pack a, Pack b) -> Pack { return Pack{_mm256_blendv_ps(b.v, a.v, m)}; }
+  friend auto round(Pack a) -> Pack { return Pack{_mm256_round_ps(a.v, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC)}; }
+};
+
+/**
+ * Four doubles in an AVX register
+ */
+template<>
+struct Pack<double, 4> {
+  using Type = double;
+  static constexpr std::size_t Width = 4;
+  using Mask = __m256d;
+
+  __m256d v;
+
+  static auto load(double const * p) -> Pack { return Pack{_mm256_loadu_pd(p)}; }
+  static auto broadcast(double const x) -> Pack { return Pack{_mm256_set1_pd(x)}; }
+  static auto bits(Mask const m) -> unsigned { return static_cast<unsigned>(_mm256_movemask_pd(m)); }
+  auto store(double * p) const -> void { _mm256_storeu_pd(p, v); }
+
+  friend auto operator+(Pack a, Pack b) -> Pack { return Pack{_mm256_add_pd(a.v, b.v)}; }
+  friend auto operator-(Pack a, Pack b) -> Pack { return Pack{_mm256_sub_pd(a.v, b.v)}; }
+  friend auto operator*(Pack a, Pack b) -> Pack { return Pack{_mm256_mul_pd(a.v, b.v)}; }
+  friend auto operator/(Pack a, Pack b) -> Pack { return Pack{_mm256_div_pd(a.v, b.v)}; }
+  friend auto operator-(Pack a) -> Pack { return Pack{_mm256_xor_pd(a.v, _mm256_set1_pd(-0.0))}; }
+  friend auto operator<(Pack a, Pack b) -> Mask { return _mm256_cmp_pd(a.v, b.v, _CMP_LT_OQ); }
+  friend auto operator>(Pack a, Pack b) -> Mask { return _mm256_cmp_pd(a.v, b.v, _CMP_GT_OQ); }
+  friend auto operator<=(Pack a, Pack b) -> Mask { return _mm256_cmp_pd(a.v, b.v, _CMP_LE_OQ); }
+  friend auto sqrt(Pack a) -> Pack { return Pack{_mm256_sqrt_pd(a.v)}; }
+  friend auto min(Pack a, Pack b) -> Pack { return Pack{_mm256_min_pd(a.v, b.v)}; }
+  friend auto max(Pack a, Pack b) -> Pack { return Pack{_mm256_max_pd(a.v, b.v)}; }
+  friend auto select(Mask m, Pack a, Pack b) -> Pack { return Pack{_mm256_blendv_pd(b.v, a.v, m)}; }
+  friend auto round(Pack a) -> Pack { return Pack{_mm256_round_pd(a.v, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC)}; }
+};
+
+#endif // CAGEY_SIMD_AVX
+
+/**
+ * The widest available Pack width no larger than N, for arrays whose size
+ * is known at compile time.
+ */
+template<typename T, std::size_t N, std::size_t W = NativeWidth<T>::value>
+struct FitWidth : std::conditional_t<(W <= N), std::integral_constant<std::size_t, W>, FitWidth<T, N, W / 2>> {};
+
+template<typename T, std::size_t N>
+struct FitWidth<T, N, 1> : std::integral_constant<std::size_t, 1> {};
+
+/**
+ * Call f(Pack, index) over [0, count).  The bulk of the range is visited a
+ * full native register at a time, the remainder one element at a time.
+ *
+ * @param count the number of elements
+ * @param f a generic callable taking a Pack (only its type is meaningful)
+ *          and the index of the first element it covers
+ */
+template<typename T, typename F>
+inline auto forEachPack(std::size_t const count, F && f) -> void {
+  using Wide = Pack<T>;
+  std::size_t i = 0;
+  for (; i + Wide::Width <= count; i += Wide::Width) {
+    f(Wide{}, i);
+  }
+  for (; i < count; ++i) {
+    f(Pack<T, 1>{}, i);
+  }
+}
+
+} // namespace detail
+} // namespace math
+} // namespace cagey
+
+#endif /* CAGEY_MATH_SIMD_HH_ */
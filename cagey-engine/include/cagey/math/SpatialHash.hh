@@ -0,0 +1,374 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// cagey-engine - Toy 3D Engine
+// Copyright (c) 2014 Kyle Girard <theycallmecoach@gmail.com>
+//
+// The MIT License (MIT)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * @file
+ * @ref cagey::math::SpatialHash uniform grid.
+ */
+
+#ifndef CAGEY_MATH_SPATIALHASH_HH_
+#define CAGEY_MATH_SPATIALHASH_HH_
+
+#include <cstddef>
+#include <cstdint>
+#include <algorithm>
+#include <numeric>
+#include <type_traits>
+#include <vector>
+
+#include "cagey/math/Point.hh"
+#include "cagey/math/RadixSort.hh"
+
+namespace cagey {
+namespace math {
+
+/**
+ * A contiguous run of point indices
+ */
+struct IndexRange {
+  std::uint32_t const * first;
+  std::uint32_t const * last;
+
+  constexpr auto begin() const noexcept -> std::uint32_t const * { return first; }
+  constexpr auto end() const noexcept -> std::uint32_t const * { return last; }
+  constexpr auto size() const noexcept -> std::size_t { return static_cast<std::size_t>(last - first); }
+  constexpr auto empty() const noexcept -> bool { return first == last; }
+};
+
+/**
+ * Uniform grid over 2D or 3D points for proximity queries.  Points are
+ * quantized to integer cells, the cells hashed into a table about twice
+ * the size of the point set and the points radix sorted by bucket, so every
+ * bucket is a contiguous range of indices.  Rebuilding reuses its buffers,
+ * making it cheap to do every frame.
+ *
+ * Distinct cells may share a bucket, so raw bucket ranges can hold points
+ * from elsewhere; queryAabb and queryRadius filter those out by cell, which
+ * also keeps a shared bucket from reporting a point twice.  Queries allocate
+ * nothing.
+ *
+ * @tparam T underlying floating point type
+ * @tparam N the number of dimensions, 2 or 3
+ */
+template<typename T, std::size_t N>
+class SpatialHash {
+public:
+  /** @cond doxygen has some issues with static assert */
+  static_assert(std::is_floating_point<T>::value, "Underlying type must be floating point");
+  static_assert(N == 2 || N == 3, "SpatialHash supports 2 or 3 dimensions");
+  /** @endcond */
+
+  /// The underlying type of this SpatialHash
+  using Type = T;
+  using PointType = Point<T, N>;
+  using CellType = Point<int, N>;
+
+  /**
+   * Construct an empty hash
+   *
+   * @param cellSize the edge length of a cell, typically the query radius
+   */
+  explicit SpatialHash(T cellSize);
+
+  /**
+   * Replace the contents with count points
+   */
+  auto rebuild(PointType const * points, std::size_t count) -> void;
+
+  /**
+   * Replace the contents with the given points
+   */
+  auto rebuild(std::vector<PointType> const & points) -> void { rebuild(points.data(), points.size()); }
+
+  /**
+   * Return the edge length of a cell
+   */
+  auto cellSize() const noexcept -> T { return mCellSize; }
+
+  /**
+   * Return the number of points
+   */
+  auto size() const noexcept -> std::size_t { return mIndices.size(); }
+
+  /**
+   * Return the point indices sorted by bucket
+   */
+  auto indices() const noexcept -> std::vector<std::uint32_t> const & { return mIndices; }
+
+  /**
+   * Return the cell the given point falls in.  Coordinates more than 2^30
+   * cells from the origin are clamped to that bound and NaN maps to 0.
+   */
+  auto cellOf(PointType const & pt) const -> CellType;
+
+  /**
+   * Return the indices in the bucket of the given cell.  This includes
+   * every point in the cell and possibly some from colliding cells.
+   */
+  auto bucket(CellType const & cell) const -> IndexRange;
+
+  /**
+   * Call f(IndexRange) with the bucket of each cell overlapping the box
+   * [lo, hi].  Colliding cells share a bucket, so a range can come up more
+   * than once.  Boxes covering more cells than there are buckets get a
+   * single range holding every point instead.
+   */
+  template<typename F>
+  auto forEachBucket(PointType const & lo, PointType const & hi, F && f) const -> void;
+
+  /**
+   * Call f(index) for every point inside the box [lo, hi]
+   */
+  template<typename F>
+  auto queryAabb(PointType const & lo, PointType const & hi, F && f) const -> void;
+
+  /**
+   * Call f(index) for every point within radius of center
+   */
+  template<typename F>
+  auto queryRadius(PointType const & center, T radius, F && f) const -> void;
+
+private:
+  auto hash(CellType const & cell) const noexcept -> std::uint32_t;
+
+  template<typename F>
+  auto forEachCell(PointType const & lo, PointType const & hi, F && f) const -> bool;
+
+  template<typename F>
+  auto forEachCandidate(PointType const & lo, PointType const & hi, F && f) const -> void;
+
+  T mCellSize;
+  T mInvCellSize;
+  std::uint32_t mMask = 0;
+  unsigned mBits = 0;
+  std::vector<std::uint32_t> mIndices;
+  /// the points in mIndices order
+  std::vector<PointType> mPoints;
+  /// bucket b holds mIndices[mStart[b], mStart[b + 1])
+  std::vector<std::uint32_t> mStart;
+  std::vector<std::uint32_t> mKeys;
+  std::vector<std::uint32_t> mKeysTmp;
+  std::vector<std::uint32_t> mIndicesTmp;
+};
+
+using SpatialHash2f = SpatialHash<float, 2>;
+using SpatialHash2d = SpatialHash<double, 2>;
+using SpatialHash3f = SpatialHash<float, 3>;
+using SpatialHash3d = SpatialHash<double, 3>;
+
+template<typename T, std::size_t N>
+SpatialHash<T, N>::SpatialHash(T const cellSize) : mCellSize(cellSize), mInvCellSize(T{1} / cellSize) {}
+
+template<typename T, std::size_t N>
+auto SpatialHash<T, N>::cellOf(PointType const & pt) const -> CellType {
+  // well inside int, so neighbouring cells and extents never overflow
+  T const limit = T(1 << 30);
+  CellType cell;
+  for (std::size_t i = 0; i < N; ++i) {
+    T scaled = pt[i] * mInvCellSize;
+    // NaN fails every comparison, so it has to be caught before the clamp
+    if (scaled != scaled) {
+      scaled = T{0};
+    }
+    scaled = std::min(std::max(scaled, -limit), limit);
+    // floor without the libm call, truncation rounds negatives up
+    int const truncated = static_cast<int>(scaled);
+    cell[i] = truncated - (scaled < static_cast<T>(truncated));
+  }
+  return cell;
+}
+
+template<typename T, std::size_t N>
+auto SpatialHash<T, N>::hash(CellType const & cell) const noexcept -> std::uint32_t {
+  static constexpr std::uint32_t Primes[] = {73856093u, 19349663u, 83492791u};
+  std::uint32_t h = 0;
+  for (std::size_t i = 0; i < N; ++i) {
+    h ^= static_cast<std::uint32_t>(cell[i]) * Primes[i];
+  }
+  return h & mMask;
+}
+
+template<typename T, std::size_t N>
+auto SpatialHash<T, N>::rebuild(PointType const * points, std::size_t const count) -> void {
+  mBits = 4;
+  while ((std::size_t{1} << mBits) < 2 * count) {
+    ++mBits;
+  }
+  mMask = (1u << mBits) - 1;
+
+  mKeys.resize(count);
+  mIndices.resize(count);
+  mKeysTmp.resize(count);
+  mIndicesTmp.resize(count);
+  for (std::size_t i = 0; i < count; ++i) {
+    mKeys[i] = hash(cellOf(points[i]));
+  }
+  std::iota(mIndices.begin(), mIndices.end(), 0u);
+  detail::radixSortPairs(mKeys.data(), mIndices.data(), mKeysTmp.data(), mIndicesTmp.data(), count, mBits);
+
+  // the keys are sorted so bucket starts fill in a single forward pass
+  mStart.resize(std::size_t{mMask} + 2);
+  std::size_t next = 0;
+  for (std::uint32_t i = 0; i < count; ++i) {
+    for (; next <= mKeys[i]; ++next) {
+      mStart[next] = i;
+    }
+  }
+  std::fill(mStart.begin() + static_cast<std::ptrdiff_t>(next), mStart.end(), static_cast<std::uint32_t>(count));
+
+  mPoints.resize(count);
+  for (std::size_t i = 0; i < count; ++i) {
+    mPoints[i] = points[mIndices[i]];
+  }
+}
+
+template<typename T, std::size_t N>
+auto SpatialHash<T, N>::bucket(CellType const & cell) const -> IndexRange {
+  if (mIndices.empty()) {
+    return IndexRange{nullptr, nullptr};
+  }
+  auto const key = hash(cell);
+  return IndexRange{mIndices.data() + mStart[key], mIndices.data() + mStart[key + 1]};
+}
+
+/**
+ * Call f(cell, begin, end) for each cell overlapping [lo, hi] with its
+ * bucket as offsets into mIndices, cells stepping through x fastest.
+ * Returns false, having called nothing, when the box covers more cells than
+ * there are buckets so callers can scan every point instead.
+ */
+template<typename T, std::size_t N>
+template<typename F>
+auto SpatialHash<T, N>::forEachCell(PointType const & lo, PointType const & hi, F && f) const -> bool {
+  CellType const first = cellOf(lo);
+  CellType const last = cellOf(hi);
+  double cells = 1.0;
+  for (std::size_t i = 0; i < N; ++i) {
+    if (last[i] < first[i]) {
+      return true;
+    }
+    cells *= static_cast<double>(last[i]) - first[i] + 1.0;
+  }
+  if (cells > static_cast<double>(mMask)) {
+    return false;
+  }
+  CellType cell = first;
+  for (;;) {
+    auto const key = hash(cell);
+    if (mStart[key] != mStart[key + 1]) {
+      f(cell, mStart[key], mStart[key + 1]);
+    }
+    std::size_t i = 0;
+    for (; i < N && cell[i] == last[i]; ++i) {
+      cell[i] = first[i];
+    }
+    if (i == N) {
+      return true;
+    }
+    ++cell[i];
+  }
+}
+
+/**
+ * Call f(offset) for every point whose cell overlaps [lo, hi], each once.
+ * Points are matched to the cell being visited, so a bucket shared by two
+ * cells in the box yields each of its points for its own cell only.
+ */
+template<typename T, std::size_t N>
+template<typename F>
+auto SpatialHash<T, N>::forEachCandidate(PointType const & lo, PointType const & hi, F && f) const -> void {
+  if (mIndices.empty()) {
+    return;
+  }
+  bool const fits = forEachCell(lo, hi, [&](CellType const & cell, std::uint32_t const begin, std::uint32_t const end) {
+    for (auto i = begin; i < end; ++i) {
+      if (cellOf(mPoints[i]) == cell) {
+        f(i);
+      }
+    }
+  });
+  if (!fits) {
+    for (std::uint32_t i = 0; i < mIndices.size(); ++i) {
+      f(i);
+    }
+  }
+}
+
+template<typename T, std::size_t N>
+template<typename F>
+auto SpatialHash<T, N>::forEachBucket(PointType const & lo, PointType const & hi, F && f) const -> void {
+  if (mIndices.empty()) {
+    return;
+  }
+  bool const fits = forEachCell(lo, hi, [this, &f](CellType const &, std::uint32_t const begin, std::uint32_t const end) {
+    f(IndexRange{mIndices.data() + begin, mIndices.data() + end});
+  });
+  if (!fits) {
+    f(IndexRange{mIndices.data(), mIndices.data() + mIndices.size()});
+  }
+}
+
+template<typename T, std::size_t N>
+template<typename F>
+auto SpatialHash<T, N>::queryAabb(PointType const & lo, PointType const & hi, F && f) const -> void {
+  forEachCandidate(lo, hi, [&](std::uint32_t const i) {
+    bool inside = true;
+    for (std::size_t d = 0; d < N; ++d) {
+      inside = inside && mPoints[i][d] >= lo[d] && mPoints[i][d] <= hi[d];
+    }
+    if (inside) {
+      f(mIndices[i]);
+    }
+  });
+}
+
+template<typename T, std::size_t N>
+template<typename F>
+auto SpatialHash<T, N>::queryRadius(PointType const & center, T const radius, F && f) const -> void {
+  PointType lo;
+  PointType hi;
+  for (std::size_t d = 0; d < N; ++d) {
+    lo[d] = center[d] - radius;
+    hi[d] = center[d] + radius;
+  }
+  T const radiusSquared = radius * radius;
+  forEachCandidate(lo, hi, [&](std::uint32_t const i) {
+    T distance = T{0};
+    for (std::size_t d = 0; d < N; ++d) {
+      T const delta = mPoints[i][d] - center[d];
+      distance += delta * delta;
+    }
+    if (distance <= radiusSquared) {
+      f(mIndices[i]);
+    }
+  });
+}
+
+} // namespace math
+} // namespace cagey
+
+#endif /* CAGEY_MATH_SPATIALHASH_HH_ */
@@ -0,0 +1,157 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// cagey-engine - Toy 3D Engine
+// Copyright (c) 2014 Kyle Girard <theycallmecoach@gmail.com>
+//
+// The MIT License (MIT)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+
+/**
+ * @file
+ * @ref cagey::math::Sphere class.
+ */
+
+#ifndef CAGEY_MATH_SPHERE_HH_
+#define CAGEY_MATH_SPHERE_HH_
+
+#include <algorithm>
+#include <cmath>
+#include <type_traits>
+#include <iostream>
+
+#include "cagey/math/Point.hh"
+#include "cagey/math/Aabb.hh"
+
+namespace cagey {
+namespace math {
+
+/**
+ * Bounding sphere given by its center and radius.
+ *
+ * @tparam T underlying floating point type
+ */
+template<typename T>
+class Sphere {
+public:
+  /** @cond doxygen has some issues with static assert */
+  static_assert(std::is_floating_point<T>::value, "Underlying type must be floating point");
+  /** @endcond */
+
+  /// The underlying type of this Sphere
+  using Type = T;
+
+  /**
+   * Construct a zero radius sphere at the origin
+   */
+  constexpr Sphere() noexcept = default;
+
+  /**
+   * Construct a sphere
+   *
+   * @param c the center
+   * @param r the radius
+   */
+  constexpr Sphere(Point3<T> const & c, T const r) noexcept : center(c), radius(r) {}
+
+public:
+  Point3<T> center; ///< The center of the sphere
+  T radius{};       ///< The radius of the sphere
+};
+
+using Spheref = Sphere<float>;
+using Sphered = Sphere<double>;
+
+namespace detail {
+
+template<typename T>
+auto distanceSquared(Point3<T> const & lhs, Point3<T> const & rhs) -> T {
+  T const dx = lhs.x - rhs.x;
+  T const dy = lhs.y - rhs.y;
+  T const dz = lhs.z - rhs.z;
+  return dx * dx + dy * dy + dz * dz;
+}
+
+} // namespace detail
+
+/**
+ * Return the sphere enclosing the given box
+ */
+template<typename T>
+auto boundingSphere(Aabb<T> const & box) -> Sphere<T> {
+  using std::sqrt;
+  auto const e = extents(box);
+  return Sphere<T>{center(box), sqrt(e.x * e.x + e.y * e.y + e.z * e.z)};
+}
+
+/**
+ * Return true if the point lies inside or on the sphere
+ */
+template<typename T>
+auto contains(Sphere<T> const & sphere, Point3<T> const & pt) -> bool {
+  return detail::distanceSquared(sphere.center, pt) <= sphere.radius * sphere.radius;
+}
+
+/**
+ * Return true if the spheres overlap or touch
+ */
+template<typename T>
+auto intersects(Sphere<T> const & lhs, Sphere<T> const & rhs) -> bool {
+  T const r = lhs.radius + rhs.radius;
+  return detail::distanceSquared(lhs.center, rhs.center) <= r * r;
+}
+
+/**
+ * Return true if the sphere and box overlap or touch
+ */
+template<typename T>
+auto intersects(Sphere<T> const & sphere, Aabb<T> const & box) -> bool {
+  using std::min;
+  using std::max;
+  Point3<T> const closest{max(box.min.x, min(sphere.center.x, box.max.x)),
+                          max(box.min.y, min(sphere.center.y, box.max.y)),
+                          max(box.min.z, min(sphere.center.z, box.max.z))};
+  return contains(sphere, closest);
+}
+
+template<typename T>
+auto operator==(Sphere<T> const & lhs, Sphere<T> const & rhs) -> bool {
+  return lhs.center == rhs.center && lhs.radius == rhs.radius;
+}
+
+template<typename T>
+auto operator!=(Sphere<T> const & lhs, Sphere<T> const & rhs) -> bool {
+  return !(lhs == rhs);
+}
+
+/**
+ * Output the given sphere to the given output stream
+ */
+template<typename T>
+auto operator<<(std::ostream & os, Sphere<T> const & sphere) -> std::ostream & {
+  return os << "Sphere(" << sphere.center << ", " << sphere.radius << ")";
+}
+
+} // namespace math
+} // namespace cagey
+
+#endif /* CAGEY_MATH_SPHERE_HH_ */
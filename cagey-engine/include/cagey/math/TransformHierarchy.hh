@@ -0,0 +1,310 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// cagey-engine - Toy 3D Engine
+// Copyright (c) 2014 Kyle Girard <theycallmecoach@gmail.com>
+//
+// The MIT License (MIT)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+
+/**
+ * @file
+ * @ref cagey::math::TransformHierarchy flat scene graph.
+ */
+
+#ifndef CAGEY_MATH_TRANSFORMHIERARCHY_HH_
+#define CAGEY_MATH_TRANSFORMHIERARCHY_HH_
+
+#include <cstddef>
+#include <cstdint>
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <limits>
+#include <vector>
+
+#include "cagey/math/Matrix.hh"
+#include "cagey/math/Parallel.hh"
+#include "cagey/core/Exception.hh"
+
+namespace cagey {
+namespace math {
+
+/**
+ * Parent/child transform hierarchy stored as flat arrays.  Nodes are only
+ * ever appended below an existing parent, so every parent precedes its
+ * children and a single forward pass computes world matrices.  Changing a
+ * local transform marks the node dirty; update() recomputes the world
+ * matrices of dirty nodes and their descendants only.
+ *
+ * Nodes are also grouped by depth so update() can process a level at a
+ * time across a ThreadPool, waiting for each level before starting the
+ * next.  Each world matrix is computed by the same kernel
+ * from the same inputs either way, so threaded results match the serial
+ * ones bit for bit.
+ *
+ * @tparam T underlying type
+ */
+template<typename T>
+class TransformHierarchy {
+public:
+  /// Parent index of root nodes
+  enum : std::uint32_t { NoParent = std::numeric_limits<std::uint32_t>::max() };
+
+  /// The underlying type of this TransformHierarchy
+  using Type = T;
+
+  /**
+   * Append a node
+   *
+   * @param parent index of an existing node or NoParent
+   * @param local the transform relative to the parent
+   * @return the index of the new node
+   */
+  auto add(std::uint32_t parent, Mat4<T> const & local = Mat4<T>{}) -> std::uint32_t;
+
+  /**
+   * Reserve space for count nodes
+   */
+  auto reserve(std::size_t count) -> void;
+
+  /**
+   * Replace the local transform of a node, its subtree is updated on the
+   * next call to update()
+   */
+  auto setLocal(std::uint32_t index, Mat4<T> const & local) -> void;
+
+  /**
+   * Recompute the world transforms of dirty subtrees on the calling thread
+   *
+   * @return the number of nodes whose world transform was recomputed
+   */
+  auto update() -> std::size_t;
+
+  /**
+   * Recompute the world transforms of dirty subtrees level by level on the
+   * given pool.  The pool outlives the call so frames do not pay for thread
+   * creation.
+   *
+   * @param pool the threads to share each level across
+   * @return the number of nodes whose world transform was recomputed
+   */
+  auto update(ThreadPool & pool) -> std::size_t;
+
+  /**
+   * Return the number of nodes recomputed by the last update()
+   */
+  auto updatedCount() const noexcept -> std::size_t { return mUpdated; }
+
+  /**
+   * Return the number of nodes
+   */
+  auto size() const noexcept -> std::size_t { return mParents.size(); }
+
+  /**
+   * Return the number of levels, one more than the deepest node's depth
+   */
+  auto levels() const noexcept -> std::size_t { return mLevels.size(); }
+
+  /**
+   * Return the depth of a node, 0 for roots
+   */
+  auto depth(std::uint32_t const index) const -> std::uint32_t { return mDepths[index]; }
+
+  /**
+   * Return the parent of a node or NoParent
+   */
+  auto parent(std::uint32_t const index) const -> std::uint32_t { return mParents[index]; }
+
+  /**
+   * Return the local transform of a node
+   */
+  auto local(std::uint32_t const index) const -> Mat4<T> const & { return mLocal[index]; }
+
+  /**
+   * Return the world transform of a node as of the last update()
+   */
+  auto world(std::uint32_t const index) const -> Mat4<T> const & { return mWorld[index]; }
+
+  /**
+   * Return true if the node changed since the last update()
+   */
+  auto isDirty(std::uint32_t const index) const -> bool { return mDirty[index] != 0; }
+
+private:
+  /// Nodes per chunk when a level is split across threads
+  static constexpr std::size_t Grain = 256;
+
+  auto markDirty(std::uint32_t index) -> void;
+  auto updateSerial() -> std::size_t;
+  auto updateLevels(ThreadPool & pool) -> std::size_t;
+  auto finishUpdate(std::size_t updated) -> std::size_t;
+
+  std::vector<std::uint32_t> mParents;
+  std::vector<std::uint32_t> mDepths;
+  /// node indices by depth, each level in ascending order
+  std::vector<std::vector<std::uint32_t>> mLevels;
+  std::vector<Mat4<T>> mLocal;
+  std::vector<Mat4<T>> mWorld;
+  /// bytes rather than vector<bool> so flags are cheap to test and set
+  std::vector<std::uint8_t> mDirty;
+  /// no node before this one is dirty
+  std::size_t mFirstDirty = 0;
+  std::size_t mUpdated = 0;
+};
+
+using TransformHierarchyf = TransformHierarchy<float>;
+using TransformHierarchyd = TransformHierarchy<double>;
+
+template<typename T>
+auto TransformHierarchy<T>::add(std::uint32_t const parent, Mat4<T> const & local) -> std::uint32_t {
+  if (parent != NoParent && parent >= mParents.size()) {
+    BOOST_THROW_EXCEPTION(core::IndexOutOfBoundsException() << core::ThrowMsg("Parent node does not exist"));
+  }
+  auto const index = static_cast<std::uint32_t>(mParents.size());
+  auto const depth = parent == NoParent ? 0u : mDepths[parent] + 1;
+  if (depth == mLevels.size()) {
+    mLevels.emplace_back();
+  }
+  mLevels[depth].push_back(index);
+  mParents.push_back(parent);
+  mDepths.push_back(depth);
+  mLocal.push_back(local);
+  mWorld.push_back(local);
+  mDirty.push_back(0);
+  markDirty(index);
+  return index;
+}
+
+template<typename T>
+auto TransformHierarchy<T>::reserve(std::size_t const count) -> void {
+  mParents.reserve(count);
+  mDepths.reserve(count);
+  mLocal.reserve(count);
+  mWorld.reserve(count);
+  mDirty.reserve(count);
+}
+
+template<typename T>
+auto TransformHierarchy<T>::setLocal(std::uint32_t const index, Mat4<T> const & local) -> void {
+  assert(index < mParents.size());
+  mLocal[index] = local;
+  markDirty(index);
+}
+
+template<typename T>
+auto TransformHierarchy<T>::markDirty(std::uint32_t const index) -> void {
+  mFirstDirty = std::min<std::size_t>(mFirstDirty, index);
+  mDirty[index] = 1;
+}
+
+template<typename T>
+auto TransformHierarchy<T>::update() -> std::size_t {
+  return finishUpdate(updateSerial());
+}
+
+template<typename T>
+auto TransformHierarchy<T>::update(ThreadPool & pool) -> std::size_t {
+  return finishUpdate(pool.size() == 1 ? updateSerial() : updateLevels(pool));
+}
+
+/**
+ * Clear the dirty flags the pass consumed
+ */
+template<typename T>
+auto TransformHierarchy<T>::finishUpdate(std::size_t const updated) -> std::size_t {
+  auto const count = mParents.size();
+  if (mFirstDirty < count) {
+    std::fill(mDirty.begin() + static_cast<std::ptrdiff_t>(mFirstDirty), mDirty.end(), std::uint8_t{0});
+  }
+  mFirstDirty = count;
+  mUpdated = updated;
+  return updated;
+}
+
+/**
+ * Dirtiness is pushed down in the same pass: a parent is always visited,
+ * and its flag settled, before any of its children.
+ */
+template<typename T>
+auto TransformHierarchy<T>::updateSerial() -> std::size_t {
+  std::size_t updated = 0;
+  auto const count = mParents.size();
+  for (auto i = mFirstDirty; i < count; ++i) {
+    auto const parent = mParents[i];
+    if (parent != NoParent && mDirty[parent]) {
+      mDirty[i] = 1;
+    }
+    if (!mDirty[i]) {
+      continue;
+    }
+    if (parent == NoParent) {
+      mWorld[i] = mLocal[i];
+    } else {
+      detail::mul4x4(mWorld[parent].begin(), mLocal[i].begin(), mWorld[i].begin());
+    }
+    ++updated;
+  }
+  return updated;
+}
+
+/**
+ * One parallel pass per level.  ThreadPool::parallelFor() returns only when
+ * the whole level is done, so parents, one level up, have final flags and
+ * world matrices before any child reads them.  Nodes before
+ * mFirstDirty are clean and skipped by searching each sorted level.
+ */
+template<typename T>
+auto TransformHierarchy<T>::updateLevels(ThreadPool & pool) -> std::size_t {
+  std::atomic<std::size_t> updated{0};
+  for (auto const & level : mLevels) {
+    auto const first = std::lower_bound(level.begin(), level.end(), mFirstDirty) - level.begin();
+    std::uint32_t const * nodes = level.data() + first;
+    auto const count = level.size() - static_cast<std::size_t>(first);
+    pool.parallelFor(count, Grain, [&](std::size_t const begin, std::size_t const end) {
+      std::size_t local = 0;
+      for (auto n = begin; n < end; ++n) {
+        auto const i = nodes[n];
+        auto const parent = mParents[i];
+        if (parent != NoParent && mDirty[parent]) {
+          mDirty[i] = 1;
+        }
+        if (!mDirty[i]) {
+          continue;
+        }
+        if (parent == NoParent) {
+          mWorld[i] = mLocal[i];
+        } else {
+          detail::mul4x4(mWorld[parent].begin(), mLocal[i].begin(), mWorld[i].begin());
+        }
+        ++local;
+      }
+      updated += local;
+    });
+  }
+  return updated;
+}
+
+} // namespace math
+} // namespace cagey
+
+#endif /* CAGEY_MATH_TRANSFORMHIERARCHY_HH_ */
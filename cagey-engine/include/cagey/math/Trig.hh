@@ -0,0 +1,286 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// cagey-engine - Toy 3D Engine
+// Copyright (c) 2014 Kyle Girard <theycallmecoach@gmail.com>
+//
+// The MIT License (MIT)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+
+/**
+ * @file
+ * sin, cos and tan of Radian and Degree with a selectable precision.
+ */
+
+#ifndef CAGEY_MATH_TRIG_HH_
+#define CAGEY_MATH_TRIG_HH_
+
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <type_traits>
+
+#include "cagey/math/Radian.hh"
+#include "cagey/math/Degree.hh"
+#include "cagey/math/Simd.hh"
+
+namespace cagey {
+namespace math {
+
+/**
+ * How accurately sin, cos and tan are evaluated.  The polynomial policies
+ * reduce the angle by multiples of pi/2 and hold their bounds for angles
+ * smaller than 8192 radians in magnitude.
+ */
+enum class Precision {
+  Exact, ///< std::sin and std::cos
+  High,  ///< polynomial, absolute error below 1e-6
+  Fast   ///< polynomial, absolute error below 1e-3
+};
+
+/**
+ * The sine and cosine of one angle
+ */
+template<typename T>
+struct SinCos {
+  T sin; ///< the sine
+  T cos; ///< the cosine
+};
+
+namespace detail {
+
+/**
+ * floor built from round, valid over the same range as round
+ */
+template<typename P>
+inline auto floorPack(P const x) -> P {
+  using T = typename P::Type;
+  P const t = round(x);
+  return select(t > x, t - P::broadcast(T{1}), t);
+}
+
+/**
+ * Reduce x by q multiples of pi/2, with pi/2 split in three so the
+ * products with q are exact
+ */
+template<typename P>
+inline auto reduceHalfPi(P const x, P const q) -> P {
+  using T = typename P::Type;
+  return ((x - q * P::broadcast(T(1.5703125))) -
+          q * P::broadcast(T(4.837512969970703125e-4))) -
+          q * P::broadcast(T(7.54978995489188216e-8));
+}
+
+/**
+ * sin and cos of r in [-pi/4, pi/4] by polynomials
+ */
+template<Precision Prec, typename P>
+inline auto sincosPoly(P const r, P & s, P & c) -> void {
+  using T = typename P::Type;
+  P const r2 = r * r;
+  P const one = P::broadcast(T{1});
+  if (Prec == Precision::Fast) {
+    s = r + r * r2 * P::broadcast(T(-0.16225913));
+    c = one + r2 * (P::broadcast(T(-0.49977631)) + r2 * P::broadcast(T(0.040488936)));
+  } else {
+    //Cephes sinf and cosf minimax coefficients
+    s = P::broadcast(T(-1.9515295891e-4));
+    s = s * r2 + P::broadcast(T(8.3321608736e-3));
+    s = s * r2 + P::broadcast(T(-1.6666654611e-1));
+    s = r + s * r2 * r;
+    c = P::broadcast(T(2.443315711809948e-5));
+    c = c * r2 + P::broadcast(T(-1.388731625493765e-3));
+    c = c * r2 + P::broadcast(T(4.166664568298827e-2));
+    c = one - P::broadcast(T(0.5)) * r2 + c * r2 * r2;
+  }
+}
+
+/**
+ * sin and cos of a Pack of angles.  The polynomial results are swapped and
+ * negated by selects according to the quadrant q mod 4.
+ */
+template<Precision Prec, typename P>
+inline auto sincosPack(P const x, P & sinOut, P & cosOut) -> void {
+  using T = typename P::Type;
+  P const q = round(x * P::broadcast(T(0.636619772367581343076)));
+  P s;
+  P c;
+  sincosPoly<Prec>(reduceHalfPi(x, q), s, c);
+
+  // quadrant in {0, 1, 2, 3}
+  P const quad = q - P::broadcast(T{4}) * floorPack(q * P::broadcast(T(0.25)));
+  P const half = P::broadcast(T(0.5));
+  P const odd = quad - P::broadcast(T{2}) * floorPack(quad * half);
+  P const sinQ = select(odd > half, c, s);
+  P const cosQ = select(odd > half, s, c);
+  sinOut = select(quad > P::broadcast(T(1.5)), -sinQ, sinQ);
+  cosOut = select(quad > half, select(quad < P::broadcast(T(2.5)), -cosQ, cosQ), cosQ);
+}
+
+/**
+ * sin and cos of a single angle.  The quadrant is kept as an integer so the
+ * swap and signs are table lookups rather than unpredictable branches.
+ * q is rounded in floating point and reduced mod 4 before the integer
+ * conversion, so huge angles stay defined; NaN and infinity give NaN.
+ */
+template<Precision Prec, typename T>
+inline auto sincosScalar(T const x) -> SinCos<T> {
+  using P = Pack<T, 1>;
+  T const q = std::nearbyint(x * T(0.636619772367581343076));
+  if (!std::isfinite(q)) {
+    T const nan = std::numeric_limits<T>::quiet_NaN();
+    return SinCos<T>{nan, nan};
+  }
+  P s;
+  P c;
+  sincosPoly<Prec>(reduceHalfPi(P{x}, P{q}), s, c);
+  T const vals[2] = {s.v, c.v};
+  auto const quad = static_cast<int>(q - T{4} * std::floor(q * T(0.25)));
+  auto const odd = quad & 1;
+  return SinCos<T>{vals[odd] * T(1 - (quad & 2)), vals[odd ^ 1] * T(1 - ((quad + 1) & 2))};
+}
+
+} // namespace detail
+
+/**
+ * Return the sine and cosine of the given angle
+ *
+ * @tparam Prec the precision to evaluate to
+ */
+template<Precision Prec = Precision::Exact, typename T>
+auto sincos(BaseAngle<Radian, T> const angle) -> SinCos<T> {
+  /** @cond doxygen has some issues with static assert */
+  static_assert(std::is_floating_point<T>::value, "Underlying type must be floating point");
+  /** @endcond */
+  if (Prec == Precision::Exact) {
+    return SinCos<T>{std::sin(T(angle)), std::cos(T(angle))};
+  }
+  return detail::sincosScalar<Prec>(T(angle));
+}
+
+template<Precision Prec = Precision::Exact, typename T>
+auto sincos(BaseAngle<Degree, T> const angle) -> SinCos<T> {
+  return sincos<Prec>(Radian<T>{angle});
+}
+
+template<Precision Prec = Precision::Exact, typename T>
+auto sin(BaseAngle<Radian, T> const angle) -> T {
+  return sincos<Prec>(angle).sin;
+}
+
+template<Precision Prec = Precision::Exact, typename T>
+auto sin(BaseAngle<Degree, T> const angle) -> T {
+  return sincos<Prec>(Radian<T>{angle}).sin;
+}
+
+template<Precision Prec = Precision::Exact, typename T>
+auto cos(BaseAngle<Radian, T> const angle) -> T {
+  return sincos<Prec>(angle).cos;
+}
+
+template<Precision Prec = Precision::Exact, typename T>
+auto cos(BaseAngle<Degree, T> const angle) -> T {
+  return sincos<Prec>(Radian<T>{angle}).cos;
+}
+
+/**
+ * Return the tangent of the given angle.  The polynomial policies divide
+ * sin by cos, so their error grows as cos approaches zero.
+ */
+template<Precision Prec = Precision::Exact, typename T>
+auto tan(BaseAngle<Radian, T> const angle) -> T {
+  if (Prec == Precision::Exact) {
+    return std::tan(T(angle));
+  }
+  auto const sc = sincos<Prec>(angle);
+  return sc.sin / sc.cos;
+}
+
+template<Precision Prec = Precision::Exact, typename T>
+auto tan(BaseAngle<Degree, T> const angle) -> T {
+  return tan<Prec>(Radian<T>{angle});
+}
+
+/**
+ * Calculate the sine and cosine of an array of angles, a full register of
+ * angles at a time for the polynomial policies
+ *
+ * @param angles pointer to count angles
+ * @param sins storage for count sines
+ * @param coss storage for count cosines
+ * @param count the number of angles
+ */
+template<Precision Prec = Precision::Exact, typename T>
+auto sincos(Radian<T> const * angles, T * sins, T * coss, std::size_t const count) -> void {
+  /** @cond doxygen has an issue with static assert */
+  static_assert(sizeof(Radian<T>) == sizeof(T), "Radian must be tightly packed");
+  /** @endcond */
+  if (Prec == Precision::Exact) {
+    for (std::size_t i = 0; i < count; ++i) {
+      sins[i] = std::sin(T(angles[i]));
+      coss[i] = std::cos(T(angles[i]));
+    }
+    return;
+  }
+  auto const in = reinterpret_cast<T const *>(angles);
+  detail::forEachPack<T>(count, [&](auto p, std::size_t const i) {
+    using P = decltype(p);
+    P s;
+    P c;
+    detail::sincosPack<Prec>(P::load(in + i), s, c);
+    s.store(sins + i);
+    c.store(coss + i);
+  });
+}
+
+/**
+ * Calculate the tangent of an array of angles
+ *
+ * @param angles pointer to count angles
+ * @param out storage for count tangents
+ * @param count the number of angles
+ */
+template<Precision Prec = Precision::Exact, typename T>
+auto tan(Radian<T> const * angles, T * out, std::size_t const count) -> void {
+  /** @cond doxygen has an issue with static assert */
+  static_assert(sizeof(Radian<T>) == sizeof(T), "Radian must be tightly packed");
+  /** @endcond */
+  if (Prec == Precision::Exact) {
+    for (std::size_t i = 0; i < count; ++i) {
+      out[i] = std::tan(T(angles[i]));
+    }
+    return;
+  }
+  auto const in = reinterpret_cast<T const *>(angles);
+  detail::forEachPack<T>(count, [&](auto p, std::size_t const i) {
+    using P = decltype(p);
+    P s;
+    P c;
+    detail::sincosPack<Prec>(P::load(in + i), s, c);
+    (s / c).store(out + i);
+  });
+}
+
+} // namespace math
+} // namespace cagey
+
+#endif /* CAGEY_MATH_TRIG_HH_ */
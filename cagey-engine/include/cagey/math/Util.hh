@@ -28,10 +28,15 @@
 #ifndef CAGEY_MATH_UTIL_HH_
 #define CAGEY_MATH_UTIL_HH_
 
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
 #include <limits>
 #include <type_traits>
 #include <cmath>
 
+#include "cagey/math/Simd.hh"
+
 namespace cagey { 
 namespace math {
 
@@ -64,6 +69,254 @@ typename std::enable_if<std::is_arithmetic<T>::value, bool>::type equals(T const
   return diff / (xx + yy) < ep;
 }
 
+/**
+ * How nearlyEqual() and allNearlyEqual() decide that two values match.
+ * NaN never matches anything, not even itself.
+ *
+ * @tparam T float or double
+ */
+template<typename T>
+struct Tolerance {
+  enum class Mode {
+    Ulp,   ///< at most maxUlps representable values apart
+    RelAbs ///< |x - y| <= absolute or |x - y| <= relative * max(|x|, |y|)
+  };
+
+  /**
+   * Match values at most n representable values apart.  -0 and +0 are the
+   * same value and infinity is one step past the largest finite value.
+   */
+  static constexpr auto ulps(std::uint32_t const n) noexcept -> Tolerance {
+    return Tolerance{Mode::Ulp, n, T{0}, T{0}};
+  }
+
+  /**
+   * Match values whose difference is within absolute or within relative
+   * times the larger magnitude.  Infinities only match themselves.
+   */
+  static constexpr auto relAbs(T const relative, T const absolute = T{0}) noexcept -> Tolerance {
+    return Tolerance{Mode::RelAbs, 0, relative, absolute};
+  }
+
+  Mode mode;             ///< which test to apply
+  std::uint32_t maxUlps; ///< largest distance for Mode::Ulp
+  T relative;            ///< relative tolerance for Mode::RelAbs
+  T absolute;            ///< absolute tolerance for Mode::RelAbs
+};
+
+namespace detail {
+
+/// Unsigned integer with the same size as a floating point type
+template<typename T> struct FloatBits;
+template<> struct FloatBits<float> { using Type = std::uint32_t; };
+template<> struct FloatBits<double> { using Type = std::uint64_t; };
+
+/**
+ * Lanes where x and y do not match under Mode::RelAbs, as a bit mask.
+ * Each comparison is packed into bits and the bits are combined, so no
+ * lane takes a branch and no mask has to be blended.
+ */
+template<typename P>
+inline auto relAbsMismatch(P const x, P const y, P const relative, P const absolute) -> unsigned {
+  using T = typename P::Type;
+  P const diff = max(x, y) - min(x, y);
+  P const mag = max(max(x, -x), max(y, -y));
+  unsigned const equal = P::bits(x <= y) & P::bits(y <= x);
+  unsigned const close = P::bits(diff <= absolute) | P::bits(diff <= relative * mag);
+  unsigned const finite = P::bits(diff < P::broadcast(std::numeric_limits<T>::infinity()));
+  unsigned const ordered = P::bits(x <= x) & P::bits(y <= y);
+  unsigned const lanes = (1u << P::Width) - 1u;
+  return ~((equal | (close & finite)) & ordered) & lanes;
+}
+
+/**
+ * Return the index of the lowest set bit of a non zero mask plus base
+ */
+inline auto firstSetBit(unsigned bits, std::size_t base) -> std::size_t {
+  while ((bits & 1u) == 0) {
+    bits >>= 1;
+    ++base;
+  }
+  return base;
+}
+
+} // namespace detail
+
+/**
+ * Return the number of representable values between x and y, or the
+ * largest std::uint64_t if either is NaN.
+ */
+template<typename T>
+auto ulpDistance(T const x, T const y) noexcept -> std::uint64_t {
+  /** @cond doxygen has an issue with static assert */
+  static_assert(std::is_same<T, float>::value || std::is_same<T, double>::value, "Only float and double are supported");
+  /** @endcond */
+  using Bits = typename detail::FloatBits<T>::Type;
+  if (x != x || y != y) {
+    return std::numeric_limits<std::uint64_t>::max();
+  }
+  Bits bx;
+  Bits by;
+  std::memcpy(&bx, &x, sizeof(T));
+  std::memcpy(&by, &y, sizeof(T));
+  Bits const sign = Bits{1} << (sizeof(T) * 8 - 1);
+  std::uint64_t const mx = bx & ~sign;
+  std::uint64_t const my = by & ~sign;
+  if ((bx ^ by) & sign) {
+    return mx + my;
+  }
+  return mx > my ? mx - my : my - mx;
+}
+
+/**
+ * Return true if x and y match under the given tolerance
+ */
+template<typename T>
+auto nearlyEqual(T const x, T const y, Tolerance<T> const & tol) -> bool {
+  if (tol.mode == Tolerance<T>::Mode::Ulp) {
+    return ulpDistance(x, y) <= tol.maxUlps;
+  }
+  using P = detail::Pack<T, 1>;
+  return detail::relAbsMismatch(P{x}, P{y}, P{tol.relative}, P{tol.absolute}) == 0;
+}
+
+namespace detail {
+
+#if defined(CAGEY_SIMD_SSE2)
+
+/**
+ * Lanes of four float pairs more than maxUlps apart or NaN, as a bit mask.
+ * maxUlps is biased by 0x80000000 so the signed compare acts unsigned.
+ * AVX has no 256 bit integer operations so this also serves AVX builds.
+ */
+inline auto ulpMismatch(float const * lhs, float const * rhs, __m128i const maxUlps) -> unsigned {
+  __m128 const x = _mm_loadu_ps(lhs);
+  __m128 const y = _mm_loadu_ps(rhs);
+  __m128i const bx = _mm_castps_si128(x);
+  __m128i const by = _mm_castps_si128(y);
+  __m128i const magMask = _mm_set1_epi32(0x7fffffff);
+  __m128i const mx = _mm_and_si128(bx, magMask);
+  __m128i const my = _mm_and_si128(by, magMask);
+  // same sign: |mx - my|, opposite signs: mx + my which may need all 32 bits
+  __m128i const d = _mm_sub_epi32(mx, my);
+  __m128i const s = _mm_srai_epi32(d, 31);
+  __m128i const same = _mm_sub_epi32(_mm_xor_si128(d, s), s);
+  __m128i const opposite = _mm_srai_epi32(_mm_xor_si128(bx, by), 31);
+  __m128i const dist = _mm_or_si128(_mm_and_si128(opposite, _mm_add_epi32(mx, my)), _mm_andnot_si128(opposite, same));
+  __m128i const far = _mm_cmpgt_epi32(_mm_xor_si128(dist, _mm_set1_epi32(INT32_MIN)), maxUlps);
+  return static_cast<unsigned>(_mm_movemask_ps(_mm_or_ps(_mm_castsi128_ps(far), _mm_cmpunord_ps(x, y))));
+}
+
+/**
+ * Lanes of two double pairs more than maxUlps apart or NaN, as a bit mask.
+ * SSE2 has no 64 bit shifts or compares, so signs are taken from the high
+ * dwords and the distance is tested as a zero high dword and a low dword
+ * no larger than maxUlps, which is biased as for floats.
+ */
+inline auto ulpMismatch(double const * lhs, double const * rhs, __m128i const maxUlps) -> unsigned {
+  __m128d const x = _mm_loadu_pd(lhs);
+  __m128d const y = _mm_loadu_pd(rhs);
+  __m128i const bx = _mm_castpd_si128(x);
+  __m128i const by = _mm_castpd_si128(y);
+  __m128i const magMask = _mm_set1_epi64x(0x7fffffffffffffffll);
+  __m128i const mx = _mm_and_si128(bx, magMask);
+  __m128i const my = _mm_and_si128(by, magMask);
+  __m128i const d = _mm_sub_epi64(mx, my);
+  __m128i const s = _mm_srai_epi32(_mm_shuffle_epi32(d, _MM_SHUFFLE(3, 3, 1, 1)), 31);
+  __m128i const same = _mm_sub_epi64(_mm_xor_si128(d, s), s);
+  __m128i const opposite = _mm_srai_epi32(_mm_shuffle_epi32(_mm_xor_si128(bx, by), _MM_SHUFFLE(3, 3, 1, 1)), 31);
+  __m128i const dist = _mm_or_si128(_mm_and_si128(opposite, _mm_add_epi64(mx, my)), _mm_andnot_si128(opposite, same));
+  __m128i const hiZero = _mm_cmpeq_epi32(dist, _mm_setzero_si128());
+  __m128i const loFar = _mm_cmpgt_epi32(_mm_xor_si128(dist, _mm_set1_epi32(INT32_MIN)), maxUlps);
+  __m128i const far = _mm_or_si128(_mm_shuffle_epi32(loFar, _MM_SHUFFLE(2, 2, 0, 0)),
+                                   _mm_andnot_si128(_mm_shuffle_epi32(hiZero, _MM_SHUFFLE(3, 3, 1, 1)),
+                                                    _mm_set1_epi32(-1)));
+  return static_cast<unsigned>(_mm_movemask_pd(_mm_or_pd(_mm_castsi128_pd(far), _mm_cmpunord_pd(x, y))));
+}
+
+#endif // CAGEY_SIMD_SSE2
+
+/**
+ * Return the index of the first pair more than maxUlps apart, or count
+ */
+template<typename T>
+inline auto firstUlpMismatch(T const * lhs, T const * rhs, std::size_t const count, std::uint32_t const maxUlps)
+    -> std::size_t {
+  std::size_t i = 0;
+#if defined(CAGEY_SIMD_SSE2)
+  constexpr std::size_t Width = 16 / sizeof(T);
+  __m128i const biased = _mm_set1_epi32(static_cast<int>(maxUlps ^ 0x80000000u));
+  for (; i + Width <= count; i += Width) {
+    unsigned const bits = ulpMismatch(lhs + i, rhs + i, biased);
+    if (bits != 0) {
+      return firstSetBit(bits, i);
+    }
+  }
+#endif
+  for (; i < count; ++i) {
+    if (ulpDistance(lhs[i], rhs[i]) > maxUlps) {
+      return i;
+    }
+  }
+  return count;
+}
+
+/**
+ * Return the index of the first pair that fails Mode::RelAbs, or count
+ */
+template<typename T>
+inline auto firstRelAbsMismatch(T const * lhs, T const * rhs, std::size_t const count, T const relative,
+                                T const absolute) -> std::size_t {
+  using P = Pack<T>;
+  P const rel = P::broadcast(relative);
+  P const absTol = P::broadcast(absolute);
+  std::size_t i = 0;
+  for (; i + P::Width <= count; i += P::Width) {
+    unsigned const bits = relAbsMismatch(P::load(lhs + i), P::load(rhs + i), rel, absTol);
+    if (bits != 0) {
+      return firstSetBit(bits, i);
+    }
+  }
+  using S = Pack<T, 1>;
+  for (; i < count; ++i) {
+    if (relAbsMismatch(S{lhs[i]}, S{rhs[i]}, S{relative}, S{absolute}) != 0) {
+      return i;
+    }
+  }
+  return count;
+}
+
+} // namespace detail
+
+/**
+ * Compare two arrays element by element, for instance to verify a replayed
+ * state snapshot against a recorded one.  Every element is tested without
+ * branching, a whole register at a time; the scan stops at the first
+ * register holding a mismatch.
+ *
+ * @param lhs pointer to the first of count values
+ * @param rhs pointer to the first of count values
+ * @param count the number of values to compare
+ * @param tol the tolerance, see Tolerance
+ * @param mismatch if not null receives the index of the first pair that
+ *        does not match, or count if all match
+ * @return true if every pair matches
+ */
+template<typename T>
+auto allNearlyEqual(T const * lhs, T const * rhs, std::size_t const count, Tolerance<T> const & tol,
+                    std::size_t * mismatch = nullptr) -> bool {
+  /** @cond doxygen has an issue with static assert */
+  static_assert(std::is_same<T, float>::value || std::is_same<T, double>::value, "Only float and double are supported");
+  /** @endcond */
+  std::size_t const first = tol.mode == Tolerance<T>::Mode::Ulp
+                          ? detail::firstUlpMismatch(lhs, rhs, count, tol.maxUlps)
+                          : detail::firstRelAbsMismatch(lhs, rhs, count, tol.relative, tol.absolute);
+  if (mismatch != nullptr) {
+    *mismatch = first;
+  }
+  return first == count;
+}
+
 } // namespace cagey
 } // namespace math
  
@@ -28,7 +28,11 @@
 #ifndef CAGEY_MATH_VECTOR_HH_
 #define CAGEY_MATH_VECTOR_HH_
 
+#include <cmath> //for std::sqrt
+#include <limits> //for std::numeric_limits
+
 #include <cagey/math/BasePoint.hh>
+#include <cagey/math/Util.hh>
 
 namespace cagey
 {
@@ -43,7 +47,7 @@ class Vector : public BasePoint<Vector, T, N> {
 public:
   /** @cond doxygen has some issues with static assert */
   static_assert(N != 0, "Vector cannot have zero elements");
-  static_assert(std::is_arithmetic<T>::value, "Underlying type must be a number");
+  static_assert(IsNumber<T>::value, "Underlying type must be a number");
   /** @endcond */
 
   /// The underlying type of this Vector
@@ -96,7 +100,7 @@ template<typename T>
 class Vector<T,2> : public BasePoint<Vector, T, 2>
 {
   /** @cond doxygen has issues with static_assert */
-  static_assert(std::is_arithmetic<T>::value, "Underlying type must be a number");
+  static_assert(IsNumber<T>::value, "Underlying type must be a number");
   /** @endcond */
 public:
   /// The number of elements in this BasePoint
@@ -152,7 +156,7 @@ template<typename T>
 class Vector<T,3> : public BasePoint<Vector, T, 3>
 {
   /** @cond doxygen has issues with static_assert */
-  static_assert(std::is_arithmetic<T>::value, "Underlying type must be a number");
+  static_assert(IsNumber<T>::value, "Underlying type must be a number");
   /** @endcond */
 public:
   /// The number of elements in this BasePoint
@@ -210,7 +214,7 @@ template<typename T>
 class Vector<T,4> : public BasePoint<Vector, T, 4>
 {
   /** @cond doxygen has issues with static_assert */
-  static_assert(std::is_arithmetic<T>::value, "Underlying type must be a number");
+  static_assert(IsNumber<T>::value, "Underlying type must be a number");
   /** @endcond */
 public:
   /// The number of elements in this BasePoint
@@ -302,7 +306,7 @@ auto length(Vector<T, S> const & rhs) -> T {
  */
 template<typename T, std::size_t S>
 auto equals(Vector<T, S> const & lhs, Vector<T, S> const & rhs) -> bool {
-  return std::equal(lhs.begin(), rhs.begin(), rhs.begin(), [] (T r, T l) { 
+  return std::equal(lhs.begin(), lhs.end(), rhs.begin(), [] (T r, T l) { 
     return math::equals(l,r); 
   });
 }
@@ -322,7 +326,7 @@ auto equals(Vector<T, S> const & lhs, Vector<T, S> const & rhs) -> bool {
  */
 template<typename T, std::size_t S>
 auto dot(Vector<T, S> const & lhs, Vector<T, S> const & rhs) -> T {
-  return std::inner_product(lhs.begin(), rhs.begin(), rhs.begin(), T{0});
+  return std::inner_product(lhs.begin(), lhs.end(), rhs.begin(), T{0});
 }
 
 
@@ -345,7 +349,7 @@ auto dotAbsolute(Vector<T, S> const & lhs, Vector<T, S> const & rhs) -> T {
  * @return the value representing the cross product of the given Vectors
  */
 template<typename T>
-auto cross(Vec2<T> const rhs, Vec2<T> const & lhs) -> T {
+auto cross(Vec2<T> const & lhs, Vec2<T> const & rhs) -> T {
   return lhs.x*rhs.y-lhs.y*rhs.x;
 }
 
@@ -357,7 +361,7 @@ auto cross(Vec2<T> const rhs, Vec2<T> const & lhs) -> T {
  * @return a vector which is the cross product of the given Vectors
  */
 template<typename T>
-auto cross(Vec3<T> const rhs, Vec3<T> const & lhs) -> Vector<T,3> {
+auto cross(Vec3<T> const & lhs, Vec3<T> const & rhs) -> Vector<T,3> {
   return Vec3<T>{lhs.y*rhs.z-lhs.z*rhs.y,
                       lhs.z*rhs.x-lhs.x*rhs.z,
                       lhs.x*rhs.y-lhs.y*rhs.x
@@ -372,9 +376,9 @@ auto cross(Vec3<T> const rhs, Vec3<T> const & lhs) -> Vector<T,3> {
  * @return a normalized copy of the given vector
  */
 template<typename T, std::size_t S>
-auto normalize(Vector<T, S> const vec) -> Vector<T, S> {
+auto normalize(Vector<T, S> vec) -> Vector<T, S> {
   T len = length(vec);
-  if (len > 0) {
+  if (len > T{0}) {
     vec *= (T{1} / len);
   } else {
     //bad things happen... zero length vector;
@@ -0,0 +1,59 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// cagey-engine - Toy 3D Engine 
+// Copyright (c) 2014 Kyle Girard <theycallmecoach@gmail.com>
+//
+// The MIT License (MIT)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in 
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+
+#include <cagey/math/Aabb.hh>
+#include "gtest/gtest.h"
+
+using namespace cagey::math;
+
+TEST(Aabb, DefaultIsEmpty) {
+  Aabbf box;
+  EXPECT_TRUE(isEmpty(box));
+  box = merge(box, Point3f{1.0f, 2.0f, 3.0f});
+  EXPECT_FALSE(isEmpty(box));
+  EXPECT_EQ(Point3f(1.0f, 2.0f, 3.0f), box.min);
+  EXPECT_EQ(Point3f(1.0f, 2.0f, 3.0f), box.max);
+}
+
+TEST(Aabb, CenterExtentsArea) {
+  Aabbf const box{Point3f{-1.0f, 0.0f, 2.0f}, Point3f{3.0f, 2.0f, 3.0f}};
+  EXPECT_EQ(Point3f(1.0f, 1.0f, 2.5f), center(box));
+  EXPECT_EQ(Vec3f(2.0f, 1.0f, 0.5f), extents(box));
+  EXPECT_FLOAT_EQ(2.0f * (4.0f * 2.0f + 2.0f * 1.0f + 1.0f * 4.0f), surfaceArea(box));
+}
+
+TEST(Aabb, MergeContainsIntersects) {
+  Aabbi const a{Point3i{0, 0, 0}, Point3i{2, 2, 2}};
+  Aabbi const b{Point3i{2, 1, -1}, Point3i{4, 3, 1}};
+  Aabbi const c{Point3i{3, 3, 3}, Point3i{4, 4, 4}};
+  EXPECT_EQ((Aabbi{Point3i{0, 0, -1}, Point3i{4, 3, 2}}), merge(a, b));
+  EXPECT_TRUE(intersects(a, b));
+  EXPECT_FALSE(intersects(a, c));
+  EXPECT_TRUE(contains(a, Point3i{2, 0, 1}));
+  EXPECT_FALSE(contains(a, Point3i{3, 0, 1}));
+}
@@ -0,0 +1,128 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// cagey-engine - Toy 3D Engine 
+// Copyright (c) 2014 Kyle Girard <theycallmecoach@gmail.com>
+//
+// The MIT License (MIT)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in 
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+
+#include <cagey/math/Affine3.hh>
+#include "gtest/gtest.h"
+#include <cmath>
+#include <random>
+
+using namespace cagey::math;
+
+namespace {
+
+template<typename T>
+auto randomAffineMat4(std::mt19937 & gen) -> Mat4<T> {
+  std::uniform_real_distribution<double> dist(-2.0, 2.0);
+  Mat4<T> ret;
+  for (std::size_t r = 0; r < 3; ++r) {
+    for (std::size_t c = 0; c < 4; ++c) {
+      ret(r, c) = static_cast<T>(dist(gen)) + (r == c ? T{3} : T{0});
+    }
+  }
+  return ret;
+}
+
+template<typename T>
+auto expectNear(Mat4<T> const & expected, Mat4<T> const & actual, T const tolerance) -> void {
+  for (std::size_t i = 0; i < 16; ++i) {
+    EXPECT_NEAR(expected[i], actual[i], tolerance);
+  }
+}
+
+} // namespace
+
+TEST(Affine3, Layout) {
+  EXPECT_EQ(12 * sizeof(float), sizeof(Affine3f));
+  EXPECT_EQ(12 * sizeof(double), sizeof(Affine3d));
+}
+
+TEST(Affine3, DefaultIsIdentity) {
+  EXPECT_EQ(Mat4f{}, toMat4(Affine3f{}));
+  Affine3d const id;
+  EXPECT_EQ(1.0, id(1, 1));
+  EXPECT_EQ(0.0, id(0, 1));
+  EXPECT_EQ(0.0, id(2, 3));
+}
+
+TEST(Affine3, Mat4RoundTrip) {
+  std::mt19937 gen{23};
+  auto const mat = randomAffineMat4<float>(gen);
+  Affine3f const aff{mat};
+  EXPECT_EQ(mat, toMat4(aff));
+  EXPECT_EQ(mat(1, 3), aff(1, 3));
+  EXPECT_EQ(mat(2, 0), aff(2, 0));
+}
+
+TEST(Affine3, DropsBottomRow) {
+  auto projective = makeScale(2.0f, 4.0f, 8.0f);
+  projective(3, 2) = -1.0f;
+  projective(3, 3) = 0.0f;
+  EXPECT_EQ(makeScale(2.0f, 4.0f, 8.0f), toMat4(Affine3f{projective}));
+}
+
+TEST(Affine3, ComposeMatchesMat4) {
+  std::mt19937 gen{29};
+  for (int i = 0; i < 50; ++i) {
+    auto const lhs = randomAffineMat4<float>(gen);
+    auto const rhs = randomAffineMat4<float>(gen);
+    expectNear(lhs * rhs, toMat4(Affine3f{lhs} * Affine3f{rhs}), 1e-4f);
+    auto const lhsd = randomAffineMat4<double>(gen);
+    auto const rhsd = randomAffineMat4<double>(gen);
+    expectNear(lhsd * rhsd, toMat4(Affine3d{lhsd} * Affine3d{rhsd}), 1e-12);
+  }
+}
+
+TEST(Affine3, TransformPointAndVector) {
+  Affine3f const aff{makeTranslation(1.0f, 2.0f, 3.0f) * makeScale(2.0f, 2.0f, 2.0f)};
+  EXPECT_EQ(Point3f(3.0f, 4.0f, 5.0f), aff * Point3f(1.0f, 1.0f, 1.0f));
+  EXPECT_EQ(Vec3f(2.0f, 2.0f, 2.0f), aff * Vec3f(1.0f, 1.0f, 1.0f));
+
+  Point3f points[5] = {{0.0f, 0.0f, 0.0f}, {1.0f, 0.0f, 0.0f}, {0.0f, 1.0f, 0.0f}, {0.0f, 0.0f, 1.0f}, {1.0f, 1.0f, 1.0f}};
+  Point3f out[5];
+  transformPoints(aff, points, out, 5);
+  for (std::size_t i = 0; i < 5; ++i) {
+    EXPECT_EQ(aff * points[i], out[i]);
+  }
+}
+
+TEST(Affine3, Inverse) {
+  std::mt19937 gen{31};
+  for (int i = 0; i < 50; ++i) {
+    auto const mat = randomAffineMat4<float>(gen);
+    Affine3f const aff{mat};
+    expectNear(Mat4f{}, toMat4(aff * inverse(aff)), 1e-4f);
+    expectNear(inverseAffine(mat), toMat4(inverse(aff)), 1e-4f);
+  }
+  Affine3f const rigid{makeTranslation(1.0f, -2.0f, 0.5f)};
+  EXPECT_EQ(Affine3f{makeTranslation(-1.0f, 2.0f, -0.5f)}, inverseRigid(rigid));
+
+  Affine3f out;
+  EXPECT_FALSE(tryInverse(Affine3f{makeScale(1.0f, 0.0f, 1.0f)}, out));
+  EXPECT_EQ(Affine3f{}, out);
+  EXPECT_THROW(inverse(Affine3f{makeScale(0.0f, 0.0f, 1.0f)}), cagey::core::SingularMatrixException);
+}
@@ -0,0 +1,110 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// cagey-engine - Toy 3D Engine 
+// Copyright (c) 2014 Kyle Girard <theycallmecoach@gmail.com>
+//
+// The MIT License (MIT)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in 
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+
+#include <cagey/math/Aligned.hh>
+#include "gtest/gtest.h"
+#include <algorithm>
+#include <cstdint>
+#include <memory>
+#include <random>
+
+using namespace cagey::math;
+
+namespace {
+
+auto isAligned(void const * ptr, std::size_t const alignment) -> bool {
+  return reinterpret_cast<std::uintptr_t>(ptr) % alignment == 0;
+}
+
+auto randomMat4fA(std::mt19937 & gen) -> Mat4fA {
+  std::uniform_real_distribution<float> dist(-10.0f, 10.0f);
+  Mat4fA ret;
+  std::generate(ret.begin(), ret.end(), [&] { return dist(gen); });
+  return ret;
+}
+
+} // namespace
+
+TEST(Aligned, Layout) {
+  EXPECT_EQ(16u, alignof(Vec4fA));
+  EXPECT_EQ(64u, alignof(Mat4fA));
+  EXPECT_EQ(sizeof(Vec4f), sizeof(Vec4fA));
+  EXPECT_EQ(sizeof(Mat4f), sizeof(Mat4fA));
+  EXPECT_EQ(Mat4f{}, Mat4fA{});
+  EXPECT_EQ(Vec4f{}, Vec4fA{});
+}
+
+TEST(Aligned, AllocatorAlignsVectorElements) {
+  for (std::size_t n = 1; n < 20; ++n) {
+    AlignedVector<Mat4fA> mats(n);
+    AlignedVector<Vec4fA> vecs(n);
+    for (std::size_t i = 0; i < n; ++i) {
+      EXPECT_TRUE(isAligned(&mats[i], 64));
+      EXPECT_TRUE(isAligned(&vecs[i], 16));
+    }
+  }
+  std::vector<float, AlignedAllocator<float, 32>> floats(7);
+  EXPECT_TRUE(isAligned(floats.data(), 32));
+}
+
+TEST(Aligned, HeapAllocation) {
+  std::unique_ptr<Mat4fA> single{new Mat4fA};
+  std::unique_ptr<Mat4fA[]> many{new Mat4fA[5]};
+  EXPECT_TRUE(isAligned(single.get(), 64));
+  EXPECT_TRUE(isAligned(many.get(), 64));
+  EXPECT_EQ(Mat4f{}, many[4]);
+}
+
+TEST(Aligned, MultiplyMatchesUnaligned) {
+  std::mt19937 gen{17};
+  for (int i = 0; i < 50; ++i) {
+    Mat4fA const lhs = randomMat4fA(gen);
+    Mat4fA const rhs = randomMat4fA(gen);
+    Mat4fA const aligned = lhs * rhs;
+    Mat4f const unaligned = static_cast<Mat4f const &>(lhs) * static_cast<Mat4f const &>(rhs);
+    EXPECT_EQ(unaligned, aligned);
+
+    Vec4fA const vec{1.0f, -2.0f, 3.0f, 1.0f};
+    Vec4fA const alignedVec = lhs * vec;
+    EXPECT_EQ(static_cast<Mat4f const &>(lhs) * static_cast<Vec4f const &>(vec), alignedVec);
+  }
+}
+
+TEST(Aligned, TransformVectors) {
+  std::mt19937 gen{19};
+  Mat4fA const mat = randomMat4fA(gen);
+  AlignedVector<Vec4fA> vecs(9);
+  for (std::size_t i = 0; i < vecs.size(); ++i) {
+    vecs[i] = Vec4f{float(i), 1.0f, -float(i), 1.0f};
+  }
+  AlignedVector<Vec4fA> out(vecs.size());
+  transformVectors(mat, vecs.data(), out.data(), vecs.size());
+  for (std::size_t i = 0; i < vecs.size(); ++i) {
+    EXPECT_EQ(mat * vecs[i], out[i]);
+  }
+}
@@ -0,0 +1,208 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// cagey-engine - Toy 3D Engine 
+// Copyright (c) 2014 Kyle Girard <theycallmecoach@gmail.com>
+//
+// The MIT License (MIT)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in 
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+#include <cagey/math/Array3.hh>
+#include "gtest/gtest.h"
+#include <cmath>
+#include <random>
+#include <vector>
+using namespace cagey::math;
+
+namespace {
+
+// nine pairs, more than a pack of floats, with integer results where possible
+std::vector<Vec3f> const Lhs{{1.0f, 0.0f, 0.0f}, {0.0f, 1.0f, 0.0f}, {0.0f, 0.0f, 1.0f},
+                             {3.0f, 4.0f, 0.0f}, {0.0f, 0.0f, 0.0f}, {1.0f, 2.0f, 3.0f},
+                             {-2.0f, 1.0f, 2.0f}, {2.0f, -3.0f, 6.0f}, {0.0f, 5.0f, 12.0f}};
+std::vector<Vec3f> const Rhs{{0.0f, 1.0f, 0.0f}, {0.0f, 0.0f, 1.0f}, {1.0f, 0.0f, 0.0f},
+                             {4.0f, -3.0f, 0.0f}, {1.0f, 1.0f, 1.0f}, {4.0f, 5.0f, 6.0f},
+                             {1.0f, 2.0f, 2.0f}, {1.0f, 1.0f, 1.0f}, {0.0f, -12.0f, 5.0f}};
+
+auto expectVectors(std::vector<Vec3f> const & expected, Vec3fArray const & actual) -> void {
+  ASSERT_EQ(expected.size(), actual.size());
+  for (std::size_t i = 0; i < expected.size(); ++i) {
+    Vec3f const vec = actual[i];
+    EXPECT_FLOAT_EQ(expected[i].x, vec.x) << i;
+    EXPECT_FLOAT_EQ(expected[i].y, vec.y) << i;
+    EXPECT_FLOAT_EQ(expected[i].z, vec.z) << i;
+  }
+}
+
+} // namespace
+
+TEST(Array3, Construct) {
+  Vec3fArray empty;
+  EXPECT_TRUE(empty.empty());
+  Vec3fArray zeros(5);
+  EXPECT_EQ(5u, zeros.size());
+  EXPECT_EQ(0.0f, zeros[4].y);
+}
+
+TEST(Array3, ReferenceProxy) {
+  Vec3fArray arr(3);
+  arr[1] = Vec3f{1.0f, 2.0f, 3.0f};
+  arr[2] = arr[1];
+  Vec3f vec = arr[2];
+  EXPECT_EQ(1.0f, vec.x);
+  EXPECT_EQ(2.0f, vec.y);
+  EXPECT_EQ(3.0f, vec.z);
+  arr[0].z = 7.0f;
+  EXPECT_EQ(7.0f, arr.getZ()[0]);
+}
+
+TEST(Array3, ConvertVector) {
+  Vec3fArray arr{Lhs};
+  EXPECT_EQ(Lhs.size(), arr.size());
+  EXPECT_EQ(Lhs, arr.toVector());
+  EXPECT_EQ(2.0f, arr.getX()[7]);
+  EXPECT_EQ(-3.0f, arr.getY()[7]);
+  EXPECT_EQ(6.0f, arr.getZ()[7]);
+  arr.pushBack(Vec3f{1.0f, 1.0f, 1.0f});
+  EXPECT_EQ(10u, arr.size());
+}
+
+TEST(Array3, PointArray) {
+  Point3fArray points;
+  points.pushBack(Point3f{1.0f, 2.0f, 3.0f});
+  points.pushBack(Point3f{4.0f, 6.0f, 3.0f});
+  Point3fArray origin(2);
+  std::vector<float> dist(2);
+  distanceSquared(points, origin, dist.data());
+  EXPECT_FLOAT_EQ(14.0f, dist[0]);
+  EXPECT_FLOAT_EQ(61.0f, dist[1]);
+}
+
+TEST(Array3, MismatchedSize) {
+  Vec3fArray lhs(3);
+  Vec3fArray rhs(4);
+  std::vector<float> out(4);
+  EXPECT_THROW(dot(lhs, rhs, out.data()), cagey::core::InvalidArgumentException);
+}
+
+TEST(Array3, Dot) {
+  std::vector<float> out(Lhs.size());
+  dot(Vec3fArray{Lhs}, Vec3fArray{Rhs}, out.data());
+  EXPECT_EQ((std::vector<float>{0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 32.0f, 4.0f, 5.0f, 0.0f}), out);
+}
+
+TEST(Array3, Length) {
+  std::vector<float> out(Lhs.size());
+  lengthSquared(Vec3fArray{Lhs}, out.data());
+  EXPECT_EQ((std::vector<float>{1.0f, 1.0f, 1.0f, 25.0f, 0.0f, 14.0f, 9.0f, 49.0f, 169.0f}), out);
+  length(Vec3fArray{Lhs}, out.data());
+  EXPECT_EQ((std::vector<float>{1.0f, 1.0f, 1.0f, 5.0f, 0.0f, std::sqrt(14.0f), 3.0f, 7.0f, 13.0f}), out);
+}
+
+TEST(Array3, Cross) {
+  Vec3fArray out;
+  cross(Vec3fArray{Lhs}, Vec3fArray{Rhs}, out);
+  expectVectors({{0.0f, 0.0f, 1.0f}, {1.0f, 0.0f, 0.0f}, {0.0f, 1.0f, 0.0f},
+                 {0.0f, 0.0f, -25.0f}, {0.0f, 0.0f, 0.0f}, {-3.0f, 6.0f, -3.0f},
+                 {-2.0f, 6.0f, -5.0f}, {-9.0f, 4.0f, 5.0f}, {169.0f, 0.0f, 0.0f}}, out);
+
+  // the output may alias an input
+  Vec3fArray lhs{Lhs};
+  cross(lhs, Vec3fArray{Rhs}, lhs);
+  expectVectors(out.toVector(), lhs);
+}
+
+TEST(Array3, DistanceSquared) {
+  std::vector<float> out(Lhs.size());
+  distanceSquared(Vec3fArray{Lhs}, Vec3fArray{Rhs}, out.data());
+  EXPECT_EQ((std::vector<float>{2.0f, 2.0f, 2.0f, 50.0f, 3.0f, 27.0f, 10.0f, 42.0f, 338.0f}), out);
+}
+
+TEST(Array3, Normalize) {
+  // the zero vector is left alone
+  Vec3fArray arr{Lhs};
+  normalize(arr);
+  float const inv14 = 1.0f / std::sqrt(14.0f);
+  expectVectors({{1.0f, 0.0f, 0.0f}, {0.0f, 1.0f, 0.0f}, {0.0f, 0.0f, 1.0f},
+                 {0.6f, 0.8f, 0.0f}, {0.0f, 0.0f, 0.0f}, {inv14, 2.0f * inv14, 3.0f * inv14},
+                 {-2.0f / 3.0f, 1.0f / 3.0f, 2.0f / 3.0f}, {2.0f / 7.0f, -3.0f / 7.0f, 6.0f / 7.0f},
+                 {0.0f, 5.0f / 13.0f, 12.0f / 13.0f}}, arr);
+}
+
+TEST(Array3, AddScaled) {
+  Vec3fArray arr{Lhs};
+  addScaled(arr, Vec3fArray{Rhs}, 0.5f);
+  expectVectors({{1.0f, 0.5f, 0.0f}, {0.0f, 1.0f, 0.5f}, {0.5f, 0.0f, 1.0f},
+                 {5.0f, 2.5f, 0.0f}, {0.5f, 0.5f, 0.5f}, {3.0f, 4.5f, 6.0f},
+                 {-1.5f, 2.0f, 3.0f}, {2.5f, -2.5f, 6.5f}, {0.0f, -1.0f, 14.5f}}, arr);
+}
+
+TEST(Array3, BulkMatchesScalar) {
+  //odd size so the tail is exercised
+  std::mt19937 gen{1};
+  std::uniform_real_distribution<float> dist(-10.0f, 10.0f);
+  std::vector<Vec3f> a;
+  std::vector<Vec3f> b;
+  for (std::size_t i = 0; i < 37; ++i) {
+    a.emplace_back(dist(gen), dist(gen), dist(gen));
+    b.emplace_back(dist(gen), dist(gen), dist(gen));
+  }
+  Vec3fArray lhs{a};
+  Vec3fArray rhs{b};
+
+  std::vector<float> out(a.size());
+  dot(lhs, rhs, out.data());
+  for (std::size_t i = 0; i < a.size(); ++i) {
+    EXPECT_FLOAT_EQ(dot(a[i], b[i]), out[i]);
+  }
+
+  length(lhs, out.data());
+  for (std::size_t i = 0; i < a.size(); ++i) {
+    EXPECT_FLOAT_EQ(length(a[i]), out[i]);
+  }
+
+  std::vector<Vec3f> expected;
+  for (std::size_t i = 0; i < a.size(); ++i) {
+    expected.push_back(cross(a[i], b[i]));
+  }
+  Vec3fArray crossed;
+  cross(lhs, rhs, crossed);
+  expectVectors(expected, crossed);
+
+  expected.clear();
+  for (auto const & vec : a) {
+    expected.push_back(normalize(vec));
+  }
+  Vec3fArray normals{a};
+  normalize(normals);
+  expectVectors(expected, normals);
+}
+
+TEST(Array3, BulkDouble) {
+  Vec3dArray arr;
+  arr.pushBack(Vec3d{3.0, 4.0, 0.0});
+  arr.pushBack(Vec3d{0.0, 0.0, 0.0});
+  arr.pushBack(Vec3d{0.0, 0.0, 2.0});
+  normalize(arr);
+  EXPECT_DOUBLE_EQ(0.6, arr[0].x);
+  EXPECT_DOUBLE_EQ(0.0, arr[1].x);
+  EXPECT_DOUBLE_EQ(1.0, arr[2].z);
+}
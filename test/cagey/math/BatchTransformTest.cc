@@ -0,0 +1,148 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// cagey-engine - Toy 3D Engine 
+// Copyright (c) 2014 Kyle Girard <theycallmecoach@gmail.com>
+//
+// The MIT License (MIT)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in 
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+#include <cagey/math/BatchTransform.hh>
+#include "gtest/gtest.h"
+#include <random>
+#include <vector>
+using namespace cagey::math;
+
+namespace {
+
+auto makeTransform() -> Mat4f {
+  return Mat4f{{{0.5f, 1.0f, -2.0f, 0.0f,
+                 3.0f, -0.25f, 1.5f, 0.0f,
+                 -1.0f, 2.0f, 0.75f, 0.0f,
+                 10.0f, -20.0f, 30.0f, 1.0f}}};
+}
+
+template<typename V>
+auto makeInput(std::size_t count) -> std::vector<V> {
+  std::mt19937 gen{1234};
+  std::uniform_real_distribution<float> dist(-100.0f, 100.0f);
+  std::vector<V> ret(count);
+  for (auto & v : ret) {
+    std::generate(v.begin(), v.end(), [&] { return dist(gen); });
+  }
+  return ret;
+}
+
+} // namespace
+
+TEST(BatchTransform, transformPoints) {
+  auto mat = makeTransform();
+  //cover the scalar tail for every remainder
+  for (std::size_t count = 0; count < 19; ++count) {
+    auto in = makeInput<Point3f>(count);
+    std::vector<Point3f> out(count);
+    transformPoints(mat, in.data(), out.data(), count);
+    for (std::size_t i = 0; i < count; ++i) {
+      auto expected = mat * Vec4f{in[i].x, in[i].y, in[i].z, 1.0f};
+      EXPECT_NEAR(expected.x, out[i].x, 1e-3f);
+      EXPECT_NEAR(expected.y, out[i].y, 1e-3f);
+      EXPECT_NEAR(expected.z, out[i].z, 1e-3f);
+    }
+  }
+}
+
+TEST(BatchTransform, transformVectors) {
+  auto mat = makeTransform();
+  auto in = makeInput<Vec3f>(23);
+  std::vector<Vec3f> out(in.size());
+  transformVectors(mat, in.data(), out.data(), in.size());
+  for (std::size_t i = 0; i < in.size(); ++i) {
+    auto expected = mat * Vec4f{in[i].x, in[i].y, in[i].z, 0.0f};
+    EXPECT_NEAR(expected.x, out[i].x, 1e-3f);
+    EXPECT_NEAR(expected.y, out[i].y, 1e-3f);
+    EXPECT_NEAR(expected.z, out[i].z, 1e-3f);
+  }
+}
+
+TEST(BatchTransform, transformVec4) {
+  auto mat = makeTransform();
+  auto in = makeInput<Vec4f>(9);
+  std::vector<Vec4f> out(in.size());
+  transformVectors(mat, in.data(), out.data(), in.size());
+  for (std::size_t i = 0; i < in.size(); ++i) {
+    auto expected = mat * in[i];
+    for (std::size_t j = 0; j < 4; ++j) {
+      EXPECT_FLOAT_EQ(expected[j], out[i][j]);
+    }
+  }
+}
+
+TEST(BatchTransform, transformInPlace) {
+  auto mat = makeTranslation(1.0f, 2.0f, 3.0f);
+  std::vector<Point3f> points(7, Point3f{1.0f, 1.0f, 1.0f});
+  transformPoints(mat, points.data(), points.data(), points.size());
+  for (auto const & p : points) {
+    EXPECT_FLOAT_EQ(2.0f, p.x);
+    EXPECT_FLOAT_EQ(3.0f, p.y);
+    EXPECT_FLOAT_EQ(4.0f, p.z);
+  }
+}
+
+TEST(BatchTransform, transformPointsDouble) {
+  auto mat = makeTranslation(1.0, 2.0, 3.0);
+  std::vector<Point3d> points(5, Point3d{1.0, 1.0, 1.0});
+  std::vector<Vec3d> vectors(5, Vec3d{1.0, 1.0, 1.0});
+  transformPoints(mat, points.data(), points.data(), points.size());
+  transformVectors(mat, vectors.data(), vectors.data(), vectors.size());
+  EXPECT_DOUBLE_EQ(4.0, points[4].z);
+  EXPECT_DOUBLE_EQ(1.0, vectors[4].z);
+}
+
+TEST(BatchTransform, transformDouble) {
+  // seven triples leave a tail after every pack width
+  Mat4d const mat{{{0.5, 1.0, -2.0, 0.0,
+                    3.0, -0.25, 1.5, 0.0,
+                    -1.0, 2.0, 0.75, 0.0,
+                    10.0, -20.0, 30.0, 1.0}}};
+  std::vector<Point3d> const in{{0.0, 0.0, 0.0}, {1.0, 0.0, 0.0}, {0.0, 1.0, 0.0}, {0.0, 0.0, 1.0},
+                                {1.0, 2.0, 3.0}, {-4.0, 0.5, 8.0}, {100.0, -100.0, 0.25}};
+  std::vector<Point3d> const points{{10.0, -20.0, 30.0}, {10.5, -19.0, 28.0}, {13.0, -20.25, 31.5},
+                                    {9.0, -18.0, 30.75}, {13.5, -13.5, 33.25}, {1.5, -8.125, 44.75},
+                                    {-240.25, 105.5, -319.8125}};
+  std::vector<Point3d> out(in.size());
+  transformPoints(mat, in.data(), out.data(), in.size());
+  EXPECT_EQ(points, out);
+
+  std::vector<Vec3d> vecs(in.size());
+  for (std::size_t i = 0; i < in.size(); ++i) {
+    vecs[i] = Vec3d{in[i].x, in[i].y, in[i].z};
+  }
+  transformVectors(mat, vecs.data(), vecs.data(), vecs.size());
+  for (std::size_t i = 0; i < in.size(); ++i) {
+    EXPECT_EQ(Vec3d(points[i].x - 10.0, points[i].y + 20.0, points[i].z - 30.0), vecs[i]);
+  }
+
+  std::vector<Vec4d> quads{{1.0, 2.0, 3.0, 1.0}, {1.0, 2.0, 3.0, 0.0}, {0.0, 0.0, 0.0, 2.0}};
+  transformVectors(mat, quads.data(), quads.data(), quads.size());
+  EXPECT_EQ(Vec4d(13.5, -13.5, 33.25, 1.0), quads[0]);
+  EXPECT_EQ(Vec4d(3.5, 6.5, 3.25, 0.0), quads[1]);
+  EXPECT_EQ(Vec4d(20.0, -40.0, 60.0, 2.0), quads[2]);
+}
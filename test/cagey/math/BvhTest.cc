@@ -0,0 +1,185 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// cagey-engine - Toy 3D Engine 
+// Copyright (c) 2014 Kyle Girard <theycallmecoach@gmail.com>
+//
+// The MIT License (MIT)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in 
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+////////////////////////////////////////////////////////////////////////////////
+#include <cagey/math/Bvh.hh>
+#include "gtest/gtest.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <random>
+#include <vector>
+
+using namespace cagey::math;
+
+namespace {
+
+auto randomBoxes(std::size_t const count) -> std::vector<Aabbf> {
+  std::mt19937 gen{42};
+  std::uniform_real_distribution<float> pos{-100.0f, 100.0f};
+  std::uniform_real_distribution<float> size{0.1f, 4.0f};
+  std::vector<Aabbf> boxes;
+  for (std::size_t i = 0; i < count; ++i) {
+    Point3f const lo{pos(gen), pos(gen), pos(gen)};
+    boxes.push_back(Aabbf{lo, Point3f{lo.x + size(gen), lo.y + size(gen), lo.z + size(gen)}});
+  }
+  return boxes;
+}
+
+template<typename F>
+auto collect(F && query) -> std::vector<std::uint32_t> {
+  std::vector<std::uint32_t> found;
+  query([&](std::uint32_t const i) { found.push_back(i); });
+  std::sort(found.begin(), found.end());
+  return found;
+}
+
+} // namespace
+
+TEST(Bvh, NodeLayout) {
+  EXPECT_EQ(32u, sizeof(BvhNode));
+}
+
+TEST(Bvh, Empty) {
+  Bvh const bvh{std::vector<Aabbf>{}};
+  EXPECT_TRUE(bvh.empty());
+  EXPECT_EQ(Bvh::InvalidIndex, bvh.raycast(Rayf{Point3f{}, Vec3f{1.0f, 0.0f, 0.0f}}).primitive);
+  EXPECT_TRUE(collect([&](auto f) { bvh.queryAabb(Aabbf{Point3f{-1.0f, -1.0f, -1.0f}, Point3f{1.0f, 1.0f, 1.0f}}, f); }).empty());
+}
+
+TEST(Bvh, Structure) {
+  auto const boxes = randomBoxes(1000);
+  Bvh const bvh{boxes, 4};
+  auto const & nodes = bvh.nodes();
+  ASSERT_EQ(boxes.size(), bvh.size());
+
+  // every primitive appears in exactly one leaf, leaves are small and
+  // children are contained in their parents and follow them
+  std::vector<std::uint32_t> seen(boxes.size(), 0);
+  for (std::size_t i = 0; i < nodes.size(); ++i) {
+    auto const & node = nodes[i];
+    if (node.count > 0) {
+      EXPECT_LE(node.count, 4u);
+      for (auto j = node.offset; j < node.offset + node.count; ++j) {
+        auto const prim = bvh.indices()[j];
+        ++seen[prim];
+        EXPECT_TRUE(contains(Aabbf{node.min, node.max}, boxes[prim].min));
+        EXPECT_TRUE(contains(Aabbf{node.min, node.max}, boxes[prim].max));
+      }
+    } else {
+      ASSERT_GT(node.offset, i + 1);
+      ASSERT_LT(node.offset, nodes.size());
+      for (auto const child : {i + 1, static_cast<std::size_t>(node.offset)}) {
+        EXPECT_TRUE(contains(Aabbf{node.min, node.max}, nodes[child].min));
+        EXPECT_TRUE(contains(Aabbf{node.min, node.max}, nodes[child].max));
+      }
+    }
+  }
+  EXPECT_TRUE(std::all_of(seen.begin(), seen.end(), [](std::uint32_t const n) { return n == 1; }));
+}
+
+TEST(Bvh, ThreadedBuildMatchesSerial) {
+  auto const boxes = randomBoxes(20000);
+  Bvh const serial{boxes, 4, 1};
+  Bvh const threaded{boxes, 4, 4};
+  ASSERT_EQ(serial.nodes().size(), threaded.nodes().size());
+  EXPECT_EQ(serial.indices(), threaded.indices());
+  for (std::size_t i = 0; i < serial.nodes().size(); ++i) {
+    EXPECT_EQ(serial.nodes()[i].min, threaded.nodes()[i].min);
+    EXPECT_EQ(serial.nodes()[i].max, threaded.nodes()[i].max);
+    EXPECT_EQ(serial.nodes()[i].offset, threaded.nodes()[i].offset);
+    EXPECT_EQ(serial.nodes()[i].count, threaded.nodes()[i].count);
+  }
+}
+
+TEST(Bvh, QueriesMatchBruteForce) {
+  auto const boxes = randomBoxes(2000);
+  Bvh const bvh{boxes};
+  std::mt19937 gen{7};
+  std::uniform_real_distribution<float> pos{-100.0f, 100.0f};
+  for (int q = 0; q < 50; ++q) {
+    Point3f const c{pos(gen), pos(gen), pos(gen)};
+    Aabbf const box{c, Point3f{c.x + 20.0f, c.y + 10.0f, c.z + 15.0f}};
+    Spheref const sphere{c, 12.0f};
+    std::vector<std::uint32_t> boxExpected;
+    std::vector<std::uint32_t> sphereExpected;
+    for (std::uint32_t i = 0; i < boxes.size(); ++i) {
+      if (intersects(boxes[i], box)) {
+        boxExpected.push_back(i);
+      }
+      if (intersects(sphere, boxes[i])) {
+        sphereExpected.push_back(i);
+      }
+    }
+    EXPECT_EQ(boxExpected, collect([&](auto f) { bvh.queryAabb(box, f); }));
+    EXPECT_EQ(sphereExpected, collect([&](auto f) { bvh.querySphere(sphere, f); }));
+  }
+}
+
+TEST(Bvh, RaycastMatchesBruteForce) {
+  auto const boxes = randomBoxes(2000);
+  Bvh const bvh{boxes};
+  std::mt19937 gen{11};
+  std::uniform_real_distribution<float> pos{-120.0f, 120.0f};
+  for (int q = 0; q < 200; ++q) {
+    Point3f const origin{pos(gen), pos(gen), pos(gen)};
+    Vec3f const dir{pos(gen), pos(gen), pos(gen)};
+    Rayf const ray{origin, dir};
+    float best = std::numeric_limits<float>::infinity();
+    for (auto const & box : boxes) {
+      best = std::min(best, intersect(ray, box));
+    }
+    auto const hit = bvh.raycast(ray);
+    EXPECT_EQ(best, hit.t);
+    if (hit.primitive != Bvh::InvalidIndex) {
+      EXPECT_EQ(best, intersect(ray, boxes[hit.primitive]));
+    } else {
+      EXPECT_EQ(std::numeric_limits<float>::infinity(), best);
+    }
+  }
+}
+
+TEST(Bvh, RaycastCallback) {
+  // unit spheres inside each box, intersected analytically
+  std::vector<Aabbf> boxes;
+  for (int i = 0; i < 10; ++i) {
+    auto const x = static_cast<float>(3 * i);
+    boxes.push_back(Aabbf{Point3f{x - 1.0f, -1.0f, -1.0f}, Point3f{x + 1.0f, 1.0f, 1.0f}});
+  }
+  Bvh const bvh{boxes, 1};
+  Rayf const ray{Point3f{12.5f, 0.0f, -10.0f}, Vec3f{0.0f, 0.0f, 1.0f}};
+  std::size_t calls = 0;
+  auto const hit = bvh.raycast(ray, 100.0f, [&](std::uint32_t const prim, float const tMax) {
+    ++calls;
+    // the hit lies past where the ray enters the box, within tMax
+    auto const dx = ray.origin.x - static_cast<float>(3 * prim);
+    float const t = dx * dx < 1.0f ? 10.0f - std::sqrt(1.0f - dx * dx) : std::numeric_limits<float>::infinity();
+    return t <= tMax ? t : std::numeric_limits<float>::infinity();
+  });
+  EXPECT_EQ(1u, calls);
+  EXPECT_EQ(4u, hit.primitive);
+  EXPECT_FLOAT_EQ(10.0f - std::sqrt(0.75f), hit.t);
+}
@@ -0,0 +1,104 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// cagey-engine - Toy 3D Engine 
+// Copyright (c) 2014 Kyle Girard <theycallmecoach@gmail.com>
+//
+// The MIT License (MIT)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in 
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+
+#include <cagey/math/Expression.hh>
+#include "gtest/gtest.h"
+
+using namespace cagey::math;
+
+namespace {
+
+template<typename T, std::size_t R, std::size_t C>
+auto sequenceMatrix(T const start) -> Matrix<T, R, C> {
+  Matrix<T, R, C> ret;
+  T val = start;
+  for (auto & e : ret) {
+    e = val;
+    val += T{1};
+  }
+  return ret;
+}
+
+} // namespace
+
+TEST(Expression, MatrixChainMatchesEager) {
+  auto const a = sequenceMatrix<float, 4, 4>(1.0f);
+  auto const b = sequenceMatrix<float, 4, 4>(-7.0f);
+  auto const c = sequenceMatrix<float, 4, 4>(0.5f);
+  Mat4f const eager = a + b * 2.0f - c / 4.0f;
+  Mat4f const fused = lazy(a) + lazy(b) * 2.0f - lazy(c) / 4.0f;
+  for (std::size_t i = 0; i < 16; ++i) {
+    EXPECT_FLOAT_EQ(eager.data[i], fused.data[i]);
+  }
+}
+
+TEST(Expression, MixedOperands) {
+  auto const a = sequenceMatrix<double, 4, 4>(3.0);
+  auto const b = sequenceMatrix<double, 4, 4>(-2.0);
+  Mat4d const fused = a + lazy(b) * 3.0 - a;
+  Mat4d const fused2 = 0.5 * (lazy(a) - b) + b;
+  for (std::size_t i = 0; i < 16; ++i) {
+    EXPECT_DOUBLE_EQ(b.data[i] * 3.0, fused.data[i]);
+    EXPECT_DOUBLE_EQ(0.5 * (a.data[i] - b.data[i]) + b.data[i], fused2.data[i]);
+  }
+}
+
+TEST(Expression, OddSizedMatrix) {
+  auto const a = sequenceMatrix<double, 6, 6>(1.0);
+  auto const b = sequenceMatrix<double, 6, 6>(100.0);
+  auto const c = sequenceMatrix<float, 3, 5>(2.0f);
+  auto const fused = eval(-lazy(a) + lazy(b));
+  auto const scaled = eval(lazy(c) * 3.0f);
+  for (std::size_t i = 0; i < 36; ++i) {
+    EXPECT_DOUBLE_EQ(99.0, fused.data[i]);
+  }
+  for (std::size_t i = 0; i < 15; ++i) {
+    EXPECT_FLOAT_EQ(c.data[i] * 3.0f, scaled.data[i]);
+  }
+}
+
+TEST(Expression, Vectors) {
+  Vec4f const a{1.0f, 2.0f, 3.0f, 4.0f};
+  Vec4f const b{4.0f, 3.0f, 2.0f, 1.0f};
+  Vec4f const fused = (lazy(a) + b) * 2.0f - a;
+  EXPECT_EQ(Vec4f(9.0f, 8.0f, 7.0f, 6.0f), fused);
+
+  Vec3i const c{1, 2, 3};
+  Vec3i const d{10, 20, 30};
+  Vec3i const ints = lazy(d) - lazy(c) * 2;
+  EXPECT_EQ(Vec3i(8, 16, 24), ints);
+}
+
+TEST(Expression, AssignAliasesOperand) {
+  auto m = sequenceMatrix<float, 4, 4>(1.0f);
+  auto const n = sequenceMatrix<float, 4, 4>(1.0f);
+  assign(m, lazy(m) * 2.0f + lazy(m));
+  for (std::size_t i = 0; i < 16; ++i) {
+    EXPECT_FLOAT_EQ(n.data[i] * 3.0f, m.data[i]);
+  }
+}
@@ -0,0 +1,131 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// cagey-engine - Toy 3D Engine 
+// Copyright (c) 2014 Kyle Girard <theycallmecoach@gmail.com>
+//
+// The MIT License (MIT)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in 
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+#include <cagey/math/Fixed.hh>
+#include <cagey/math/Matrix.hh>
+#include <cagey/math/Point.hh>
+#include "gtest/gtest.h"
+#include <cstdint>
+#include <limits>
+using namespace cagey::math;
+
+TEST(Fixed, Conversion) {
+  EXPECT_EQ(3 << 16, Fixed32{3}.raw());
+  EXPECT_EQ(-(3 << 16), Fixed32{-3}.raw());
+  EXPECT_EQ(1.5, double(Fixed32{1.5}));
+  EXPECT_EQ(-1.25f, float(Fixed32{-1.25f}));
+  EXPECT_EQ(-2, int(Fixed32{-2.75}));
+  EXPECT_EQ(128, Fixed16{0.5f}.raw());
+  // nearest raw value, ties away from zero
+  EXPECT_EQ(1, Fixed16{1.5 / 256.0 - 1e-9}.raw());
+  EXPECT_EQ(-2, Fixed16{-1.5 / 256.0}.raw());
+  EXPECT_EQ(2, sizeof(Fixed16));
+  EXPECT_EQ(4, sizeof(Fixed32));
+}
+
+TEST(Fixed, Arithmetic) {
+  Fixed32 const a{2.5};
+  Fixed32 const b{-1.25};
+  EXPECT_EQ(Fixed32{1.25}, a + b);
+  EXPECT_EQ(Fixed32{3.75}, a - b);
+  EXPECT_EQ(Fixed32{-3.125}, a * b);
+  EXPECT_EQ(Fixed32{-2}, a / b);
+  EXPECT_EQ(Fixed32{1.25}, -b);
+  EXPECT_TRUE(b < a);
+  EXPECT_TRUE(a >= a);
+  EXPECT_EQ(Fixed32{1.25}, abs(b));
+
+  // products round to the nearest raw value
+  auto const tiny = Fixed32::fromRaw(1);
+  EXPECT_EQ(1, (tiny * Fixed32{0.5}).raw());
+  EXPECT_EQ(0, (tiny * Fixed32{0.25}).raw());
+
+  constexpr Fixed32 c = Fixed32{3} * Fixed32{0.5};
+  EXPECT_EQ(Fixed32{1.5}, c);
+
+  EXPECT_THROW(a / Fixed32{0}, cagey::core::DivideByZeroException);
+}
+
+TEST(Fixed, Wrap) {
+  auto const max = std::numeric_limits<Fixed32>::max();
+  auto const lowest = std::numeric_limits<Fixed32>::lowest();
+  auto const eps = std::numeric_limits<Fixed32>::epsilon();
+  EXPECT_EQ(lowest, max + eps);
+  EXPECT_EQ(max, lowest - eps);
+  EXPECT_EQ(lowest, -lowest);
+  EXPECT_EQ(lowest, abs(lowest));
+  EXPECT_EQ(std::numeric_limits<Fixed16>::lowest(), std::numeric_limits<Fixed16>::max() + Fixed16::fromRaw(1));
+
+  // integers wrap to their low Storage bits after scaling
+  EXPECT_EQ(Fixed32{0}, Fixed32{65536});
+  EXPECT_EQ(Fixed32{-1}, Fixed32{std::numeric_limits<std::int64_t>::max()});
+  EXPECT_EQ(Fixed32{0}, Fixed32{std::numeric_limits<std::int64_t>::min()});
+  EXPECT_EQ(Fixed16{-128}, Fixed16{128u});
+}
+
+TEST(Fixed, Sqrt) {
+  EXPECT_EQ(Fixed32{3}, sqrt(Fixed32{9}));
+  EXPECT_EQ(Fixed32{0.5}, sqrt(Fixed32{0.25}));
+  EXPECT_EQ(Fixed32{0}, sqrt(Fixed32{-4}));
+  EXPECT_NEAR(1.41421356, double(sqrt(Fixed32{2})), 1.0 / 65536.0);
+  EXPECT_EQ(Fixed16{4}, sqrt(Fixed16{16}));
+}
+
+TEST(Fixed, Limits) {
+  EXPECT_EQ(1, std::numeric_limits<Fixed32>::epsilon().raw());
+  EXPECT_NEAR(32768.0, double(std::numeric_limits<Fixed32>::max()), 1e-4);
+  EXPECT_EQ(-128.0, double(std::numeric_limits<Fixed16>::lowest()));
+
+  // out of range floats saturate rather than wrap
+  EXPECT_EQ(std::numeric_limits<Fixed16>::max(), Fixed16{1000.0f});
+  EXPECT_EQ(std::numeric_limits<Fixed16>::lowest(), Fixed16{-1000.0f});
+  EXPECT_EQ(std::numeric_limits<Fixed32>::max(), Fixed32{1e30});
+  EXPECT_EQ(std::numeric_limits<Fixed32>::lowest(), Fixed32{-std::numeric_limits<float>::infinity()});
+  EXPECT_EQ(Fixed32{0}, Fixed32{std::numeric_limits<double>::quiet_NaN()});
+  EXPECT_EQ(std::numeric_limits<Fixed16>::max(), Fixed16{127.998f});
+}
+
+TEST(Fixed, Vector) {
+  Vector<Fixed32, 3> const vec{Fixed32{1}, Fixed32{2}, Fixed32{2}};
+  EXPECT_EQ(Fixed32{3}, length(vec));
+  EXPECT_EQ(Fixed32{9}, dot(vec, vec));
+  auto const unit = normalize(vec);
+  EXPECT_NEAR(1.0 / 3.0, double(unit.x), 1e-4);
+  EXPECT_NEAR(2.0 / 3.0, double(unit.z), 1e-4);
+
+  Point<Fixed32, 2> const pt{Fixed32{1}, Fixed32{-1}};
+  EXPECT_EQ(Fixed32{2}, (pt + pt).x);
+
+  // integer arithmetic, so the result is exact and the same everywhere
+  Mat4<Fixed32> mat;
+  mat(0, 3) = Fixed32{1.5};
+  mat(1, 1) = Fixed32{0.5};
+  auto const product = mat * mat;
+  EXPECT_EQ(Fixed32{3}, product(0, 3));
+  EXPECT_EQ(Fixed32{0.25}, product(1, 1));
+  EXPECT_EQ(Fixed32{1}, product(3, 3));
+}
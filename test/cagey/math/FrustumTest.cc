@@ -0,0 +1,133 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// cagey-engine - Toy 3D Engine 
+// Copyright (c) 2014 Kyle Girard <theycallmecoach@gmail.com>
+//
+// The MIT License (MIT)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in 
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+
+#include <cagey/math/Frustum.hh>
+#include "gtest/gtest.h"
+#include <random>
+#include <vector>
+
+using namespace cagey::math;
+
+namespace {
+
+auto isVisible(std::vector<std::uint32_t> const & bits, std::size_t const i) -> bool {
+  return (bits[i / 32] >> (i % 32)) & 1u;
+}
+
+/**
+ * Perspective projection looking down -z, OpenGL conventions
+ */
+auto perspective(float const near, float const far) -> Mat4f {
+  Mat4f ret{0.0f};
+  ret(0, 0) = 1.0f;
+  ret(1, 1) = 1.0f;
+  ret(2, 2) = (far + near) / (near - far);
+  ret(2, 3) = 2.0f * far * near / (near - far);
+  ret(3, 2) = -1.0f;
+  return ret;
+}
+
+} // namespace
+
+TEST(Frustum, ExtractIdentity) {
+  // the identity maps the unit cube to itself
+  Frustumf const frustum{Mat4f{}};
+  EXPECT_EQ(Vec3f(1.0f, 0.0f, 0.0f), frustum.planes[Frustumf::Left].normal);
+  EXPECT_EQ(Vec3f(-1.0f, 0.0f, 0.0f), frustum.planes[Frustumf::Right].normal);
+  EXPECT_FLOAT_EQ(1.0f, frustum.planes[Frustumf::Far].distance);
+  EXPECT_TRUE(intersects(frustum, Spheref{Point3f{1.5f, 0.0f, 0.0f}, 0.6f}));
+  EXPECT_FALSE(intersects(frustum, Spheref{Point3f{1.5f, 0.0f, 0.0f}, 0.4f}));
+  EXPECT_TRUE(intersects(frustum, Aabbf{Point3f{0.9f, 0.9f, 0.9f}, Point3f{2.0f, 2.0f, 2.0f}}));
+  EXPECT_FALSE(intersects(frustum, Aabbf{Point3f{1.1f, -0.5f, -0.5f}, Point3f{2.0f, 0.5f, 0.5f}}));
+}
+
+TEST(Frustum, ExtractPerspective) {
+  Frustumf const frustum{perspective(1.0f, 100.0f) * makeTranslation(0.0f, 0.0f, -10.0f)};
+  EXPECT_NEAR(9.0f, signedDistance(frustum.planes[Frustumf::Near], Point3f{0.0f, 0.0f, 0.0f}), 1e-4f);
+  EXPECT_NEAR(90.0f, signedDistance(frustum.planes[Frustumf::Far], Point3f{0.0f, 0.0f, 0.0f}), 1e-2f);
+  EXPECT_TRUE(intersects(frustum, Spheref{Point3f{0.0f, 0.0f, 0.0f}, 1.0f}));
+  EXPECT_FALSE(intersects(frustum, Spheref{Point3f{0.0f, 0.0f, 20.0f}, 1.0f}));
+  EXPECT_FALSE(intersects(frustum, Spheref{Point3f{20.0f, 0.0f, 0.0f}, 1.0f}));
+}
+
+TEST(Frustum, BatchMatchesScalar) {
+  Frustumf const frustum{perspective(0.5f, 50.0f) * makeTranslation(0.0f, 0.0f, -5.0f)};
+  std::mt19937 gen{37};
+  std::uniform_real_distribution<float> pos(-40.0f, 40.0f);
+  std::uniform_real_distribution<float> size(0.0f, 3.0f);
+
+  std::size_t const count = 5003;
+  Point3fArray centers;
+  Vec3fArray halfSizes;
+  std::vector<float> radii;
+  for (std::size_t i = 0; i < count; ++i) {
+    centers.pushBack(Point3f{pos(gen), pos(gen), pos(gen)});
+    halfSizes.pushBack(Vec3f{size(gen), size(gen), size(gen)});
+    radii.push_back(size(gen));
+  }
+
+  std::vector<std::uint32_t> boxBits((count + 31) / 32, 0xdeadbeef);
+  std::vector<std::uint32_t> sphereBits((count + 31) / 32, 0xdeadbeef);
+  cullAabbs(frustum, centers, halfSizes, boxBits.data());
+  cullSpheres(frustum, centers, radii, sphereBits.data());
+
+  std::size_t visibleCount = 0;
+  for (std::size_t i = 0; i < count; ++i) {
+    Point3f const c = centers[i];
+    Vec3f const e = halfSizes[i];
+    Aabbf const box{Point3f{c.x - e.x, c.y - e.y, c.z - e.z}, Point3f{c.x + e.x, c.y + e.y, c.z + e.z}};
+    EXPECT_EQ(intersects(frustum, box), isVisible(boxBits, i)) << i;
+    EXPECT_EQ(intersects(frustum, Spheref{c, radii[i]}), isVisible(sphereBits, i)) << i;
+    visibleCount += isVisible(boxBits, i);
+  }
+  EXPECT_GT(visibleCount, 0u);
+  EXPECT_LT(visibleCount, count);
+  // bits past the end are cleared
+  EXPECT_EQ(0u, boxBits.back() >> (count % 32));
+}
+
+TEST(Frustum, ThreadedMatchesSingle) {
+  Frustumf const frustum{perspective(0.5f, 50.0f)};
+  std::mt19937 gen{41};
+  std::uniform_real_distribution<float> pos(-60.0f, 60.0f);
+  std::size_t const count = 100000;
+  std::vector<float> x(count), y(count), z(count), r(count, 1.0f);
+  for (std::size_t i = 0; i < count; ++i) {
+    x[i] = pos(gen);
+    y[i] = pos(gen);
+    z[i] = pos(gen);
+  }
+  std::vector<std::uint32_t> single((count + 31) / 32);
+  std::vector<std::uint32_t> threaded((count + 31) / 32);
+  cullSpheres(frustum, x.data(), y.data(), z.data(), r.data(), count, single.data());
+  cullSpheres(frustum, x.data(), y.data(), z.data(), r.data(), count, threaded.data(), 4);
+  EXPECT_EQ(single, threaded);
+  cullAabbs(frustum, x.data(), y.data(), z.data(), r.data(), r.data(), r.data(), count, single.data());
+  cullAabbs(frustum, x.data(), y.data(), z.data(), r.data(), r.data(), r.data(), count, threaded.data(), 0);
+  EXPECT_EQ(single, threaded);
+}
@@ -0,0 +1,139 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// cagey-engine - Toy 3D Engine 
+// Copyright (c) 2014 Kyle Girard <theycallmecoach@gmail.com>
+//
+// The MIT License (MIT)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in 
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+#include <cagey/math/Half.hh>
+#include <cagey/math/Matrix.hh>
+#include <cagey/math/Point.hh>
+#include "gtest/gtest.h"
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <random>
+#include <vector>
+using namespace cagey::math;
+
+TEST(Half, RoundTripEveryValue) {
+  for (std::uint32_t bits = 0; bits < 0x10000u; ++bits) {
+    auto const half = Half::fromBits(static_cast<std::uint16_t>(bits));
+    float const value = half;
+    if (std::isnan(value)) {
+      EXPECT_EQ(0x7c00u, bits & 0x7c00u);
+      continue;
+    }
+    EXPECT_EQ(bits, Half{value}.bits());
+  }
+}
+
+TEST(Half, Rounding) {
+  EXPECT_EQ(0x3c00u, Half{1.0f}.bits());
+  EXPECT_EQ(0xc000u, Half{-2.0f}.bits());
+  // ties go to the even mantissa
+  EXPECT_EQ(0x3c00u, Half{1.0f + std::ldexp(1.0f, -11)}.bits());
+  EXPECT_EQ(0x3c02u, Half{1.0f + 3.0f * std::ldexp(1.0f, -11)}.bits());
+  EXPECT_EQ(65504.0f, float(Half{65519.0f}));
+  EXPECT_TRUE(std::isinf(float(Half{65520.0f})));
+  EXPECT_TRUE(std::isinf(float(Half{1e10f})));
+  EXPECT_TRUE(std::isnan(float(Half{std::numeric_limits<float>::quiet_NaN()})));
+  EXPECT_EQ(0x0001u, Half{std::ldexp(1.0f, -24)}.bits());
+  EXPECT_EQ(0x0000u, Half{std::ldexp(1.0f, -26)}.bits());
+  EXPECT_EQ(0x8000u, Half{-0.0f}.bits());
+  EXPECT_EQ(65504.0f, float(std::numeric_limits<Half>::max()));
+  EXPECT_EQ(std::ldexp(1.0f, -10), float(std::numeric_limits<Half>::epsilon()));
+}
+
+TEST(Half, BulkConversion) {
+  std::mt19937 gen{1};
+  std::uniform_real_distribution<float> exponent(-28.0f, 17.0f);
+  std::uniform_real_distribution<float> mantissa(-2.0f, 2.0f);
+  // odd so the scalar tail is exercised
+  std::vector<float> values(1001);
+  for (auto & val : values) {
+    val = mantissa(gen) * std::exp2(exponent(gen));
+  }
+  std::vector<Half> halves(values.size());
+  toHalf(values.data(), halves.data(), values.size());
+  std::vector<float> back(values.size());
+  toFloat(halves.data(), back.data(), values.size());
+  for (std::size_t i = 0; i < values.size(); ++i) {
+    EXPECT_EQ(Half{values[i]}.bits(), halves[i].bits());
+    EXPECT_EQ(float(halves[i]), back[i]);
+  }
+}
+
+TEST(Half, BulkEveryValue) {
+  // the SIMD kernels must agree with the scalar conversions bit for bit,
+  // NaN payloads included
+  std::vector<Half> halves(0x10000);
+  for (std::uint32_t bits = 0; bits < 0x10000u; ++bits) {
+    halves[bits] = Half::fromBits(static_cast<std::uint16_t>(bits));
+  }
+  std::vector<float> floats(halves.size());
+  toFloat(halves.data(), floats.data(), halves.size());
+  std::vector<Half> back(halves.size());
+  toHalf(floats.data(), back.data(), floats.size());
+  for (std::size_t i = 0; i < halves.size(); ++i) {
+    float const expected = halves[i];
+    std::uint32_t expectedBits;
+    std::uint32_t actualBits;
+    std::memcpy(&expectedBits, &expected, sizeof(expectedBits));
+    std::memcpy(&actualBits, &floats[i], sizeof(actualBits));
+    EXPECT_EQ(expectedBits, actualBits);
+    EXPECT_EQ(Half{floats[i]}.bits(), back[i].bits());
+  }
+}
+
+TEST(Half, BulkSpecialValues) {
+  float const inf = std::numeric_limits<float>::infinity();
+  std::vector<float> const values{65519.0f, 65520.0f, 1e10f, inf, -inf, std::numeric_limits<float>::quiet_NaN(),
+                                  -std::numeric_limits<float>::quiet_NaN(), std::ldexp(1.0f, -24),
+                                  std::ldexp(1.0f, -25), std::ldexp(3.0f, -26), -0.0f, 1.0f + std::ldexp(1.0f, -11),
+                                  1.0f + 3.0f * std::ldexp(1.0f, -11), std::numeric_limits<float>::denorm_min(),
+                                  std::ldexp(1.0f, -14), std::ldexp(1023.5f, -24)};
+  std::vector<Half> halves(values.size());
+  toHalf(values.data(), halves.data(), values.size());
+  for (std::size_t i = 0; i < values.size(); ++i) {
+    EXPECT_EQ(Half{values[i]}.bits(), halves[i].bits()) << values[i];
+  }
+}
+
+TEST(Half, Vector) {
+  EXPECT_EQ(6u, sizeof(Vector<Half, 3>));
+  Vector<Half, 3> vec{Half{1.0f}, Half{2.0f}, Half{2.0f}};
+  auto const sum = vec + vec;
+  EXPECT_EQ(4.0f, float(sum.z));
+  EXPECT_EQ(Vec3f(2.0f, 4.0f, 4.0f), Vec3f{sum});
+  EXPECT_EQ(3.0f, float(length(vec)));
+
+  Point<Half, 2> pt{Half{0.5f}, Half{0.25f}};
+  EXPECT_EQ(0.75f, float(pt.x + pt.y));
+
+  Mat4<Half> mat;
+  auto const product = mat * mat;
+  EXPECT_EQ(1.0f, float(product(2, 2)));
+  EXPECT_EQ(0.0f, float(product(2, 1)));
+}
@@ -0,0 +1,128 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// cagey-engine - Toy 3D Engine 
+// Copyright (c) 2014 Kyle Girard <theycallmecoach@gmail.com>
+//
+// The MIT License (MIT)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in 
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+////////////////////////////////////////////////////////////////////////////////
+#include <cagey/math/Lu.hh>
+#include "gtest/gtest.h"
+
+#include <algorithm>
+#include <random>
+
+using namespace cagey::math;
+
+namespace {
+
+template<std::size_t N>
+auto randomMatrix(std::mt19937 & gen) -> Matrix<double, N, N> {
+  std::uniform_real_distribution<double> dist(-1.0, 1.0);
+  Matrix<double, N, N> ret;
+  std::generate(ret.begin(), ret.end(), [&] { return dist(gen); });
+  return ret;
+}
+
+template<std::size_t N>
+auto expectIdentity(Matrix<double, N, N> const & mat, double const tolerance) -> void {
+  for (std::size_t r = 0; r < N; ++r) {
+    for (std::size_t c = 0; c < N; ++c) {
+      EXPECT_NEAR(r == c ? 1.0 : 0.0, mat(r, c), tolerance) << r << "," << c;
+    }
+  }
+}
+
+template<std::size_t N>
+auto expectInverseAndSolve(std::mt19937 & gen) -> void {
+  auto const mat = randomMatrix<N>(gen);
+  expectIdentity(inverse(mat) * mat, 1e-9);
+
+  Vector<double, N> b;
+  for (std::size_t i = 0; i < N; ++i) {
+    b[i] = static_cast<double>(i) - 2.0;
+  }
+  auto const x = solve(mat, b);
+  auto const check = mat * x;
+  for (std::size_t i = 0; i < N; ++i) {
+    EXPECT_NEAR(b[i], check[i], 1e-9);
+  }
+
+  // det(AB) = det(A) det(B)
+  auto const other = randomMatrix<N>(gen);
+  EXPECT_NEAR(det(mat) * det(other), det(mat * other), 1e-9 * std::abs(det(mat) * det(other)) + 1e-12);
+}
+
+} // namespace
+
+TEST(Lu, MatchesCofactorFor4x4) {
+  std::mt19937 gen{1};
+  for (int i = 0; i < 20; ++i) {
+    auto const mat = randomMatrix<4>(gen);
+    Lu<double, 4> const lu{mat};
+    ASSERT_FALSE(lu.isSingular());
+    EXPECT_NEAR(det(mat), lu.det(), 1e-12);
+    Mat4d luInverse;
+    ASSERT_TRUE(lu.trySolve(Mat4d{}, luInverse));
+    auto const cofactor = inverse(mat);
+    for (std::size_t j = 0; j < 16; ++j) {
+      EXPECT_NEAR(cofactor[j], luInverse[j], 1e-9);
+    }
+  }
+}
+
+TEST(Lu, Pivoting) {
+  // a permutation matrix has zeros on the diagonal and determinant +-1
+  Matrix<double, 5, 5> perm(0.0);
+  std::size_t const order[] = {3, 0, 4, 1, 2};
+  for (std::size_t c = 0; c < 5; ++c) {
+    perm(order[c], c) = 1.0;
+  }
+  Lu<double, 5> const lu{perm};
+  ASSERT_FALSE(lu.isSingular());
+  EXPECT_DOUBLE_EQ(1.0, std::abs(lu.det()));
+  expectIdentity(inverse(perm) * perm, 0.0);
+  EXPECT_EQ(transpose(perm), inverse(perm));
+}
+
+TEST(Lu, InverseAndSolve) {
+  std::mt19937 gen{2};
+  expectInverseAndSolve<1>(gen);
+  expectInverseAndSolve<5>(gen);
+  expectInverseAndSolve<6>(gen);
+  expectInverseAndSolve<12>(gen);
+}
+
+TEST(Lu, Singular) {
+  std::mt19937 gen{3};
+  auto mat = randomMatrix<6>(gen);
+  for (std::size_t c = 0; c < 6; ++c) {
+    mat(4, c) = 2.0 * mat(1, c);
+  }
+  EXPECT_TRUE((Lu<double, 6>{mat}.isSingular()));
+  EXPECT_EQ(0.0, det(mat));
+
+  Matrix<double, 6, 6> out(7.0);
+  EXPECT_FALSE(tryInverse(mat, out));
+  EXPECT_EQ((Matrix<double, 6, 6>(7.0)), out);
+  EXPECT_THROW(inverse(mat), cagey::core::SingularMatrixException);
+  EXPECT_THROW(solve(mat, Vector<double, 6>{}), cagey::core::SingularMatrixException);
+}
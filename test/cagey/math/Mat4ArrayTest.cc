@@ -0,0 +1,169 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// cagey-engine - Toy 3D Engine 
+// Copyright (c) 2014 Kyle Girard <theycallmecoach@gmail.com>
+//
+// The MIT License (MIT)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in 
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+#include <cagey/math/Mat4Array.hh>
+#include "gtest/gtest.h"
+#include <cmath>
+#include <random>
+#include <vector>
+using namespace cagey::math;
+
+namespace {
+
+Mat4f const Singular{{{1, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0}}};
+// det 1e-8 is below epsilon, so this counts as singular too
+Mat4f const NearSingular{{{0.01f, 0, 0, 0, 0, 0.01f, 0, 0, 0, 0, 0.01f, 0, 0, 0, 0, 0.01f}}};
+// det 1.6e-7 is just above epsilon
+Mat4f const JustInvertible{{{0.02f, 0, 0, 0, 0, 0.02f, 0, 0, 0, 0, 0.02f, 0, 0, 0, 0, 0.02f}}};
+Mat4f const Block{{{2, 1, 0, 0, 1, 2, 0, 0, 0, 0, 3, 0, 0, 0, 0, 1}}};
+Mat4f const SwapXY{{{0, 1, 0, 0, 1, 0, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1}}};
+
+/**
+ * Eleven matrices, so a pack of 4 or 8 leaves a tail of three: the
+ * samples in order, then Singular, NearSingular and the identity again
+ */
+auto samples() -> std::vector<Mat4f> {
+  std::vector<Mat4f> const distinct{Singular, NearSingular, Mat4f{}, makeTranslation(1.0f, 2.0f, 3.0f),
+                                    makeScale(2.0f, 4.0f, 0.5f), Block, SwapXY, JustInvertible};
+  std::vector<Mat4f> ret;
+  for (std::size_t i = 0; i < 11; ++i) {
+    ret.push_back(distinct[i % distinct.size()]);
+  }
+  return ret;
+}
+
+auto expectNear(Mat4f const & expected, Mat4f const & actual) -> void {
+  for (std::size_t k = 0; k < 16; ++k) {
+    EXPECT_NEAR(expected[k], actual[k], 1e-4f * std::max(1.0f, std::abs(expected[k])));
+  }
+}
+
+} // namespace
+
+TEST(Mat4Array, ConvertVector) {
+  std::vector<Mat4f> const mats{Mat4f{}, makeTranslation(1.0f, 2.0f, 3.0f), Block};
+  Mat4fArray arr{mats};
+  EXPECT_EQ(3u, arr.size());
+  EXPECT_EQ(mats, arr.toVector());
+  EXPECT_EQ(2.0f, arr.stream(13)[1]);
+  EXPECT_EQ(3.0f, arr.stream(10)[2]);
+
+  arr.pushBack(SwapXY);
+  EXPECT_EQ(4u, arr.size());
+  EXPECT_EQ(SwapXY, arr[3]);
+  arr.set(0, Block);
+  EXPECT_EQ(Block, arr[0]);
+
+  Mat4fArray zeros(3);
+  EXPECT_EQ(Mat4f(0.0f, 16), zeros[2]);
+  zeros.clear();
+  EXPECT_TRUE(zeros.empty());
+}
+
+TEST(Mat4Array, Det) {
+  Mat4fArray const arr{samples()};
+  std::vector<float> dets(arr.size());
+  det(arr, dets.data());
+  std::vector<float> const expected{0.0f, 1e-8f, 1.0f, 1.0f, 4.0f, 9.0f, -1.0f, 1.6e-7f, 0.0f, 1e-8f, 1.0f};
+  for (std::size_t i = 0; i < expected.size(); ++i) {
+    EXPECT_NEAR(expected[i], dets[i], 1e-6f * std::max(1.0f, expected[i])) << i;
+  }
+}
+
+TEST(Mat4Array, Inverse) {
+  Mat4fArray const arr{samples()};
+  Mat4fArray inv;
+  // Singular and NearSingular, at 0 and 1 and again in the tail at 8 and 9
+  EXPECT_EQ(4u, inverse(arr, inv));
+  ASSERT_EQ(11u, inv.size());
+  Mat4f const zero(0.0f, 16);
+  std::vector<Mat4f> const expected{
+    zero, zero, Mat4f{}, makeTranslation(-1.0f, -2.0f, -3.0f), makeScale(0.5f, 0.25f, 2.0f),
+    Mat4f{{{2.0f / 3.0f, -1.0f / 3.0f, 0, 0, -1.0f / 3.0f, 2.0f / 3.0f, 0, 0, 0, 0, 1.0f / 3.0f, 0, 0, 0, 0, 1}}},
+    SwapXY, Mat4f{{{50, 0, 0, 0, 0, 50, 0, 0, 0, 0, 50, 0, 0, 0, 0, 50}}}, zero, zero, Mat4f{}};
+  for (std::size_t i = 0; i < expected.size(); ++i) {
+    expectNear(expected[i], inv[i]);
+  }
+
+  Mat4fArray inPlace{samples()};
+  inverse(inPlace, inPlace);
+  EXPECT_EQ(inv.toVector(), inPlace.toVector());
+}
+
+TEST(Mat4Array, InverseMatchesScalar) {
+  std::mt19937 gen{3};
+  std::uniform_real_distribution<float> dist(-2.0f, 2.0f);
+  std::vector<Mat4f> mats(37);
+  for (auto & mat : mats) {
+    for (auto & v : mat) {
+      v = dist(gen);
+    }
+  }
+  Mat4fArray inv;
+  inverse(Mat4fArray{mats}, inv);
+  for (std::size_t i = 0; i < mats.size(); ++i) {
+    Mat4f expected;
+    ASSERT_TRUE(tryInverse(mats[i], expected));
+    expectNear(expected, inv[i]);
+  }
+}
+
+TEST(Mat4Array, Transpose) {
+  Mat4f const counting{{{0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15}}};
+  Mat4f const transposed{{{0, 4, 8, 12, 1, 5, 9, 13, 2, 6, 10, 14, 3, 7, 11, 15}}};
+  Mat4fArray arr{std::vector<Mat4f>(11, counting)};
+  Mat4fArray out;
+  transpose(arr, out);
+  EXPECT_EQ(std::vector<Mat4f>(11, transposed), out.toVector());
+  transpose(out, out);
+  EXPECT_EQ(arr.toVector(), out.toVector());
+}
+
+TEST(Mat4Array, Multiply) {
+  auto const lhs = samples();
+  std::vector<Mat4f> rhs(lhs.size(), Block);
+  rhs[3] = makeTranslation(-1.0f, 1.0f, 2.0f);
+  rhs[4] = makeScale(0.5f, 0.25f, 2.0f);
+  rhs[10] = SwapXY;
+  Mat4fArray a{lhs};
+  Mat4fArray const b{rhs};
+  Mat4fArray out;
+  multiply(a, b, out);
+  ASSERT_EQ(11u, out.size());
+  expectNear(Block, out[2]);
+  expectNear(makeTranslation(0.0f, 3.0f, 5.0f), out[3]);
+  expectNear(Mat4f{}, out[4]);
+  expectNear(Mat4f{{{5, 4, 0, 0, 4, 5, 0, 0, 0, 0, 9, 0, 0, 0, 0, 1}}}, out[5]);
+  expectNear(SwapXY, out[10]);
+  expectNear(Mat4f(0.0f, 16), out[8] - Singular * Block);
+
+  multiply(a, b, a);
+  EXPECT_EQ(out.toVector(), a.toVector());
+
+  Mat4fArray small(2);
+  EXPECT_THROW(multiply(small, b, out), cagey::core::InvalidArgumentException);
+}
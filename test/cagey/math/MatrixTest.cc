@@ -29,9 +29,58 @@
 #include "gtest/gtest.h"
 #include <algorithm>
 #include <type_traits>
+#include <random>
 
 using namespace cagey::math;
 
+namespace {
+
+template<typename T>
+auto randomMat4(std::mt19937 & gen) -> Mat4<T> {
+  std::uniform_real_distribution<double> dist(-10.0, 10.0);
+  Mat4<T> ret;
+  std::generate(ret.begin(), ret.end(), [&] { return static_cast<T>(dist(gen)); });
+  return ret;
+}
+
+template<typename T>
+auto referenceMultiply(Mat4<T> const & lhs, Mat4<T> const & rhs) -> Mat4<T> {
+  Mat4<T> ret{T{0}};
+  for (std::size_t i = 0; i < 4; ++i) {
+    for (std::size_t j = 0; j < 4; ++j) {
+      for (std::size_t k = 0; k < 4; ++k) {
+        ret(i, j) += lhs(i, k) * rhs(k, j);
+      }
+    }
+  }
+  return ret;
+}
+
+template<typename T>
+auto randomRigid(std::mt19937 & gen) -> Mat4<T> {
+  std::uniform_real_distribution<double> dist(-3.0, 3.0);
+  double const a = dist(gen);
+  double const b = dist(gen);
+  Mat4<T> rz;
+  rz(0, 0) = static_cast<T>(std::cos(a)); rz(0, 1) = static_cast<T>(-std::sin(a));
+  rz(1, 0) = static_cast<T>(std::sin(a)); rz(1, 1) = static_cast<T>(std::cos(a));
+  Mat4<T> rx;
+  rx(1, 1) = static_cast<T>(std::cos(b)); rx(1, 2) = static_cast<T>(-std::sin(b));
+  rx(2, 1) = static_cast<T>(std::sin(b)); rx(2, 2) = static_cast<T>(std::cos(b));
+  auto trans = makeTranslation(static_cast<T>(dist(gen)), static_cast<T>(dist(gen)), static_cast<T>(dist(gen)));
+  return trans * rz * rx;
+}
+
+template<typename T>
+auto expectIdentity(Mat4<T> const & mat, T const tolerance) -> void {
+  Mat4<T> const identity;
+  for (std::size_t j = 0; j < 16; ++j) {
+    EXPECT_NEAR(identity[j], mat[j], tolerance);
+  }
+}
+
+} // namespace
+
 
 TEST(Matrix, DefaultConstructor) {
   typedef Matrix<int, 5, 5> Mat5f;
@@ -103,3 +152,295 @@ TEST(Matrix, makeTranslationTest) {
   auto trans = makeTranslation(2.0f, 2.0f, 2.0f);
   EXPECT_EQ(2, trans(0,3));
 }
+
+TEST(Matrix, multiplyIdentity) {
+  Mat4f ma{{{1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16}}};
+  EXPECT_EQ(ma, ma * Mat4f{});
+  EXPECT_EQ(ma, Mat4f{} * ma);
+}
+
+TEST(Matrix, multiplyTranslation) {
+  auto mat = makeTranslation(1.0f, 2.0f, 3.0f) * makeTranslation(4.0f, 5.0f, 6.0f);
+  EXPECT_EQ(5, mat(0,3));
+  EXPECT_EQ(7, mat(1,3));
+  EXPECT_EQ(9, mat(2,3));
+  EXPECT_EQ(1, mat(3,3));
+}
+
+TEST(Matrix, multiplyMat4fReference) {
+  std::mt19937 gen{42};
+  for (int i = 0; i < 100; ++i) {
+    auto lhs = randomMat4<float>(gen);
+    auto rhs = randomMat4<float>(gen);
+    auto expected = referenceMultiply(lhs, rhs);
+    auto actual = lhs * rhs;
+    for (std::size_t j = 0; j < 16; ++j) {
+      EXPECT_NEAR(expected[j], actual[j], 1e-3f);
+    }
+  }
+}
+
+TEST(Matrix, multiplyMat4dReference) {
+  std::mt19937 gen{42};
+  for (int i = 0; i < 100; ++i) {
+    auto lhs = randomMat4<double>(gen);
+    auto rhs = randomMat4<double>(gen);
+    auto expected = referenceMultiply(lhs, rhs);
+    auto actual = lhs * rhs;
+    for (std::size_t j = 0; j < 16; ++j) {
+      EXPECT_NEAR(expected[j], actual[j], 1e-9);
+    }
+  }
+}
+
+TEST(Matrix, multiplyMat4iReference) {
+  Mat4i lhs{{{1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16}}};
+  Mat4i rhs{{{16, 15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1}}};
+  EXPECT_EQ(referenceMultiply(lhs, rhs), lhs * rhs);
+}
+
+TEST(Matrix, multiplyVec4) {
+  std::mt19937 gen{7};
+  auto mat = randomMat4<float>(gen);
+  Vec4f vec{1.0f, -2.0f, 3.0f, 1.0f};
+  auto actual = mat * vec;
+  for (std::size_t r = 0; r < 4; ++r) {
+    float expected = 0.0f;
+    for (std::size_t k = 0; k < 4; ++k) {
+      expected += mat(r, k) * vec[k];
+    }
+    EXPECT_NEAR(expected, actual[r], 1e-4f);
+  }
+  auto point = makeTranslation(1.0, 2.0, 3.0) * Vec4d{1.0, 1.0, 1.0, 1.0};
+  EXPECT_DOUBLE_EQ(2.0, point.x);
+  EXPECT_DOUBLE_EQ(3.0, point.y);
+  EXPECT_DOUBLE_EQ(4.0, point.z);
+  EXPECT_DOUBLE_EQ(1.0, point.w);
+}
+
+TEST(Matrix, inverseMat4) {
+  std::mt19937 gen{7};
+  for (int i = 0; i < 100; ++i) {
+    auto mat = randomMat4<double>(gen);
+    expectIdentity(mat * inverse(mat), 1e-9);
+  }
+  EXPECT_THROW(inverse(Mat4f{0.0f}), cagey::core::SingularMatrixException);
+}
+
+TEST(Matrix, inverseAffine) {
+  std::mt19937 gen{11};
+  for (int i = 0; i < 100; ++i) {
+    auto mat = randomRigid<float>(gen) * makeScale(2.0f, 0.5f, 3.0f);
+    auto inv = inverseAffine(mat);
+    expectIdentity(mat * inv, 1e-4f);
+    auto generic = inverse(mat);
+    for (std::size_t j = 0; j < 16; ++j) {
+      EXPECT_NEAR(generic[j], inv[j], 1e-4f);
+    }
+    auto matd = randomRigid<double>(gen) * makeScale(2.0, 0.5, 3.0);
+    expectIdentity(matd * inverseAffine(matd), 1e-12);
+  }
+  EXPECT_THROW(inverseAffine(makeScale(1.0f, 0.0f, 1.0f)), cagey::core::SingularMatrixException);
+}
+
+TEST(Matrix, inverseRigid) {
+  std::mt19937 gen{13};
+  for (int i = 0; i < 100; ++i) {
+    auto mat = randomRigid<float>(gen);
+    EXPECT_TRUE(isRigid(mat));
+    auto inv = inverseRigid(mat);
+    expectIdentity(mat * inv, 1e-5f);
+    auto matd = randomRigid<double>(gen);
+    expectIdentity(inverseRigid(matd) * matd, 1e-12);
+  }
+}
+
+template<typename T>
+auto checkInverseKernels(T const tolerance) -> void {
+  std::mt19937 gen{17};
+  for (int i = 0; i < 100; ++i) {
+    auto const mat = randomRigid<T>(gen) * makeScale(T{2}, T(0.5), T{3});
+    Mat4<T> simd;
+    Mat4<T> scalar;
+    EXPECT_NEAR(cagey::math::detail::inverseAffine4<T>(mat.begin(), scalar.begin()),
+                cagey::math::detail::inverseAffine4(mat.begin(), simd.begin()), tolerance);
+    for (std::size_t j = 0; j < 16; ++j) {
+      EXPECT_NEAR(scalar[j], simd[j], tolerance);
+    }
+    auto const rigid = randomRigid<T>(gen);
+    cagey::math::detail::inverseRigid4<T>(rigid.begin(), scalar.begin());
+    cagey::math::detail::inverseRigid4(rigid.begin(), simd.begin());
+    for (std::size_t j = 0; j < 16; ++j) {
+      EXPECT_NEAR(scalar[j], simd[j], tolerance);
+    }
+  }
+}
+
+TEST(Matrix, inverseAffineKernels) {
+  // the SIMD kernels agree with the scalar fallbacks
+  checkInverseKernels<float>(1e-5f);
+  checkInverseKernels<double>(1e-13);
+  EXPECT_THROW(inverseAffine(makeScale(1.0, 0.0, 1.0)), cagey::core::SingularMatrixException);
+}
+
+TEST(Matrix, isAffine) {
+  EXPECT_TRUE(isAffine(makeScale(2.0f, 3.0f, 4.0f)));
+  EXPECT_FALSE(isRigid(makeScale(2.0f, 3.0f, 4.0f)));
+  Mat4f projective;
+  projective(3, 2) = -1.0f;
+  EXPECT_FALSE(isAffine(projective));
+  EXPECT_FALSE(isRigid(projective));
+}
+
+TEST(Matrix, tryInverse) {
+  Mat3d const mat{{{2.0, 0.0, 0.0, 0.0, 4.0, 0.0, 1.0, 0.0, 1.0}}};
+  Mat3d inv{0.0};
+  EXPECT_TRUE(tryInverse(mat, inv));
+  EXPECT_EQ(inverse(mat), inv);
+
+  Mat3d const singular{1.0};
+  EXPECT_FALSE(tryInverse(singular, inv));
+  EXPECT_EQ(inverse(mat), inv);
+
+  Mat4f out;
+  EXPECT_FALSE(tryInverseAffine(makeScale(0.0f, 1.0f, 1.0f), out));
+  EXPECT_EQ(Mat4f{}, out);
+  EXPECT_TRUE(tryInverseAffine(makeScale(2.0f, 4.0f, 8.0f), out));
+  EXPECT_EQ(makeScale(0.5f, 0.25f, 0.125f), out);
+
+  // the bottom row is not read
+  auto projective = makeScale(2.0f, 4.0f, 8.0f);
+  projective(3, 2) = -1.0f;
+  projective(3, 3) = 0.0f;
+  out = Mat4f{};
+  EXPECT_TRUE(tryInverseAffine(projective, out));
+  EXPECT_EQ(makeScale(0.5f, 0.25f, 0.125f), out);
+}
+
+TEST(Matrix, tryDivide) {
+  Mat2f mat{{{2.0f, 4.0f, 6.0f, 8.0f}}};
+  EXPECT_FALSE(tryDivide(mat, 0.0f));
+  EXPECT_EQ((Mat2f{{{2.0f, 4.0f, 6.0f, 8.0f}}}), mat);
+  EXPECT_TRUE(tryDivide(mat, 2.0f));
+  EXPECT_EQ((Mat2f{{{1.0f, 2.0f, 3.0f, 4.0f}}}), mat);
+  EXPECT_THROW(mat /= 0.0f, cagey::core::DivideByZeroException);
+}
+
+namespace {
+
+template<std::size_t R, std::size_t C>
+auto randomMatrix(std::mt19937 & gen) -> Matrix<int, R, C> {
+  std::uniform_int_distribution<int> dist(-9, 9);
+  Matrix<int, R, C> ret;
+  std::generate(ret.begin(), ret.end(), [&] { return dist(gen); });
+  return ret;
+}
+
+template<std::size_t R, std::size_t N, std::size_t C>
+auto expectMultiply(std::mt19937 & gen) -> void {
+  auto const lhs = randomMatrix<R, N>(gen);
+  auto const rhs = randomMatrix<N, C>(gen);
+  auto const product = lhs * rhs;
+  static_assert(std::is_same<decltype(product), Matrix<int, R, C> const>::value, "R by C result");
+  for (std::size_t r = 0; r < R; ++r) {
+    for (std::size_t c = 0; c < C; ++c) {
+      int expected = 0;
+      for (std::size_t k = 0; k < N; ++k) {
+        expected += lhs(r, k) * rhs(k, c);
+      }
+      EXPECT_EQ(expected, product(r, c)) << R << "x" << N << " * " << N << "x" << C << " at " << r << "," << c;
+    }
+  }
+}
+
+template<std::size_t R, std::size_t C>
+auto expectTranspose(std::mt19937 & gen) -> void {
+  auto const mat = randomMatrix<R, C>(gen);
+  auto const ret = transpose(mat);
+  static_assert(std::is_same<decltype(ret), Matrix<int, C, R> const>::value, "C by R result");
+  for (std::size_t r = 0; r < R; ++r) {
+    for (std::size_t c = 0; c < C; ++c) {
+      EXPECT_EQ(mat(r, c), ret(c, r)) << R << "x" << C << " at " << r << "," << c;
+    }
+  }
+  EXPECT_EQ(mat, transpose(ret));
+}
+
+template<std::size_t R, std::size_t C>
+auto expectMultiplyVector(std::mt19937 & gen) -> void {
+  auto const mat = randomMatrix<R, C>(gen);
+  Vector<int, C> vec;
+  std::uniform_int_distribution<int> dist(-9, 9);
+  for (std::size_t i = 0; i < C; ++i) {
+    vec[i] = dist(gen);
+  }
+  auto const ret = mat * vec;
+  for (std::size_t r = 0; r < R; ++r) {
+    int expected = 0;
+    for (std::size_t c = 0; c < C; ++c) {
+      expected += mat(r, c) * vec[c];
+    }
+    EXPECT_EQ(expected, ret[r]) << R << "x" << C << " row " << r;
+  }
+}
+
+} // namespace
+
+TEST(Matrix, nonSquareIndexing) {
+  Matrix<int, 2, 3> const mat{std::array<int, 6>{{1, 2, 3, 4, 5, 6}}};
+  EXPECT_EQ(1, mat(0, 0));
+  EXPECT_EQ(2, mat(1, 0));
+  EXPECT_EQ(3, mat(0, 1));
+  EXPECT_EQ(6, mat(1, 2));
+
+  Matrix<int, 2, 3> const identity;
+  EXPECT_EQ((std::array<int, 6>{{1, 0, 0, 1, 0, 0}}), identity.data);
+  Matrix<int, 3, 2> const tall;
+  EXPECT_EQ((std::array<int, 6>{{1, 0, 0, 0, 1, 0}}), tall.data);
+}
+
+TEST(Matrix, multiplySizes) {
+  std::mt19937 gen{101};
+  expectMultiply<1, 4, 1>(gen);
+  expectMultiply<4, 1, 4>(gen);
+  expectMultiply<1, 4, 6>(gen);
+  expectMultiply<2, 2, 2>(gen);
+  expectMultiply<2, 3, 5>(gen);
+  expectMultiply<3, 3, 3>(gen);
+  expectMultiply<3, 5, 2>(gen);
+  expectMultiply<4, 4, 4>(gen);
+  expectMultiply<5, 5, 5>(gen);
+  expectMultiply<6, 4, 3>(gen);
+  expectMultiply<6, 6, 6>(gen);
+}
+
+TEST(Matrix, transposeSizes) {
+  std::mt19937 gen{103};
+  expectTranspose<1, 4>(gen);
+  expectTranspose<2, 3>(gen);
+  expectTranspose<3, 3>(gen);
+  expectTranspose<4, 4>(gen);
+  expectTranspose<5, 2>(gen);
+  expectTranspose<3, 6>(gen);
+  expectTranspose<6, 6>(gen);
+}
+
+TEST(Matrix, multiplyVectorSizes) {
+  std::mt19937 gen{107};
+  expectMultiplyVector<2, 2>(gen);
+  expectMultiplyVector<2, 4>(gen);
+  expectMultiplyVector<3, 3>(gen);
+  expectMultiplyVector<4, 3>(gen);
+  expectMultiplyVector<4, 4>(gen);
+  expectMultiplyVector<6, 4>(gen);
+}
+
+TEST(Matrix, constexprMultiplyTranspose) {
+  constexpr Matrix<int, 2, 3> mat{std::array<int, 6>{{1, 2, 3, 4, 5, 6}}};
+  constexpr auto product = mat * transpose(mat);
+  static_assert(product(0, 0) == 35 && product(0, 1) == 44 && product(1, 0) == 44 && product(1, 1) == 56,
+                "multiply and transpose are constant expressions");
+  constexpr auto vec = mat * Vec3i{std::array<int, 3>{{1, 0, -1}}};
+  static_assert(vec[0] == -4 && vec[1] == -4, "matrix vector multiply is a constant expression");
+  EXPECT_EQ(35, product(0, 0));
+}
@@ -0,0 +1,136 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// cagey-engine - Toy 3D Engine 
+// Copyright (c) 2014 Kyle Girard <theycallmecoach@gmail.com>
+//
+// The MIT License (MIT)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in 
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+#include <cagey/math/Morton.hh>
+#include "gtest/gtest.h"
+#include <cstdint>
+#include <random>
+#include <vector>
+using namespace cagey::math;
+
+TEST(Morton, Encode2) {
+  EXPECT_EQ(0u, encodeMorton2(Point2u{0, 0}));
+  EXPECT_EQ(1u, encodeMorton2(Point2u{1, 0}));
+  EXPECT_EQ(2u, encodeMorton2(Point2u{0, 1}));
+  EXPECT_EQ(3u, encodeMorton2(Point2u{1, 1}));
+  EXPECT_EQ(0x30u, encodeMorton2(Point2u{4, 4}));
+  EXPECT_EQ(0x5555555555555555ull, encodeMorton2(Point2u{0xffffffffu, 0}));
+  EXPECT_EQ(0xffffffffffffffffull, encodeMorton2(Point2u{0xffffffffu, 0xffffffffu}));
+}
+
+TEST(Morton, Encode3) {
+  EXPECT_EQ(0u, encodeMorton3(Point3u{0, 0, 0}));
+  EXPECT_EQ(1u, encodeMorton3(Point3u{1, 0, 0}));
+  EXPECT_EQ(2u, encodeMorton3(Point3u{0, 1, 0}));
+  EXPECT_EQ(4u, encodeMorton3(Point3u{0, 0, 1}));
+  EXPECT_EQ(0x38u, encodeMorton3(Point3u{2, 2, 2}));
+  EXPECT_EQ(0x7fffffffffffffffull, encodeMorton3(Point3u{0x1fffff, 0x1fffff, 0x1fffff}));
+  // only the low 21 bits of each coordinate fit
+  EXPECT_EQ(encodeMorton3(Point3u{5, 6, 7}), encodeMorton3(Point3u{5 | 0x200000, 6 | 0x400000, 7 | 0x800000}));
+}
+
+TEST(Morton, Decode2) {
+  EXPECT_EQ(Point2u(0, 0), decodeMorton2(0));
+  EXPECT_EQ(Point2u(1, 0), decodeMorton2(1));
+  EXPECT_EQ(Point2u(0, 1), decodeMorton2(2));
+  EXPECT_EQ(Point2u(4, 4), decodeMorton2(0x30));
+  EXPECT_EQ(Point2u(0xffffffffu, 0), decodeMorton2(0x5555555555555555ull));
+  EXPECT_EQ(Point2u(0, 0xffffffffu), decodeMorton2(0xaaaaaaaaaaaaaaaaull));
+  EXPECT_EQ(Point2u(0x80000000u, 0x80000000u), decodeMorton2(0xc000000000000000ull));
+  EXPECT_EQ(Point2u(0xffffffffu, 0xffffffffu), decodeMorton2(0xffffffffffffffffull));
+}
+
+TEST(Morton, Decode3) {
+  EXPECT_EQ(Point3u(0, 0, 0), decodeMorton3(0));
+  EXPECT_EQ(Point3u(1, 0, 0), decodeMorton3(1));
+  EXPECT_EQ(Point3u(0, 1, 0), decodeMorton3(2));
+  EXPECT_EQ(Point3u(0, 0, 1), decodeMorton3(4));
+  EXPECT_EQ(Point3u(2, 2, 2), decodeMorton3(0x38));
+  EXPECT_EQ(Point3u(0x1fffff, 0, 0), decodeMorton3(0x1249249249249249ull));
+  EXPECT_EQ(Point3u(0x100000, 0x100000, 0x100000), decodeMorton3(0x7000000000000000ull));
+  // bit 63 is not part of any coordinate
+  EXPECT_EQ(Point3u(0x1fffff, 0x1fffff, 0x1fffff), decodeMorton3(0xffffffffffffffffull));
+}
+
+TEST(Morton, Order) {
+  // codes of the cells of a 2x2 block are contiguous and in z order
+  EXPECT_LT(encodeMorton2(Point2u{1, 1}), encodeMorton2(Point2u{2, 0}));
+  EXPECT_LT(encodeMorton3(Point3u{1, 1, 1}), encodeMorton3(Point3u{2, 0, 0}));
+}
+
+TEST(Morton, MagicBits) {
+  // with BMI2 the codes come from pdep/pext, check them against the masks
+  std::mt19937 gen{1};
+  std::uniform_int_distribution<std::uint32_t> dist2;
+  std::uniform_int_distribution<std::uint32_t> dist3(0, 0x1fffff);
+  for (int i = 0; i < 1000; ++i) {
+    Point2u const pt2{dist2(gen), dist2(gen)};
+    auto const code2 = detail::spreadBits2(pt2.x) | (detail::spreadBits2(pt2.y) << 1);
+    EXPECT_EQ(code2, encodeMorton2(pt2));
+    EXPECT_EQ(pt2, decodeMorton2(code2));
+
+    Point3u const pt3{dist3(gen), dist3(gen), dist3(gen)};
+    auto const code3 = detail::spreadBits3(pt3.x) | (detail::spreadBits3(pt3.y) << 1) | (detail::spreadBits3(pt3.z) << 2);
+    EXPECT_EQ(code3, encodeMorton3(pt3));
+    EXPECT_EQ(pt3, decodeMorton3(code3));
+  }
+}
+
+TEST(Morton, Bulk2) {
+  // an odd count leaves a tail after any packed loop
+  std::vector<Point2u> const pts{{0, 0}, {1, 0}, {0, 1}, {1, 1}, {4, 4}, {0xffffffffu, 0}, {0, 0xffffffffu},
+                                 {0xffffffffu, 0xffffffffu}, {0x80000000u, 1}, {0x12345678u, 0x9abcdef0u}, {7, 0x10000u}};
+  std::vector<std::uint64_t> codes(pts.size());
+  std::vector<Point2u> decoded(pts.size());
+  encodeMorton2(pts.data(), codes.data(), pts.size());
+  decodeMorton2(codes.data(), decoded.data(), pts.size());
+  EXPECT_EQ(0x5555555555555555ull, codes[5]);
+  EXPECT_EQ(0xaaaaaaaaaaaaaaaaull, codes[6]);
+  for (std::size_t i = 0; i < pts.size(); ++i) {
+    EXPECT_EQ(encodeMorton2(pts[i]), codes[i]);
+    EXPECT_EQ(pts[i], decoded[i]);
+  }
+}
+
+TEST(Morton, Bulk3) {
+  std::vector<Point3u> const pts{{0, 0, 0}, {1, 0, 0}, {0, 1, 0}, {0, 0, 1}, {2, 2, 2}, {0x1fffff, 0, 0}, {0, 0x1fffff, 0},
+                                 {0, 0, 0x1fffff}, {0x1fffff, 0x1fffff, 0x1fffff}, {0x100000, 1, 0x0abcde}, {0x12345, 0x54321, 7}};
+  std::vector<std::uint64_t> codes(pts.size());
+  std::vector<Point3u> decoded(pts.size());
+  encodeMorton3(pts.data(), codes.data(), pts.size());
+  decodeMorton3(codes.data(), decoded.data(), pts.size());
+  EXPECT_EQ(0x7fffffffffffffffull, codes[8]);
+  for (std::size_t i = 0; i < pts.size(); ++i) {
+    EXPECT_EQ(encodeMorton3(pts[i]), codes[i]);
+    EXPECT_EQ(pts[i], decoded[i]);
+  }
+  // coordinates above 21 bits are masked like the single point version
+  Point3u const wide{0xffffffffu, 0x200001u, 0};
+  std::uint64_t code = 0;
+  encodeMorton3(&wide, &code, 1);
+  EXPECT_EQ(encodeMorton3(Point3u{0x1fffff, 1, 0}), code);
+}
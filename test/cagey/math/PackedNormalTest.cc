@@ -0,0 +1,164 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// cagey-engine - Toy 3D Engine 
+// Copyright (c) 2014 Kyle Girard <theycallmecoach@gmail.com>
+//
+// The MIT License (MIT)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in 
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+#include <cagey/math/PackedNormal.hh>
+#include "gtest/gtest.h"
+#include <cmath>
+#include <cstdint>
+#include <random>
+#include <vector>
+using namespace cagey::math;
+
+namespace {
+
+/**
+ * Angle in degrees between a unit vector and its decoded value
+ */
+auto angleError(Vec3f const & expected, Vec3f const & actual) -> double {
+  double const c = dot(expected, actual);
+  double const s = length(cross(expected, actual));
+  return std::atan2(s, c) * 180.0 / 3.14159265358979;
+}
+
+/**
+ * The axes, then the lower hemisphere fold seam where x or y is zero,
+ * both signs of zero included, then the octant corners: thirteen vectors,
+ * so packs of 4 and 8 leave a tail
+ */
+auto edgeCases() -> std::vector<Vec3f> {
+  return {Vec3f{1.0f, 0.0f, 0.0f}, Vec3f{-1.0f, 0.0f, 0.0f}, Vec3f{0.0f, 1.0f, 0.0f}, Vec3f{0.0f, -1.0f, 0.0f},
+          Vec3f{0.0f, 0.0f, 1.0f}, Vec3f{0.0f, 0.0f, -1.0f},
+          Vec3f{0.0f, 0.6f, -0.8f}, Vec3f{-0.0f, -0.6f, -0.8f}, Vec3f{0.6f, 0.0f, -0.8f}, Vec3f{-0.6f, -0.0f, -0.8f},
+          normalize(Vec3f{1.0f, 1.0f, 1.0f}), normalize(Vec3f{-1.0f, 1.0f, -1.0f}), normalize(Vec3f{1.0f, -1.0f, -1.0f})};
+}
+
+} // namespace
+
+TEST(PackedNormal, Axes) {
+  EXPECT_EQ(0x00007fffu, encodeOct32(Vec3f{1.0f, 0.0f, 0.0f}));
+  EXPECT_EQ(0x7fff0000u, encodeOct32(Vec3f{0.0f, 1.0f, 0.0f}));
+  EXPECT_EQ(0x7f7fu, encodeOct16(Vec3f{0.0f, 0.0f, -1.0f}));
+  EXPECT_EQ(0x400001ffu, encode1010102(Vec3f{1.0f, 0.0f, 0.0f}));
+  for (auto const & axis : edgeCases()) {
+    if (std::abs(axis.x) + std::abs(axis.y) + std::abs(axis.z) != 1.0f) {
+      continue;
+    }
+    EXPECT_EQ(axis, decodeOct32(encodeOct32(axis)));
+    EXPECT_EQ(axis, decodeOct16(encodeOct16(axis)));
+    EXPECT_EQ(axis, decode1010102(encode1010102(axis)));
+  }
+}
+
+TEST(PackedNormal, ErrorBounds) {
+  // the limits documented in PackedNormal.hh
+  for (auto const & vec : edgeCases()) {
+    EXPECT_LT(angleError(vec, decodeOct32(encodeOct32(vec))), 0.005) << vec;
+    EXPECT_LT(angleError(vec, decodeOct16(encodeOct16(vec))), 1.0) << vec;
+    EXPECT_LT(angleError(vec, decode1010102(encode1010102(vec))), 0.11) << vec;
+  }
+}
+
+TEST(PackedNormal, FoldSeam) {
+  // on the seam the fold keeps x or y at zero, whichever the sign of zero
+  EXPECT_EQ(encodeOct32(Vec3f{0.0f, 0.6f, -0.8f}), encodeOct32(Vec3f{-0.0f, 0.6f, -0.8f}));
+  auto const vec = decodeOct32(encodeOct32(Vec3f{0.0f, -0.6f, -0.8f}));
+  EXPECT_EQ(0.0f, vec.x);
+  EXPECT_NEAR(-0.6f, vec.y, 1e-4f);
+  EXPECT_NEAR(-0.8f, vec.z, 1e-4f);
+}
+
+TEST(PackedNormal, MinimumBitPattern) {
+  // -Max - 1 is one step past -1 and decodes as -1
+  EXPECT_EQ(Vec3f(-1.0f, 0.0f, 0.0f), decodeOct32(0x00008000u));
+  EXPECT_EQ(Vec3f(0.0f, -1.0f, 0.0f), decodeOct32(0x80000000u));
+  EXPECT_EQ(Vec3f(-1.0f, 0.0f, 0.0f), decodeOct16(0x0080u));
+  EXPECT_EQ(Vec3f(0.0f, 0.0f, -1.0f), decode1010102(0x20000000u));
+  // w's -2 pattern clamps to -1 as well
+  float w = 0.0f;
+  EXPECT_EQ(Vec3f(1.0f, 0.0f, 0.0f), decode1010102(0x800001ffu, &w));
+  EXPECT_EQ(-1.0f, w);
+}
+
+TEST(PackedNormal, Handedness) {
+  float w = 0.0f;
+  EXPECT_EQ(0xdff00000u, encode1010102(Vec3f{0.0f, 0.0f, 1.0f}, -1.0f));
+  EXPECT_EQ(Vec3f(0.0f, 0.0f, 1.0f), decode1010102(0xdff00000u, &w));
+  EXPECT_EQ(-1.0f, w);
+  decode1010102(encode1010102(Vec3f{0.0f, 1.0f, 0.0f}, 1.0f), &w);
+  EXPECT_EQ(1.0f, w);
+}
+
+TEST(PackedNormal, ArraysMatchSingle) {
+  auto const normals = edgeCases();
+  std::vector<float> handedness(normals.size());
+  for (std::size_t i = 0; i < normals.size(); ++i) {
+    handedness[i] = i % 3 ? 1.0f : -1.0f;
+  }
+  std::vector<std::uint32_t> oct32(normals.size());
+  std::vector<std::uint16_t> oct16(normals.size());
+  std::vector<std::uint32_t> snorm(normals.size());
+  std::vector<Vec3f> decoded(normals.size());
+  std::vector<float> w(normals.size());
+  encodeOct32(normals.data(), oct32.data(), normals.size());
+  encodeOct16(normals.data(), oct16.data(), normals.size());
+  encode1010102(normals.data(), handedness.data(), snorm.data(), normals.size());
+  for (std::size_t i = 0; i < normals.size(); ++i) {
+    EXPECT_EQ(encodeOct32(normals[i]), oct32[i]);
+    EXPECT_EQ(encodeOct16(normals[i]), oct16[i]);
+    EXPECT_EQ(encode1010102(normals[i], handedness[i]), snorm[i]);
+  }
+  decodeOct32(oct32.data(), decoded.data(), normals.size());
+  for (std::size_t i = 0; i < normals.size(); ++i) {
+    EXPECT_EQ(decodeOct32(oct32[i]), decoded[i]);
+  }
+  decodeOct16(oct16.data(), decoded.data(), normals.size());
+  for (std::size_t i = 0; i < normals.size(); ++i) {
+    EXPECT_EQ(decodeOct16(oct16[i]), decoded[i]);
+  }
+  decode1010102(snorm.data(), decoded.data(), w.data(), normals.size());
+  for (std::size_t i = 0; i < normals.size(); ++i) {
+    EXPECT_EQ(decode1010102(snorm[i]), decoded[i]);
+    EXPECT_EQ(handedness[i], w[i]);
+  }
+}
+
+TEST(PackedNormal, RandomWithinBounds) {
+  std::mt19937 gen{1};
+  std::normal_distribution<float> dist;
+  for (int i = 0; i < 5000; ++i) {
+    auto const vec = normalize(Vec3f{dist(gen), dist(gen), dist(gen)});
+    EXPECT_LT(angleError(vec, decodeOct32(encodeOct32(vec))), 0.005);
+    EXPECT_LT(angleError(vec, decodeOct16(encodeOct16(vec))), 1.0);
+    EXPECT_LT(angleError(vec, decode1010102(encode1010102(vec))), 0.11);
+  }
+}
+
+TEST(PackedNormal, Double) {
+  Vec3d const vec = normalize(Vec3d{0.3, -0.5, -0.8});
+  EXPECT_NEAR(1.0, dot(vec, decodeOct32<double>(encodeOct32(vec))), 1e-8);
+  EXPECT_NEAR(1.0, dot(vec, decode1010102<double>(encode1010102(vec))), 1e-5);
+}
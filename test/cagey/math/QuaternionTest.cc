@@ -0,0 +1,178 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// cagey-engine - Toy 3D Engine 
+// Copyright (c) 2014 Kyle Girard <theycallmecoach@gmail.com>
+//
+// The MIT License (MIT)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in 
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+#include <cagey/math/Quaternion.hh>
+#include "gtest/gtest.h"
+#include <random>
+#include <vector>
+using namespace cagey::math;
+
+namespace {
+
+auto randomQuat(std::mt19937 & gen) -> Quatf {
+  std::uniform_real_distribution<float> dist(-1.0f, 1.0f);
+  return normalize(Quatf{dist(gen), dist(gen), dist(gen), dist(gen)});
+}
+
+} // namespace
+
+TEST(Quaternion, DefaultConstructor) {
+  Quatf q;
+  EXPECT_EQ(0.0f, q.x);
+  EXPECT_EQ(0.0f, q.y);
+  EXPECT_EQ(0.0f, q.z);
+  EXPECT_EQ(1.0f, q.w);
+}
+
+TEST(Quaternion, AxisAngleConstructor) {
+  Quatf q{Vec3f{0.0f, 0.0f, 2.0f}, Radian<float>{constants::pi<float>}};
+  EXPECT_NEAR(0.0f, q.x, 1e-6f);
+  EXPECT_NEAR(1.0f, q.z, 1e-6f);
+  EXPECT_NEAR(0.0f, q.w, 1e-6f);
+}
+
+TEST(Quaternion, RotateVector) {
+  Quatd q{Vec3d{0.0, 0.0, 1.0}, Radian<double>{constants::pi<double> / 2.0}};
+  auto v = q * Vec3d{1.0, 0.0, 0.0};
+  EXPECT_NEAR(0.0, v.x, 1e-12);
+  EXPECT_NEAR(1.0, v.y, 1e-12);
+  EXPECT_NEAR(0.0, v.z, 1e-12);
+}
+
+TEST(Quaternion, ProductAndConjugate) {
+  Quatd a{Vec3d{0.0, 0.0, 1.0}, Radian<double>{0.5}};
+  Quatd b{Vec3d{0.0, 0.0, 1.0}, Radian<double>{0.25}};
+  Quatd c{Vec3d{0.0, 0.0, 1.0}, Radian<double>{0.75}};
+  auto ab = a * b;
+  EXPECT_NEAR(c.z, ab.z, 1e-12);
+  EXPECT_NEAR(c.w, ab.w, 1e-12);
+  auto ident = a * conjugate(a);
+  EXPECT_NEAR(0.0, ident.z, 1e-12);
+  EXPECT_NEAR(1.0, ident.w, 1e-12);
+}
+
+TEST(Quaternion, ToMatrixMatchesRotation) {
+  std::mt19937 gen{3};
+  Vec3f v{1.0f, -2.0f, 0.5f};
+  for (int i = 0; i < 20; ++i) {
+    auto q = randomQuat(gen);
+    auto expected = q * v;
+    auto m4 = toMat4(q) * Vec4f{v.x, v.y, v.z, 0.0f};
+    auto m3 = toMat3(q);
+    EXPECT_NEAR(expected.x, m4.x, 1e-5f);
+    EXPECT_NEAR(expected.y, m4.y, 1e-5f);
+    EXPECT_NEAR(expected.z, m4.z, 1e-5f);
+    EXPECT_NEAR(expected.x, m3(0,0) * v.x + m3(0,1) * v.y + m3(0,2) * v.z, 1e-5f);
+    EXPECT_NEAR(expected.y, m3(1,0) * v.x + m3(1,1) * v.y + m3(1,2) * v.z, 1e-5f);
+    EXPECT_NEAR(expected.z, m3(2,0) * v.x + m3(2,1) * v.y + m3(2,2) * v.z, 1e-5f);
+  }
+}
+
+TEST(Quaternion, SlerpEndpointsAndMidpoint) {
+  Quatd a;
+  Quatd b{Vec3d{0.0, 1.0, 0.0}, Radian<double>{1.0}};
+  Quatd mid{Vec3d{0.0, 1.0, 0.0}, Radian<double>{0.5}};
+  auto s0 = slerp(a, b, 0.0);
+  auto s1 = slerp(a, b, 1.0);
+  auto sm = slerp(a, b, 0.5);
+  EXPECT_NEAR(a.w, s0.w, 1e-12);
+  EXPECT_NEAR(b.y, s1.y, 1e-12);
+  EXPECT_NEAR(mid.y, sm.y, 1e-12);
+  EXPECT_NEAR(mid.w, sm.w, 1e-12);
+  //shortest path through the negated quaternion
+  auto sn = slerp(a, -b, 0.5);
+  EXPECT_NEAR(mid.w, std::abs(sn.w), 1e-12);
+}
+
+TEST(Quaternion, NlerpIsUnitLength) {
+  Quatf a{Vec3f{1.0f, 0.0f, 0.0f}, Radian<float>{0.3f}};
+  Quatf b{Vec3f{0.0f, 1.0f, 0.0f}, Radian<float>{1.3f}};
+  EXPECT_NEAR(1.0f, length(nlerp(a, b, 0.3f)), 1e-6f);
+}
+
+TEST(Quaternion, BatchedSlerpMatchesScalar) {
+  std::mt19937 gen{11};
+  std::uniform_real_distribution<float> dist(0.0f, 1.0f);
+  std::size_t const count = 45;
+  std::vector<Quatf> from(count);
+  std::vector<Quatf> to(count);
+  std::vector<float> t(count);
+  for (std::size_t i = 0; i < count; ++i) {
+    from[i] = randomQuat(gen);
+    to[i] = randomQuat(gen);
+    t[i] = dist(gen);
+  }
+  //nearly identical and opposite rotations
+  to[5] = from[5];
+  to[6] = -from[6];
+
+  std::vector<Quatf> out(count);
+  slerp(from.data(), to.data(), t.data(), out.data(), count);
+  for (std::size_t i = 0; i < count; ++i) {
+    auto expected = slerp(from[i], to[i], t[i]);
+    for (std::size_t k = 0; k < 4; ++k) {
+      EXPECT_NEAR(expected[k], out[i][k], 1e-6f);
+    }
+  }
+
+  slerp(from.data(), to.data(), 0.25f, out.data(), count);
+  for (std::size_t i = 0; i < count; ++i) {
+    auto expected = slerp(from[i], to[i], 0.25f);
+    for (std::size_t k = 0; k < 4; ++k) {
+      EXPECT_NEAR(expected[k], out[i][k], 1e-6f);
+    }
+  }
+}
+
+TEST(Quaternion, BatchedSlerpDouble) {
+  std::vector<Quatd> from(3, Quatd{});
+  std::vector<Quatd> to(3, Quatd{Vec3d{0.0, 0.0, 1.0}, Radian<double>{1.0}});
+  std::vector<Quatd> out(3);
+  slerp(from.data(), to.data(), 0.5, out.data(), out.size());
+  auto expected = slerp(from[0], to[0], 0.5);
+  for (auto const & q : out) {
+    EXPECT_NEAR(expected.z, q.z, 1e-10);
+    EXPECT_NEAR(expected.w, q.w, 1e-10);
+  }
+}
+
+TEST(Quaternion, BatchedSlerpExtrapolates) {
+  // t outside [0, 1] takes the scalar path lane by lane, in place
+  Quatd const a{};
+  Quatd const b{Vec3d{0.0, 0.0, 1.0}, Radian<double>{3.0}};
+  std::vector<double> const t{0.0, -0.5, 0.25, 1.5, 1.0, 3.0, 0.75, -2.0, 0.5};
+  std::vector<Quatd> from(t.size(), a);
+  std::vector<Quatd> const to(t.size(), b);
+  slerp(from.data(), to.data(), t.data(), from.data(), from.size());
+  for (std::size_t i = 0; i < t.size(); ++i) {
+    // rotations about z by 3t radians, beyond the sin polynomial for t = 3
+    Quatd const expected{Vec3d{0.0, 0.0, 1.0}, Radian<double>{3.0 * t[i]}};
+    for (std::size_t k = 0; k < 4; ++k) {
+      EXPECT_NEAR(expected[k], from[i][k], 1e-8) << i;
+    }
+  }
+}
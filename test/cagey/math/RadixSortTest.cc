@@ -0,0 +1,130 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// cagey-engine - Toy 3D Engine 
+// Copyright (c) 2014 Kyle Girard <theycallmecoach@gmail.com>
+//
+// The MIT License (MIT)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in 
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+#include <cagey/math/RadixSort.hh>
+#include "gtest/gtest.h"
+#include <algorithm>
+#include <cstdint>
+#include <numeric>
+#include <random>
+#include <utility>
+#include <vector>
+using namespace cagey::math;
+
+namespace {
+
+auto indices(std::size_t const count) -> std::vector<std::uint32_t> {
+  std::vector<std::uint32_t> ret(count);
+  std::iota(ret.begin(), ret.end(), 0u);
+  return ret;
+}
+
+} // namespace
+
+TEST(RadixSort, Empty) {
+  std::vector<std::uint64_t> keys;
+  std::vector<std::uint32_t> values;
+  radixSort(keys, values);
+  EXPECT_TRUE(keys.empty());
+  EXPECT_TRUE(values.empty());
+}
+
+TEST(RadixSort, SizeMismatch) {
+  std::vector<std::uint32_t> keys(3);
+  std::vector<std::uint32_t> values(2);
+  EXPECT_THROW(radixSort(keys, values), cagey::core::InvalidArgumentException);
+}
+
+TEST(RadixSort, Single) {
+  std::vector<std::uint64_t> keys{42};
+  auto values = indices(1);
+  radixSort(keys, values, 4);
+  EXPECT_EQ(std::vector<std::uint64_t>{42}, keys);
+  EXPECT_EQ(std::vector<std::uint32_t>{0}, values);
+}
+
+TEST(RadixSort, Stable) {
+  // equal keys keep their input order
+  std::vector<std::uint32_t> keys{3, 1, 3, 0, 1, 3, 0, 2};
+  auto values = indices(keys.size());
+  radixSort(keys, values);
+  EXPECT_EQ((std::vector<std::uint32_t>{0, 0, 1, 1, 2, 3, 3, 3}), keys);
+  EXPECT_EQ((std::vector<std::uint32_t>{3, 6, 1, 4, 7, 0, 2, 5}), values);
+}
+
+TEST(RadixSort, DigitBoundaries) {
+  // 0x7ff and 0x800 differ only in the second 11 bit digit
+  std::vector<std::uint32_t> keys{0x800, 0x7ff, 0x3fffff, 0x400000, 0x801, 0, 0x7ff};
+  auto values = indices(keys.size());
+  radixSort(keys, values);
+  EXPECT_EQ((std::vector<std::uint32_t>{0, 0x7ff, 0x7ff, 0x800, 0x801, 0x3fffff, 0x400000}), keys);
+  EXPECT_EQ((std::vector<std::uint32_t>{5, 1, 6, 0, 4, 2, 3}), values);
+}
+
+TEST(RadixSort, Keys32) {
+  std::vector<std::uint32_t> keys{0xffffffffu, 0x80000000u, 1, 0x7fffffffu, 0, 0xffffffffu};
+  auto values = indices(keys.size());
+  radixSort(keys, values);
+  EXPECT_EQ((std::vector<std::uint32_t>{0, 1, 0x7fffffffu, 0x80000000u, 0xffffffffu, 0xffffffffu}), keys);
+  EXPECT_EQ((std::vector<std::uint32_t>{4, 2, 3, 1, 0, 5}), values);
+}
+
+TEST(RadixSort, Keys64) {
+  // the high bits only reach the last passes
+  std::vector<std::uint64_t> keys{0xffffffffffffffffull, 1ull << 63, 1ull << 32, 0xffffffffull, 0, 1ull << 63, 1};
+  auto values = indices(keys.size());
+  radixSort(keys, values);
+  EXPECT_EQ((std::vector<std::uint64_t>{0, 1, 0xffffffffull, 1ull << 32, 1ull << 63, 1ull << 63, 0xffffffffffffffffull}),
+            keys);
+  EXPECT_EQ((std::vector<std::uint32_t>{4, 6, 3, 2, 1, 5, 0}), values);
+}
+
+TEST(RadixSort, MatchesStableSort) {
+  // large enough for the passes to be split across threads
+  std::mt19937_64 gen{1};
+  for (std::uint64_t const maxKey : {15ull, 1000ull, ~0ull}) {
+    std::uniform_int_distribution<std::uint64_t> dist(0, maxKey);
+    std::vector<std::uint64_t> input(300001);
+    std::generate(input.begin(), input.end(), [&] { return dist(gen); });
+    std::vector<std::pair<std::uint64_t, std::uint32_t>> expected(input.size());
+    for (std::size_t i = 0; i < input.size(); ++i) {
+      expected[i] = {input[i], static_cast<std::uint32_t>(i)};
+    }
+    std::stable_sort(expected.begin(), expected.end(),
+                     [](auto const & lhs, auto const & rhs) { return lhs.first < rhs.first; });
+
+    for (std::size_t const threads : {1, 3, 4, 0}) {
+      auto keys = input;
+      auto values = indices(keys.size());
+      radixSort(keys, values, threads);
+      for (std::size_t i = 0; i < keys.size(); ++i) {
+        ASSERT_EQ(expected[i].first, keys[i]);
+        ASSERT_EQ(expected[i].second, values[i]);
+      }
+    }
+  }
+}
@@ -0,0 +1,179 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// cagey-engine - Toy 3D Engine 
+// Copyright (c) 2014 Kyle Girard <theycallmecoach@gmail.com>
+//
+// The MIT License (MIT)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in 
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+////////////////////////////////////////////////////////////////////////////////
+#include <cagey/math/RayPacket.hh>
+#include "gtest/gtest.h"
+
+#include <random>
+#include <vector>
+
+using namespace cagey::math;
+
+namespace {
+
+/// Not a multiple of any register width so the scalar tail runs too
+constexpr std::size_t Count = 1003;
+
+template<typename T>
+auto expectSame(T const expected, T const actual) -> void {
+  if (expected == std::numeric_limits<T>::infinity()) {
+    EXPECT_EQ(expected, actual);
+  } else {
+    EXPECT_NEAR(expected, actual, std::abs(expected) * 1e-5 + 1e-5);
+  }
+}
+
+} // namespace
+
+template<typename T>
+class RayPacketTest : public ::testing::Test {};
+
+using RayPacketTypes = ::testing::Types<float, double>;
+TYPED_TEST_CASE(RayPacketTest, RayPacketTypes);
+
+TYPED_TEST(RayPacketTest, OneRayManyBoxes) {
+  using T = TypeParam;
+  std::mt19937 gen{3};
+  std::uniform_real_distribution<T> pos{-10, 10};
+  std::uniform_real_distribution<T> size{0.5, 3};
+  Point3Array<T> mins;
+  Point3Array<T> maxs;
+  std::vector<Aabb<T>> boxes;
+  for (std::size_t i = 0; i < Count; ++i) {
+    Point3<T> const lo{pos(gen), pos(gen), pos(gen)};
+    Point3<T> const hi{lo.x + size(gen), lo.y + size(gen), lo.z + size(gen)};
+    mins.pushBack(lo);
+    maxs.pushBack(hi);
+    boxes.push_back(Aabb<T>{lo, hi});
+  }
+  std::vector<T> out(Count);
+  for (int r = 0; r < 20; ++r) {
+    Ray<T> const ray{Point3<T>{pos(gen), pos(gen), pos(gen)}, Vec3<T>{pos(gen), pos(gen), pos(gen)}};
+    T const tMax = r % 2 ? T{2} : std::numeric_limits<T>::infinity();
+    intersect(ray, mins, maxs, out.data(), tMax);
+    for (std::size_t i = 0; i < Count; ++i) {
+      expectSame(intersect(ray, boxes[i], tMax), out[i]);
+    }
+  }
+}
+
+TYPED_TEST(RayPacketTest, ManyRaysOneBox) {
+  using T = TypeParam;
+  std::mt19937 gen{5};
+  std::uniform_real_distribution<T> pos{-10, 10};
+  Aabb<T> const box{Point3<T>{-2, -1, -3}, Point3<T>{2, 3, 1}};
+  Point3Array<T> origins;
+  Vec3Array<T> directions;
+  std::vector<Ray<T>> rays;
+  for (std::size_t i = 0; i < Count; ++i) {
+    rays.push_back(Ray<T>{Point3<T>{pos(gen), pos(gen), pos(gen)}, Vec3<T>{pos(gen), pos(gen), pos(gen)}});
+    origins.pushBack(rays.back().origin);
+    directions.pushBack(rays.back().direction);
+  }
+  std::vector<T> out(Count);
+  intersect(origins, directions, box, out.data());
+  std::size_t hits = 0;
+  for (std::size_t i = 0; i < Count; ++i) {
+    expectSame(intersect(rays[i], box), out[i]);
+    hits += out[i] != std::numeric_limits<T>::infinity();
+  }
+  EXPECT_GT(hits, 0u);
+  EXPECT_LT(hits, Count);
+
+  Vec3Array<T> tooFew;
+  EXPECT_THROW(intersect(origins, tooFew, box, out.data()), cagey::core::InvalidArgumentException);
+}
+
+TYPED_TEST(RayPacketTest, Triangles) {
+  using T = TypeParam;
+  std::mt19937 gen{7};
+  std::uniform_real_distribution<T> pos{-5, 5};
+  TriangleArray<T> tris;
+  std::vector<Point3<T>> verts;
+  for (std::size_t i = 0; i < Count; ++i) {
+    Point3<T> const a{pos(gen), pos(gen), pos(gen)};
+    Point3<T> const b{pos(gen), pos(gen), pos(gen)};
+    // every tenth triangle is degenerate
+    Point3<T> const c = i % 10 ? Point3<T>{pos(gen), pos(gen), pos(gen)} : b;
+    tris.pushBack(a, b, c);
+    verts.insert(verts.end(), {a, b, c});
+  }
+  ASSERT_EQ(Count, tris.size());
+  std::vector<T> out(Count);
+  std::size_t hits = 0;
+  for (int r = 0; r < 20; ++r) {
+    Ray<T> const ray{Point3<T>{pos(gen), pos(gen), pos(gen)}, Vec3<T>{pos(gen), pos(gen), pos(gen)}};
+    T const tMax = r % 2 ? T{0.5} : std::numeric_limits<T>::infinity();
+    intersect(ray, tris, out.data(), tMax);
+    for (std::size_t i = 0; i < Count; ++i) {
+      expectSame(intersect(ray, verts[3 * i], verts[3 * i + 1], verts[3 * i + 2], tMax), out[i]);
+      hits += out[i] != std::numeric_limits<T>::infinity();
+    }
+  }
+  EXPECT_GT(hits, 0u);
+}
+
+TYPED_TEST(RayPacketTest, AxisAlignedBoundaryOrigins) {
+  // rays parallel to a face and starting on its plane give 0 * inf = NaN in
+  // the slab test, boundaries count as part of the box on every face
+  using T = TypeParam;
+  T const inf = std::numeric_limits<T>::infinity();
+  Aabb<T> const box{Point3<T>{0, 0, 0}, Point3<T>{1, 1, 1}};
+  std::vector<Ray<T>> const rays{
+      {Point3<T>{-1, 0, T(0.5)}, Vec3<T>{1, 0, 0}},     // along y = min
+      {Point3<T>{-1, 1, T(0.5)}, Vec3<T>{1, 0, 0}},     // along y = max
+      {Point3<T>{-1, T(0.5), 0}, Vec3<T>{1, 0, 0}},     // along z = min
+      {Point3<T>{-1, T(0.5), 1}, Vec3<T>{1, 0, 0}},     // along z = max
+      {Point3<T>{2, 0, 0}, Vec3<T>{-1, 0, 0}},          // along an edge
+      {Point3<T>{2, 1, 1}, Vec3<T>{-1, 0, 0}},          // along the opposite edge
+      {Point3<T>{0, T(0.5), T(0.5)}, Vec3<T>{0, 1, 0}}, // inside the x = min face
+      {Point3<T>{1, -1, T(0.5)}, Vec3<T>{0, -1, 0}},    // on x = max, heading away
+      {Point3<T>{-1, 2, T(0.5)}, Vec3<T>{1, 0, 0}},     // parallel outside
+  };
+  std::vector<T> const expected{1, 1, 1, 1, 1, 1, 0, inf, inf};
+
+  Point3Array<T> origins;
+  Vec3Array<T> directions;
+  for (auto const & ray : rays) {
+    origins.pushBack(ray.origin);
+    directions.pushBack(ray.direction);
+  }
+  std::vector<T> out(rays.size());
+  intersect(origins, directions, box, out.data());
+  for (std::size_t i = 0; i < rays.size(); ++i) {
+    EXPECT_EQ(expected[i], intersect(rays[i], box)) << i;
+    EXPECT_EQ(expected[i], out[i]) << i;
+  }
+
+  Point3Array<T> const mins{std::vector<Point3<T>>(rays.size(), box.min)};
+  Point3Array<T> const maxs{std::vector<Point3<T>>(rays.size(), box.max)};
+  for (std::size_t r = 0; r < rays.size(); ++r) {
+    intersect(rays[r], mins, maxs, out.data());
+    for (std::size_t i = 0; i < rays.size(); ++i) {
+      EXPECT_EQ(expected[r], out[i]) << r;
+    }
+  }
+}
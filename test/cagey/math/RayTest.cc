@@ -0,0 +1,60 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// cagey-engine - Toy 3D Engine 
+// Copyright (c) 2014 Kyle Girard <theycallmecoach@gmail.com>
+//
+// The MIT License (MIT)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in 
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+////////////////////////////////////////////////////////////////////////////////
+#include <cagey/math/Ray.hh>
+#include "gtest/gtest.h"
+
+#include <limits>
+
+using namespace cagey::math;
+
+TEST(Ray, PointAt) {
+  Rayf const ray{Point3f{1.0f, 2.0f, 3.0f}, Vec3f{0.0f, 0.0f, 2.0f}};
+  EXPECT_EQ(Point3f(1.0f, 2.0f, 7.0f), pointAt(ray, 2.0f));
+}
+
+TEST(Ray, IntersectAabb) {
+  Aabbf const box{Point3f{-1.0f, -1.0f, -1.0f}, Point3f{1.0f, 1.0f, 1.0f}};
+  auto const inf = std::numeric_limits<float>::infinity();
+  EXPECT_FLOAT_EQ(4.0f, intersect(Rayf{Point3f{0.0f, 0.0f, -5.0f}, Vec3f{0.0f, 0.0f, 1.0f}}, box));
+  EXPECT_FLOAT_EQ(0.0f, intersect(Rayf{Point3f{0.0f, 0.0f, 0.0f}, Vec3f{1.0f, 0.0f, 0.0f}}, box));
+  EXPECT_EQ(inf, intersect(Rayf{Point3f{0.0f, 0.0f, -5.0f}, Vec3f{0.0f, 0.0f, -1.0f}}, box));
+  EXPECT_EQ(inf, intersect(Rayf{Point3f{0.0f, 2.0f, -5.0f}, Vec3f{0.0f, 0.0f, 1.0f}}, box));
+  EXPECT_EQ(inf, intersect(Rayf{Point3f{0.0f, 0.0f, -5.0f}, Vec3f{0.0f, 0.0f, 1.0f}}, box, 3.0f));
+}
+
+TEST(Ray, IntersectTriangle) {
+  Point3f const a{0.0f, 0.0f, 0.0f};
+  Point3f const b{1.0f, 0.0f, 0.0f};
+  Point3f const c{0.0f, 1.0f, 0.0f};
+  auto const inf = std::numeric_limits<float>::infinity();
+  EXPECT_FLOAT_EQ(2.0f, intersect(Rayf{Point3f{0.25f, 0.25f, 2.0f}, Vec3f{0.0f, 0.0f, -1.0f}}, a, b, c));
+  EXPECT_FLOAT_EQ(2.0f, intersect(Rayf{Point3f{0.25f, 0.25f, -2.0f}, Vec3f{0.0f, 0.0f, 1.0f}}, a, b, c));
+  EXPECT_EQ(inf, intersect(Rayf{Point3f{0.75f, 0.75f, 2.0f}, Vec3f{0.0f, 0.0f, -1.0f}}, a, b, c));
+  EXPECT_EQ(inf, intersect(Rayf{Point3f{0.25f, 0.25f, 2.0f}, Vec3f{0.0f, 0.0f, 1.0f}}, a, b, c));
+  EXPECT_EQ(inf, intersect(Rayf{Point3f{0.25f, 0.25f, 2.0f}, Vec3f{0.0f, 0.0f, -1.0f}}, a, b, c, 1.0f));
+  EXPECT_EQ(inf, intersect(Rayf{Point3f{0.25f, 0.25f, 2.0f}, Vec3f{0.0f, 0.0f, -1.0f}}, a, b, b));
+}
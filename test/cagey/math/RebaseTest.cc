@@ -0,0 +1,144 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// cagey-engine - Toy 3D Engine 
+// Copyright (c) 2014 Kyle Girard <theycallmecoach@gmail.com>
+//
+// The MIT License (MIT)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in 
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+#include <cagey/math/Rebase.hh>
+#include "gtest/gtest.h"
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <vector>
+using namespace cagey::math;
+
+namespace {
+
+/// A camera far from the world origin, where float spacing is a whole metre
+Point3d const Camera{1.0e7, -2.5e7, 6.0e6};
+
+/**
+ * Offsets from the camera, from sub-micrometre to far beyond float precision
+ * at the camera
+ */
+auto offsets() -> std::vector<Point3d> {
+  return {{0.0, 0.0, 0.0},
+          {1.0, -1.0, 0.5},
+          {0.5, -0.75, 0.123456},
+          {1.0e-6, -3.0e-6, 2.5e-7},
+          {-0.1, 0.2, -0.3},
+          {99.999999, -100.0, 12.345678},
+          {1234.5678, 0.001, -999.999},
+          {-4096.0, 4096.0, 0.0},
+          {1.0e5 + 0.25, -1.0e5 - 0.25, 3.0e4},
+          {2.0e6, -2.0e6, 1.0e6 + 0.5},
+          {-1.0e7, 2.5e7, -6.0e6}};
+}
+
+auto world() -> std::vector<Point3d> {
+  auto ret = offsets();
+  for (auto & pt : ret) {
+    pt = Point3d{Camera.x + pt.x, Camera.y + pt.y, Camera.z + pt.z};
+  }
+  return ret;
+}
+
+} // namespace
+
+TEST(Rebase, Point) {
+  EXPECT_EQ(Point3f(1.5f, -2.0f, 0.25f), rebase(Point3d{11.5, 8.0, 10.25}, Point3d{10.0, 10.0, 10.0}));
+  EXPECT_EQ(Point3f(0.0f, 0.0f, 0.0f), rebase(Camera, Camera));
+  // the last offset moves back to the world origin
+  EXPECT_EQ(Point3f(-1.0e7f, 2.5e7f, -6.0e6f), rebase(Point3d{0.0, 0.0, 0.0}, Camera));
+}
+
+TEST(Rebase, ArrayMatchesPoint) {
+  //cover the scalar tail for every remainder
+  auto const in = world();
+  for (std::size_t count = 0; count <= in.size(); ++count) {
+    std::vector<Point3f> out(count);
+    rebase(in.data(), Camera, out.data(), count);
+    for (std::size_t i = 0; i < count; ++i) {
+      EXPECT_EQ(rebase(in[i], Camera), out[i]);
+    }
+  }
+}
+
+TEST(Rebase, KnownOffsets) {
+  // the only rounding is the final narrowing, so every component is the
+  // nearest float to the exact double difference
+  auto const in = world();
+  std::vector<Point3f> out(in.size());
+  rebase(in.data(), Camera, out.data(), in.size());
+  for (std::size_t i = 0; i < in.size(); ++i) {
+    for (std::size_t k = 0; k < 3; ++k) {
+      EXPECT_EQ(static_cast<float>(in[i][k] - Camera[k]), out[i][k]);
+    }
+  }
+  EXPECT_EQ(Point3f(1.0f, -1.0f, 0.5f), out[1]);
+  EXPECT_EQ(Point3f(-4096.0f, 4096.0f, 0.0f), out[7]);
+}
+
+TEST(Rebase, CorrectlyRounded) {
+  std::mt19937 gen{1};
+  std::uniform_real_distribution<double> dist(-5000.0, 5000.0);
+  std::vector<Point3d> in(1001);
+  for (auto & pt : in) {
+    pt = Point3d{Camera.x + dist(gen), Camera.y + dist(gen), Camera.z + dist(gen)};
+  }
+  std::vector<Point3f> out(in.size());
+  rebase(in.data(), Camera, out.data(), in.size());
+  for (std::size_t i = 0; i < in.size(); ++i) {
+    for (std::size_t k = 0; k < 3; ++k) {
+      double const exact = in[i][k] - Camera[k];
+      double const err = std::abs(static_cast<double>(out[i][k]) - exact);
+      EXPECT_LE(err, std::abs(exact) * std::ldexp(1.0, -24));
+    }
+  }
+}
+
+TEST(Rebase, BeatsNaiveConversion) {
+  // converting to float before subtracting rounds to the float spacing at
+  // the camera: 1m in x, 2m in y and 0.5m in z
+  Point3d const in{Camera.x + 0.5, Camera.y - 0.75, Camera.z + 0.123456};
+  Point3f const cameraf{static_cast<float>(Camera.x), static_cast<float>(Camera.y), static_cast<float>(Camera.z)};
+  Point3f const naive{static_cast<float>(in.x) - cameraf.x, static_cast<float>(in.y) - cameraf.y,
+                      static_cast<float>(in.z) - cameraf.z};
+  EXPECT_EQ(Point3f(0.0f, 0.0f, 0.0f), naive);
+
+  auto const out = rebase(in, Camera);
+  EXPECT_EQ(0.5f, out.x);
+  EXPECT_EQ(-0.75f, out.y);
+  EXPECT_NEAR(0.123456, out.z, 1.0e-8);
+}
+
+TEST(Rebase, LargeOffsets) {
+  // large offsets stay within half a float ulp, tiny ones are limited only
+  // by the spacing of the double inputs
+  Point3d const far{Camera.x + 3.0e9, Camera.y - 1.0e-3, Camera.z + 123456.789};
+  auto const out = rebase(far, Camera);
+  EXPECT_FLOAT_EQ(3.0e9f, out.x);
+  EXPECT_NEAR(-1.0e-3, out.y, 1.0e-8);
+  EXPECT_FLOAT_EQ(123456.789f, out.z);
+}
@@ -0,0 +1,156 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// cagey-engine - Toy 3D Engine 
+// Copyright (c) 2014 Kyle Girard <theycallmecoach@gmail.com>
+//
+// The MIT License (MIT)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in 
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+////////////////////////////////////////////////////////////////////////////////
+#include <cagey/math/SpatialHash.hh>
+#include "gtest/gtest.h"
+
+#include <algorithm>
+#include <limits>
+#include <random>
+#include <vector>
+
+using namespace cagey::math;
+
+namespace {
+
+template<typename P>
+auto randomPoints(std::size_t const count, float const extent) -> std::vector<P> {
+  std::mt19937 gen{17};
+  std::uniform_real_distribution<float> pos{-extent, extent};
+  std::vector<P> points(count);
+  for (auto & pt : points) {
+    for (auto & v : pt) {
+      v = pos(gen);
+    }
+  }
+  return points;
+}
+
+template<typename F>
+auto collect(F && query) -> std::vector<std::uint32_t> {
+  std::vector<std::uint32_t> found;
+  query([&](std::uint32_t const i) { found.push_back(i); });
+  std::sort(found.begin(), found.end());
+  return found;
+}
+
+} // namespace
+
+TEST(SpatialHash, Empty) {
+  SpatialHash3f hash{1.0f};
+  hash.rebuild(std::vector<Point3f>{});
+  EXPECT_EQ(0u, hash.size());
+  EXPECT_TRUE(hash.bucket(Point3i{0, 0, 0}).empty());
+  EXPECT_TRUE(collect([&](auto f) { hash.queryRadius(Point3f{0.0f, 0.0f, 0.0f}, 10.0f, f); }).empty());
+}
+
+TEST(SpatialHash, CellOf) {
+  SpatialHash2f const hash{2.0f};
+  EXPECT_EQ(Point2i(0, 0), hash.cellOf(Point2f{0.5f, 1.9f}));
+  EXPECT_EQ(Point2i(-1, 1), hash.cellOf(Point2f{-0.5f, 2.0f}));
+  // far coordinates clamp to 2^30 cells rather than overflowing int
+  EXPECT_EQ(Point2i(1 << 30, -(1 << 30)), hash.cellOf(Point2f{1e30f, -std::numeric_limits<float>::infinity()}));
+  EXPECT_EQ(Point2i(0, 3), hash.cellOf(Point2f{std::numeric_limits<float>::quiet_NaN(), 7.0f}));
+}
+
+TEST(SpatialHash, SharedBucketsReportOnce) {
+  // 5 points get 16 buckets, so the 12 cells of each box collide often
+  std::vector<Point2f> const points{{0.5f, 0.5f}, {1.5f, 0.5f}, {2.5f, 3.5f}, {0.5f, 2.5f}, {-0.5f, 1.5f}};
+  SpatialHash2f hash{1.0f};
+  hash.rebuild(points);
+  for (float x = -3.0f; x < 3.0f; x += 0.5f) {
+    Point2f const lo{x, -0.5f};
+    Point2f const hi{x + 2.9f, 3.9f};
+    std::vector<std::uint32_t> expected;
+    for (std::uint32_t i = 0; i < points.size(); ++i) {
+      if (points[i].x >= lo.x && points[i].x <= hi.x && points[i].y >= lo.y && points[i].y <= hi.y) {
+        expected.push_back(i);
+      }
+    }
+    EXPECT_EQ(expected, collect([&](auto f) { hash.queryAabb(lo, hi, f); }));
+  }
+  Point2f const nan{std::numeric_limits<float>::quiet_NaN(), 0.0f};
+  EXPECT_TRUE(collect([&](auto f) { hash.queryRadius(nan, 2.0f, f); }).empty());
+}
+
+TEST(SpatialHash, BucketsAreContiguous) {
+  auto const points = randomPoints<Point3f>(5000, 50.0f);
+  SpatialHash3f hash{2.0f};
+  hash.rebuild(points);
+  ASSERT_EQ(points.size(), hash.size());
+  for (std::uint32_t i = 0; i < points.size(); ++i) {
+    auto const range = hash.bucket(hash.cellOf(points[i]));
+    EXPECT_NE(range.end(), std::find(range.begin(), range.end(), i));
+  }
+  auto sorted = hash.indices();
+  std::sort(sorted.begin(), sorted.end());
+  for (std::uint32_t i = 0; i < sorted.size(); ++i) {
+    ASSERT_EQ(i, sorted[i]);
+  }
+}
+
+TEST(SpatialHash, Radius3MatchesBruteForce) {
+  auto const points = randomPoints<Point3f>(5000, 50.0f);
+  auto const centers = randomPoints<Point3f>(50, 60.0f);
+  SpatialHash3f hash{4.0f};
+  hash.rebuild(points);
+  for (auto const radius : {1.0f, 4.0f, 15.0f}) {
+    for (auto const & c : centers) {
+      std::vector<std::uint32_t> expected;
+      for (std::uint32_t i = 0; i < points.size(); ++i) {
+        auto const dx = points[i].x - c.x;
+        auto const dy = points[i].y - c.y;
+        auto const dz = points[i].z - c.z;
+        if (dx * dx + dy * dy + dz * dz <= radius * radius) {
+          expected.push_back(i);
+        }
+      }
+      EXPECT_EQ(expected, collect([&](auto f) { hash.queryRadius(c, radius, f); }));
+    }
+  }
+}
+
+TEST(SpatialHash, Aabb2MatchesBruteForce) {
+  auto const points = randomPoints<Point2d>(3000, 20.0f);
+  auto const corners = randomPoints<Point2d>(40, 25.0f);
+  SpatialHash2d hash{1.0};
+  for (int frame = 0; frame < 2; ++frame) {
+    hash.rebuild(points.data(), points.size() - static_cast<std::size_t>(frame) * 1000);
+    for (auto const & lo : corners) {
+      // the second box covers every cell and takes the full scan path
+      for (auto const size : {3.0, 200.0}) {
+        Point2d const hi{lo.x + size, lo.y + size / 2.0};
+        std::vector<std::uint32_t> expected;
+        for (std::uint32_t i = 0; i < hash.size(); ++i) {
+          if (points[i].x >= lo.x && points[i].x <= hi.x && points[i].y >= lo.y && points[i].y <= hi.y) {
+            expected.push_back(i);
+          }
+        }
+        EXPECT_EQ(expected, collect([&](auto f) { hash.queryAabb(lo, hi, f); }));
+      }
+    }
+  }
+}
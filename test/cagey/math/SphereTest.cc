@@ -0,0 +1,53 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// cagey-engine - Toy 3D Engine 
+// Copyright (c) 2014 Kyle Girard <theycallmecoach@gmail.com>
+//
+// The MIT License (MIT)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in 
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+
+#include <cagey/math/Sphere.hh>
+#include "gtest/gtest.h"
+
+using namespace cagey::math;
+
+TEST(Sphere, BoundingSphere) {
+  Aabbd const box{Point3d{-1.0, -2.0, -2.0}, Point3d{1.0, 2.0, 2.0}};
+  auto const sphere = boundingSphere(box);
+  EXPECT_EQ(Point3d(0.0, 0.0, 0.0), sphere.center);
+  EXPECT_DOUBLE_EQ(3.0, sphere.radius);
+  EXPECT_TRUE(contains(sphere, box.min));
+  EXPECT_TRUE(contains(sphere, box.max));
+}
+
+TEST(Sphere, Intersects) {
+  Spheref const a{Point3f{0.0f, 0.0f, 0.0f}, 1.0f};
+  Spheref const b{Point3f{1.5f, 0.0f, 0.0f}, 0.5f};
+  Spheref const c{Point3f{0.0f, 3.0f, 0.0f}, 1.0f};
+  EXPECT_TRUE(intersects(a, b));
+  EXPECT_FALSE(intersects(a, c));
+
+  Aabbf const box{Point3f{0.5f, 0.5f, 0.5f}, Point3f{2.0f, 2.0f, 2.0f}};
+  EXPECT_TRUE(intersects(a, box));
+  EXPECT_FALSE(intersects(Spheref{Point3f{-1.0f, -1.0f, -1.0f}, 1.0f}, box));
+}
@@ -0,0 +1,189 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// cagey-engine - Toy 3D Engine 
+// Copyright (c) 2014 Kyle Girard <theycallmecoach@gmail.com>
+//
+// The MIT License (MIT)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in 
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+////////////////////////////////////////////////////////////////////////////////
+#include <cagey/math/TransformHierarchy.hh>
+#include "gtest/gtest.h"
+
+#include <cstring>
+#include <random>
+#include <vector>
+
+using namespace cagey::math;
+
+namespace {
+
+/**
+ * Reference world transform by walking up the parents
+ */
+auto worldOf(TransformHierarchyd const & tree, std::uint32_t index) -> Mat4d {
+  Mat4d world = tree.local(index);
+  for (auto p = tree.parent(index); p != TransformHierarchyd::NoParent; p = tree.parent(p)) {
+    world = tree.local(p) * world;
+  }
+  return world;
+}
+
+auto expectNear(Mat4d const & expected, Mat4d const & actual) -> void {
+  for (std::size_t i = 0; i < 16; ++i) {
+    EXPECT_NEAR(expected.begin()[i], actual.begin()[i], 1e-9);
+  }
+}
+
+} // namespace
+
+TEST(TransformHierarchy, Chain) {
+  TransformHierarchyf tree;
+  auto const root = tree.add(TransformHierarchyf::NoParent, makeTranslation(1.0f, 0.0f, 0.0f));
+  auto const child = tree.add(root, makeScale(Vec3f{2.0f, 2.0f, 2.0f}));
+  auto const leaf = tree.add(child, makeTranslation(0.0f, 1.0f, 0.0f));
+  EXPECT_EQ(3u, tree.update());
+  EXPECT_EQ(makeTranslation(1.0f, 0.0f, 0.0f) * makeScale(2.0f, 2.0f, 2.0f) * makeTranslation(0.0f, 1.0f, 0.0f), tree.world(leaf));
+  EXPECT_EQ(makeTranslation(1.0f, 2.0f, 0.0f), tree.world(leaf) * makeScale(0.5f, 0.5f, 0.5f));
+  EXPECT_EQ(0u, tree.update());
+  EXPECT_EQ(0u, tree.updatedCount());
+}
+
+TEST(TransformHierarchy, InvalidParent) {
+  TransformHierarchyf tree;
+  EXPECT_THROW(tree.add(0), cagey::core::IndexOutOfBoundsException);
+  tree.add(TransformHierarchyf::NoParent);
+  EXPECT_NO_THROW(tree.add(0));
+  EXPECT_THROW(tree.add(5), cagey::core::IndexOutOfBoundsException);
+}
+
+TEST(TransformHierarchy, OnlyDirtySubtreesUpdate) {
+  // 0 is the root with children 1 and 2, 1 has children 3 and 4, 2 has 5
+  TransformHierarchyd tree;
+  tree.add(TransformHierarchyd::NoParent);
+  tree.add(0, makeTranslation(1.0, 0.0, 0.0));
+  tree.add(0, makeTranslation(0.0, 1.0, 0.0));
+  tree.add(1, makeScale(2.0, 2.0, 2.0));
+  tree.add(1, makeTranslation(0.0, 0.0, 1.0));
+  tree.add(2, makeScale(3.0, 1.0, 1.0));
+  EXPECT_EQ(6u, tree.update());
+
+  tree.setLocal(1, makeTranslation(5.0, 0.0, 0.0));
+  EXPECT_TRUE(tree.isDirty(1));
+  EXPECT_FALSE(tree.isDirty(3));
+  EXPECT_EQ(3u, tree.update());
+  EXPECT_EQ(3u, tree.updatedCount());
+  EXPECT_FALSE(tree.isDirty(1));
+
+  tree.setLocal(5, makeScale(1.0, 4.0, 1.0));
+  tree.setLocal(2, makeTranslation(0.0, 2.0, 0.0));
+  EXPECT_EQ(2u, tree.update());
+
+  tree.setLocal(0, makeTranslation(0.0, 0.0, -1.0));
+  EXPECT_EQ(6u, tree.update());
+  for (std::uint32_t i = 0; i < tree.size(); ++i) {
+    expectNear(worldOf(tree, i), tree.world(i));
+  }
+}
+
+TEST(TransformHierarchy, RandomTreeMatchesReference) {
+  std::mt19937 gen{23};
+  std::uniform_real_distribution<double> dist{-2.0, 2.0};
+  TransformHierarchyd tree;
+  tree.add(TransformHierarchyd::NoParent);
+  for (std::uint32_t i = 1; i < 500; ++i) {
+    std::uniform_int_distribution<std::uint32_t> parent{0, i - 1};
+    tree.add(parent(gen), makeTranslation(dist(gen), dist(gen), dist(gen)));
+  }
+  tree.update();
+  for (int frame = 0; frame < 5; ++frame) {
+    std::uniform_int_distribution<std::uint32_t> node{0, 499};
+    for (int k = 0; k < 10; ++k) {
+      tree.setLocal(node(gen), makeTranslation(dist(gen), dist(gen), dist(gen)) * makeScale(1.5, 1.0, 0.5));
+    }
+    EXPECT_LE(tree.update(), 500u);
+    for (std::uint32_t i = 0; i < tree.size(); ++i) {
+      expectNear(worldOf(tree, i), tree.world(i));
+    }
+  }
+}
+
+TEST(TransformHierarchy, Levels) {
+  TransformHierarchyf tree;
+  tree.add(TransformHierarchyf::NoParent);
+  tree.add(0);
+  tree.add(TransformHierarchyf::NoParent);
+  tree.add(1);
+  EXPECT_EQ(3u, tree.levels());
+  EXPECT_EQ(0u, tree.depth(2));
+  EXPECT_EQ(2u, tree.depth(3));
+}
+
+TEST(TransformHierarchy, ThreadedUpdateMatchesSerial) {
+  std::mt19937 gen{31};
+  std::uniform_real_distribution<float> dist{-1.0f, 1.0f};
+  TransformHierarchyf serial;
+  for (std::uint32_t i = 0; i < 20000; ++i) {
+    // wide shallow levels so each one splits into several chunks
+    auto const local = makeTranslation(dist(gen), dist(gen), dist(gen)) * makeScale(1.01f, 0.99f, 1.0f);
+    if (i < 4) {
+      serial.add(TransformHierarchyf::NoParent, local);
+    } else {
+      serial.add(std::uniform_int_distribution<std::uint32_t>{i / 8, i / 4 - 1}(gen), local);
+    }
+  }
+  auto threaded = serial;
+  ThreadPool pool{4};
+  EXPECT_EQ(serial.update(), threaded.update(pool));
+  for (int frame = 0; frame < 3; ++frame) {
+    std::uniform_int_distribution<std::uint32_t> node{0, 19999};
+    for (int k = 0; k < 50; ++k) {
+      auto const i = node(gen);
+      auto const local = makeTranslation(dist(gen), dist(gen), dist(gen));
+      serial.setLocal(i, local);
+      threaded.setLocal(i, local);
+    }
+    EXPECT_EQ(serial.update(), threaded.update(pool));
+    EXPECT_EQ(serial.updatedCount(), threaded.updatedCount());
+    for (std::uint32_t i = 0; i < serial.size(); ++i) {
+      ASSERT_EQ(0, std::memcmp(serial.world(i).begin(), threaded.world(i).begin(), sizeof(Mat4f)));
+    }
+  }
+}
+
+TEST(TransformHierarchy, ThreadPool) {
+  ThreadPool pool{3};
+  EXPECT_EQ(3u, pool.size());
+  std::vector<int> hits(1000, 0);
+  for (int round = 0; round < 50; ++round) {
+    pool.parallelFor(hits.size(), 64, [&](std::size_t const begin, std::size_t const end) {
+      EXPECT_EQ(0u, begin % 64);
+      for (auto i = begin; i < end; ++i) {
+        ++hits[i];
+      }
+    });
+  }
+  for (auto const hit : hits) {
+    EXPECT_EQ(50, hit);
+  }
+  std::size_t calls = 0;
+  pool.parallelFor(0, 64, [&](std::size_t, std::size_t) { ++calls; });
+  EXPECT_EQ(1u, calls);
+}
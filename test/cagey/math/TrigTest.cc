@@ -0,0 +1,197 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// cagey-engine - Toy 3D Engine 
+// Copyright (c) 2014 Kyle Girard <theycallmecoach@gmail.com>
+//
+// The MIT License (MIT)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in 
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+#include <cagey/math/Trig.hh>
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <vector>
+
+using namespace cagey::math;
+
+namespace {
+
+/**
+ * Degrees with exact sines and cosines, one or more in every quadrant and
+ * some several turns out; eleven of them so packs of 4 and 8 leave a tail
+ */
+struct Known {
+  double degrees;
+  double sin;
+  double cos;
+};
+
+double const Half = 0.5;
+double const Root2 = 0.70710678118654752;
+double const Root3 = 0.86602540378443865;
+
+std::vector<Known> const KnownAngles{
+  {30.0, Half, Root3}, {45.0, Root2, Root2}, {60.0, Root3, Half}, {120.0, Root3, -Half},
+  {135.0, Root2, -Root2}, {210.0, -Half, -Root3}, {300.0, -Root3, Half}, {-30.0, -Half, Root3},
+  {-135.0, -Root2, -Root2}, {750.0, Half, Root3}, {3645.0, Root2, Root2}};
+
+template<typename T>
+auto knownRadians() -> std::vector<Radian<T>> {
+  std::vector<Radian<T>> ret;
+  for (auto const & known : KnownAngles) {
+    ret.emplace_back(T(known.degrees * 3.14159265358979323846 / 180.0));
+  }
+  return ret;
+}
+
+} // namespace
+
+TEST(Trig, Exact) {
+  auto const sc = sincos(Radian<float>{0.5f});
+  EXPECT_FLOAT_EQ(std::sin(0.5f), sc.sin);
+  EXPECT_FLOAT_EQ(std::cos(0.5f), sc.cos);
+  EXPECT_FLOAT_EQ(std::tan(0.5f), tan(Radian<float>{0.5f}));
+}
+
+TEST(Trig, Quadrants) {
+  EXPECT_NEAR(0.0, sin<Precision::High>(Radian<double>{0.0}), 1e-6);
+  EXPECT_NEAR(1.0, cos<Precision::High>(Radian<double>{0.0}), 1e-6);
+  EXPECT_NEAR(1.0, sin<Precision::High>(90.0_deg), 1e-6);
+  EXPECT_NEAR(0.0, cos<Precision::High>(90.0_deg), 1e-6);
+  EXPECT_NEAR(0.0, sin<Precision::High>(180.0_deg), 1e-6);
+  EXPECT_NEAR(-1.0, cos<Precision::High>(180.0_deg), 1e-6);
+  EXPECT_NEAR(-1.0, sin<Precision::High>(270.0_deg), 1e-6);
+  EXPECT_NEAR(0.0, cos<Precision::High>(270.0_deg), 1e-6);
+  EXPECT_NEAR(-1.0, sin<Precision::High>(-90.0_deg), 1e-6);
+  EXPECT_NEAR(1.0, tan<Precision::High>(45.0_deg), 1e-6);
+  EXPECT_NEAR(-1.0, tan<Precision::Fast>(-45.0_deg), 1e-3);
+}
+
+TEST(Trig, KnownAngles) {
+  auto const floats = knownRadians<float>();
+  auto const doubles = knownRadians<double>();
+  for (std::size_t i = 0; i < KnownAngles.size(); ++i) {
+    auto const & known = KnownAngles[i];
+    auto const high = sincos<Precision::High>(doubles[i]);
+    EXPECT_NEAR(known.sin, high.sin, 1e-6) << known.degrees;
+    EXPECT_NEAR(known.cos, high.cos, 1e-6) << known.degrees;
+    auto const fast = sincos<Precision::Fast>(doubles[i]);
+    EXPECT_NEAR(known.sin, fast.sin, 1e-3) << known.degrees;
+    EXPECT_NEAR(known.cos, fast.cos, 1e-3) << known.degrees;
+    // float angles carry their own rounding, so compare with the exact
+    // value of the rounded angle
+    double const x = float(floats[i]);
+    auto const single = sincos<Precision::High>(floats[i]);
+    EXPECT_NEAR(std::sin(x), single.sin, 1e-6) << known.degrees;
+    EXPECT_NEAR(std::cos(x), single.cos, 1e-6) << known.degrees;
+  }
+}
+
+TEST(Trig, QuadrantBoundaries) {
+  // the reduction picks a new quadrant at each odd multiple of pi/4
+  for (int k = -7; k <= 7; k += 2) {
+    double const boundary = k * 0.78539816339744831;
+    for (double const offset : {-1e-9, 0.0, 1e-9}) {
+      Radian<double> const angle{boundary + offset};
+      auto const sc = sincos<Precision::High>(angle);
+      EXPECT_NEAR(std::sin(boundary + offset), sc.sin, 1e-6) << k;
+      EXPECT_NEAR(std::cos(boundary + offset), sc.cos, 1e-6) << k;
+    }
+  }
+}
+
+TEST(Trig, SweepWithinBounds) {
+  // the one bulk check: every 4th degree over a wide range of turns
+  double highErr = 0.0;
+  double fastErr = 0.0;
+  for (double degrees = -450000.0; degrees <= 450000.0; degrees += 4.01) {
+    double const x = degrees * 3.14159265358979323846 / 180.0;
+    auto const high = sincos<Precision::High>(Radian<double>{x});
+    auto const fast = sincos<Precision::Fast>(Radian<double>{x});
+    highErr = std::max({highErr, std::abs(high.sin - std::sin(x)), std::abs(high.cos - std::cos(x))});
+    fastErr = std::max({fastErr, std::abs(fast.sin - std::sin(x)), std::abs(fast.cos - std::cos(x))});
+  }
+  EXPECT_LT(highErr, 1e-6);
+  EXPECT_LT(fastErr, 1e-3);
+}
+
+TEST(Trig, ArrayMatchesScalar) {
+  auto const angles = knownRadians<float>();
+  auto const count = angles.size();
+  std::vector<float> sins(count);
+  std::vector<float> coss(count);
+  std::vector<float> tans(count);
+
+  sincos<Precision::High>(angles.data(), sins.data(), coss.data(), count);
+  tan<Precision::High>(angles.data(), tans.data(), count);
+  for (std::size_t i = 0; i < count; ++i) {
+    auto const sc = sincos<Precision::High>(angles[i]);
+    EXPECT_EQ(sc.sin, sins[i]);
+    EXPECT_EQ(sc.cos, coss[i]);
+    EXPECT_EQ(tan<Precision::High>(angles[i]), tans[i]);
+  }
+
+  sincos<Precision::Fast>(angles.data(), sins.data(), coss.data(), count);
+  for (std::size_t i = 0; i < count; ++i) {
+    auto const sc = sincos<Precision::Fast>(angles[i]);
+    EXPECT_EQ(sc.sin, sins[i]);
+    EXPECT_EQ(sc.cos, coss[i]);
+  }
+
+  sincos(angles.data(), sins.data(), coss.data(), count);
+  EXPECT_FLOAT_EQ(std::sin(float(angles[7])), sins[7]);
+  EXPECT_FLOAT_EQ(std::cos(float(angles[7])), coss[7]);
+}
+
+TEST(Trig, NonFinite) {
+  float const inf = std::numeric_limits<float>::infinity();
+  float const nan = std::numeric_limits<float>::quiet_NaN();
+  // eleven angles cover the packs and the scalar tail at every width
+  std::vector<Radian<float>> angles(11, Radian<float>{nan});
+  for (std::size_t i = 1; i < angles.size(); i += 2) {
+    angles[i] = Radian<float>{i % 4 == 1 ? inf : -inf};
+  }
+  std::vector<float> sins(angles.size());
+  std::vector<float> coss(angles.size());
+  sincos<Precision::High>(angles.data(), sins.data(), coss.data(), angles.size());
+  for (std::size_t i = 0; i < angles.size(); ++i) {
+    auto const sc = sincos<Precision::High>(angles[i]);
+    EXPECT_TRUE(std::isnan(sc.sin));
+    EXPECT_TRUE(std::isnan(sc.cos));
+    EXPECT_TRUE(std::isnan(tan<Precision::Fast>(angles[i])));
+    EXPECT_TRUE(std::isnan(sins[i]));
+    EXPECT_TRUE(std::isnan(coss[i]));
+  }
+}
+
+TEST(Trig, ArrayDouble) {
+  auto const angles = knownRadians<double>();
+  auto const count = angles.size();
+  std::vector<double> sins(count);
+  std::vector<double> coss(count);
+  sincos<Precision::High>(angles.data(), sins.data(), coss.data(), count);
+  for (std::size_t i = 0; i < count; ++i) {
+    EXPECT_NEAR(KnownAngles[i].sin, sins[i], 1e-6);
+    EXPECT_NEAR(KnownAngles[i].cos, coss[i], 1e-6);
+  }
+}
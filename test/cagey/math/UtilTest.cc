@@ -0,0 +1,214 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// cagey-engine - Toy 3D Engine 
+// Copyright (c) 2014 Kyle Girard <theycallmecoach@gmail.com>
+//
+// The MIT License (MIT)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in 
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+#include <cagey/math/Util.hh>
+#include "gtest/gtest.h"
+#include <cmath>
+#include <limits>
+#include <random>
+#include <vector>
+using namespace cagey::math;
+
+namespace {
+
+/**
+ * Step x n representable values towards +infinity
+ */
+template<typename T>
+auto stepUp(T x, unsigned n) -> T {
+  for (unsigned i = 0; i < n; ++i) {
+    x = std::nextafter(x, std::numeric_limits<T>::infinity());
+  }
+  return x;
+}
+
+/**
+ * Eleven pairs, a tail at every pack width, each at most 2 ulps apart:
+ * signed zeros, denormals either side of zero, max against infinity and
+ * neighbours across a power of two
+ */
+template<typename T>
+struct UlpCases {
+  std::vector<T> lhs;
+  std::vector<T> rhs;
+
+  UlpCases() {
+    T const tiny = std::numeric_limits<T>::denorm_min();
+    T const max = std::numeric_limits<T>::max();
+    lhs = {T{0}, tiny, max, T{1}, -tiny, T{2}, -T{0}, T{1000}, T{-1}, std::numeric_limits<T>::min(), tiny * 3};
+    rhs = {-T{0}, -tiny, std::numeric_limits<T>::infinity(), stepUp(T{1}, 2), T{0}, std::nextafter(T{2}, T{0}),
+           T{0}, stepUp(T{1000}, 1), stepUp(T{-1}, 2), std::numeric_limits<T>::min(), tiny};
+  }
+};
+
+} // namespace
+
+template<typename T>
+class UtilTest : public ::testing::Test {};
+
+using FloatTypes = ::testing::Types<float, double>;
+TYPED_TEST_CASE(UtilTest, FloatTypes);
+
+TYPED_TEST(UtilTest, ulpDistance) {
+  using T = TypeParam;
+  T const inf = std::numeric_limits<T>::infinity();
+  T const nan = std::numeric_limits<T>::quiet_NaN();
+  EXPECT_EQ(0u, ulpDistance(T{1}, T{1}));
+  EXPECT_EQ(0u, ulpDistance(T{0}, -T{0}));
+  EXPECT_EQ(3u, ulpDistance(T{1}, stepUp(T{1}, 3)));
+  EXPECT_EQ(3u, ulpDistance(stepUp(T{1}, 3), T{1}));
+  EXPECT_EQ(2u, ulpDistance(-std::numeric_limits<T>::denorm_min(), std::numeric_limits<T>::denorm_min()));
+  EXPECT_EQ(1u, ulpDistance(std::numeric_limits<T>::max(), inf));
+  EXPECT_EQ(std::numeric_limits<std::uint64_t>::max(), ulpDistance(nan, nan));
+  EXPECT_EQ(std::numeric_limits<std::uint64_t>::max(), ulpDistance(T{1}, nan));
+}
+
+TYPED_TEST(UtilTest, nearlyEqualRelAbs) {
+  using T = TypeParam;
+  T const inf = std::numeric_limits<T>::infinity();
+  T const nan = std::numeric_limits<T>::quiet_NaN();
+  auto const tol = Tolerance<T>::relAbs(T(1e-3), T(1e-6));
+  EXPECT_TRUE(nearlyEqual(T{1000}, T{1000.5}, tol));
+  EXPECT_FALSE(nearlyEqual(T{1000}, T{1002}, tol));
+  EXPECT_TRUE(nearlyEqual(T{0}, T(1e-7), tol));
+  EXPECT_FALSE(nearlyEqual(T{0}, T(1e-5), tol));
+  EXPECT_TRUE(nearlyEqual(inf, inf, tol));
+  EXPECT_FALSE(nearlyEqual(inf, -inf, tol));
+  EXPECT_FALSE(nearlyEqual(inf, T{1}, tol));
+  EXPECT_FALSE(nearlyEqual(nan, nan, tol));
+  EXPECT_FALSE(nearlyEqual(T{1}, nan, tol));
+  EXPECT_TRUE(nearlyEqual(inf, inf, Tolerance<T>::relAbs(T{0})));
+}
+
+TYPED_TEST(UtilTest, nearlyEqualUlps) {
+  using T = TypeParam;
+  auto const tol = Tolerance<T>::ulps(4);
+  EXPECT_TRUE(nearlyEqual(T{2}, stepUp(T{2}, 4), tol));
+  EXPECT_FALSE(nearlyEqual(T{2}, stepUp(T{2}, 5), tol));
+  // crossing a power of two
+  EXPECT_TRUE(nearlyEqual(std::nextafter(T{2}, T{0}), stepUp(T{2}, 3), tol));
+  EXPECT_TRUE(nearlyEqual(-std::numeric_limits<T>::denorm_min(), std::numeric_limits<T>::denorm_min(), tol));
+  EXPECT_FALSE(nearlyEqual(T{-1}, T{1}, Tolerance<T>::ulps(0x7effffffu)));
+}
+
+TEST(Util, allNearlyEqualFullRange) {
+  // float distances use all 32 bits, past the range of a signed compare
+  float const big = std::numeric_limits<float>::max();
+  std::vector<float> const lhs(9, -big);
+  std::vector<float> const rhs(9, big);
+  std::size_t mismatch = 0;
+  EXPECT_TRUE(allNearlyEqual(lhs.data(), rhs.data(), lhs.size(), Tolerance<float>::ulps(0xfefffffeu)));
+  EXPECT_FALSE(allNearlyEqual(lhs.data(), rhs.data(), lhs.size(), Tolerance<float>::ulps(0xfefffffdu), &mismatch));
+  EXPECT_EQ(0u, mismatch);
+  // 1 + 2^-20 is 2^32 doubles past 1, 1 + 2^-21 is 2^31
+  std::vector<double> const ones(5, 1.0);
+  std::vector<double> const far(5, 1.0 + std::ldexp(1.0, -20));
+  std::vector<double> const near(5, 1.0 + std::ldexp(1.0, -21));
+  EXPECT_FALSE(allNearlyEqual(ones.data(), far.data(), ones.size(), Tolerance<double>::ulps(0xffffffffu)));
+  EXPECT_TRUE(allNearlyEqual(ones.data(), near.data(), ones.size(), Tolerance<double>::ulps(0x80000000u)));
+  EXPECT_FALSE(allNearlyEqual(ones.data(), near.data(), ones.size(), Tolerance<double>::ulps(0x7fffffffu)));
+}
+
+TEST(Util, allNearlyEqualHighDword) {
+  // 2^32 + 1 doubles apart: the low dword alone would say 1
+  std::vector<double> const ones(3, 1.0);
+  std::vector<double> const far(3, std::nextafter(1.0 + std::ldexp(1.0, -20), 2.0));
+  std::vector<double> const farther(3, 1.0 + std::ldexp(1.0, -19));
+  EXPECT_EQ(0x100000001u, ulpDistance(1.0, far[0]));
+  EXPECT_FALSE(allNearlyEqual(ones.data(), far.data(), ones.size(), Tolerance<double>::ulps(2)));
+  EXPECT_FALSE(allNearlyEqual(ones.data(), farther.data(), ones.size(), Tolerance<double>::ulps(0xffffffffu)));
+}
+
+TYPED_TEST(UtilTest, allNearlyEqualUlpCases) {
+  using T = TypeParam;
+  UlpCases<T> const cases;
+  auto const count = cases.lhs.size();
+  std::size_t mismatch = 0;
+  EXPECT_TRUE(allNearlyEqual(cases.lhs.data(), cases.rhs.data(), count, Tolerance<T>::ulps(2), &mismatch));
+  EXPECT_EQ(count, mismatch);
+  EXPECT_TRUE(allNearlyEqual(cases.lhs.data(), cases.rhs.data(), 0, Tolerance<T>::ulps(2), &mismatch));
+  EXPECT_EQ(0u, mismatch);
+  // the denormals either side of zero are the first pair 2 ulps apart
+  EXPECT_FALSE(allNearlyEqual(cases.lhs.data(), cases.rhs.data(), count, Tolerance<T>::ulps(1), &mismatch));
+  EXPECT_EQ(1u, mismatch);
+
+  // the smallest normals either side of zero are 2^24 float ulps apart,
+  // 2^53 for double which no 32 bit tolerance covers
+  std::vector<T> const lo(count, -std::numeric_limits<T>::min());
+  std::vector<T> const hi(count, std::numeric_limits<T>::min());
+  EXPECT_FALSE(allNearlyEqual(lo.data(), hi.data(), count, Tolerance<T>::ulps(0xffffffu), &mismatch));
+  EXPECT_EQ(0u, mismatch);
+  EXPECT_EQ(sizeof(T) == 4, allNearlyEqual(lo.data(), hi.data(), count, Tolerance<T>::ulps(0x1000000u)));
+}
+
+TYPED_TEST(UtilTest, allNearlyEqualFirstMismatch) {
+  using T = TypeParam;
+  UlpCases<T> const cases;
+  auto const count = cases.lhs.size();
+  // every position, the last three in the scalar tail at widths 4 and 8
+  for (std::size_t bad = 0; bad < count; ++bad) {
+    for (T const value : {T{5000}, std::numeric_limits<T>::quiet_NaN()}) {
+      auto rhs = cases.lhs;
+      rhs[bad] = value;
+      rhs[count - 1] = T{7777};
+      for (auto const tol : {Tolerance<T>::ulps(16), Tolerance<T>::relAbs(T(1e-4), T(1e-4))}) {
+        std::size_t mismatch = 0;
+        EXPECT_FALSE(allNearlyEqual(cases.lhs.data(), rhs.data(), count, tol, &mismatch));
+        EXPECT_EQ(bad, mismatch);
+      }
+    }
+  }
+}
+
+TYPED_TEST(UtilTest, allNearlyEqualMatchesScalar) {
+  using T = TypeParam;
+  std::mt19937 gen{3};
+  std::uniform_real_distribution<T> values(-1000, 1000);
+  std::uniform_int_distribution<unsigned> steps(0, 8);
+  std::vector<T> lhs(301);
+  std::vector<T> rhs(lhs.size());
+  for (std::size_t i = 0; i < lhs.size(); ++i) {
+    lhs[i] = values(gen);
+    // include pairs of opposite sign near zero
+    rhs[i] = i % 7 == 0 ? stepUp(-std::numeric_limits<T>::denorm_min(), steps(gen)) : stepUp(lhs[i], steps(gen));
+  }
+  std::vector<T> zeros(lhs.size(), T{0});
+  for (auto const tol : {Tolerance<T>::ulps(4), Tolerance<T>::relAbs(std::numeric_limits<T>::epsilon() * 3)}) {
+    for (auto const * base : {&lhs, &zeros}) {
+      std::size_t expected = lhs.size();
+      for (std::size_t i = 0; i < lhs.size(); ++i) {
+        if (!nearlyEqual((*base)[i], rhs[i], tol)) {
+          expected = i;
+          break;
+        }
+      }
+      std::size_t mismatch = 0;
+      EXPECT_EQ(expected == lhs.size(), allNearlyEqual(base->data(), rhs.data(), lhs.size(), tol, &mismatch));
+      EXPECT_EQ(expected, mismatch);
+    }
+  }
+}
@@ -229,6 +229,15 @@ TEST(Vector, VectorMinMax) {
   EXPECT_EQ(8, max(vec2a));
 }
 
+TEST(Vector, VectorEquals) {
+  Vec3f vec3a = {1.0f, 2.0f, 3.0f};
+  Vec3f vec3b = {1.0f, 2.0f, 3.0f + 1e-8f};
+  Vec3f vec3c = {1.0f, 2.0f, 3.5f};
+  EXPECT_TRUE(equals(vec3a, vec3b));
+  EXPECT_FALSE(equals(vec3a, vec3c));
+  EXPECT_FALSE(equals(vec3c, vec3a));
+}
+
 TEST(Vector, VectorSum) {
   Vec2i vec2a = {4, 8};
   EXPECT_EQ(12, sum(vec2a));